@@ -0,0 +1,90 @@
+#!/bin/bash
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+# fail on any errors
+set -e
+
+print_usage()
+{
+    cat <<EOFUSAGE
+usage: $0 [-n <runs>] [topology files or directories]
+       -n Number of testbench runs per topology (default 10)
+
+Reports the testbench topology parse time of every topology, the
+minimum and the average over the runs. The testbench needs to be
+built with ./scripts/rebuild-testbench.sh and the default component
+test topologies with ./scripts/build-tools.sh -t
+EOFUSAGE
+}
+
+# topology file name is test-<dir>-<dai>-...-<comp>-s<in>le-s<out>le-...
+tplg_bits_in()
+{
+    basename "$1" | sed -n 's/.*-s\([0-9][0-9]\)le-s[0-9][0-9]le-.*/\1/p'
+}
+
+bench_tplg()
+{
+    local tplg=$1
+    local bits
+
+    bits=$(tplg_bits_in "$tplg")
+    : "${bits:=32}"
+
+    for _ in $(seq "$RUNS"); do
+	"$TESTBENCH" -q -r 48000 -R 48000 -c 2 -n 2 -b "S${bits}_LE" \
+		     -t "$tplg" -i "$BENCH_DIR"/in.raw -o "$BENCH_DIR"/out.raw \
+		     2>/dev/null | sed -n 's/^Topology parse time: \([0-9]*\) us/\1/p'
+    done | awk -v name="$(basename "$tplg")" '
+	NR == 1 || $1 < min { min = $1 }
+	{ sum += $1 }
+	END {
+	    if (NR)
+		printf "%8d %8d  %s\n", min, sum / NR, name
+	    else
+		printf "%8s %8s  %s\n", "-", "-", name
+	}'
+}
+
+main()
+{
+    SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+    SOF_REPO=$(dirname "$SCRIPT_DIR")
+    BUILD_TESTBENCH_DIR="$SOF_REPO"/tools/testbench/build_testbench
+    TESTBENCH="$BUILD_TESTBENCH_DIR"/install/bin/testbench
+    RUNS=10
+
+    while getopts "n:h" OPTION; do
+	case "$OPTION" in
+	    n) RUNS=$OPTARG;;
+	    h) print_usage; exit 1;;
+	    *) print_usage; exit 1;;
+	esac
+    done
+    shift $((OPTIND - 1))
+
+    if [ $# -eq 0 ]; then
+	set -- "$SOF_REPO"/tools/build_tools/test/topology
+    fi
+
+    test -x "$TESTBENCH" || {
+	printf 'No testbench %s, run rebuild-testbench.sh\n' "$TESTBENCH"
+	exit 1
+    }
+
+    HOST_LIB="$BUILD_TESTBENCH_DIR"/sof_ep/install/lib
+    TPLG_LIB="$BUILD_TESTBENCH_DIR"/sof_parser/install/lib
+    export LD_LIBRARY_PATH="$HOST_LIB":"$TPLG_LIB"
+
+    BENCH_DIR=$(mktemp -d)
+    trap 'rm -rf "$BENCH_DIR"' EXIT
+    head -c 4096 < /dev/zero > "$BENCH_DIR"/in.raw
+
+    printf '%8s %8s  %s\n' "min us" "avg us" "topology"
+    find "$@" -name '*.tplg' | sort | while read -r tplg; do
+	bench_tplg "$tplg"
+    done
+}
+
+main "$@"
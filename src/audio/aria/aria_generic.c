@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/aria/aria.h>
+#include <sof/audio/format.h>
+
+#if ARIA_GENERIC
+
+/* Absolute value saturated to 32 bits, equivalent of AE_MAXABS32S operand */
+static inline uint32_t aria_abs_sat(int32_t x)
+{
+	return x == INT32_MIN ? INT32_MAX : (uint32_t)(x < 0 ? -x : x);
+}
+
+/* Q1.31 x Q1.31 multiply with symmetric rounding back to Q1.31 and a
+ * saturating left shift by att, equivalent of AE_MULFP32X2RS followed by
+ * AE_SLAA32S.
+ */
+static inline int32_t aria_apply_gain(int32_t gain, int32_t x, size_t att)
+{
+	int64_t prod = (int64_t)gain * x;
+
+	if (prod < 0)
+		prod = -((-prod + (1LL << 30)) >> 31);
+	else
+		prod = (prod + (1LL << 30)) >> 31;
+
+	return sat_int32(prod * (1LL << att));
+}
+
+void aria_algo_calc_gain(struct comp_dev *dev, size_t gain_idx,
+			 int32_t *__restrict data, const size_t src_size)
+{
+	struct aria_data *cd = comp_get_drvdata(dev);
+	/* detecting maximum value in data chunk */
+	uint32_t max_data = 0;
+	size_t i;
+
+	for (i = 0; i < src_size; ++i)
+		max_data = MAX(max_data, aria_abs_sat(data[i]));
+
+	uint64_t gain = (1ULL << (cd->att + 32)) - 1;
+	/* currently att_ value is checked on initialization and is in range <0;3>
+	 * so eventual zero check for max_data is not needed (prevention from division by 0)
+	 */
+	if (max_data > (0x7fffffffUL >> cd->att))
+		gain = (0x7fffffffULL << 32) / max_data;
+
+	/* normalization by attenuation factor to obtain fractional range <1 / (2 pow att), 1> */
+	cd->gains[gain_idx] = (int32_t)(gain >> (cd->att + 1));
+}
+
+void aria_algo_get_data(struct comp_dev *dev, int32_t *__restrict data, size_t size)
+{
+	struct aria_data *cd = comp_get_drvdata(dev);
+	/* do linear approximation between points gain_begin and gain_end */
+	int32_t gain_begin = cd->gains[(cd->gain_state + 2) % ARIA_MAX_GAIN_STATES];
+	int32_t gain_end = cd->gains[(cd->gain_state + 3) % ARIA_MAX_GAIN_STATES];
+	size_t idx, ch, i;
+
+	for (idx = 1; idx < ARIA_MAX_GAIN_STATES - 1; ++idx) {
+		gain_begin = MIN(gain_begin, cd->gains[(cd->gain_state + idx + 2) %
+						ARIA_MAX_GAIN_STATES]);
+		gain_end = MIN(gain_end, cd->gains[(cd->gain_state + idx + 3) %
+						ARIA_MAX_GAIN_STATES]);
+	}
+
+	const size_t smpl_groups = size / cd->chan_cnt;
+	const int32_t step = (gain_end - gain_begin) / (int32_t)smpl_groups;
+	/* ensure index is always positive */
+	size_t pos = (cd->buff_pos + cd->offset) % cd->buff_size;
+	size_t frag = 0;
+	int32_t gain = gain_begin;
+
+	/* The HiFi3 version processes sample pairs from 8 byte aligned
+	 * addresses and applies the gain of the next sample group to the
+	 * last sample when it is left over from the pairs. Track the same
+	 * condition to stay bit exact with it.
+	 */
+	size_t odd_detect = ALIGN_DOWN(size, 2);
+	size_t acc = size;
+
+	if (pos & 1) {
+		odd_detect = ALIGN_DOWN(size - 1, 2);
+		acc = size - cd->chan_cnt;
+	}
+
+	for (idx = 0; idx < smpl_groups; ++idx) {
+		/* samples of a group are amplified with the same gain */
+		for (ch = 0; ch < cd->chan_cnt; ++ch) {
+			data[frag++] = aria_apply_gain(gain, cd->data[pos], cd->att);
+			if (++pos == cd->buff_size)
+				pos = 0;
+		}
+		gain = gain_begin + (idx + 1) * step;
+	}
+
+	/* maintains odd sample left over from the pairs */
+	if (acc > odd_detect) {
+		i = pos ? pos - 1 : cd->buff_size - 1;
+		data[size - 1] = aria_apply_gain(gain, cd->data[i], cd->att);
+	}
+	cd->gain_state = (cd->gain_state + 1) % ARIA_MAX_GAIN_STATES;
+}
+
+#endif /* ARIA_GENERIC */
@@ -2,6 +2,7 @@
 //
 // Copyright(c) 2019-2022 Intel Corporation. All rights reserved.
 
+#include <sof/audio/asrc/asrc_config.h>
 #include <sof/audio/asrc/asrc_farrow.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
@@ -387,10 +388,13 @@ static int asrc_initialize_buffers(struct asrc_farrow *src_obj)
 
 	/* Set buffer_length to filter_length * 2 to compensate for
 	 * missing element wise wrap around while loading but allowing
-	 * aligned loads.
+	 * aligned loads. In block mode the ring buffer holds also the
+	 * input frames consumed while output frames are collected.
 	 */
-	src_obj->buffer_length = src_obj->filter_length * 2;
-	src_obj->buffer_write_position = src_obj->filter_length;
+	src_obj->buffer_length = (src_obj->filter_length +
+				  ASRC_BLOCK_HISTORY) * 2;
+	src_obj->buffer_write_position = src_obj->filter_length +
+		ASRC_BLOCK_HISTORY;
 
 	if (src_obj->bit_depth == 32) {
 		buffer_size = src_obj->buffer_length * sizeof(int32_t);
@@ -209,14 +209,20 @@ static enum asrc_error_code initialise_filter(struct comp_dev *dev,
  * ------------------------------|-------------------------------------|
  * 0x0000                        |asrc_farrow src_obj                  |
  * ------------------------------|-------------------------------------|
- * &src_obj + 1                  |int32 impulse_response[filter_length]|
+ * &src_obj + 1                  |int32 impulse_response[filter_length *|
+ *                               |      ASRC_BLOCK_FRAMES]             |
  * ------------------------------|-------------------------------------|
  * &impulse_response[0] +        |int_x *buffer_pointer[num_channels]  |
- * filter_length                 |                                     |
+ * filter_length *               |                                     |
+ * ASRC_BLOCK_FRAMES             |                                     |
  * ------------------------------|-------------------------------------|
  *
  * Info:
  *
+ * impulse_response:
+ * In block mode the impulse responses of up to ASRC_BLOCK_FRAMES output
+ * frames are stored one after another.
+ *
  * buffer_pointer[num_channels]:
  * Pointers to each channels data. Buffers are allocated externally.
  */
@@ -262,7 +268,7 @@ enum asrc_error_code asrc_get_required_size(struct comp_dev *dev,
 	size = sizeof(struct asrc_farrow);
 
 	/* size of the impulse response */
-	size += ASRC_MAX_FILTER_LENGTH * sizeof(int32_t);
+	size += ASRC_MAX_FILTER_LENGTH * ASRC_BLOCK_FRAMES * sizeof(int32_t);
 
 	/* size of pointers to the buffers */
 	size += sizeof(int32_t *) * num_channels;
@@ -379,11 +385,11 @@ enum asrc_error_code asrc_initialise(struct comp_dev *dev,
 	if (src_obj->bit_depth == 32) {
 		src_obj->ring_buffers16 = NULL;
 		src_obj->ring_buffers32 = (int32_t **)(src_obj->impulse_response +
-			src_obj->filter_length);
+			src_obj->filter_length * ASRC_BLOCK_FRAMES);
 	} else if (src_obj->bit_depth == 16) {
 		src_obj->ring_buffers32 = NULL;
 		src_obj->ring_buffers16 = (int16_t **)(src_obj->impulse_response +
-			src_obj->filter_length);
+			src_obj->filter_length * ASRC_BLOCK_FRAMES);
 	}
 
 	/* return ok, if everything worked out */
@@ -457,11 +463,11 @@ enum asrc_error_code asrc_set_fs_ratio(struct comp_dev *dev,
 	if (src_obj->bit_depth == 32) {
 		src_obj->ring_buffers16 = NULL;
 		src_obj->ring_buffers32 = (int32_t **)(src_obj->impulse_response +
-			src_obj->filter_length);
+			src_obj->filter_length * ASRC_BLOCK_FRAMES);
 	} else if (src_obj->bit_depth == 16) {
 		src_obj->ring_buffers32 = NULL;
 		src_obj->ring_buffers16 = (int16_t **)(src_obj->impulse_response +
-			src_obj->filter_length);
+			src_obj->filter_length * ASRC_BLOCK_FRAMES);
 	}
 
 	return ASRC_EC_OK;
@@ -885,6 +891,85 @@ void asrc_write_to_ring_buffer32(struct asrc_farrow  *src_obj,
 	}
 }
 
+#if ASRC_BLOCK_MODE
+/*
+ * Output frames that are collected for block processing. For each
+ * frame the time value, the ring buffer write position and the index
+ * in the output buffer are stored when the state machine decides to
+ * generate the frame.
+ */
+struct asrc_block {
+	uint32_t time_value[ASRC_BLOCK_FRAMES];
+	int write_position[ASRC_BLOCK_FRAMES];
+	int index_output_frame[ASRC_BLOCK_FRAMES];
+	int num_frames;		/* Number of collected output frames */
+	int num_input_frames;	/* Input frames consumed after the first */
+				/* collected output frame */
+};
+
+static void asrc_block_add(struct asrc_block *block,
+			   struct asrc_farrow *src_obj,
+			   int index_output_frame)
+{
+	block->time_value[block->num_frames] = src_obj->time_value;
+	block->write_position[block->num_frames] =
+		src_obj->buffer_write_position;
+	block->index_output_frame[block->num_frames] = index_output_frame;
+	block->num_frames++;
+}
+
+/*
+ * The ring buffer keeps ASRC_BLOCK_HISTORY frames more than the filter
+ * length, so the collected frames must be processed before more input
+ * frames are consumed.
+ */
+static bool asrc_block_is_full(struct asrc_block *block)
+{
+	return block->num_frames == ASRC_BLOCK_FRAMES ||
+		(block->num_frames && block->num_input_frames == ASRC_BLOCK_HISTORY);
+}
+
+static void asrc_block_input(struct asrc_block *block)
+{
+	if (block->num_frames)
+		block->num_input_frames++;
+}
+
+static void asrc_block_process16(struct asrc_block *block,
+				 struct asrc_farrow *src_obj,
+				 int16_t **output_buffers)
+{
+	if (!block->num_frames)
+		return;
+
+	asrc_calc_impulse_response_block(src_obj, block->time_value,
+					 block->num_frames);
+	asrc_fir_filter16_block(src_obj, output_buffers,
+				block->write_position,
+				block->index_output_frame,
+				block->num_frames);
+	block->num_frames = 0;
+	block->num_input_frames = 0;
+}
+
+static void asrc_block_process32(struct asrc_block *block,
+				 struct asrc_farrow *src_obj,
+				 int32_t **output_buffers)
+{
+	if (!block->num_frames)
+		return;
+
+	asrc_calc_impulse_response_block(src_obj, block->time_value,
+					 block->num_frames);
+	asrc_fir_filter32_block(src_obj, output_buffers,
+				block->write_position,
+				block->index_output_frame,
+				block->num_frames);
+	block->num_frames = 0;
+	block->num_input_frames = 0;
+}
+#endif /* ASRC_BLOCK_MODE */
+
 enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 					 struct asrc_farrow *src_obj,
 					 int16_t **__restrict input_buffers,
@@ -896,6 +981,9 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 {
 	int index_input_frame;
 	int max_num_free_frames;
+#if ASRC_BLOCK_MODE
+	struct asrc_block block = { .num_frames = 0 };
+#endif
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -931,6 +1019,15 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 			if (*output_num_frames == max_num_free_frames)
 				break;
 
+#if ASRC_BLOCK_MODE
+			/* Collect the output frame, the impulse responses
+			 * and filtering are done for full blocks
+			 */
+			asrc_block_add(&block, src_obj, src_obj->io_buffer_idx);
+			if (asrc_block_is_full(&block))
+				asrc_block_process16(&block, src_obj,
+						     output_buffers);
+#else
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
 
@@ -939,6 +1036,7 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 			 */
 			asrc_fir_filter16(src_obj, output_buffers,
 					  src_obj->io_buffer_idx);
+#endif
 
 			/* Update time and buffer index */
 			src_obj->time_value += src_obj->fs_ratio;
@@ -952,6 +1050,13 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 			(*output_num_frames)++;
 		} else {
 			/* Consume one input sample */
+#if ASRC_BLOCK_MODE
+			if (asrc_block_is_full(&block))
+				asrc_block_process16(&block, src_obj,
+						     output_buffers);
+
+			asrc_block_input(&block);
+#endif
 			asrc_write_to_ring_buffer16(src_obj, input_buffers,
 						    index_input_frame);
 			index_input_frame++;
@@ -960,6 +1065,10 @@ enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 			src_obj->time_value -= TIME_VALUE_ONE;
 		}
 	}
+#if ASRC_BLOCK_MODE
+	/* Process the remaining collected frames */
+	asrc_block_process16(&block, src_obj, output_buffers);
+#endif
 	*write_index = src_obj->io_buffer_idx;
 	*input_num_frames = index_input_frame;
 
@@ -1009,6 +1118,9 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 	 */
 	int index_input_frame;
 	int max_num_free_frames;
+#if ASRC_BLOCK_MODE
+	struct asrc_block block = { .num_frames = 0 };
+#endif
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1039,6 +1151,13 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 			if (*output_num_frames == max_num_free_frames)
 				break;
 
+#if ASRC_BLOCK_MODE
+			/* Collect output frame to block */
+			asrc_block_add(&block, src_obj, src_obj->io_buffer_idx);
+			if (asrc_block_is_full(&block))
+				asrc_block_process32(&block, src_obj,
+						     output_buffers);
+#else
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
 
@@ -1047,6 +1166,7 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 			 */
 			asrc_fir_filter32(src_obj, output_buffers,
 					  src_obj->io_buffer_idx);
+#endif
 
 			/* Update time and index */
 			src_obj->time_value += src_obj->fs_ratio;
@@ -1060,6 +1180,13 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 			(*output_num_frames)++;
 		} else {
 			/* Consume input sample */
+#if ASRC_BLOCK_MODE
+			if (asrc_block_is_full(&block))
+				asrc_block_process32(&block, src_obj,
+						     output_buffers);
+
+			asrc_block_input(&block);
+#endif
 			asrc_write_to_ring_buffer32(src_obj, input_buffers,
 						    index_input_frame);
 			index_input_frame++;
@@ -1068,6 +1195,10 @@ enum asrc_error_code asrc_process_push32(struct comp_dev *dev,
 			src_obj->time_value -= TIME_VALUE_ONE;
 		}
 	}
+#if ASRC_BLOCK_MODE
+	/* Process the remaining collected frames */
+	asrc_block_process32(&block, src_obj, output_buffers);
+#endif
 	*write_index = src_obj->io_buffer_idx;
 	*input_num_frames = index_input_frame;
 
@@ -1113,6 +1244,9 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 					 int *read_index)
 {
 	int index_output_frame = 0;
+#if ASRC_BLOCK_MODE
+	struct asrc_block block = { .num_frames = 0 };
+#endif
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1140,6 +1274,13 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 			if (src_obj->io_buffer_idx == write_index)
 				break;
 
+#if ASRC_BLOCK_MODE
+			if (asrc_block_is_full(&block))
+				asrc_block_process16(&block, src_obj,
+						     output_buffers);
+
+			asrc_block_input(&block);
+#endif
 			asrc_write_to_ring_buffer16(src_obj,
 						    input_buffers,
 						    src_obj->io_buffer_idx);
@@ -1158,12 +1299,20 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 					       src_obj->fs_ratio_inv) >> 27;
 			src_obj->time_value_pull += src_obj->fs_ratio;
 		} else {
+#if ASRC_BLOCK_MODE
+			/* Collect output frame to block */
+			asrc_block_add(&block, src_obj, index_output_frame);
+			if (asrc_block_is_full(&block))
+				asrc_block_process16(&block, src_obj,
+						     output_buffers);
+#else
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
 
 			/* Filter and write output sample to output_buffer */
 			asrc_fir_filter16(src_obj, output_buffers,
 					  index_output_frame);
+#endif
 
 			/* Update time and index */
 			src_obj->time_value += src_obj->fs_ratio_inv;
@@ -1171,6 +1320,10 @@ enum asrc_error_code asrc_process_pull16(struct comp_dev *dev,
 			index_output_frame++;
 		}
 	}
+#if ASRC_BLOCK_MODE
+	/* Process the remaining collected frames */
+	asrc_block_process16(&block, src_obj, output_buffers);
+#endif
 	*read_index = src_obj->io_buffer_idx;
 	*output_num_frames = index_output_frame;
 
@@ -1216,6 +1369,9 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 					 int *read_index)
 {
 	int index_output_frame = 0;
+#if ASRC_BLOCK_MODE
+	struct asrc_block block = { .num_frames = 0 };
+#endif
 
 	/* parameter error handling */
 	if (!src_obj || !input_buffers || !output_buffers ||
@@ -1244,6 +1400,13 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 			if (src_obj->io_buffer_idx == write_index)
 				break;
 
+#if ASRC_BLOCK_MODE
+			if (asrc_block_is_full(&block))
+				asrc_block_process32(&block, src_obj,
+						     output_buffers);
+
+			asrc_block_input(&block);
+#endif
 			asrc_write_to_ring_buffer32(src_obj,
 						    input_buffers,
 						    src_obj->io_buffer_idx);
@@ -1262,12 +1425,20 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 					       src_obj->fs_ratio_inv) >> 27;
 			src_obj->time_value_pull += src_obj->fs_ratio;
 		} else {
+#if ASRC_BLOCK_MODE
+			/* Collect output frame to block */
+			asrc_block_add(&block, src_obj, index_output_frame);
+			if (asrc_block_is_full(&block))
+				asrc_block_process32(&block, src_obj,
+						     output_buffers);
+#else
 			/* Calculate impulse response */
 			(*src_obj->calc_ir)(src_obj);
 
 			/* Filter and write output sample to output_buffer */
 			asrc_fir_filter32(src_obj, output_buffers,
 					  index_output_frame);
+#endif
 
 			/* Update time and index */
 			src_obj->time_value += src_obj->fs_ratio_inv;
@@ -1275,6 +1446,10 @@ enum asrc_error_code asrc_process_pull32(struct comp_dev *dev,
 			index_output_frame++;
 		}
 	}
+#if ASRC_BLOCK_MODE
+	/* Process the remaining collected frames */
+	asrc_block_process32(&block, src_obj, output_buffers);
+#endif
 	*read_index = src_obj->io_buffer_idx;
 	*output_num_frames = index_output_frame;
 
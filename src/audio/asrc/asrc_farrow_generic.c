@@ -111,6 +111,87 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 	}
 }
 
+void asrc_fir_filter16_block(struct asrc_farrow *src_obj,
+			     int16_t **output_buffers,
+			     const int *write_position,
+			     const int *index_output_frame,
+			     int num_frames)
+{
+	int64_t prod;
+	int32_t prod32;
+	const int32_t *filter_p;
+	int16_t *buffer_p;
+	int step;
+	int ch;
+	int n;
+	int j;
+
+	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
+		step = src_obj->num_channels;
+	else
+		step = 1;
+
+	/* Iterate over each channel and frame of the block. See
+	 * asrc_fir_filter16() for the arithmetic.
+	 */
+	for (ch = 0; ch < src_obj->num_channels; ch++) {
+		filter_p = &src_obj->impulse_response[0];
+		for (j = 0; j < num_frames; j++) {
+			buffer_p = &src_obj->ring_buffers16[ch]
+				[write_position[j]];
+
+			prod = 0;
+			for (n = 0; n < src_obj->filter_length; n++)
+				prod += (int64_t)buffer_p[-n] * filter_p[n];
+
+			prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+			output_buffers[ch][step * index_output_frame[j]] =
+				sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+			filter_p += src_obj->filter_length;
+		}
+	}
+}
+
+void asrc_fir_filter32_block(struct asrc_farrow *src_obj,
+			     int32_t **output_buffers,
+			     const int *write_position,
+			     const int *index_output_frame,
+			     int num_frames)
+{
+	int64_t prod;
+	const int32_t *filter_p;
+	int32_t *buffer_p;
+	int step;
+	int ch;
+	int n;
+	int j;
+
+	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
+		step = src_obj->num_channels;
+	else
+		step = 1;
+
+	/* Iterate over each channel and frame of the block. See
+	 * asrc_fir_filter32() for the arithmetic.
+	 */
+	for (ch = 0; ch < src_obj->num_channels; ch++) {
+		filter_p = &src_obj->impulse_response[0];
+		for (j = 0; j < num_frames; j++) {
+			buffer_p = &src_obj->ring_buffers32[ch]
+				[write_position[j]];
+
+			prod = 0;
+			for (n = 0; n < src_obj->filter_length; n++)
+				prod += (int64_t)buffer_p[-n] *
+					(filter_p[n] >> 8);
+
+			output_buffers[ch][step * index_output_frame[j]] =
+				sat_int32(Q_SHIFT(prod, 53, 31));
+			filter_p += src_obj->filter_length;
+		}
+	}
+}
+
 /* + ALGORITHM SPECIFIC FUNCTIONS */
 
 void asrc_calc_impulse_response_n4(struct asrc_farrow *src_obj)
@@ -360,4 +441,71 @@ void asrc_calc_impulse_response_n7(struct asrc_farrow *src_obj)
 	}
 }
 
+/*
+ * Rounded Q1.31 x Q1.31 -> Q1.31 multiply for the Horner's method with a
+ * time value. The time is non-negative, so the magnitude of the result
+ * never exceeds the magnitude of x and the saturation done in
+ * q_multsr_sat_32x32() is not needed. The result is identical.
+ */
+static inline int32_t asrc_mult_time(int32_t x, int32_t time)
+{
+	return (int32_t)((uint64_t)((int64_t)x * time + (1LL << 30)) >> 31);
+}
+
+void asrc_calc_impulse_response_block(struct asrc_farrow *src_obj,
+				      const uint32_t *time_value,
+				      int num_frames)
+{
+	/*
+	 * See 'calc_impulse_response_n4' for a detailed description
+	 * of the algorithm and data handling. The Horner's method
+	 * iterations are done for the two bins of all frames of the
+	 * block with the same loaded coefficients. The lower and higher
+	 * bin of frame j are in accum[2 * j] and accum[2 * j + 1]. The
+	 * full block width is always calculated, the unused frames of a
+	 * partial block repeat the time value of the last frame.
+	 */
+	int32_t time[2 * ASRC_BLOCK_FRAMES];
+	int32_t accum[2 * ASRC_BLOCK_FRAMES];
+	const int32_t *filter_P;
+	int32_t *result_P;
+	const int filter_length = src_obj->filter_length;
+	const int num_filters = src_obj->num_filters;
+	int index_filter;
+	int index_limit;
+	int k;
+	int j;
+
+	filter_P = &src_obj->polyphase_filters[0];
+	result_P = &src_obj->impulse_response[0];
+	for (j = 0; j < 2 * ASRC_BLOCK_FRAMES; j++)
+		time[j] = sat_int32((int64_t)time_value[MIN(j >> 1, num_frames - 1)] << 4);
+
+	index_limit = filter_length >> 1;
+	for (index_filter = 0; index_filter < index_limit; index_filter++) {
+		/* Highest order polyphase filter coefficients */
+		for (j = 0; j < 2 * ASRC_BLOCK_FRAMES; j++)
+			accum[j] = filter_P[j & 1];
+
+		filter_P += 2;
+
+		/* Multiply and accumulate the lower order coefficients */
+		for (k = 1; k < num_filters; k++) {
+			for (j = 0; j < 2 * ASRC_BLOCK_FRAMES; j++)
+				accum[j] = filter_P[j & 1] +
+					asrc_mult_time(accum[j], time[j]);
+
+			filter_P += 2;
+		}
+
+		/* Store the two bins of every frame of the block */
+		for (j = 0; j < num_frames; j++) {
+			result_P[j * filter_length] = accum[2 * j];
+			result_P[j * filter_length + 1] = accum[2 * j + 1];
+		}
+
+		result_P += 2;
+	}
+}
+
 #endif /* ASRC_GENERIC */
@@ -7,6 +7,7 @@
 
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
+#include <sof/audio/component_ext.h>
 #include <rtos/interrupt.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
@@ -104,6 +105,11 @@ int buffer_set_size(struct comp_buffer __sparse_cache *buffer, uint32_t size)
 	if (size == buffer->stream.size)
 		return 0;
 
+	if (buffer->own_addr) {
+		buf_err(buffer, "resize of aliased buffer");
+		return -EBUSY;
+	}
+
 	new_ptr = rbrealloc(buffer->stream.addr, SOF_MEM_FLAG_NO_COPY,
 			    buffer->caps, size, buffer->stream.size);
 
@@ -191,10 +197,66 @@ void buffer_free(struct comp_buffer *buffer)
 	notifier_unregister_all(NULL, buffer);
 
 	coherent_free_thread(buffer, c);
-	rfree(buffer->stream.addr);
+	rfree(buffer->own_addr ? buffer->own_addr : buffer->stream.addr);
 	rfree(buffer);
 }
 
+int buffer_alias(struct comp_buffer __sparse_cache *sink,
+		 struct comp_buffer __sparse_cache *source)
+{
+	struct comp_dev *consumer = sink->sink;
+
+	if (sink->c.shared || source->c.shared)
+		return -EINVAL;
+
+	if (!consumer || comp_get_endpoint_type(consumer) != COMP_ENDPOINT_NODE ||
+	    consumer->pipeline != sink->source->pipeline)
+		return -EINVAL;
+
+	buffer_alias_clear(sink);
+
+	sink->own_addr = sink->stream.addr;
+	sink->own_size = sink->stream.size;
+	sink->alias_avail = 0;
+	audio_stream_init(&sink->stream, source->stream.addr, source->stream.size);
+
+	buf_dbg(sink, "buffer_alias(), aliased to buffer %u", source->id);
+
+	return 0;
+}
+
+void buffer_alias_clear(struct comp_buffer __sparse_cache *sink)
+{
+	if (!sink->own_addr)
+		return;
+
+	audio_stream_init(&sink->stream, sink->own_addr, sink->own_size);
+	sink->own_addr = NULL;
+	sink->own_size = 0;
+}
+
+/*
+ * Both buffers start from the same position after prepare. The data read
+ * from the sink since the last call is consumed from the source and the
+ * data produced to the source since the last call is produced to the sink,
+ * which keeps the read and write pointers of the buffers in sync.
+ */
+uint32_t buffer_alias_forward(struct comp_buffer __sparse_cache *source,
+			      struct comp_buffer __sparse_cache *sink)
+{
+	uint32_t bytes;
+
+	comp_update_buffer_consume(source, sink->alias_avail -
+				   audio_stream_get_avail_bytes(&sink->stream));
+
+	bytes = audio_stream_get_avail_bytes(&source->stream) -
+		audio_stream_get_avail_bytes(&sink->stream);
+	comp_update_buffer_produce(sink, bytes);
+	sink->alias_avail = audio_stream_get_avail_bytes(&sink->stream);
+
+	return bytes;
+}
+
 /*
  * comp_update_buffer_produce() and comp_update_buffer_consume() send
  * NOTIFIER_ID_BUFFER_PRODUCE and NOTIFIER_ID_BUFFER_CONSUME notifier events
@@ -12,25 +12,26 @@
 #include <sof/math/iir_df2t.h>
 
 /*
- * \brief Splits x into two based on the coefficients set in the lp
- *        and hp filters. The output of the lp is in y1, the output of
- *        the hp is in y2.
+ * \brief Splits a block of frames x into two based on the coefficients set
+ *        in the lp and hp filters. The output of the lp is in y1, the
+ *        output of the hp is in y2. The y1 can be the same buffer as x.
  *
  * As a side effect, this function mutates the delay values of both
  * filters.
  */
 static inline void crossover_generic_lr4_split(struct iir_state_df2t *lp,
 					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y1,
-					       int32_t *y2)
+					       int32_t *x, int32_t *y1,
+					       int32_t *y2, int frames)
 {
-	*y1 = crossover_generic_process_lr4(x, lp);
-	*y2 = crossover_generic_process_lr4(x, hp);
+	crossover_generic_process_lr4_block(x, y2, hp, frames);
+	crossover_generic_process_lr4_block(x, y1, lp, frames);
 }
 
 /*
  * \brief Splits input signal into two and merges it back to it's
- *        original form.
+ *        original form. The x is used as scratch and its contents are
+ *        lost.
  *
  * With 3-way crossovers, one output goes through only one LR4 filter,
  * whereas the other two go through two LR4 filters. This causes the signals
@@ -39,50 +40,56 @@ static inline void crossover_generic_lr4_split(struct iir_state_df2t *lp,
  */
 static inline void crossover_generic_lr4_merge(struct iir_state_df2t *lp,
 					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y)
+					       int32_t *x, int32_t *y,
+					       int frames)
 {
-	int32_t z1, z2;
+	int i;
 
-	z1 = crossover_generic_process_lr4(x, lp);
-	z2 = crossover_generic_process_lr4(x, hp);
-	*y = sat_int32(((int64_t)z1) + z2);
+	crossover_generic_process_lr4_block(x, y, lp, frames);
+	crossover_generic_process_lr4_block(x, x, hp, frames);
+	for (i = 0; i < frames; i++)
+		y[i] = sat_int32(((int64_t)y[i]) + x[i]);
 }
 
-static void crossover_generic_split_2way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+/* The split functions use the output buffers for the intermediate
+ * signals, so no other scratch memory is needed for a block.
+ */
+static void crossover_generic_split_2way(const int32_t *in,
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &out[0], &out[1]);
+	crossover_generic_process_lr4_block(in, out[0], &state->lowpass[0], frames);
+	crossover_generic_process_lr4_block(in, out[1], &state->highpass[0], frames);
 }
 
-static void crossover_generic_split_3way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_3way(const int32_t *in,
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
-	int32_t z1, z2;
-
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &z1, &z2);
+	/* z1 in out[2] and z2 in out[1] */
+	crossover_generic_process_lr4_block(in, out[2], &state->lowpass[0], frames);
+	crossover_generic_process_lr4_block(in, out[1], &state->highpass[0], frames);
 	/* Realign the phase of z1 */
 	crossover_generic_lr4_merge(&state->lowpass[1], &state->highpass[1],
-				    z1, &out[0]);
+				    out[2], out[0], frames);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[1], &out[2]);
+				    out[1], out[1], out[2], frames);
 }
 
-static void crossover_generic_split_4way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_4way(const int32_t *in,
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
-	int32_t z1, z2;
-
-	crossover_generic_lr4_split(&state->lowpass[1], &state->highpass[1],
-				    in, &z1, &z2);
+	/* z1 in out[0] and z2 in out[2] */
+	crossover_generic_process_lr4_block(in, out[0], &state->lowpass[1], frames);
+	crossover_generic_process_lr4_block(in, out[2], &state->highpass[1], frames);
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    z1, &out[0], &out[1]);
+				    out[0], out[0], out[1], frames);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[2], &out[3]);
+				    out[2], out[2], out[3], frames);
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -134,6 +141,44 @@ static void crossover_s32_default_pass(const struct comp_dev *dev,
 }
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
+/*
+ * \brief Returns the number of frames to process in the next block. The
+ *        block ends before the source or any of the sinks wraps.
+ */
+static int crossover_block_frames(const struct audio_stream __sparse_cache *source,
+				  const void *x,
+				  struct comp_buffer __sparse_cache *sinks[],
+				  void *y[], int32_t num_sinks, int frames)
+{
+	int n = MIN(frames, CROSSOVER_BLOCK_FRAMES);
+	int j;
+
+	n = MIN(n, audio_stream_frames_without_wrap(source, x));
+	for (j = 0; j < num_sinks; j++)
+		if (sinks[j])
+			n = MIN(n, audio_stream_frames_without_wrap(&sinks[j]->stream, y[j]));
+
+	return n;
+}
+
+/*
+ * \brief Splits the de-interleaved block of every channel to the band
+ *        outputs.
+ */
+static void crossover_split_block(struct comp_data *cd, int nch, int32_t num_sinks,
+				  int frames)
+{
+	int32_t *out[SOF_CROSSOVER_MAX_STREAMS];
+	int ch, j;
+
+	for (ch = 0; ch < nch; ch++) {
+		for (j = 0; j < num_sinks; j++)
+			out[j] = cd->out[j][ch];
+
+		cd->crossover_split(cd->in[ch], out, &cd->state[ch], frames);
+	}
+}
+
 #if CONFIG_FORMAT_S16LE
 static void crossover_s16_default(const struct comp_dev *dev,
 				  const struct comp_buffer __sparse_cache *source,
@@ -142,33 +187,38 @@ static void crossover_s16_default(const struct comp_dev *dev,
 				  uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
 	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int16_t *x, *y;
-	int ch, i, j;
-	int idx;
+	int16_t *x = source_stream->r_ptr;
+	int16_t *y[SOF_CROSSOVER_MAX_STREAMS];
+	int ch, i, j, n;
 	int nch = source_stream->channels;
-	int32_t out[num_sinks];
+	int remaining = frames;
 
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source_stream, idx);
-			cd->crossover_split(*x << 16, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
-					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s16(sink_stream,
-								idx);
-				*y = sat_int16(Q_SHIFT_RND(out[j], 31, 15));
-			}
-
-			idx += nch;
+	for (j = 0; j < num_sinks; j++)
+		y[j] = sinks[j] ? sinks[j]->stream.w_ptr : NULL;
+
+	while (remaining) {
+		n = crossover_block_frames(source_stream, x, sinks, (void **)y, num_sinks,
+					   remaining);
+		for (i = 0; i < n; i++)
+			for (ch = 0; ch < nch; ch++)
+				cd->in[ch][i] = *x++ << 16;
+
+		crossover_split_block(cd, nch, num_sinks, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!sinks[j])
+				continue;
+
+			for (i = 0; i < n; i++)
+				for (ch = 0; ch < nch; ch++)
+					*y[j]++ = sat_int16(Q_SHIFT_RND(cd->out[j][ch][i], 31, 15));
+
+			y[j] = audio_stream_wrap(&sinks[j]->stream, y[j]);
 		}
+
+		x = audio_stream_wrap(source_stream, x);
+		remaining -= n;
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -181,33 +231,38 @@ static void crossover_s24_default(const struct comp_dev *dev,
 				  uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
 	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int32_t *x, *y;
-	int ch, i, j;
-	int idx;
+	int32_t *x = source_stream->r_ptr;
+	int32_t *y[SOF_CROSSOVER_MAX_STREAMS];
+	int ch, i, j, n;
 	int nch = source_stream->channels;
-	int32_t out[num_sinks];
+	int remaining = frames;
 
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x << 8, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
-					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = sat_int24(Q_SHIFT_RND(out[j], 31, 23));
-			}
-
-			idx += nch;
+	for (j = 0; j < num_sinks; j++)
+		y[j] = sinks[j] ? sinks[j]->stream.w_ptr : NULL;
+
+	while (remaining) {
+		n = crossover_block_frames(source_stream, x, sinks, (void **)y, num_sinks,
+					   remaining);
+		for (i = 0; i < n; i++)
+			for (ch = 0; ch < nch; ch++)
+				cd->in[ch][i] = *x++ << 8;
+
+		crossover_split_block(cd, nch, num_sinks, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!sinks[j])
+				continue;
+
+			for (i = 0; i < n; i++)
+				for (ch = 0; ch < nch; ch++)
+					*y[j]++ = sat_int24(Q_SHIFT_RND(cd->out[j][ch][i], 31, 23));
+
+			y[j] = audio_stream_wrap(&sinks[j]->stream, y[j]);
 		}
+
+		x = audio_stream_wrap(source_stream, x);
+		remaining -= n;
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
@@ -220,33 +275,38 @@ static void crossover_s32_default(const struct comp_dev *dev,
 				  uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
 	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int32_t *x, *y;
-	int ch, i, j;
-	int idx;
+	int32_t *x = source_stream->r_ptr;
+	int32_t *y[SOF_CROSSOVER_MAX_STREAMS];
+	int ch, i, j, n;
 	int nch = source_stream->channels;
-	int32_t out[num_sinks];
+	int remaining = frames;
 
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[0];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
-					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = out[j];
-			}
-
-			idx += nch;
+	for (j = 0; j < num_sinks; j++)
+		y[j] = sinks[j] ? sinks[j]->stream.w_ptr : NULL;
+
+	while (remaining) {
+		n = crossover_block_frames(source_stream, x, sinks, (void **)y, num_sinks,
+					   remaining);
+		for (i = 0; i < n; i++)
+			for (ch = 0; ch < nch; ch++)
+				cd->in[ch][i] = *x++;
+
+		crossover_split_block(cd, nch, num_sinks, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!sinks[j])
+				continue;
+
+			for (i = 0; i < n; i++)
+				for (ch = 0; ch < nch; ch++)
+					*y[j]++ = cd->out[j][ch][i];
+
+			y[j] = audio_stream_wrap(&sinks[j]->stream, y[j]);
 		}
+
+		x = audio_stream_wrap(source_stream, x);
+		remaining -= n;
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
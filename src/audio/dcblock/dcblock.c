@@ -50,8 +50,23 @@ static void dcblock_set_passthrough(struct comp_data *cd)
 	comp_cl_info(&comp_dcblock, "dcblock_set_passthrough()");
 	int i;
 
+	cd->sections = 1;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		cd->R_coeffs[i] = ONE_Q2_30;
+		cd->R_coeffs[0][i] = ONE_Q2_30;
+}
+
+/**
+ * \brief Returns the number of sections in a blob of the size or zero if
+ * the size is not valid.
+ */
+static int dcblock_blob_sections(struct comp_data *cd, size_t size)
+{
+	size_t section_size = sizeof(cd->R_coeffs[0]);
+
+	if (!size || size % section_size || size > sizeof(cd->R_coeffs))
+		return 0;
+
+	return size / section_size;
 }
 
 /**
@@ -74,6 +89,7 @@ static struct comp_dev *dcblock_new(const struct comp_driver *drv,
 	struct comp_data *cd;
 	struct ipc_config_process *ipc_dcblock = spec;
 	size_t bs = ipc_dcblock->size;
+	int sections;
 	int ret;
 
 	comp_cl_info(&comp_dcblock, "dcblock_new()");
@@ -96,13 +112,15 @@ static struct comp_dev *dcblock_new(const struct comp_driver *drv,
 	 * Copy over the coefficients from the blob to cd->R_coeffs
 	 * Set passthrough if the size of the blob is invalid
 	 */
-	if (bs == sizeof(cd->R_coeffs)) {
-		ret = memcpy_s(cd->R_coeffs, bs, ipc_dcblock->data, bs);
+	sections = dcblock_blob_sections(cd, bs);
+	if (sections) {
+		ret = memcpy_s(cd->R_coeffs, sizeof(cd->R_coeffs), ipc_dcblock->data, bs);
 		assert(!ret);
+		cd->sections = sections;
 	} else {
 		if (bs > 0)
-			comp_cl_warn(&comp_dcblock, "dcblock_new(), binary blob size %i, expected %i",
-				     bs, sizeof(cd->R_coeffs));
+			comp_cl_warn(&comp_dcblock, "dcblock_new(), binary blob size %i, expected multiple of %i",
+				     bs, sizeof(cd->R_coeffs[0]));
 		dcblock_set_passthrough(cd);
 	}
 
@@ -175,7 +193,7 @@ static int dcblock_cmd_get_data(struct comp_dev *dev,
 		comp_info(dev, "dcblock_cmd_get_data(), SOF_CTRL_CMD_BINARY");
 
 		/* Copy coefficients back to user space */
-		resp_size = sizeof(cd->R_coeffs);
+		resp_size = cd->sections * sizeof(cd->R_coeffs[0]);
 		comp_info(dev, "dcblock_cmd_get_data(), resp_size %u",
 			  resp_size);
 
@@ -205,18 +223,33 @@ static int dcblock_cmd_set_data(struct comp_dev *dev,
 				struct sof_ipc_ctrl_data *cdata)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	size_t req_size = sizeof(cd->R_coeffs);
+	size_t req_size = cdata->data->size;
+	int sections;
 	int ret = 0;
 
 	switch (cdata->cmd) {
 	case SOF_CTRL_CMD_BINARY:
 		comp_info(dev, "dcblock_cmd_set_data(), SOF_CTRL_CMD_BINARY");
 
+		sections = dcblock_blob_sections(cd, req_size);
+		if (!sections) {
+			comp_err(dev, "dcblock_cmd_set_data(), invalid blob size %u",
+				 req_size);
+			ret = -EINVAL;
+			break;
+		}
+
 		/* Retrieve the binary controls from the packet */
-		ret = memcpy_s(cd->R_coeffs, req_size, cdata->data->data,
+		ret = memcpy_s(cd->R_coeffs, sizeof(cd->R_coeffs), cdata->data->data,
 			       req_size);
 		assert(!ret);
 
+		/* Added sections start from zero state */
+		if (sections > cd->sections)
+			memset(&cd->state[cd->sections], 0,
+			       (sections - cd->sections) * sizeof(cd->state[0]));
+
+		cd->sections = sections;
 		break;
 	default:
 		comp_err(dev, "dcblock_set_data(), invalid command %i",
@@ -13,25 +13,42 @@ LOG_MODULE_DECLARE(dcblock, CONFIG_SOF_LOG_LEVEL);
 
 /**
  *
- * Genereric processing function. Input is 32 bits.
+ * Genereric processing function. Processes one frame of all channels
+ * for one section in place. Input is 32 bits.
  *
  */
-static int32_t dcblock_generic(struct dcblock_state *state,
-			       int64_t R, int32_t x)
+static void dcblock_generic(struct dcblock_state *state,
+			    const int32_t *R, int32_t *x, int nch)
 {
-	/*
-	 * R: Q2.30, y_prev: Q1.31
-	 * R * y_prev: Q3.61
-	 */
-	int64_t out = ((int64_t)x) - state->x_prev +
-		      Q_SHIFT_RND(R * state->y_prev, 61, 31);
+	int64_t out;
+	int ch;
+
+	for (ch = 0; ch < nch; ch++) {
+		/*
+		 * R: Q2.30, y_prev: Q1.31
+		 * R * y_prev: Q3.61
+		 */
+		out = ((int64_t)x[ch]) - state->x_prev[ch] +
+		      Q_SHIFT_RND((int64_t)R[ch] * state->y_prev[ch], 61, 31);
+
+		state->x_prev[ch] = x[ch];
+		state->y_prev[ch] = sat_int32(out);
+		x[ch] = state->y_prev[ch];
+	}
+}
 
-	state->y_prev = sat_int32(out);
-	state->x_prev = x;
+/* Run the frame through all the cascaded sections */
+static inline void dcblock_frame(struct comp_data *cd, int32_t *frame, int nch)
+{
+	int s;
 
-	return state->y_prev;
+	for (s = 0; s < cd->sections; s++)
+		dcblock_generic(&cd->state[s], cd->R_coeffs[s], frame, nch);
 }
 
+/* The frames are processed one at a time with all the channels in one
+ * pass, the state of the channels is contiguous in struct dcblock_state.
+ */
 #if CONFIG_FORMAT_S16LE
 static void dcblock_s16_default(const struct comp_dev *dev,
 				const struct audio_stream __sparse_cache *source,
@@ -39,12 +56,9 @@ static void dcblock_s16_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int16_t *x = source->r_ptr;
 	int16_t *y = sink->w_ptr;
-	int32_t R;
-	int32_t tmp;
-	int idx;
 	int ch;
 	int i, n, nmax;
 	int nch = source->channels;
@@ -55,15 +69,13 @@ static void dcblock_s16_default(const struct comp_dev *dev,
 		n = MIN(samples, nmax);
 		nmax = audio_stream_samples_without_wrap_s16(sink, y);
 		n = MIN(n, nmax);
-		for (ch = 0; ch < nch; ch++) {
-			state = &cd->state[ch];
-			R = cd->R_coeffs[ch];
-			idx = ch;
-			for (i = 0; i < n; i += nch) {
-				tmp = dcblock_generic(state, R, x[idx] << 16);
-				y[idx] = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
-				idx += nch;
-			}
+		for (i = 0; i < n; i += nch) {
+			for (ch = 0; ch < nch; ch++)
+				frame[ch] = x[i + ch] << 16;
+
+			dcblock_frame(cd, frame, nch);
+			for (ch = 0; ch < nch; ch++)
+				y[i + ch] = sat_int16(Q_SHIFT_RND(frame[ch], 31, 15));
 		}
 		samples -= n;
 		x = audio_stream_wrap(source, x + n);
@@ -80,12 +92,9 @@ static void dcblock_s24_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int32_t *x = source->r_ptr;
 	int32_t *y = sink->w_ptr;
-	int32_t R;
-	int32_t tmp;
-	int idx;
 	int ch;
 	int i, n, nmax;
 	int nch = source->channels;
@@ -96,15 +105,13 @@ static void dcblock_s24_default(const struct comp_dev *dev,
 		n = MIN(samples, nmax);
 		nmax = audio_stream_samples_without_wrap_s24(sink, y);
 		n = MIN(n, nmax);
-		for (ch = 0; ch < nch; ch++) {
-			state = &cd->state[ch];
-			R = cd->R_coeffs[ch];
-			idx = ch;
-			for (i = 0; i < n; i += nch) {
-				tmp = dcblock_generic(state, R, x[idx] << 8);
-				y[idx] = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
-				idx += nch;
-			}
+		for (i = 0; i < n; i += nch) {
+			for (ch = 0; ch < nch; ch++)
+				frame[ch] = x[i + ch] << 8;
+
+			dcblock_frame(cd, frame, nch);
+			for (ch = 0; ch < nch; ch++)
+				y[i + ch] = sat_int24(Q_SHIFT_RND(frame[ch], 31, 23));
 		}
 		samples -= n;
 		x = audio_stream_wrap(source, x + n);
@@ -121,11 +128,8 @@ static void dcblock_s32_default(const struct comp_dev *dev,
 				uint32_t frames)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct dcblock_state *state;
 	int32_t *x = source->r_ptr;
 	int32_t *y = sink->w_ptr;
-	int32_t R;
-	int idx;
 	int ch;
 	int i, n, nmax;
 	int nch = source->channels;
@@ -136,14 +140,12 @@ static void dcblock_s32_default(const struct comp_dev *dev,
 		n = MIN(samples, nmax);
 		nmax = audio_stream_samples_without_wrap_s32(sink, y);
 		n = MIN(n, nmax);
-		for (ch = 0; ch < nch; ch++) {
-			state = &cd->state[ch];
-			R = cd->R_coeffs[ch];
-			idx = ch;
-			for (i = 0; i < n; i += nch) {
-				y[idx] = dcblock_generic(state, R, x[idx]);
-				idx += nch;
-			}
+		for (i = 0; i < n; i += nch) {
+			for (ch = 0; ch < nch; ch++)
+				y[i + ch] = x[i + ch];
+
+			/* in place in the sink */
+			dcblock_frame(cd, &y[i], nch);
 		}
 		samples -= n;
 		x = audio_stream_wrap(source, x + n);
@@ -21,12 +21,31 @@
 #define TWELVE_Q21     Q_CONVERT_FLOAT(12.0f, 21)               /* Q11.21 */
 #define HALF_Q24       Q_CONVERT_FLOAT(0.5f, 24)                /* Q8.24 */
 #define NEG_TWO_DB_Q30 Q_CONVERT_FLOAT(0.7943282347242815f, 30) /* -2dB = 10^(-2/20); Q2.30 */
+#define LOG10_DIV20_Q27 Q_CONVERT_FLOAT(0.1151292546f, 27)      /* log(10) / 20; Q5.27 */
 
-/* This is the knee part of the compression curve. Returns the output level
- * given the input level x. */
-static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
+/* Full compression curve with constant ratio after knee. Computes the ratio
+ * of output and input signal for a division of input levels x. The knee part
+ * of the curve and the constant ratio part are both computed for all frames
+ * and the right one is selected per frame, so that the batch math functions
+ * can process the whole division at once. Array tmp is used as scratch.
+ */
+static void volume_gain_array(const struct sof_drc_params *p, int32_t *gain,
+			      const int32_t *x, int32_t *tmp)
 {
-	int32_t knee_exp_gamma;
+	const int32_t knee_threshold =
+		sat_int32(Q_SHIFT_LEFT((int64_t)p->knee_threshold, 24, 31));
+	const int32_t linear_threshold =
+		sat_int32(Q_SHIFT_LEFT((int64_t)p->linear_threshold, 30, 31));
+	const int32_t slope_minus_one = p->slope - ONE_Q30; /* Q2.30 */
+	int32_t knee_curve_k; /* Q8.24 */
+	int32_t gamma; /* Q5.27 */
+	int32_t y; /* Q2.30 */
+	int i;
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		tmp[i] = Q_SHIFT_RND(x[i], 31, 26); /* Q6.26 */
+
+	drc_log_fixed_array(tmp, tmp, DRC_DIVISION_FRAMES); /* Q6.26 */
 
 	/* The formula in knee_curveK is linear_threshold +
 	 * (1 - expf(-k * (x - linear_threshold))) / k
@@ -34,43 +53,33 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 	 * where alpha = linear_threshold + 1 / k
 	 *	 beta = -expf(k * linear_threshold) / k
 	 *	 gamma = -k * x
+	 *
+	 * Constant ratio after knee.
+	 * log(y/y0) = s * log(x/x0)
+	 * => y = y0 * (x/x0)^s
+	 * => y = [y0 * (1/x0)^s] * x^s
+	 * => y = ratio_base * x^s
+	 * => y/x = ratio_base * x^(s - 1)
+	 * => y/x = ratio_base * e^(log(x) * (s - 1))
 	 */
-	knee_exp_gamma = exp_fixed(Q_MULTSR_32X32((int64_t)x, -p->K, 31, 20, 27)); /* Q12.20 */
-	return p->knee_alpha + Q_MULTSR_32X32((int64_t)p->knee_beta, knee_exp_gamma, 24, 20, 24);
-}
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		gamma = Q_MULTSR_32X32((int64_t)x[i], -p->K, 31, 20, 27);
+		gain[i] = x[i] < knee_threshold ? gamma :
+			Q_MULTSR_32X32((int64_t)tmp[i], slope_minus_one, 26, 30, 27);
+	}
 
-/* Full compression curve with constant ratio after knee. Returns the ratio of
- * output and input signal. */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
-{
-	const int32_t knee_threshold =
-		sat_int32(Q_SHIFT_LEFT((int64_t)p->knee_threshold, 24, 31));
-	const int32_t linear_threshold =
-		sat_int32(Q_SHIFT_LEFT((int64_t)p->linear_threshold, 30, 31));
-	int32_t exp_knee;
-	int32_t y;
+	drc_exp_fixed_array(gain, gain, DRC_DIVISION_FRAMES); /* Q12.20 */
+	drc_inv_fixed_array(tmp, x, DRC_DIVISION_FRAMES, 31, 20); /* Q12.20 */
 
-	if (x < knee_threshold) {
-		if (x < linear_threshold)
-			return ONE_Q30;
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
 		/* y = knee_curveK(x) / x */
-		y = Q_MULTSR_32X32((int64_t)knee_curveK(p, x), drc_inv_fixed(x, 31, 20),
-				   24, 20, 30);
-	} else {
-		/* Constant ratio after knee.
-		 * log(y/y0) = s * log(x/x0)
-		 * => y = y0 * (x/x0)^s
-		 * => y = [y0 * (1/x0)^s] * x^s
-		 * => y = ratio_base * x^s
-		 * => y/x = ratio_base * x^(s - 1)
-		 * => y/x = ratio_base * e^(log(x) * (s - 1))
-		 */
-		exp_knee = exp_fixed(Q_MULTSR_32X32((int64_t)drc_log_fixed(Q_SHIFT_RND(x, 31, 26)),
-						    (p->slope - ONE_Q30), 26, 30, 27)); /* Q12.20 */
-		y = Q_MULTSR_32X32((int64_t)p->ratio_base, exp_knee, 30, 20, 30);
+		knee_curve_k = p->knee_alpha +
+			Q_MULTSR_32X32((int64_t)p->knee_beta, gain[i], 24, 20, 24);
+		y = x[i] < knee_threshold ?
+			Q_MULTSR_32X32((int64_t)knee_curve_k, tmp[i], 24, 20, 30) :
+			Q_MULTSR_32X32((int64_t)p->ratio_base, gain[i], 30, 20, 30);
+		gain[i] = x[i] < linear_threshold ? ONE_Q30 : y;
 	}
-
-	return y;
 }
 
 /* Update detector_average from the last input division. */
@@ -81,15 +90,14 @@ void drc_update_detector_average(struct drc_state *state,
 {
 	int32_t detector_average = state->detector_average; /* Q2.30 */
 	int32_t abs_input_array[DRC_DIVISION_FRAMES]; /* Q1.31 */
+	int32_t gain[DRC_DIVISION_FRAMES]; /* Q2.30 */
+	int32_t release_rate[DRC_DIVISION_FRAMES]; /* Q2.30 */
 	int div_start, i, ch;
 	int16_t *sample16_p; /* for s16 format case */
 	int32_t *sample32_p; /* for s24 and s32 format cases */
 	int32_t sample;
-	int32_t gain;
 	int32_t gain_diff;
-	int is_release;
 	int32_t db_per_frame;
-	int32_t sat_release_rate;
 
 	/* Calculate the start index of the last input division */
 	if (state->pre_delay_write_index == 0) {
@@ -121,40 +129,49 @@ void drc_update_detector_average(struct drc_state *state,
 		}
 	}
 
+	/* Compute compression amount from un-delayed signal */
+
+	/* Calculate shaped power on undelayed input.  Put through
+	 * shaping curve. This is linear up to the threshold, then
+	 * enters a "knee" portion followed by the "ratio" portion. The
+	 * transition from the threshold to the knee is smooth (1st
+	 * derivative matched). The transition from the knee to the
+	 * ratio portion is smooth (1st derivative matched).
+	 */
+	volume_gain_array(p, gain, abs_input_array, release_rate); /* Q2.30 */
+
+	/* The release rate of a frame depends only on its gain. Compute the
+	 * rates for the whole division, the detector update below uses them
+	 * for the frames where the gain is released.
+	 */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		release_rate[i] = Q_SHIFT_RND(gain[i], 30, 26); /* Q6.26 */
+
+	drc_lin2db_fixed_array(release_rate, release_rate, DRC_DIVISION_FRAMES); /* Q11.21 */
+
+	/* db2lin(db_per_frame) = exp(db_per_frame * log(10) / 20) */
 	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-		/* Compute compression amount from un-delayed signal */
-
-		/* Calculate shaped power on undelayed input.  Put through
-		 * shaping curve. This is linear up to the threshold, then
-		 * enters a "knee" portion followed by the "ratio" portion. The
-		 * transition from the threshold to the knee is smooth (1st
-		 * derivative matched). The transition from the knee to the
-		 * ratio portion is smooth (1st derivative matched).
-		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
-		gain_diff = gain - detector_average; /* Q2.30 */
-		is_release = (gain_diff > 0);
-		if (is_release) {
-			if (gain > NEG_TWO_DB_Q30) {
-				detector_average +=
-					Q_MULTSR_32X32((int64_t)gain_diff,
-						       p->sat_release_rate_at_neg_two_db,
-						       30, 30, 30);
-			} else {
-				db_per_frame =
-					Q_MULTSR_32X32((int64_t)drc_lin2db_fixed(Q_SHIFT_RND(gain,
-											     30,
-											     26)),
-						       p->sat_release_frames_inv_neg,
-						       21, 30, 24); /* Q8.24 */
-				sat_release_rate =
-					db2lin_fixed(db_per_frame) - ONE_Q20; /* Q12.20 */
-				detector_average += Q_MULTSR_32X32((int64_t)gain_diff,
-								   sat_release_rate, 30, 20, 30);
-			}
-		} else {
-			detector_average = gain;
-		}
+		db_per_frame = Q_MULTSR_32X32((int64_t)release_rate[i],
+					      p->sat_release_frames_inv_neg,
+					      21, 30, 24); /* Q8.24 */
+		release_rate[i] = Q_MULTSR_32X32((int64_t)db_per_frame, LOG10_DIV20_Q27,
+						 24, 27, 27); /* Q5.27 */
+	}
+
+	drc_exp_fixed_array(release_rate, release_rate, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		release_rate[i] = gain[i] > NEG_TWO_DB_Q30 ?
+			p->sat_release_rate_at_neg_two_db :
+			sat_int32((int64_t)(release_rate[i] - ONE_Q20) << 10); /* Q2.30 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		gain_diff = gain[i] - detector_average; /* Q2.30 */
+		if (gain_diff > 0) /* is release */
+			detector_average += Q_MULTSR_32X32((int64_t)gain_diff, release_rate[i],
+							   30, 30, 30);
+		else
+			detector_average = gain[i];
 
 		detector_average = MIN(detector_average, ONE_Q30);
 	}
@@ -263,18 +280,14 @@ void drc_compress_output(struct drc_state *state,
 			 int nch)
 {
 	const int div_start = state->pre_delay_read_index;
-	int count = DRC_DIVISION_FRAMES >> 2;
 
 	int32_t c, base, r, r2, r4; /* Q2.30 */
 	int32_t x[4]; /* Q2.30 */
-	int32_t post_warp_compressor_gain;
-	int32_t total_gain;
+	int32_t total_gain[DRC_DIVISION_FRAMES];
 
-	int i, j, ch, inc;
+	int i, j, ch;
 	int16_t *sample16_p; /* for s16 format case */
 	int32_t *sample32_p; /* for s24 and s32 format cases */
-	int32_t sample;
-	int is_2byte = (nbyte == 2); /* otherwise is 4-bytes */
 
 	/* Exponential approach to desired gain. */
 	if (state->envelope_rate < ONE_Q30) {
@@ -288,76 +301,14 @@ void drc_compress_output(struct drc_state *state,
 		r2 = Q_MULTSR_32X32((int64_t)r, r, 30, 30, 30);
 		r4 = Q_MULTSR_32X32((int64_t)r2, r2, 30, 30, 30);
 
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain =
-						drc_sin_fixed(x[j] + base); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						*sample16_p =
-							sat_int16(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 15, 24, 15));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
+		for (i = 0; i < DRC_DIVISION_FRAMES; i += 4) {
+			if (i > 0) {
 				for (j = 0; j < 4; j++)
 					x[j] = Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30);
 			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain =
-						drc_sin_fixed(x[j] + base); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						*sample32_p =
-							sat_int32(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 31, 24, 31));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
 
-				for (j = 0; j < 4; j++)
-					x[j] = Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30);
-			}
+			for (j = 0; j < 4; j++)
+				total_gain[i + j] = x[j] + base;
 		}
 
 		state->compressor_gain = x[3] + base;
@@ -371,80 +322,48 @@ void drc_compress_output(struct drc_state *state,
 		r2 = Q_MULTSR_32X32((int64_t)r, r, 30, 30, 30);
 		r4 = Q_MULTSR_32X32((int64_t)r2, r2, 30, 30, 30);
 
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						*sample16_p =
-							sat_int16(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 15, 24, 15));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
+		for (i = 0; i < DRC_DIVISION_FRAMES; i += 4) {
+			if (i > 0) {
 				for (j = 0; j < 4; j++)
 					x[j] = MIN(ONE_Q30,
 						   Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30));
 			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						*sample32_p =
-							sat_int32(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 31, 24, 31));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
 
-				for (j = 0; j < 4; j++)
-					x[j] = MIN(ONE_Q30,
-						   Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30));
-			}
+			for (j = 0; j < 4; j++)
+				total_gain[i + j] = x[j];
 		}
 
 		state->compressor_gain = x[3];
 	}
+
+	/* Warp pre-compression gain to smooth out sharp exponential
+	 * transition points.
+	 */
+	drc_sin_fixed_array(total_gain, total_gain, DRC_DIVISION_FRAMES); /* Q1.31 */
+
+	/* Calculate total gain using master gain. */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		total_gain[i] = Q_MULTSR_32X32((int64_t)p->master_linear_gain, total_gain[i],
+					       24, 31, 24); /* Q8.24 */
+
+	/* Apply final gain. */
+	if (nbyte == 2) { /* 2 bytes per sample */
+		for (ch = 0; ch < nch; ch++) {
+			sample16_p = (int16_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+				sample16_p[i] =
+					sat_int16(Q_MULTSR_32X32((int64_t)sample16_p[i],
+								 total_gain[i], 15, 24, 15));
+		}
+	} else { /* 4 bytes per sample */
+		for (ch = 0; ch < nch; ch++) {
+			sample32_p = (int32_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+				sample32_p[i] =
+					sat_int32(Q_MULTSR_32X32((int64_t)sample32_p[i],
+								 total_gain[i], 31, 24, 31));
+		}
+	}
 }
 
 #endif /* DRC_GENERIC */
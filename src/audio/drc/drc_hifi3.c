@@ -23,15 +23,29 @@
 #define TWELVE_Q21     25165824   /* Q_CONVERT_FLOAT(12.0f, 21) */
 #define HALF_Q24       8388608    /* Q_CONVERT_FLOAT(0.5f, 24) */
 #define NEG_TWO_DB_Q30 852903424  /* Q_CONVERT_FLOAT(0.7943282347242815f, 30) */
+#define LOG10_DIV20_Q27 15452387  /* Q_CONVERT_FLOAT(0.1151292546f, 27) */
 
-/* This is the knee part of the compression curve. Returns the output level
- * given the input level x.
+/* Full compression curve with constant ratio after knee. Computes the ratio
+ * of output and input signal for a division of input levels x. The exp, log
+ * and inverse functions are computed with the batch math functions for the
+ * whole division. Array tmp is used as scratch.
  */
-static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
+static void volume_gain_array(const struct sof_drc_params *p, int32_t *gain,
+			      const int32_t *x, int32_t *tmp)
 {
-	ae_f32 gamma; /* Q5.27 */
-	ae_f32 knee_exp_gamma; /* Q12.20 */
+	const ae_f32 knee_threshold = AE_SLAI32S(p->knee_threshold, 7); /* Q8.24 -> Q1.31 */
+	const ae_f32 linear_threshold = AE_SLAI32S(p->linear_threshold, 1); /* Q2.30 -> Q1.31 */
+	const ae_f32 slope_minus_one = AE_SUB32(p->slope, ONE_Q30); /* Q2.30 */
 	ae_f32 knee_curve_k; /* Q8.24 */
+	ae_f32 y; /* Q2.30 */
+	int i;
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		y = AE_SRAI32R(x[i], 5); /* Q1.31 -> Q6.26 */
+		tmp[i] = y;
+	}
+
+	drc_log_fixed_array(tmp, tmp, DRC_DIVISION_FRAMES); /* Q6.26 */
 
 	/* The formula in knee_curveK is linear_threshold +
 	 * (1 - expf(-k * (x - linear_threshold))) / k
@@ -39,49 +53,40 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 	 * where alpha = linear_threshold + 1 / k
 	 *	 beta = -expf(k * linear_threshold) / k
 	 *	 gamma = -k * x
+	 *
+	 * Constant ratio after knee.
+	 * log(y/y0) = s * log(x/x0)
+	 * => y = y0 * (x/x0)^s
+	 * => y = [y0 * (1/x0)^s] * x^s
+	 * => y = ratio_base * x^s
+	 * => y/x = ratio_base * x^(s - 1)
+	 * => y/x = ratio_base * e^(log(x) * (s - 1))
 	 */
-	gamma = drc_mult_lshift(x, -p->K, drc_get_lshift(31, 20, 27));
-	knee_exp_gamma = exp_fixed(gamma);
-	knee_curve_k = drc_mult_lshift(p->knee_beta, knee_exp_gamma, drc_get_lshift(24, 20, 24));
-	knee_curve_k = AE_ADD32(knee_curve_k, p->knee_alpha);
-	return knee_curve_k;
-}
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		if (x[i] < (int32_t)knee_threshold)
+			gain[i] = drc_mult_lshift(x[i], -p->K, drc_get_lshift(31, 20, 27));
+		else
+			gain[i] = drc_mult_lshift(tmp[i], slope_minus_one,
+						  drc_get_lshift(26, 30, 27));
+	}
 
-/* Full compression curve with constant ratio after knee. Returns the ratio of
- * output and input signal.
- */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
-{
-	const ae_f32 knee_threshold = AE_SLAI32S(p->knee_threshold, 7); /* Q8.24 -> Q1.31 */
-	const ae_f32 linear_threshold = AE_SLAI32S(p->linear_threshold, 1); /* Q2.30 -> Q1.31 */
-	ae_f32 exp_knee; /* Q12.20 */
-	ae_f32 y; /* Q2.30 */
-	ae_f32 tmp;
-	ae_f32 tmp2;
+	drc_exp_fixed_array(gain, gain, DRC_DIVISION_FRAMES); /* Q12.20 */
+	drc_inv_fixed_array(tmp, x, DRC_DIVISION_FRAMES, 31, 20); /* Q12.20 */
 
-	if (x < (int32_t)knee_threshold) {
-		if (x < (int32_t)linear_threshold)
-			return ONE_Q30;
-		/* y = knee_curveK(x) / x */
-		y = drc_mult_lshift(knee_curveK(p, x), drc_inv_fixed(x, 31, 20),
-				    drc_get_lshift(24, 20, 30));
-	} else {
-		/* Constant ratio after knee.
-		 * log(y/y0) = s * log(x/x0)
-		 * => y = y0 * (x/x0)^s
-		 * => y = [y0 * (1/x0)^s] * x^s
-		 * => y = ratio_base * x^s
-		 * => y/x = ratio_base * x^(s - 1)
-		 * => y/x = ratio_base * e^(log(x) * (s - 1))
-		 */
-		tmp = AE_SRAI32R(x, 5); /* Q1.31 -> Q5.26 */
-		tmp = drc_log_fixed(tmp); /* Q6.26 */
-		tmp2 = AE_SUB32(p->slope, ONE_Q30); /* Q2.30 */
-		exp_knee = exp_fixed(drc_mult_lshift(tmp, tmp2, drc_get_lshift(26, 30, 27)));
-		y = drc_mult_lshift(p->ratio_base, exp_knee, drc_get_lshift(30, 20, 30));
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		if (x[i] < (int32_t)linear_threshold) {
+			y = ONE_Q30;
+		} else if (x[i] < (int32_t)knee_threshold) {
+			/* y = knee_curveK(x) / x */
+			knee_curve_k = drc_mult_lshift(p->knee_beta, gain[i],
+						       drc_get_lshift(24, 20, 24));
+			knee_curve_k = AE_ADD32(knee_curve_k, p->knee_alpha);
+			y = drc_mult_lshift(knee_curve_k, tmp[i], drc_get_lshift(24, 20, 30));
+		} else {
+			y = drc_mult_lshift(p->ratio_base, gain[i], drc_get_lshift(30, 20, 30));
+		}
+		gain[i] = y;
 	}
-
-	return y;
 }
 
 /* Update detector_average from the last input division. */
@@ -92,17 +97,16 @@ void drc_update_detector_average(struct drc_state *state,
 {
 	ae_f32 detector_average = state->detector_average; /* Q2.30 */
 	int32_t abs_input_array[DRC_DIVISION_FRAMES]; /* Q1.31 */
+	int32_t gain[DRC_DIVISION_FRAMES]; /* Q2.30 */
+	int32_t release_rate[DRC_DIVISION_FRAMES]; /* Q2.30 */
 	int32_t *abs_input_array_p;
 	int div_start, i, ch;
 	int16_t *sample16_p; /* for s16 format case */
 	int32_t *sample32_p; /* for s24 and s32 format cases */
 	int32_t sample;
-	ae_f32 gain;
 	ae_f32 gain_diff;
 	ae_f32 db_per_frame;
-	ae_f32 sat_release_rate;
 	ae_f32 tmp;
-	int is_release;
 
 	/* Calculate the start index of the last input division */
 	if (state->pre_delay_write_index == 0)
@@ -136,35 +140,56 @@ void drc_update_detector_average(struct drc_state *state,
 		}
 	}
 
+	/* Compute compression amount from un-delayed signal */
+
+	/* Calculate shaped power on undelayed input.  Put through
+	 * shaping curve. This is linear up to the threshold, then
+	 * enters a "knee" portion followed by the "ratio" portion. The
+	 * transition from the threshold to the knee is smooth (1st
+	 * derivative matched). The transition from the knee to the
+	 * ratio portion is smooth (1st derivative matched).
+	 */
+	volume_gain_array(p, gain, abs_input_array, release_rate); /* Q2.30 */
+
+	/* The release rate of a frame depends only on its gain. Compute the
+	 * rates for the whole division, the detector update below uses them
+	 * for the frames where the gain is released.
+	 */
 	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-		/* Compute compression amount from un-delayed signal */
-
-		/* Calculate shaped power on undelayed input.  Put through
-		 * shaping curve. This is linear up to the threshold, then
-		 * enters a "knee" portion followed by the "ratio" portion. The
-		 * transition from the threshold to the knee is smooth (1st
-		 * derivative matched). The transition from the knee to the
-		 * ratio portion is smooth (1st derivative matched).
-		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
-		gain_diff = AE_SUB32(gain, detector_average); /* Q2.30 */
-		is_release = ((int32_t)gain_diff > 0);
-		if (is_release) {
-			if ((int32_t)gain > NEG_TWO_DB_Q30) {
-				tmp = drc_mult_lshift(gain_diff, p->sat_release_rate_at_neg_two_db,
-						      drc_get_lshift(30, 30, 30));
-			} else {
-				gain = AE_SRAI32R(gain, 4); /* Q2.30 -> Q6.26 */
-				db_per_frame = drc_mult_lshift(drc_lin2db_fixed(gain),
-							       p->sat_release_frames_inv_neg,
-							       drc_get_lshift(21, 30, 24));
-				sat_release_rate = AE_SUB32(db2lin_fixed(db_per_frame), ONE_Q20);
-				tmp = drc_mult_lshift(gain_diff, sat_release_rate,
-						      drc_get_lshift(30, 20, 30));
-			}
+		tmp = AE_SRAI32R(gain[i], 4); /* Q2.30 -> Q6.26 */
+		release_rate[i] = tmp;
+	}
+
+	drc_lin2db_fixed_array(release_rate, release_rate, DRC_DIVISION_FRAMES); /* Q11.21 */
+
+	/* db2lin(db_per_frame) = exp(db_per_frame * log(10) / 20) */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		db_per_frame = drc_mult_lshift(release_rate[i], p->sat_release_frames_inv_neg,
+					       drc_get_lshift(21, 30, 24));
+		release_rate[i] = drc_mult_lshift(db_per_frame, LOG10_DIV20_Q27,
+						  drc_get_lshift(24, 27, 27));
+	}
+
+	drc_exp_fixed_array(release_rate, release_rate, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		if (gain[i] > NEG_TWO_DB_Q30) {
+			tmp = p->sat_release_rate_at_neg_two_db;
+		} else {
+			tmp = AE_SUB32(release_rate[i], ONE_Q20);
+			tmp = AE_SLAI32S(tmp, 10); /* Q12.20 -> Q2.30 */
+		}
+		release_rate[i] = tmp;
+	}
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		gain_diff = AE_SUB32(gain[i], detector_average); /* Q2.30 */
+		if ((int32_t)gain_diff > 0) { /* is release */
+			tmp = drc_mult_lshift(gain_diff, release_rate[i],
+					      drc_get_lshift(30, 30, 30));
 			detector_average = AE_ADD32(detector_average, tmp);
 		} else {
-			detector_average = gain;
+			detector_average = gain[i];
 		}
 
 		detector_average = AE_MIN32(detector_average, ONE_Q30);
@@ -293,107 +318,40 @@ void drc_compress_output(struct drc_state *state,
 			 int nch)
 {
 	const int div_start = state->pre_delay_read_index;
-	const int count = DRC_DIVISION_FRAMES >> 2;
 
 	ae_f32 x[4]; /* Q2.30 */
 	ae_f32 c, base, r, r2, r4; /* Q2.30 */
-	ae_f32 post_warp_compressor_gain;
-	ae_f32 total_gain;
 	ae_f32 tmp;
+	int32_t total_gain[DRC_DIVISION_FRAMES];
 
-	int i, j, ch, inc;
+	int i, j, ch;
 	int16_t *sample16_p; /* for s16 format case */
 	int32_t *sample32_p; /* for s24 and s32 format cases */
 	int32_t sample;
 	int32_t lshift;
-	int is_2byte = (nbyte == 2); /* otherwise is 4-bytes */
 
 	/* Exponential approach to desired gain. */
+	lshift = drc_get_lshift(30, 30, 30);
 	if (state->envelope_rate < ONE_Q30) {
 		/* Attack - reduce gain to desired. */
 		c = AE_SUB32(state->compressor_gain, state->scaled_desired_gain);
 		base = state->scaled_desired_gain;
 		r = AE_SUB32(ONE_Q30, state->envelope_rate);
-		lshift = drc_get_lshift(30, 30, 30);
 		x[0] = drc_mult_lshift(c, r, lshift);
 		for (j = 1; j < 4; j++)
 			x[j] = drc_mult_lshift(x[j - 1], r, lshift);
 		r2 = drc_mult_lshift(r, r, lshift);
 		r4 = drc_mult_lshift(r2, r2, lshift);
 
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					tmp = AE_ADD32(x[j], base);
-					post_warp_compressor_gain = drc_sin_fixed(tmp); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					lshift = drc_get_lshift(24, 31, 24);
-					total_gain = drc_mult_lshift(p->master_linear_gain,
-								     post_warp_compressor_gain,
-								     lshift); /* Q8.24 */
-
-					/* Apply final gain. */
-					lshift = drc_get_lshift(15, 24, 15);
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						sample = drc_mult_lshift(sample, total_gain,
-									 lshift);
-						*sample16_p = sat_int16(sample);
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
-				lshift = drc_get_lshift(30, 30, 30);
+		for (i = 0; i < DRC_DIVISION_FRAMES; i += 4) {
+			if (i > 0) {
 				for (j = 0; j < 4; j++)
 					x[j] = drc_mult_lshift(x[j], r4, lshift);
 			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					tmp = AE_ADD32(x[j], base);
-					post_warp_compressor_gain = drc_sin_fixed(tmp); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					lshift = drc_get_lshift(24, 31, 24);
-					total_gain = drc_mult_lshift(p->master_linear_gain,
-								     post_warp_compressor_gain,
-								     lshift); /* Q8.24 */
-
-					/* Apply final gain. */
-					lshift = drc_get_lshift(31, 24, 31);
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						sample = drc_mult_lshift(sample, total_gain,
-									 lshift);
-						*sample32_p = sample;
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
 
-				lshift = drc_get_lshift(30, 30, 30);
-				for (j = 0; j < 4; j++)
-					x[j] = drc_mult_lshift(x[j], r4, lshift);
+			for (j = 0; j < 4; j++) {
+				tmp = AE_ADD32(x[j], base);
+				total_gain[i + j] = tmp;
 			}
 		}
 
@@ -403,93 +361,58 @@ void drc_compress_output(struct drc_state *state,
 		/* Release - exponentially increase gain to 1.0 */
 		c = state->compressor_gain;
 		r = state->envelope_rate;
-		lshift = drc_get_lshift(30, 30, 30);
 		x[0] = drc_mult_lshift(c, r, lshift);
 		for (j = 1; j < 4; j++)
 			x[j] = drc_mult_lshift(x[j - 1], r, lshift);
 		r2 = drc_mult_lshift(r, r, lshift);
 		r4 = drc_mult_lshift(r2, r2, lshift);
 
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					lshift = drc_get_lshift(24, 31, 24);
-					total_gain = drc_mult_lshift(p->master_linear_gain,
-								     post_warp_compressor_gain,
-								     lshift); /* Q8.24 */
-
-					/* Apply final gain. */
-					lshift = drc_get_lshift(15, 24, 15);
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						sample = drc_mult_lshift(sample, total_gain,
-									 lshift);
-						*sample16_p = sat_int16(sample);
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
-				lshift = drc_get_lshift(30, 30, 30);
+		for (i = 0; i < DRC_DIVISION_FRAMES; i += 4) {
+			if (i > 0) {
 				for (j = 0; j < 4; j++) {
 					tmp = drc_mult_lshift(x[j], r4, lshift);
 					x[j] = AE_MIN32(ONE_Q30, tmp);
 				}
 			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					lshift = drc_get_lshift(24, 31, 24);
-					total_gain = drc_mult_lshift(p->master_linear_gain,
-								     post_warp_compressor_gain,
-								     lshift); /* Q8.24 */
-
-					/* Apply final gain. */
-					lshift = drc_get_lshift(31, 24, 31);
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						sample = drc_mult_lshift(sample, total_gain,
-									 lshift);
-						*sample32_p = sample;
-					}
-					inc++;
-				}
 
-				if (++i == count)
-					break;
-
-				lshift = drc_get_lshift(30, 30, 30);
-				for (j = 0; j < 4; j++) {
-					tmp = drc_mult_lshift(x[j], r4, lshift);
-					x[j] = AE_MIN32(ONE_Q30, tmp);
-				}
-			}
+			for (j = 0; j < 4; j++)
+				total_gain[i + j] = x[j];
 		}
 
 		state->compressor_gain = x[3];
 	}
+
+	/* Warp pre-compression gain to smooth out sharp exponential
+	 * transition points.
+	 */
+	drc_sin_fixed_array(total_gain, total_gain, DRC_DIVISION_FRAMES); /* Q1.31 */
+
+	/* Calculate total gain using master gain. */
+	lshift = drc_get_lshift(24, 31, 24);
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		total_gain[i] = drc_mult_lshift(p->master_linear_gain, total_gain[i],
+						lshift); /* Q8.24 */
+
+	/* Apply final gain. */
+	if (nbyte == 2) { /* 2 bytes per sample */
+		lshift = drc_get_lshift(15, 24, 15);
+		for (ch = 0; ch < nch; ch++) {
+			sample16_p = (int16_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+				sample = (int32_t)sample16_p[i];
+				sample = drc_mult_lshift(sample, total_gain[i], lshift);
+				sample16_p[i] = sat_int16(sample);
+			}
+		}
+	} else { /* 4 bytes per sample */
+		lshift = drc_get_lshift(31, 24, 31);
+		for (ch = 0; ch < nch; ch++) {
+			sample32_p = (int32_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+				sample32_p[i] = drc_mult_lshift(sample32_p[i], total_gain[i],
+								lshift);
+		}
+	}
 }
 
 #endif /* DRC_HIFI3 */
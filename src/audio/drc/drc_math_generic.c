@@ -6,6 +6,7 @@
 
 #include <sof/audio/drc/drc_math.h>
 #include <sof/audio/format.h>
+#include <sof/common.h>
 #include <sof/math/decibels.h>
 #include <sof/math/numbers.h>
 #include <sof/math/trig.h>
@@ -219,6 +220,202 @@ inline int32_t drc_inv_fixed(int32_t x, int32_t precision_x, int32_t precision_y
 #undef qc
 }
 
+/*
+ * Same as rexp_fixed() but without the data dependent loop of norm_int32(),
+ * for use in the batch functions below.
+ */
+static inline int32_t rexp_fixed_batch(int32_t x, int32_t precision_x, int32_t *e)
+{
+	uint32_t v = x ^ (x >> 31);
+	int32_t bit = v ? 32 - clz(v) : 0;
+
+	*e = bit - precision_x;
+	return bit > 30 ? Q_SHIFT_RND(x, bit, 30) : Q_SHIFT_LEFT(x, bit, 30);
+}
+
+/*
+ * Input is Q6.26; output is Q6.26, same as log10_fixed()
+ */
+static inline int32_t log10_fixed_batch(int32_t x)
+{
+#define qc 26
+	const int32_t ONE_OVER_SQRT2 = Q_CONVERT_FLOAT(0.70710678118654752f, 30); /* 1/sqrt(2) */
+	const int32_t A5 = Q_CONVERT_FLOAT(1.131880283355712890625f, qc);
+	const int32_t A4 = Q_CONVERT_FLOAT(-4.258677959442138671875f, qc);
+	const int32_t A3 = Q_CONVERT_FLOAT(6.81631565093994140625f, qc);
+	const int32_t A2 = Q_CONVERT_FLOAT(-6.1185703277587890625f, qc);
+	const int32_t A1 = Q_CONVERT_FLOAT(3.6505267620086669921875f, qc);
+	const int32_t A0 = Q_CONVERT_FLOAT(-1.217894077301025390625f, qc);
+	const int32_t LOG10_2 = Q_CONVERT_FLOAT(0.301029995663981195214f, qc);
+	int32_t e;
+	int32_t exp; /* Q31.1 */
+	int32_t x2, x4; /* Q2.30 */
+	int32_t A5Xx, A3Xx;
+	int32_t gt;
+
+	x = rexp_fixed_batch(x, 26, &e); /* Q2.30 */
+	gt = x > ONE_OVER_SQRT2;
+	x = gt ? q_mult(x, ONE_OVER_SQRT2, 30, 30, 30) : x;
+	exp = ((int32_t)e << 1) + gt;
+
+	x2 = q_mult(x, x, 30, 30, 30);
+	x4 = q_mult(x2, x2, 30, 30, 30);
+	A5Xx = q_mult(A5, x, qc, 30, qc);
+	A3Xx = q_mult(A3, x, qc, 30, qc);
+	return q_mult((A5Xx + A4), x4, qc, 30, qc) + q_mult((A3Xx + A2), x2, qc, 30, qc)
+		+ q_mult(A1, x, qc, 30, qc) + A0 + q_mult(exp, LOG10_2, 1, qc, qc);
+#undef qc
+}
+
+void drc_lin2db_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	int32_t log10_linear;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		log10_linear = log10_fixed_batch(x[i]); /* Q6.26 */
+		y[i] = x[i] > 0 ? q_mult(20, log10_linear, 0, 26, 21) :
+			Q_CONVERT_FLOAT(-1000.0f, 21);
+	}
+}
+
+void drc_log_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	const int32_t LOG10 = Q_CONVERT_FLOAT(2.3025850929940457f, 29);
+	int32_t log10_x;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		log10_x = log10_fixed_batch(x[i]); /* Q6.26 */
+		y[i] = x[i] > 0 ? q_mult(LOG10, log10_x, 29, 26, 26) :
+			Q_CONVERT_FLOAT(-30.0f, 26);
+	}
+}
+
+void drc_inv_fixed_array(int32_t *y, const int32_t *x, int n, int32_t precision_x,
+			 int32_t precision_y)
+{
+#define qc 25
+	const int32_t ONE_OVER_SQRT2 = Q_CONVERT_FLOAT(0.70710678118654752f, 30); /* 1/sqrt(2) */
+	const int32_t SQRT2 = Q_CONVERT_FLOAT(1.4142135623730950488f, 30); /* sqrt(2) */
+	const int32_t A5 = Q_CONVERT_FLOAT(-2.742647647857666015625f, qc);
+	const int32_t A4 = Q_CONVERT_FLOAT(14.01327800750732421875f, qc);
+	const int32_t A3 = Q_CONVERT_FLOAT(-29.74465179443359375f, qc);
+	const int32_t A2 = Q_CONVERT_FLOAT(33.57208251953125f, qc);
+	const int32_t A1 = Q_CONVERT_FLOAT(-21.25031280517578125f, qc);
+	const int32_t A0 = Q_CONVERT_FLOAT(7.152250766754150390625f, qc);
+	int32_t e;
+	int32_t shift;
+	int32_t sqrt2_extracted;
+	int32_t in, x2, x4; /* Q2.30 */
+	int32_t A5Xx, A3Xx;
+	int32_t inv;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		in = rexp_fixed_batch(x[i], precision_x, &e); /* Q2.30 */
+		sqrt2_extracted = ABS(in) < ONE_OVER_SQRT2;
+		in = sqrt2_extracted ? q_mult(in, SQRT2, 30, 30, 30) : in;
+
+		x2 = q_mult(in, in, 30, 30, 30);
+		x4 = q_mult(x2, x2, 30, 30, 30);
+		A5Xx = q_mult(A5, in, qc, 30, qc);
+		A3Xx = q_mult(A3, in, qc, 30, qc);
+		inv = q_mult((A5Xx + A4), x4, qc, 30, qc) + q_mult((A3Xx + A2), x2, qc, 30, qc)
+			+ q_mult(A1, in, qc, 30, qc) + A0;
+		inv = sqrt2_extracted ? q_mult(inv, SQRT2, qc, 30, qc) : inv;
+
+		/* Shift from precision e + qc to precision_y */
+		shift = precision_y - e - qc;
+		y[i] = shift < 0 ? ((inv >> (-shift - 1)) + 1) >> 1 :
+			sat_int32((int64_t)inv << shift);
+	}
+#undef qc
+}
+
+/*
+ * Input is Q5.27: (-16.0, 16.0)
+ * Output is Q12.20: [0.0, 2048.0), same range limits as exp_fixed()
+ */
+void drc_exp_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	/* 2^(j/16) for j = 0 .. 15 */
+	static const int32_t exp2_table[16] = {
+		Q_CONVERT_FLOAT(1.0000000000000000, 30), Q_CONVERT_FLOAT(1.0442737824274138, 30),
+		Q_CONVERT_FLOAT(1.0905077326652577, 30), Q_CONVERT_FLOAT(1.1387886347566916, 30),
+		Q_CONVERT_FLOAT(1.1892071150027210, 30), Q_CONVERT_FLOAT(1.2418578120734840, 30),
+		Q_CONVERT_FLOAT(1.2968395546510096, 30), Q_CONVERT_FLOAT(1.3542555469368927, 30),
+		Q_CONVERT_FLOAT(1.4142135623730951, 30), Q_CONVERT_FLOAT(1.4768261459394993, 30),
+		Q_CONVERT_FLOAT(1.5422108254079407, 30), Q_CONVERT_FLOAT(1.6104903319492543, 30),
+		Q_CONVERT_FLOAT(1.6817928305074290, 30), Q_CONVERT_FLOAT(1.7562521603732995, 30),
+		Q_CONVERT_FLOAT(1.8340080864093424, 30), Q_CONVERT_FLOAT(1.9152065613971474, 30),
+	};
+	/* Coefficients for 2^r, r in [0, 1/16), max err ~= 1.17e-9 */
+	const int32_t A3 = Q_CONVERT_FLOAT(0.056721494410524875, 30);
+	const int32_t A2 = Q_CONVERT_FLOAT(0.24017874103896789, 30);
+	const int32_t A1 = Q_CONVERT_FLOAT(0.6931477791880194, 30);
+	const int32_t A0 = Q_CONVERT_FLOAT(0.9999999988283337, 30);
+	const int32_t LOG2_E = Q_CONVERT_FLOAT(1.4426950408889634, 30);
+	const int32_t MIN_X = Q_CONVERT_FLOAT(-11.5, 27);
+	const int32_t MAX_X = Q_CONVERT_FLOAT(7.6245, 27);
+	int32_t t, r, k, m, shift;
+	int32_t acc;
+	int32_t exp;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		/* exp(x) = 2^(x * log2(e)) = 2^k * 2^(j/16) * 2^r */
+		t = q_mult(x[i], LOG2_E, 27, 30, 26); /* Q6.26 */
+		k = t >> 26;
+		r = (t & 0x3fffff) << 4; /* Q2.30 */
+
+		acc = q_multq(A3, r, 30) + A2;
+		acc = q_multq(acc, r, 30) + A1;
+		acc = q_multq(acc, r, 30) + A0;
+		m = q_mult(exp2_table[(t >> 22) & 0xf], acc, 30, 30, 29); /* Q3.29 */
+
+		/* Scale by 2^k and shift from Q3.29 to Q12.20, the shift is limited
+		 * to keep it defined for the inputs below MIN_X that give 0 anyway.
+		 */
+		shift = MAX(k - 9, -31);
+		exp = shift < 0 ? ((m >> (-shift - 1)) + 1) >> 1 :
+			sat_int32((int64_t)m << shift);
+
+		exp = x[i] < MIN_X ? 0 : exp;
+		y[i] = x[i] > MAX_X ? INT32_MAX : exp;
+	}
+}
+
+/*
+ * Input is Q2.30: (-2.0, 2.0)
+ * Output range: [-1.0, 1.0]; regulated to Q1.31: (-1.0, 1.0)
+ */
+void drc_sin_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	/* Coefficients for sin(pi/2 * x), x in [-1, 1], max err ~= 5.89e-7 */
+	const int32_t ONE = Q_CONVERT_FLOAT(1.0, 30);
+	const int32_t A7 = Q_CONVERT_FLOAT(-0.004333094161160197, 30);
+	const int32_t A5 = Q_CONVERT_FLOAT(0.07943434309812776, 30);
+	const int32_t A3 = Q_CONVERT_FLOAT(-0.6458928490411165, 30);
+	const int32_t A1 = Q_CONVERT_FLOAT(1.570791011051353, 30);
+	int32_t in, in2; /* Q2.30 */
+	int32_t acc;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		/* sin(pi/2 * x) = sin(pi/2 * (2 - x)) folds (1, 2) to (0, 1) */
+		in = x[i];
+		in = in > ONE ? (ONE - in) + ONE : in;
+		in = in < -ONE ? (-ONE - in) - ONE : in;
+
+		in2 = q_multq(in, in, 30);
+		acc = q_multq(A7, in2, 30) + A5;
+		acc = q_multq(acc, in2, 30) + A3;
+		acc = q_multq(acc, in2, 30) + A1;
+		y[i] = sat_int32(Q_MULTSR_32X32((int64_t)acc, in, 30, 30, 31));
+	}
+}
+
 #endif /* DRC_GENERIC */
 
 /*
@@ -38,6 +38,18 @@
 #define INV_FUNC_A2_Q25 1126492160 /* Q_CONVERT_FLOAT(33.57208251953125f, 25) */
 #define INV_FUNC_A1_Q25 -713042175 /* Q_CONVERT_FLOAT(-21.25031280517578125f, 25) */
 #define INV_FUNC_A0_Q25 239989712 /* Q_CONVERT_FLOAT(7.152250766754150390625f, 25) */
+#define ONE_Q30 1073741824 /* Q_CONVERT_FLOAT(1.0f, 30) */
+#define LOG2_E_Q30 1549082005 /* Q_CONVERT_FLOAT(1.4426950408889634, 30) */
+#define EXP_MIN_Q27 -1543503871 /* Q_CONVERT_FLOAT(-11.5, 27) */
+#define EXP_MAX_Q27 1023343067 /* Q_CONVERT_FLOAT(7.6245, 27) */
+#define EXP2_FUNC_A3_Q30 60904241 /* Q_CONVERT_FLOAT(0.056721494410524875, 30) */
+#define EXP2_FUNC_A2_Q30 257889959 /* Q_CONVERT_FLOAT(0.24017874103896789, 30) */
+#define EXP2_FUNC_A1_Q30 744261761 /* Q_CONVERT_FLOAT(0.6931477791880194, 30) */
+#define EXP2_FUNC_A0_Q30 1073741823 /* Q_CONVERT_FLOAT(0.9999999988283337, 30) */
+#define SIN_FUNC_A7_Q30 -4652623 /* Q_CONVERT_FLOAT(-0.004333094161160197, 30) */
+#define SIN_FUNC_A5_Q30 85291976 /* Q_CONVERT_FLOAT(0.07943434309812776, 30) */
+#define SIN_FUNC_A3_Q30 -693522165 /* Q_CONVERT_FLOAT(-0.6458928490411165, 30) */
+#define SIN_FUNC_A1_Q30 1686624005 /* Q_CONVERT_FLOAT(1.570791011051353, 30) */
 
 /*
  * Input depends on precision_x
@@ -225,4 +237,111 @@ inline int32_t drc_inv_fixed(int32_t x, int32_t precision_x, int32_t precision_y
 	return acc;
 }
 
+void drc_lin2db_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = drc_lin2db_fixed(x[i]);
+}
+
+void drc_log_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = drc_log_fixed(x[i]);
+}
+
+void drc_inv_fixed_array(int32_t *y, const int32_t *x, int n, int32_t precision_x,
+			 int32_t precision_y)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = drc_inv_fixed(x[i], precision_x, precision_y);
+}
+
+/*
+ * Input is Q5.27: (-16.0, 16.0)
+ * Output is Q12.20: [0.0, 2048.0), same range limits as exp_fixed()
+ */
+void drc_exp_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	/* 2^(j/16) for j = 0 .. 15 in Q2.30 */
+	static const int32_t exp2_table[16] = {
+		1073741824, 1121280436, 1170923762, 1222764986,
+		1276901417, 1333434672, 1392470869, 1454120821,
+		1518500250, 1585730000, 1655936265, 1729250827,
+		1805811301, 1885761398, 1969251188, 2056437387,
+	};
+	/* Coefficients for 2^r, r in [0, 1/16), max err ~= 1.17e-9 */
+	const int32_t lshift = drc_get_lshift(30, 30, 30);
+	int32_t t, k;
+	ae_f32 r; /* Q2.30 */
+	ae_f32 acc; /* Q2.30 */
+	ae_f32 m; /* Q12.20 */
+	int i;
+
+	for (i = 0; i < n; i++) {
+		/* exp(x) = 2^(x * log2(e)) = 2^k * 2^(j/16) * 2^r */
+		t = drc_mult_lshift(x[i], LOG2_E_Q30, drc_get_lshift(27, 30, 26)); /* Q6.26 */
+		k = t >> 26;
+		r = (t & 0x3fffff) << 4;
+
+		acc = drc_mult_lshift(EXP2_FUNC_A3_Q30, r, lshift);
+		acc = AE_ADD32(acc, EXP2_FUNC_A2_Q30);
+		acc = drc_mult_lshift(acc, r, lshift);
+		acc = AE_ADD32(acc, EXP2_FUNC_A1_Q30);
+		acc = drc_mult_lshift(acc, r, lshift);
+		acc = AE_ADD32(acc, EXP2_FUNC_A0_Q30);
+
+		/* Scale by 2^k with the product shift, Q2.30 x Q2.30 -> Q12.20. The
+		 * shift is limited as in the generic version, the inputs below MIN_X
+		 * give 0 anyway.
+		 */
+		m = drc_mult_lshift(exp2_table[(t >> 22) & 0xf], acc,
+				    MAX(drc_get_lshift(30, 30, 20) + k, -31));
+
+		if (x[i] < EXP_MIN_Q27)
+			m = 0;
+		if (x[i] > EXP_MAX_Q27)
+			m = INT32_MAX;
+		y[i] = m;
+	}
+}
+
+/*
+ * Input is Q2.30: (-2.0, 2.0)
+ * Output range: [-1.0, 1.0]; regulated to Q1.31: (-1.0, 1.0)
+ */
+void drc_sin_fixed_array(int32_t *y, const int32_t *x, int n)
+{
+	/* Coefficients for sin(pi/2 * x), x in [-1, 1], max err ~= 5.89e-7 */
+	const int32_t lshift = drc_get_lshift(30, 30, 30);
+	int32_t v;
+	ae_f32 in, in2; /* Q2.30 */
+	ae_f32 acc;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		/* sin(pi/2 * x) = sin(pi/2 * (2 - x)) folds (1, 2) to (0, 1) */
+		v = x[i];
+		if (v > ONE_Q30)
+			v = (ONE_Q30 - v) + ONE_Q30;
+		if (v < -ONE_Q30)
+			v = (-ONE_Q30 - v) - ONE_Q30;
+
+		in = v;
+		in2 = drc_mult_lshift(in, in, lshift);
+		acc = drc_mult_lshift(SIN_FUNC_A7_Q30, in2, lshift);
+		acc = AE_ADD32(acc, SIN_FUNC_A5_Q30);
+		acc = drc_mult_lshift(acc, in2, lshift);
+		acc = AE_ADD32(acc, SIN_FUNC_A3_Q30);
+		acc = drc_mult_lshift(acc, in2, lshift);
+		acc = AE_ADD32(acc, SIN_FUNC_A1_Q30);
+		y[i] = drc_mult_lshift(acc, in, drc_get_lshift(30, 30, 31));
+	}
+}
+
 #endif /* DRC_HIFI3 */
@@ -18,6 +18,7 @@
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/kpb.h>
+#include <sof/audio/kpb_adpcm.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/common.h>
 #include <sof/debug/panic.h>
@@ -86,6 +87,9 @@ struct comp_data {
 				   * host?
 				   */
 	enum comp_copy_type force_copy_type; /**< should we force copy_type on kpb sink? */
+#if CONFIG_KPB_HISTORY_ADPCM
+	struct kpb_history_codec codec; /**< history buffer coding */
+#endif
 };
 
 /*! KPB private functions */
@@ -103,8 +107,14 @@ static inline bool kpb_is_sample_width_supported(uint32_t sampling_width);
 static void kpb_copy_samples(struct comp_buffer __sparse_cache *sink,
 			     struct comp_buffer __sparse_cache *source, size_t size,
 			     size_t sample_width);
+#if !CONFIG_KPB_HISTORY_ADPCM
 static void kpb_drain_samples(void *source, struct audio_stream __sparse_cache *sink,
 			      size_t size, size_t sample_width);
+#endif
+static size_t kpb_drain_history(struct comp_data *kpb, void *source,
+				struct audio_stream __sparse_cache *sink, size_t size);
+static bool kpb_drain_staged(struct comp_data *kpb,
+			     struct comp_buffer __sparse_cache *sink);
 static void kpb_buffer_samples(const struct audio_stream __sparse_cache *source,
 			       int offset, void *sink, size_t size,
 			       size_t sample_width);
@@ -157,6 +167,212 @@ static void kpb_lock_init(struct comp_data *kpb)
 
 #endif /* __ZEPHYR__ */
 
+#if CONFIG_KPB_HISTORY_ADPCM
+
+/* The 16 most significant bits of a sample are coded */
+static inline int16_t kpb_adpcm_sample_s16(const int32_t *pcm, int i, size_t sample_width)
+{
+	switch (sample_width) {
+	case 16:
+		return ((const int16_t *)pcm)[i];
+	case 24:
+		return sign_extend_s24(pcm[i]) >> 8;
+	default:
+		return pcm[i] >> 16;
+	}
+}
+
+static inline void kpb_adpcm_set_sample(int32_t *pcm, int i, size_t sample_width, int16_t x)
+{
+	switch (sample_width) {
+	case 16:
+		((int16_t *)pcm)[i] = x;
+		break;
+	case 24:
+		pcm[i] = (int32_t)x << 8;
+		break;
+	default:
+		pcm[i] = (int32_t)x << 16;
+		break;
+	}
+}
+
+/**
+ * \brief Code frames of the source stream into the history codec block.
+ * \param[in] kpb - KPB component data pointer.
+ * \param[in] source - source stream.
+ * \param[in] offset - start offset in the source stream in samples.
+ * \param[in] frames - number of frames to code, up to the end of block.
+ */
+static void kpb_adpcm_encode_frames(struct comp_data *kpb,
+				    const struct audio_stream __sparse_cache *source,
+				    int offset, size_t frames)
+{
+	struct kpb_history_codec *codec = &kpb->codec;
+	size_t channels = kpb->config.channels;
+	size_t sample_width = kpb->config.sampling_width;
+	size_t header_size = channels * sizeof(struct kpb_adpcm_state);
+	uint8_t *codes = codec->block + header_size;
+	size_t samples = frames * channels;
+	size_t i, n;
+	size_t c = 0;
+
+	/* the block starts with the coder state to decode it alone */
+	if (!codec->frames_staged)
+		memcpy_s(codec->block, sizeof(codec->block), codec->enc, header_size);
+
+	audio_stream_copy_to_linear(source, offset, codec->pcm, 0, samples);
+
+	n = codec->frames_staged * channels;
+	for (i = 0; i < samples; i++, n++) {
+		uint8_t code = kpb_adpcm_encode(&codec->enc[c],
+						kpb_adpcm_sample_s16(codec->pcm, i,
+								     sample_width));
+
+		if (n & 1)
+			codes[n >> 1] |= code << 4;
+		else
+			codes[n >> 1] = code;
+
+		if (++c == channels)
+			c = 0;
+	}
+
+	codec->frames_staged += frames;
+}
+
+/**
+ * \brief Decode frames of a history codec block into sink stream.
+ * \param[in] kpb - KPB component data pointer.
+ * \param[in] block - coded block.
+ * \param[in] frames - number of frames to decode from the block start.
+ * \param[in,out] sink - sink stream.
+ * \param[in] offset - start offset from the sink write pointer in samples.
+ */
+static void kpb_adpcm_decode_frames(struct comp_data *kpb, const uint8_t *block,
+				    size_t frames, struct audio_stream __sparse_cache *sink,
+				    int offset)
+{
+	struct kpb_history_codec *codec = &kpb->codec;
+	struct kpb_adpcm_state st[KPB_MAX_SUPPORTED_CHANNELS];
+	size_t channels = kpb->config.channels;
+	size_t sample_width = kpb->config.sampling_width;
+	size_t header_size = channels * sizeof(struct kpb_adpcm_state);
+	const uint8_t *codes = block + header_size;
+	size_t samples = frames * channels;
+	size_t i;
+	size_t c = 0;
+
+	kpb_adpcm_load_state(st, block, channels);
+
+	for (i = 0; i < samples; i++) {
+		uint8_t code = i & 1 ? codes[i >> 1] >> 4 : codes[i >> 1] & 0xf;
+
+		kpb_adpcm_set_sample(codec->drain_pcm, i, sample_width,
+				     kpb_adpcm_update(&st[c], code));
+		if (++c == channels)
+			c = 0;
+	}
+
+	audio_stream_copy_from_linear(codec->drain_pcm, 0, sink, offset, samples);
+}
+
+#endif /* CONFIG_KPB_HISTORY_ADPCM */
+
+/**
+ * \brief Initialize history codec for current configuration.
+ * \param[in] kpb - KPB component data pointer.
+ */
+static void kpb_history_codec_init(struct comp_data *kpb)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	struct kpb_history_codec *codec = &kpb->codec;
+
+	memset(codec->enc, 0, sizeof(codec->enc));
+	codec->frame_bytes = kpb->config.channels *
+			     (KPB_SAMPLE_CONTAINER_SIZE(kpb->config.sampling_width) / 8);
+	codec->pcm_block_size = KPB_ADPCM_BLOCK_FRAMES * codec->frame_bytes;
+	codec->block_size = KPB_ADPCM_BLOCK_SIZE(kpb->config.channels);
+	codec->frames_staged = 0;
+	codec->drain_fill = 0;
+#endif
+}
+
+/**
+ * \brief Size of history buffer needed to keep size bytes of PCM.
+ */
+static size_t kpb_history_size(const struct comp_data *kpb, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	const struct kpb_history_codec *codec = &kpb->codec;
+
+	return ceil_divide(size, codec->pcm_block_size) * codec->block_size;
+#else
+	return size;
+#endif
+}
+
+/**
+ * \brief Checks that a history buffer of size bytes holds whole coded blocks,
+ *	so blocks stay aligned when the buffer wraps.
+ */
+static bool kpb_history_size_aligned(const struct comp_data *kpb, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	return !(size % kpb->codec.block_size);
+#else
+	return true;
+#endif
+}
+
+/**
+ * \brief Bytes stored into history buffer when next size bytes of PCM
+ *	are buffered.
+ */
+static size_t kpb_history_stored_bytes(const struct comp_data *kpb, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	const struct kpb_history_codec *codec = &kpb->codec;
+
+	return (codec->frames_staged * codec->frame_bytes + size) /
+		codec->pcm_block_size * codec->block_size;
+#else
+	return size;
+#endif
+}
+
+/**
+ * \brief Bytes of PCM that can be buffered next storing at most size bytes
+ *	into history buffer.
+ */
+static size_t kpb_history_pcm_bytes(const struct comp_data *kpb, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	const struct kpb_history_codec *codec = &kpb->codec;
+
+	return (size / codec->block_size + 1) * codec->pcm_block_size -
+		(codec->frames_staged + 1) * codec->frame_bytes;
+#else
+	return size;
+#endif
+}
+
+/**
+ * \brief Bytes that can be drained next from history buffer producing at
+ *	most size bytes of PCM.
+ */
+static size_t kpb_history_drain_bytes(const struct comp_data *kpb, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	const struct kpb_history_codec *codec = &kpb->codec;
+
+	return (size / codec->pcm_block_size + 1) * codec->block_size -
+		codec->drain_fill - 1;
+#else
+	return size;
+#endif
+}
+
 /*
  * \brief Create a key phrase buffer component.
  * \param[in] config - generic ipc component pointer.
@@ -515,8 +731,15 @@ static int kpb_prepare(struct comp_dev *dev)
 	kpb->sel_sink = NULL;
 	kpb->host_sink = NULL;
 
-	if (kpb->hd.c_hb && kpb->hd.buffer_size < hb_size_req) {
-		/* Host params has changed, we need to allocate new buffer */
+	/* History buffer keeps hb_size_req of PCM in coded size */
+	kpb_history_codec_init(kpb);
+	hb_size_req = kpb_history_size(kpb, hb_size_req);
+
+	if (kpb->hd.c_hb && (kpb->hd.buffer_size < hb_size_req ||
+			     !kpb_history_size_aligned(kpb, kpb->hd.buffer_size))) {
+		/* Host params or coded block size has changed, we need to
+		 * allocate new buffer
+		 */
 		kpb_free_history_buffer(kpb->hd.c_hb);
 		kpb->hd.c_hb = NULL;
 	}
@@ -659,6 +882,7 @@ static int kpb_reset(struct comp_dev *dev)
 			 */
 			kpb_reset_history_buffer(kpb->hd.c_hb);
 		}
+		kpb_history_codec_init(kpb);
 
 		/* Unregister KPB from notifications */
 		notifier_unregister(dev, NULL, NOTIFIER_ID_KPB_CLIENT_EVT);
@@ -693,6 +917,7 @@ static int kpb_copy(struct comp_dev *dev)
 	size_t sample_width = kpb->config.sampling_width;
 	struct draining_data *dd = &kpb->draining_task_data;
 	uint32_t avail_bytes;
+	size_t stored_bytes;
 
 	comp_dbg(dev, "kpb_copy()");
 
@@ -750,6 +975,7 @@ static int kpb_copy(struct comp_dev *dev)
 		 * use by clients.
 		 */
 		if (audio_stream_get_avail_bytes(&source_c->stream) <= kpb->hd.buffer_size) {
+			stored_bytes = kpb_history_stored_bytes(kpb, copy_bytes);
 			ret = kpb_buffer_data(dev, source_c, copy_bytes);
 			if (ret) {
 				comp_err(dev, "kpb_copy(): internal buffering failed.");
@@ -763,7 +989,7 @@ static int kpb_copy(struct comp_dev *dev)
 			 */
 			kpb->hd.buffered += MIN(kpb->hd.buffer_size -
 						kpb->hd.buffered,
-						copy_bytes);
+						stored_bytes);
 		} else {
 			comp_err(dev, "kpb_copy(): too much data to buffer.");
 		}
@@ -791,6 +1017,13 @@ static int kpb_copy(struct comp_dev *dev)
 			break;
 		}
 
+		/* Frames coded while draining but not stored in the history
+		 * buffer go to host ahead of the real time stream. They are
+		 * drained here so that only this thread uses the codec block.
+		 */
+		if (!kpb_drain_staged(kpb, sink_c))
+			break;
+
 		copy_bytes = audio_stream_get_copy_bytes(&source_c->stream, &sink_c->stream);
 		if (!copy_bytes) {
 			comp_err(dev, "kpb_copy(): nothing to copy sink->free %d source->avail %d",
@@ -816,13 +1049,14 @@ static int kpb_copy(struct comp_dev *dev)
 		 * the internal history buffer.
 		 */
 		avail_bytes = audio_stream_get_avail_bytes(&source_c->stream);
-		copy_bytes = MIN(avail_bytes, kpb->hd.free);
+		copy_bytes = MIN(avail_bytes, kpb_history_pcm_bytes(kpb, kpb->hd.free));
 		ret = PPL_STATUS_PATH_STOP;
 		if (copy_bytes) {
+			stored_bytes = kpb_history_stored_bytes(kpb, copy_bytes);
 			buffer_stream_invalidate(source_c, copy_bytes);
 			ret = kpb_buffer_data(dev, source_c, copy_bytes);
-			dd->buffered_while_draining += copy_bytes;
-			kpb->hd.free -= copy_bytes;
+			dd->buffered_while_draining += stored_bytes;
+			kpb->hd.free -= stored_bytes;
 
 			if (ret) {
 				comp_err(dev, "kpb_copy(): internal buffering failed.");
@@ -853,44 +1087,32 @@ out:
 }
 
 /**
- * \brief Buffer real time data stream in
- *	the internal buffer.
+ * \brief Store data in the history buffer.
  *
- * \param[in] dev - KPB component data pointer.
- * \param[in] source - pointer to the buffer source.
+ * \param[in] dev - KPB component device pointer.
+ * \param[in] source - source stream, or NULL when storing data.
+ * \param[in] data - coded history data, used when source is NULL.
+ * \param[in] size - size in bytes.
+ * \param[in] timeout - time in cycles for buffering.
  *
+ * \return integer representing either:
+ *	0 - success
+ *	PPL_STATUS_PATH_STOP - reset requested
+ *	-ETIME - timeout.
  */
-static int kpb_buffer_data(struct comp_dev *dev,
-			   const struct comp_buffer __sparse_cache *source, size_t size)
+static int kpb_write_history(struct comp_dev *dev,
+			     const struct audio_stream __sparse_cache *source,
+			     const uint8_t *data, size_t size, uint64_t timeout)
 {
-	int ret = 0;
 	size_t size_to_copy = size;
 	size_t space_avail;
 	struct comp_data *kpb = comp_get_drvdata(dev);
 	struct history_buffer *buff = kpb->hd.c_hb;
 	uint32_t offset = 0;
-	uint64_t timeout = 0;
 	uint64_t current_time;
-	enum kpb_state state_preserved = kpb->state;
 	size_t sample_width = kpb->config.sampling_width;
+	size_t piece;
 
-	comp_dbg(dev, "kpb_buffer_data()");
-
-	/* We are allowed to buffer data in internal history buffer
-	 * only in KPB_STATE_RUN, KPB_STATE_DRAINING or KPB_STATE_INIT_DRAINING
-	 * states.
-	 */
-	if (kpb->state != KPB_STATE_RUN &&
-	    kpb->state != KPB_STATE_DRAINING &&
-	    kpb->state != KPB_STATE_INIT_DRAINING) {
-		comp_err(dev, "kpb_buffer_data(): wrong state! (current state %d, state log %x)",
-			 kpb->state, kpb->state_log);
-		return PPL_STATUS_PATH_STOP;
-	}
-
-	kpb_change_state(kpb, KPB_STATE_BUFFERING);
-
-	timeout = sof_cycle_get_64() + k_ms_to_cyc_ceil64(1);
 	/* Let's store audio stream data in internal history buffer */
 	while (size_to_copy) {
 		/* Reset was requested, it's time to stop buffering and finish
@@ -919,35 +1141,26 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			return -ETIME;
 		}
 
-		/* Check how much space there is in current write buffer */
+		/* Check how much space there is in current write buffer.
+		 * If we have more data to copy than available space in this
+		 * buffer, copy what's available and continue with next buffer.
+		 */
 		space_avail = (uintptr_t)buff->end_addr - (uintptr_t)buff->w_ptr;
+		piece = MIN(size_to_copy, space_avail);
+
+		if (source)
+			kpb_buffer_samples(source, offset, buff->w_ptr, piece,
+					   sample_width);
+		else
+			memcpy_s(buff->w_ptr, space_avail, data + offset, piece);
+
+		/* Update write pointer, requested copy size and read
+		 * pointer's offset.
+		 */
+		buff->w_ptr = (char *)buff->w_ptr + piece;
+		size_to_copy -= piece;
+		offset += piece;
 
-		if (size_to_copy > space_avail) {
-			/* We have more data to copy than available space
-			 * in this buffer, copy what's available and continue
-			 * with next buffer.
-			 */
-			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   space_avail, sample_width);
-			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + space_avail;
-			size_to_copy = size_to_copy - space_avail;
-			/* Update read pointer's offset before continuing
-			 * with next buffer.
-			 */
-			offset += space_avail;
-		} else {
-			/* Requested size is smaller or equal to the space
-			 * available in this buffer. In this scenario simply
-			 * copy what was requested.
-			 */
-			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   size_to_copy, sample_width);
-			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + size_to_copy;
-			/* Reset requested copy size */
-			size_to_copy = 0;
-		}
 		/* Have we filled whole buffer? */
 		if (buff->w_ptr == buff->end_addr) {
 			/* Reset write pointer back to the beginning
@@ -974,6 +1187,71 @@ static int kpb_buffer_data(struct comp_dev *dev,
 		}
 	}
 
+	return 0;
+}
+
+/**
+ * \brief Buffer real time data stream in
+ *	the internal buffer.
+ *
+ * \param[in] dev - KPB component data pointer.
+ * \param[in] source - pointer to the buffer source.
+ *
+ */
+static int kpb_buffer_data(struct comp_dev *dev,
+			   const struct comp_buffer __sparse_cache *source, size_t size)
+{
+	int ret = 0;
+	struct comp_data *kpb = comp_get_drvdata(dev);
+	uint64_t timeout = 0;
+	enum kpb_state state_preserved = kpb->state;
+#if CONFIG_KPB_HISTORY_ADPCM
+	struct kpb_history_codec *codec = &kpb->codec;
+	size_t frames = size / codec->frame_bytes;
+	int offset = 0;
+	size_t n;
+#endif
+
+	comp_dbg(dev, "kpb_buffer_data()");
+
+	/* We are allowed to buffer data in internal history buffer
+	 * only in KPB_STATE_RUN, KPB_STATE_DRAINING or KPB_STATE_INIT_DRAINING
+	 * states.
+	 */
+	if (kpb->state != KPB_STATE_RUN &&
+	    kpb->state != KPB_STATE_DRAINING &&
+	    kpb->state != KPB_STATE_INIT_DRAINING) {
+		comp_err(dev, "kpb_buffer_data(): wrong state! (current state %d, state log %x)",
+			 kpb->state, kpb->state_log);
+		return PPL_STATUS_PATH_STOP;
+	}
+
+	kpb_change_state(kpb, KPB_STATE_BUFFERING);
+
+	timeout = sof_cycle_get_64() + k_ms_to_cyc_ceil64(1);
+
+#if CONFIG_KPB_HISTORY_ADPCM
+	/* Code the stream in blocks, a block is stored when it is complete */
+	while (frames) {
+		n = MIN(frames, KPB_ADPCM_BLOCK_FRAMES - codec->frames_staged);
+		kpb_adpcm_encode_frames(kpb, &source->stream, offset, n);
+		offset += n * kpb->config.channels;
+		frames -= n;
+
+		if (codec->frames_staged == KPB_ADPCM_BLOCK_FRAMES) {
+			codec->frames_staged = 0;
+			ret = kpb_write_history(dev, NULL, codec->block, codec->block_size,
+						timeout);
+			if (ret)
+				return ret;
+		}
+	}
+#else
+	ret = kpb_write_history(dev, &source->stream, NULL, size, timeout);
+	if (ret)
+		return ret;
+#endif
+
 	kpb_change_state(kpb, state_preserved);
 	return ret;
 }
@@ -1070,9 +1348,9 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 	struct comp_data *kpb = comp_get_drvdata(dev);
 	bool is_sink_ready = (kpb->host_sink->sink->state == COMP_STATE_ACTIVE);
 	size_t sample_width = kpb->config.sampling_width;
-	size_t drain_req = cli->drain_req * kpb->config.channels *
-			       (kpb->config.sampling_freq / 1000) *
-			       (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8);
+	size_t drain_req = kpb_history_size(kpb, cli->drain_req * kpb->config.channels *
+					    (kpb->config.sampling_freq / 1000) *
+					    (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8));
 	struct history_buffer *buff = kpb->hd.c_hb;
 	struct history_buffer *first_buff = buff;
 	size_t buffered = 0;
@@ -1083,6 +1361,11 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 			      (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8) *
 			      kpb->config.channels;
 	size_t period_bytes_limit;
+	struct comp_buffer __sparse_cache *sink_c;
+	size_t frame_bytes = kpb->config.channels *
+			     (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8);
+	size_t burst_min;
+	size_t burst_max;
 
 	comp_info(dev, "kpb_init_draining(): requested draining of %d [ms] from history buffer",
 		  cli->drain_req);
@@ -1106,6 +1389,9 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 		kpb_lock(kpb);
 
 		kpb_change_state(kpb, KPB_STATE_INIT_DRAINING);
+#if CONFIG_KPB_HISTORY_ADPCM
+		kpb->codec.drain_fill = 0;
+#endif
 
 		/* Set history buffer size so new data won't overwrite those
 		 * staged for draining.
@@ -1184,6 +1470,17 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 			comp_info(dev, "kpb_init_draining: unlimited draining speed selected.");
 		}
 
+		/* Draining copies start from a period of the host component and
+		 * grow up to half of the sink buffer while host keeps up with them.
+		 */
+		sink_c = buffer_acquire(kpb->host_sink);
+		burst_max = ALIGN_DOWN(sink_c->stream.size / 2, frame_bytes);
+		burst_min = audio_stream_period_bytes(&sink_c->stream,
+						      kpb->host_sink->sink->frames);
+		buffer_release(sink_c);
+		burst_max = MAX(burst_max, frame_bytes);
+		burst_min = MIN(MAX(burst_min, frame_bytes), burst_max);
+
 		comp_info(dev, "kpb_init_draining(), schedule draining task");
 
 		/* Add one-time draining task into the scheduler. */
@@ -1195,6 +1492,10 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 		kpb->draining_task_data.pb_limit = period_bytes_limit;
 		kpb->draining_task_data.dev = dev;
 		kpb->draining_task_data.sync_mode_on = kpb->sync_draining_mode;
+		kpb->draining_task_data.burst_min = burst_min;
+		kpb->draining_task_data.burst_max = burst_max;
+		memset(&kpb->draining_task_data.stats, 0,
+		       sizeof(kpb->draining_task_data.stats));
 
 		/* save current sink copy type */
 		comp_get_attribute(kpb->host_sink->sink, COMP_ATTR_COPY_TYPE,
@@ -1226,9 +1527,15 @@ static enum task_state kpb_draining_task(void *arg)
 	struct comp_buffer __sparse_cache *sink = buffer_acquire(draining_data->sink);
 	struct history_buffer *buff = draining_data->hb;
 	size_t drain_req = draining_data->drain_req;
-	size_t sample_width = draining_data->sample_width;
 	size_t size_to_read;
 	size_t size_to_copy;
+	size_t drain_limit;
+	size_t produced;
+	size_t sink_free;
+	size_t last_free;
+	size_t consumed = 0;
+	size_t burst = draining_data->burst_min;
+	struct kpb_drain_stats *stats = &draining_data->stats;
 	bool move_buffer = false;
 	uint32_t drained = 0;
 	uint64_t draining_time_start;
@@ -1257,8 +1564,12 @@ static enum task_state kpb_draining_task(void *arg)
 	kpb_change_state(kpb, KPB_STATE_DRAINING);
 
 	draining_time_start = sof_cycle_get_64();
+	last_free = audio_stream_get_free_bytes(&sink->stream);
 
-	while (drain_req > 0) {
+	/* Draining continues until staged data not yet in the history buffer
+	 * is drained too and KPB switches to the host copy.
+	 */
+	while (drain_req > 0 || kpb->state == KPB_STATE_DRAINING) {
 		/* Have we received reset request? */
 		if (kpb->state == KPB_STATE_RESETTING) {
 			kpb_change_state(kpb, KPB_STATE_RESET_FINISHING);
@@ -1277,13 +1588,31 @@ static enum task_state kpb_draining_task(void *arg)
 			period_copy_start = sof_cycle_get_64();
 		}
 
+		/* Host consumption since the last check */
+		sink_free = audio_stream_get_free_bytes(&sink->stream);
+		if (sink_free > last_free) {
+			consumed += sink_free - last_free;
+			stats->host_consumed += sink_free - last_free;
+		}
+		last_free = sink_free;
+
+		/* Copy in bursts of the sink free space, unless the rest of
+		 * requested data fits already. Meanwhile let the sink
+		 * component process its data further.
+		 */
+		drain_limit = kpb_history_drain_bytes(kpb, sink_free);
+		if (sink_free < burst && drain_limit < drain_req) {
+			comp_copy(sink->sink);
+			continue;
+		}
+
 		size_to_read = (uintptr_t)buff->end_addr - (uintptr_t)buff->r_ptr;
 
-		if (size_to_read > audio_stream_get_free_bytes(&sink->stream)) {
-			if (audio_stream_get_free_bytes(&sink->stream) >= drain_req)
+		if (size_to_read > drain_limit) {
+			if (drain_limit >= drain_req)
 				size_to_copy = drain_req;
 			else
-				size_to_copy = audio_stream_get_free_bytes(&sink->stream);
+				size_to_copy = drain_limit;
 		} else {
 			if (size_to_read > drain_req) {
 				size_to_copy = drain_req;
@@ -1293,13 +1622,13 @@ static enum task_state kpb_draining_task(void *arg)
 			}
 		}
 
-		kpb_drain_samples(buff->r_ptr, &sink->stream, size_to_copy,
-				  sample_width);
+		produced = kpb_drain_history(kpb, buff->r_ptr, &sink->stream,
+					     size_to_copy);
 
 		buff->r_ptr = (char *)buff->r_ptr + (uint32_t)size_to_copy;
 		drain_req -= size_to_copy;
-		drained += size_to_copy;
-		period_bytes += size_to_copy;
+		drained += produced;
+		period_bytes += produced;
 		kpb->hd.free += MIN(kpb->hd.buffer_size -
 				    kpb->hd.free, size_to_copy);
 
@@ -1309,8 +1638,22 @@ static enum task_state kpb_draining_task(void *arg)
 			move_buffer = false;
 		}
 
-		if (size_to_copy) {
-			comp_update_buffer_produce(sink, size_to_copy);
+		if (produced) {
+			stats->bursts++;
+			stats->max_burst = MAX(stats->max_burst, produced);
+
+			/* Host has consumed two bursts since the last copy,
+			 * so it keeps up with bigger bursts. If it has not
+			 * consumed even one, copy smaller bursts again.
+			 */
+			if (consumed >= 2 * burst)
+				burst = MIN(2 * burst, draining_data->burst_max);
+			else if (consumed < burst)
+				burst = MAX(burst / 2, draining_data->burst_min);
+			consumed = 0;
+
+			comp_update_buffer_produce(sink, produced);
+			last_free = audio_stream_get_free_bytes(&sink->stream);
 			comp_copy(sink->sink);
 		} else if (!audio_stream_get_free_bytes(&sink->stream)) {
 			/* There is no free space in sink buffer.
@@ -1332,8 +1675,9 @@ static enum task_state kpb_draining_task(void *arg)
 		 * while we were draining real time stream could provided
 		 * new data which needs to be copy to host.
 		 */
-			comp_cl_info(&comp_kpb, "kpb: update drain_req by %d",
-				     *rt_stream_update);
+			if (*rt_stream_update)
+				comp_cl_info(&comp_kpb, "kpb: update drain_req by %d",
+					     *rt_stream_update);
 			kpb_lock(kpb);
 			drain_req += *rt_stream_update;
 			*rt_stream_update = 0;
@@ -1345,6 +1689,7 @@ static enum task_state kpb_draining_task(void *arg)
 			 * i.e reset request we should not change that state.
 			 */
 				kpb_change_state(kpb, KPB_STATE_HOST_COPY);
+				stats->catch_up_time = sof_cycle_get_64() - draining_time_start;
 			}
 			kpb_unlock(kpb);
 		}
@@ -1369,9 +1714,17 @@ out:
 		comp_cl_info(&comp_kpb, "KPB: kpb_draining_task(), done. %u drained in > %u ms",
 			     drained, UINT_MAX);
 
+	comp_cl_info(&comp_kpb, "KPB: drain throughput %u bytes/ms, %u bursts, max burst %u",
+		     (unsigned int)(drained / MAX(draining_time_ms, 1)), stats->bursts,
+		     stats->max_burst);
+	comp_cl_info(&comp_kpb, "KPB: host consumed %u while draining, real time after %u ms",
+		     stats->host_consumed,
+		     (unsigned int)k_cyc_to_ms_near64(stats->catch_up_time));
+
 	return SOF_TASK_STATE_COMPLETED;
 }
 
+#if !CONFIG_KPB_HISTORY_ADPCM
 /**
  * \brief Drain data samples safe, according to configuration.
  *
@@ -1405,6 +1758,82 @@ static void kpb_drain_samples(void *source, struct audio_stream __sparse_cache *
 		return;
 	}
 }
+#endif /* !CONFIG_KPB_HISTORY_ADPCM */
+
+/**
+ * \brief Drain data from history buffer, decoding it if coded.
+ *
+ * \param[in] kpb - KPB component data pointer.
+ * \param[in] source - pointer to history buffer data.
+ * \param[in] sink - pointer to sink buffer.
+ * \param[in] size - requested size in bytes of history buffer data.
+ *
+ * \return number of bytes produced in sink.
+ */
+static size_t kpb_drain_history(struct comp_data *kpb, void *source,
+				struct audio_stream __sparse_cache *sink, size_t size)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	struct kpb_history_codec *codec = &kpb->codec;
+	uint8_t *data = source;
+	size_t produced = 0;
+	size_t n;
+
+	/* Blocks can be split between history buffers, so they are gathered
+	 * before decoding.
+	 */
+	while (size) {
+		n = MIN(size, codec->block_size - codec->drain_fill);
+		memcpy_s(codec->drain_block + codec->drain_fill,
+			 sizeof(codec->drain_block) - codec->drain_fill, data, n);
+		codec->drain_fill += n;
+		data += n;
+		size -= n;
+
+		if (codec->drain_fill == codec->block_size) {
+			kpb_adpcm_decode_frames(kpb, codec->drain_block,
+						KPB_ADPCM_BLOCK_FRAMES, sink,
+						produced / audio_stream_sample_bytes(sink));
+			codec->drain_fill = 0;
+			produced += codec->pcm_block_size;
+		}
+	}
+
+	return produced;
+#else
+	kpb_drain_samples(source, sink, size, kpb->config.sampling_width);
+
+	return size;
+#endif
+}
+
+/**
+ * \brief Drain data buffered but not stored yet in history buffer.
+ *
+ * \param[in] kpb - KPB component data pointer.
+ * \param[in] sink - pointer to sink buffer.
+ *
+ * \return false if there is no space in sink buffer for the data.
+ */
+static bool kpb_drain_staged(struct comp_data *kpb,
+			     struct comp_buffer __sparse_cache *sink)
+{
+#if CONFIG_KPB_HISTORY_ADPCM
+	struct kpb_history_codec *codec = &kpb->codec;
+	size_t size = codec->frames_staged * codec->frame_bytes;
+
+	if (audio_stream_get_free_bytes(&sink->stream) < size)
+		return false;
+
+	if (size) {
+		kpb_adpcm_decode_frames(kpb, codec->block, codec->frames_staged,
+					&sink->stream, 0);
+		codec->frames_staged = 0;
+		comp_update_buffer_produce(sink, size);
+	}
+#endif
+	return true;
+}
 
 /**
  * \brief Buffers data samples safe, according to configuration.
@@ -249,6 +249,64 @@ static void mfcc_apply_window(struct mfcc_state *state, int input_shift)
 #endif
 }
 
+/* Cepstral lifter is Q7.9 vector (1, num_ceps), it's applied to all the rows of
+ * cepstral coefficients similarly as mat_multiply_elementwise() would do.
+ */
+static void mfcc_apply_lifter(struct mat_matrix_16b *ceps, struct mat_matrix_16b *lifter)
+{
+	int32_t p;
+	int16_t *c = ceps->data;
+	const int shift_minus_one = lifter->fractions - 1;
+	int i, j;
+
+	for (i = 0; i < ceps->rows; i++) {
+		for (j = 0; j < ceps->columns; j++) {
+			p = (int32_t)(*c) * lifter->data[j];
+			*c = (int16_t)(((p >> shift_minus_one) + 1) >> 1);
+			c++;
+		}
+	}
+}
+
+/* Write magic and the cepstral coefficients of hops to output buffer. A frame is
+ * dropped if there is no room for it.
+ */
+static void mfcc_output_frames(const struct comp_dev *dev, struct mfcc_state *state)
+{
+	struct mfcc_buffer *out = &state->out_buf;
+	struct mat_matrix_16b *ceps = state->cepstral_coef;
+	uint32_t magic = MFCC_MAGIC;
+	int16_t *magic16 = (int16_t *)&magic;
+	int16_t *w = out->w_ptr;
+	int16_t *c;
+	int frame_size = MFCC_MAGIC_SAMPLES + ceps->columns;
+	int i, j;
+
+	for (i = 0; i < ceps->rows; i++) {
+		if (out->s_free < frame_size) {
+			comp_warn(dev, "mfcc_output_frames(), output overrun, dropped %d frames",
+				  ceps->rows - i);
+			break;
+		}
+
+		for (j = 0; j < MFCC_MAGIC_SAMPLES; j++) {
+			*w++ = magic16[j];
+			w = mfcc_buffer_wrap(out, w);
+		}
+
+		c = mat_get_row_vector_16b(ceps, i);
+		for (j = 0; j < ceps->columns; j++) {
+			*w++ = c[j];
+			w = mfcc_buffer_wrap(out, w);
+		}
+
+		out->s_avail += frame_size;
+		out->s_free -= frame_size;
+	}
+
+	out->w_ptr = w;
+}
+
 /*
  * The main processing function for MFCC
  */
@@ -257,11 +315,11 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 {
 	struct mfcc_buffer *buf = &state->buf;
 	struct mfcc_fft *fft = &state->fft;
+	int16_t *mel_spectra;
 	int mel_scale_shift;
 	int input_shift;
 	int i;
 	int m;
-	int cc_count = 0;
 #ifdef DEBUGFILES
 	int j;
 #endif
@@ -286,12 +344,13 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 		state->prev_samples_valid = true;
 	}
 
-	/* Check if enough samples in buffer for FFT hop */
+	/* Check how many FFT hops can be done with samples in buffer */
 	m = buf->s_avail / fft->fft_hop_size;
-	for (i = 0; i < m; i++) {
-		/* Clear FFT input buffer because it has been used as scratch */
-		bzero(fft->fft_buf, fft->fft_buffer_size);
+	m = MIN(m, state->max_hops);
+	if (!m)
+		return 0;
 
+	for (i = 0; i < m; i++) {
 		/* Copy data to FFT input buffer from overlap buffer and from new samples buffer */
 		mfcc_fill_fft_buffer(state);
 
@@ -316,10 +375,12 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 			fprintf(fh_fft_in, "%d %d\n", fft->fft_buf[j].real, fft->fft_buf[j].imag);
 #endif
 
-		/* The FFT out buffer needs to be cleared to avoid to corrupt
-		 * the output. TODO: check moving it to FFT lib.
+		/* The FFT lib does not write the first output bin before it is used
+		 * in the butterflies so it needs to be cleared. TODO: check moving
+		 * it to FFT lib.
 		 */
-		bzero(fft->fft_out, fft->fft_buffer_size);
+		fft->fft_out[0].real = 0;
+		fft->fft_out[0].imag = 0;
 
 		/* Compute FFT */
 #if MFCC_FFT_BITS == 16
@@ -346,8 +407,10 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 			fprintf(fh_fft_out, "%d %d\n", fft->fft_out[j].real, fft->fft_out[j].imag);
 #endif
 
-		/* Convert powerspectrum to Mel band logarithmic spectrum */
-		mat_init_16b(state->mel_spectra, 1, state->dct.num_in, 7); /* Q8.7 */
+		/* Convert powerspectrum to Mel band logarithmic spectrum, the hop
+		 * is a row in Mel spectra matrix.
+		 */
+		mel_spectra = mat_get_row_vector_16b(state->mel_spectra, i);
 
 		/* Compensate FFT lib scaling to Mel log values, e.g. for 512 long FFT
 		 * the fft_plan->len is 9. The scaling is 1/512. Subtract from input_shift it
@@ -356,10 +419,10 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 		mel_scale_shift = input_shift - fft->fft_plan->len;
 #if MFCC_FFT_BITS == 16
 		psy_apply_mel_filterbank_16(&state->melfb, fft->fft_out, state->power_spectra,
-					    state->mel_spectra->data, mel_scale_shift);
+					    mel_spectra, mel_scale_shift);
 #else
 		psy_apply_mel_filterbank_32(&state->melfb, fft->fft_out, state->power_spectra,
-					    state->mel_spectra->data, mel_scale_shift);
+					    mel_spectra, mel_scale_shift);
 #endif
 #ifdef DEBUGFILES_READ_MEL
 		double val;
@@ -370,39 +433,36 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 			if (tmp != 1)
 				break;
 
-			state->mel_spectra->data[j] = sat_int16((int32_t)(128.0 * val));
+			mel_spectra[j] = sat_int16((int32_t)(128.0 * val));
 		}
 #endif
 
-		/* Multiply Mel spectra with DCT matrix to get cepstral coefficients */
-		mat_init_16b(state->cepstral_coef, 1, state->dct.num_out, 7); /* Q8.7 */
-		mat_multiply(state->mel_spectra, state->dct.matrix, state->cepstral_coef);
-
-		/* Apply cepstral lifter */
-		if (state->lifter.cepstral_lifter != 0)
-			mat_multiply_elementwise(state->cepstral_coef, state->lifter.matrix,
-						 state->cepstral_coef);
-
-		cc_count += state->dct.num_out;
-
-		/* Output to sink buffer */
-
 #ifdef DEBUGFILES
 		for (j = 0; j < fft->half_fft_size; j++)
-			fprintf(fh_pow, "%d\n", state->power_spectra[j]);
+			fprintf(fh_pow, "%lld\n", (long long)state->power_spectra[j]);
 
 		for (j = 0; j < state->dct.num_in; j++)
-			fprintf(fh_mel, " %d\n", state->mel_spectra->data[j]);
-
-		for (j = 0; j < state->dct.num_out; j++)
-			fprintf(fh_ceps, " %d\n", state->cepstral_coef->data[j]);
+			fprintf(fh_mel, " %d\n", mel_spectra[j]);
 #endif
 	}
 
-	/* TODO: This version handles only one FFT run per copy(). How to pass multiple
-	 * cepstral coefficients sets return is an open.
-	 */
-	return cc_count;
+	/* Multiply Mel spectra of all hops with DCT matrix to get cepstral coefficients */
+	mat_init_16b(state->mel_spectra, m, state->dct.num_in, 7); /* Q8.7 */
+	mat_init_16b(state->cepstral_coef, m, state->dct.num_out, 7); /* Q8.7 */
+	mat_multiply_transposed(state->mel_spectra, state->dct_transposed, state->cepstral_coef);
+
+	/* Apply cepstral lifter */
+	if (state->lifter.cepstral_lifter != 0)
+		mfcc_apply_lifter(state->cepstral_coef, state->lifter.matrix);
+
+#ifdef DEBUGFILES
+	for (j = 0; j < m * state->dct.num_out; j++)
+		fprintf(fh_ceps, " %d\n", state->cepstral_coef->data[j]);
+#endif
+
+	/* Output to output buffer, it's drained to sink with period pace */
+	mfcc_output_frames(dev, state);
+	return m;
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -431,8 +491,9 @@ static int16_t *mfcc_sink_copy_zero_s16(const struct audio_stream *sink,
 }
 
 static int16_t *mfcc_sink_copy_data_s16(const struct audio_stream *sink, int16_t *w_ptr,
-					int samples, int16_t *r_ptr)
+					int samples, struct mfcc_buffer *buf)
 {
+	int16_t *r_ptr = buf->r_ptr;
 	int copied;
 	int nmax;
 	int i;
@@ -442,6 +503,7 @@ static int16_t *mfcc_sink_copy_data_s16(const struct audio_stream *sink, int16_t
 		nmax = samples - copied;
 		n = audio_stream_samples_without_wrap_s16(sink, w_ptr);
 		n = MIN(n, nmax);
+		n = MIN(n, mfcc_buffer_samples_without_wrap(buf, r_ptr));
 		for (i = 0; i < n; i++) {
 			*w_ptr = *r_ptr;
 			r_ptr++;
@@ -449,8 +511,12 @@ static int16_t *mfcc_sink_copy_data_s16(const struct audio_stream *sink, int16_t
 		}
 
 		w_ptr = audio_stream_wrap(sink, w_ptr);
+		r_ptr = mfcc_buffer_wrap(buf, r_ptr);
 	}
 
+	buf->s_avail -= copied;
+	buf->s_free += copied;
+	buf->r_ptr = r_ptr;
 	return w_ptr;
 }
 
@@ -461,31 +527,25 @@ void mfcc_s16_default(struct processing_module *mod, struct input_stream_buffer
 	struct mfcc_comp_data *cd = module_get_private_data(mod);
 	struct mfcc_state *state = &cd->state;
 	struct mfcc_buffer *buf = &cd->state.buf;
-	uint32_t magic = MFCC_MAGIC;
 	int16_t *w_ptr = sink->w_ptr;
-	int num_magic = sizeof(magic) / sizeof(int16_t);
-	int num_ceps;
-	int zero_samples;
+	int sink_samples = frames * sink->channels;
+	int data_samples;
 
 	/* Get samples from source buffer */
 	mfcc_source_copy_s16(bsource, buf, &state->emph, frames, state->source_channel);
 
-	/* Run STFT and processing after FFT: Mel auditory filter and DCT. The sink
-	 * buffer is updated during STDF processing.
+	/* Run STFT and processing after FFT: Mel auditory filter and DCT for all
+	 * available hops. The cepstral coefficients frames are placed to output buffer.
 	 */
-	num_ceps = mfcc_stft_process(mod->dev, state);
+	mfcc_stft_process(mod->dev, state);
 
-	/* Done, copy data to sink. This works only if the period has room for magic (2)
-	 * plus num_ceps int16_t samples. TODO: split ceps over multiple periods.
+	/* Done, copy data to sink. The output is a stream of frames of magic (2) plus
+	 * num_ceps int16_t samples. A frame can be split over multiple periods. The
+	 * rest of period after the available frames is zero filled.
 	 */
-	zero_samples = frames * sink->channels;
-	if (num_ceps > 0) {
-		zero_samples -= num_ceps + num_magic;
-		w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, num_magic, (int16_t *)&magic);
-		w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, num_ceps, state->cepstral_coef->data);
-	}
-
-	w_ptr = mfcc_sink_copy_zero_s16(sink, w_ptr, zero_samples);
+	data_samples = MIN(state->out_buf.s_avail, sink_samples);
+	w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, data_samples, &state->out_buf);
+	w_ptr = mfcc_sink_copy_zero_s16(sink, w_ptr, sink_samples - data_samples);
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
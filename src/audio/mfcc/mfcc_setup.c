@@ -195,16 +195,28 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 		  config->preemphasis_coefficient,
 		  fft->fft_size, fft->fft_padded_size, fft->fft_hop_size);
 
+	/* The cepstral coefficients frames are output with the rate of hops, so a hop
+	 * of sink samples need to have room for a frame.
+	 */
+	if (MFCC_MAGIC_SAMPLES + config->num_ceps > fft->fft_hop_size * channels) {
+		comp_err(dev, "mfcc_setup(): Too many num_ceps %d for hop of %d samples",
+			 config->num_ceps, fft->fft_hop_size * channels);
+		return -EINVAL;
+	}
+
 	/* Calculated parameters */
 	state->prev_data_size = fft->fft_size - fft->fft_hop_size;
 	state->buffer_size = fft->fft_size + max_frames;
+	state->max_hops = MAX(state->buffer_size / fft->fft_hop_size, 1);
+	state->out_buffer_size = 2 * state->max_hops * (MFCC_MAGIC_SAMPLES + config->num_ceps);
 
-	/* Allocate buffer input samples and overlap buffer */
+	/* Allocate buffer input samples, overlap buffer, window, and output buffer */
 	state->sample_buffers_size = sizeof(int16_t) *
-		(state->buffer_size + state->prev_data_size + fft->fft_size);
+		(state->buffer_size + state->prev_data_size + fft->fft_size +
+		 state->out_buffer_size);
 
-	comp_info(dev, "mfcc_setup(), buffer_size = %d, prev_size = %d",
-		  state->buffer_size, state->prev_data_size);
+	comp_info(dev, "mfcc_setup(), buffer_size = %d, prev_size = %d, max_hops = %d",
+		  state->buffer_size, state->prev_data_size, state->max_hops);
 
 	state->buffers = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
 				 state->sample_buffers_size);
@@ -217,6 +229,7 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	mfcc_init_buffer(&state->buf, state->buffers, state->buffer_size);
 	state->prev_data = state->buffers + state->buffer_size;
 	state->window = state->prev_data + state->prev_data_size;
+	mfcc_init_buffer(&state->out_buf, state->window + fft->fft_size, state->out_buffer_size);
 
 	/* Allocate buffers for FFT input and output data */
 #if MFCC_FFT_BITS == 16
@@ -294,37 +307,56 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 		goto free_melfb_data;
 	}
 
+	/* The DCT matrix is constant, use it transposed for contiguous access in
+	 * matrix multiply.
+	 */
+	state->dct_transposed = mat_matrix_alloc_16b(dct->num_out, dct->num_in, 15);
+	if (!state->dct_transposed) {
+		comp_err(dev, "mfcc_setup(): Failed DCT transpose allocate");
+		ret = -ENOMEM;
+		goto free_dct_matrix;
+	}
+
+	mat_transpose_16b(dct->matrix, state->dct_transposed);
+
 	state->lifter.num_ceps = config->num_ceps;
 	state->lifter.cepstral_lifter = config->cepstral_lifter; /* Q7.9 max 64.0*/
 	ret = mfcc_get_cepstral_lifter(&state->lifter);
 	if (ret < 0) {
 		comp_err(dev, "mfcc_setup(): Failed cepstral lifter");
-		goto free_dct_matrix;
+		goto free_dct_transposed;
 	}
 
-	/* Scratch overlay during runtime
-	 *
-	 *  +--------------------------------------------------------+
-	 *  | 1. fft_buf[], 16 bits,size x 4, e.g. 512 -> 2048 bytes |
-	 *  +-------------------------------------+------------------+
-	 *  | 3. power_spectra[],                 |
-	 *  |    32 bits, e.g. x257 -> 1028 bytes |
-	 *  +-------------------------------------+
-	 *
-	 *  +---------------------------------------------------------------------------------+
-	 *  | 2. fft_out[], 16 bits,size x 4, e.g. 512 -> 2048 bytes                          |
-	 *  +----------------------------------+----------------------------------+-----------+
-	 *  | 4. mel_spectra[],                | 5. cepstral_coef[],              |
-	 *  |    16 bits, e.g. x23 -> 46 bytes |    16 bits, e.g. 13x -> 26 bytes |
-	 *  +----------------------------------+----------------------------------+
-	 *
+	/* Power spectra scratch for Mel filterbank, and Mel spectra and cepstral
+	 * coefficients for all hops those can be processed in one copy.
 	 */
+	state->power_spectra = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				       fb->half_fft_bins * sizeof(state->power_spectra[0]));
+	if (!state->power_spectra) {
+		comp_err(dev, "mfcc_setup(): Failed power spectra allocate");
+		ret = -ENOMEM;
+		goto free_lifter_matrix;
+	}
+
+	state->mel_spectra = mat_matrix_alloc_16b(state->max_hops, dct->num_in, 7); /* Q8.7 */
+	if (!state->mel_spectra) {
+		comp_err(dev, "mfcc_setup(): Failed Mel spectra allocate");
+		ret = -ENOMEM;
+		goto free_power_spectra;
+	}
+
+	state->cepstral_coef = mat_matrix_alloc_16b(state->max_hops, dct->num_out, 7); /* Q8.7 */
+	if (!state->cepstral_coef) {
+		comp_err(dev, "mfcc_setup(): Failed cepstral coefficients allocate");
+		ret = -ENOMEM;
+		goto free_mel_spectra;
+	}
 
-	/* Use FFT buffer as scratch for later computed data */
-	state->power_spectra = (int32_t *)&fft->fft_buf[0];
-	state->mel_spectra = (struct mat_matrix_16b *)&fft->fft_out[0];
-	state->cepstral_coef = (struct mat_matrix_16b *)
-		&state->mel_spectra->data[state->dct.num_in];
+	/* The FFT input buffer imaginary part and padding need to be zero. The buffers
+	 * were used as scratch in Mel filterbank initialization.
+	 */
+	bzero(fft->fft_buf, fft->fft_buffer_size);
+	bzero(fft->fft_out, fft->fft_buffer_size);
 
 #ifdef DEBUGFILES
 	int i, j;
@@ -358,6 +390,18 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	comp_dbg(dev, "mfcc_setup(), done");
 	return 0;
 
+free_mel_spectra:
+	rfree(state->mel_spectra);
+
+free_power_spectra:
+	rfree(state->power_spectra);
+
+free_lifter_matrix:
+	rfree(state->lifter.matrix);
+
+free_dct_transposed:
+	rfree(state->dct_transposed);
+
 free_dct_matrix:
 	rfree(state->dct.matrix);
 
@@ -385,7 +429,11 @@ void mfcc_free_buffers(struct mfcc_comp_data *cd)
 	rfree(cd->state.buffers);
 	rfree(cd->state.melfb.data);
 	rfree(cd->state.dct.matrix);
+	rfree(cd->state.dct_transposed);
 	rfree(cd->state.lifter.matrix);
+	rfree(cd->state.power_spectra);
+	rfree(cd->state.mel_spectra);
+	rfree(cd->state.cepstral_coef);
 
 #ifdef MFCC_DEBUGFILES
 	mfcc_generic_debug_close();
@@ -12,6 +12,8 @@
 #include <sof/debug/panic.h>
 #include <sof/ipc/msg.h>
 #include <rtos/alloc.h>
+#include <rtos/atomic.h>
+#include <rtos/cache.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
@@ -65,41 +67,90 @@ DECLARE_TR_CTX(mixout_tr, SOF_UUID(mixout_uuid), LOG_LEVEL_INFO);
  */
 
 /*
- * Source data is consumed by mixins in mixin_copy() but sink data cannot be
- * immediately produced. Sink data is produced by mixout in mixout_copy() after
- * ensuring all connected mixins have mixed their data into mixout sink buffer.
- * So for each connected mixin, mixout keeps knowledge of data already consumed
- * by mixin but not yet produced in mixout.
+ * Mixins and mixout may run on different cores, so they do not share any
+ * lock. Instead every party keeps free running frame counters, each of them
+ * written by a single core only and read by the others:
+ *
+ * - produced_frames: frames produced by mixout into its sink, written by mixout.
+ * - source_info[].mixed_frames: frames mixed by a mixin, written by that mixin.
+ * - core_info[].mixed_frames: end of the frames mixed by any mixin running on
+ *   the core, written by mixins of that core (and by mixout for its own core).
+ *
+ * A mixin running on the mixout core mixes straight into the mixout sink
+ * buffer. Mixins on other cores mix into a partial buffer of their core, so
+ * they never touch the sink buffer or cache lines written by other cores. The
+ * partial buffers are rings indexed by the free running frame counter, which
+ * mixout adds into its sink buffer when producing.
+ *
+ * A counter is published with a release fence and written back after the data
+ * it covers has been written back, and it is read with an invalidate and an
+ * acquire fence before the data it covers is invalidated and read. Every core
+ * writes back its counters right after updating them, so the other lines of
+ * mixed_data_info are never dirty in the cache of a reading core.
+ *
+ * Counters are compared as differences relative to produced_frames so that
+ * wrapping is handled. A difference larger than the buffer it refers to can
+ * only come from a counter that has not been updated for a long time, and it
+ * is handled as no data mixed.
  */
 struct mixout_source_info {
 	struct comp_dev *mixin;
-	uint32_t consumed_yet_not_produced_frames;
-};
+	atomic_t mixed_frames;
+} __aligned(PLATFORM_DCACHE_ALIGN);
+
+struct mixout_core_info {
+	atomic_t mixed_frames;
+	void *partial;
+} __aligned(PLATFORM_DCACHE_ALIGN);
 
 /*
- * Data used by both mixin and mixout: number of currently mixed frames in
- * mixout sink buffer and each mixin consumed data amount (and so mixout should
- * produce the appropreate amount of data).
- * Can be accessed from different cores.
+ * Data used by both mixin and mixout. Can be accessed from different cores.
+ * The source_info table and the partial buffers are only changed by bind,
+ * unbind and reset, which are serialised IPCs with no copy running.
  */
 struct mixed_data_info {
-	struct coherent c;
-	uint32_t mixed_frames;
+	atomic_t produced_frames;
+	/* partial buffer size in frames, a power of two */
+	uint32_t partial_frames;
+	enum sof_ipc_frame frame_fmt;
+	enum sof_ipc_frame valid_fmt;
+	uint32_t channels;
 	struct mixout_source_info source_info[MIXOUT_MAX_SOURCES];
+	struct mixout_core_info core_info[CONFIG_CORE_COUNT];
 };
 
-__must_check static inline
-struct mixed_data_info __sparse_cache *mixed_data_info_acquire(struct mixed_data_info *mdi)
+/* Reads a frame counter written by another core, data covered by the counter is
+ * read only after it.
+ */
+static inline uint32_t mixed_frames_read(atomic_t *counter)
 {
-	struct coherent __sparse_cache *c = coherent_acquire_thread(&mdi->c, sizeof(*mdi));
+	uint32_t frames;
+
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)counter, sizeof(*counter));
+	frames = atomic_read(counter);
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-	return attr_container_of(c, struct mixed_data_info __sparse_cache, c, __sparse_cache);
+	return frames;
 }
 
-static inline
-void mixed_data_info_release(struct mixed_data_info __sparse_cache *mdi)
+/* Publishes a frame counter to the other cores, data covered by the counter must
+ * be written back before.
+ */
+static inline void mixed_frames_publish(atomic_t *counter, uint32_t frames)
 {
-	coherent_release_thread(&mdi->c, sizeof(*mdi));
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	atomic_set(counter, frames);
+	dcache_writeback_region((__sparse_force void __sparse_cache *)counter, sizeof(*counter));
+}
+
+/* Frames the free running counter is ahead of produced frames, zero when it is
+ * behind or more than limit frames ahead.
+ */
+static inline uint32_t mixed_frames_ahead(atomic_t *counter, uint32_t produced, uint32_t limit)
+{
+	int32_t ahead = (int32_t)(mixed_frames_read(counter) - produced);
+
+	return ahead > 0 && ahead <= limit ? ahead : 0;
 }
 
 struct mixin_sink_config {
@@ -110,6 +161,19 @@ struct mixin_sink_config {
 	uint16_t gain;
 };
 
+/*
+ * Channel remapping of a sink for the remap_channels() functions: source channel,
+ * mask and gain for every sink channel. A muted sink channel reads the source
+ * channel 0 with zero mask and gain, so it is zeroed where the source is copied
+ * and left as is where the source is mixed.
+ */
+struct mixin_remap {
+	uint8_t source_channel[PLATFORM_MAX_CHANNELS];
+	int32_t mask[PLATFORM_MAX_CHANNELS];
+	uint16_t gain[PLATFORM_MAX_CHANNELS];
+	bool unity_gain;
+};
+
 /* mixin component private data */
 struct mixin_data {
 	/* Must be the 1st field, function ipc4_comp_get_base_module_cfg casts components
@@ -123,8 +187,10 @@ struct mixin_data {
 			    uint8_t source_channel_index, uint8_t source_channel_count,
 			    uint32_t frame_count, uint16_t gain);
 
-	void (*mute_channel)(struct audio_stream __sparse_cache *stream, uint8_t channel_index,
-			     uint32_t start_frame, uint32_t mixed_frames, uint32_t frame_count);
+	void (*remap_channels)(struct audio_stream __sparse_cache *sink, uint32_t start_frame,
+			       uint32_t mixed_frames,
+			       const struct audio_stream __sparse_cache *source,
+			       uint32_t frame_count, const struct mixin_remap *remap);
 
 	struct mixin_sink_config sink_config[MIXIN_MAX_SINKS];
 };
@@ -136,6 +202,13 @@ struct mixout_data {
 	 */
 	struct ipc4_base_module_cfg base_cfg;
 	struct mixed_data_info *mixed_data_info;
+
+	/* used to add the partial buffers of other cores to the sink */
+	void (*mix_channel)(struct audio_stream __sparse_cache *sink, uint8_t sink_channel_index,
+			    uint8_t sink_channel_count, uint32_t start_frame, uint32_t mixed_frames,
+			    const struct audio_stream __sparse_cache *source,
+			    uint8_t source_channel_index, uint8_t source_channel_count,
+			    uint32_t frame_count, uint16_t gain);
 };
 
 static struct comp_dev *mixin_new(const struct comp_driver *drv,
@@ -187,7 +260,9 @@ static struct comp_dev *mixout_new(const struct comp_driver *drv,
 {
 	struct comp_dev *dev;
 	struct mixout_data *md;
+	struct mixed_data_info *mdi;
 	enum sof_ipc_frame __sparse_cache frame_fmt, valid_fmt;
+	uint32_t frame_bytes;
 
 	comp_cl_dbg(&comp_mixout, "mixout_new()");
 
@@ -213,7 +288,6 @@ static struct comp_dev *mixout_new(const struct comp_driver *drv,
 		return NULL;
 	}
 
-	coherent_init_thread(md->mixed_data_info, c);
 	comp_set_drvdata(dev, md);
 
 	audio_stream_fmt_conversion(md->base_cfg.audio_fmt.depth,
@@ -223,6 +297,16 @@ static struct comp_dev *mixout_new(const struct comp_driver *drv,
 
 	dev->ipc_config.frame_fmt = frame_fmt;
 
+	/* partial buffers hold at least two output periods */
+	mdi = md->mixed_data_info;
+	mdi->frame_fmt = frame_fmt;
+	mdi->valid_fmt = valid_fmt;
+	mdi->channels = md->base_cfg.audio_fmt.channels_count;
+	frame_bytes = get_frame_bytes(frame_fmt, mdi->channels);
+	mdi->partial_frames = 1;
+	while (frame_bytes && mdi->partial_frames * frame_bytes < md->base_cfg.obs * 2)
+		mdi->partial_frames <<= 1;
+
 	dev->state = COMP_STATE_READY;
 	return dev;
 }
@@ -237,19 +321,21 @@ static void mixin_free(struct comp_dev *dev)
 static void mixout_free(struct comp_dev *dev)
 {
 	struct mixout_data *mixout_data;
+	int i;
 
 	comp_dbg(dev, "mixout_free()");
 
 	mixout_data = comp_get_drvdata(dev);
 
-	coherent_free_thread(mixout_data->mixed_data_info, c);
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		rfree(mixout_data->mixed_data_info->core_info[i].partial);
 	rfree(mixout_data->mixed_data_info);
 	rfree(mixout_data);
 	rfree(dev);
 }
 
 static
-struct mixout_source_info *find_mixout_source_info(struct mixed_data_info __sparse_cache *mdi,
+struct mixout_source_info *find_mixout_source_info(struct mixed_data_info *mdi,
 						   const struct comp_dev *mixin)
 {
 	/* mixin == NULL is also a valid input -- this will find first unused entry */
@@ -263,6 +349,36 @@ struct mixout_source_info *find_mixout_source_info(struct mixed_data_info __spar
 	return NULL;
 }
 
+/* Sets up stream to access the partial buffer of core from the first frame not
+ * yet produced by mixout.
+ */
+static void mixout_partial_stream(struct mixed_data_info *mdi, int core, uint32_t produced,
+				  struct audio_stream __sparse_cache *stream)
+{
+	uint32_t frame_bytes = get_frame_bytes(mdi->frame_fmt, mdi->channels);
+
+	stream->frame_fmt = mdi->frame_fmt;
+	stream->valid_sample_fmt = mdi->valid_fmt;
+	stream->channels = mdi->channels;
+	audio_stream_init(stream, mdi->core_info[core].partial, mdi->partial_frames * frame_bytes);
+	stream->w_ptr = (char *)stream->addr + (produced & (mdi->partial_frames - 1)) * frame_bytes;
+	stream->r_ptr = stream->w_ptr;
+}
+
+/* Number of frames that can be processed from src and dest pointers without
+ * wrap in either of the streams, but not more than frames. It is 0 when only
+ * a partial frame is left before the end of either buffer, the callers stop
+ * there instead of spinning on it.
+ */
+static inline uint32_t remap_frames_without_wrap(const struct audio_stream __sparse_cache *sink,
+						 const void *dest,
+						 const struct audio_stream __sparse_cache *source,
+						 const void *src, uint32_t frames)
+{
+	frames = MIN(frames, audio_stream_frames_without_wrap(sink, dest));
+	return MIN(frames, audio_stream_frames_without_wrap(source, src));
+}
+
 #if CONFIG_FORMAT_S16LE
 /* Instead of using sink->channels and source->channels, sink_channel_count and
  * source_channel_count are supplied as parameters. This is done to reuse the function
@@ -338,29 +454,90 @@ static void mix_channel_s16(struct audio_stream __sparse_cache *sink, uint8_t si
 	}
 }
 
-static void mute_channel_s16(struct audio_stream __sparse_cache *stream, uint8_t channel_index,
-			     uint32_t start_frame, uint32_t mixed_frames, uint32_t frame_count)
+/* Remaps and mixes all sink channels in a single pass over the source and
+ * sink frames. The sink frames are written in order, so that the stream is
+ * walked only once regardless of the channel count.
+ */
+static void remap_channels_s16(struct audio_stream __sparse_cache *sink, uint32_t start_frame,
+			       uint32_t mixed_frames,
+			       const struct audio_stream __sparse_cache *source,
+			       uint32_t frame_count, const struct mixin_remap *remap)
 {
-	uint32_t skip_mixed_frames;
-	int16_t *ptr;
+	/* local copy of the tables, the sink stores cannot alias with them */
+	const struct mixin_remap r = *remap;
+	const uint8_t *ch = r.source_channel;
+	const int32_t *mask = r.mask;
+	const uint16_t *gain = r.gain;
+	const int sink_channels = sink->channels;
+	const int source_channels = source->channels;
+	const int shift = IPC4_MIXIN_GAIN_SHIFT;
+	uint32_t frames_to_mix, frames_to_copy;
+	uint32_t frames, i;
+	int16_t *dest, *src;
+	int32_t x;
+	int c;
+
+	dest = (int16_t *)sink->w_ptr + start_frame * sink_channels;
+	src = (int16_t *)source->r_ptr;
 
 	assert(mixed_frames >= start_frame);
-	skip_mixed_frames = mixed_frames - start_frame;
+	frames_to_mix = MIN(mixed_frames - start_frame, frame_count);
+	frames_to_copy = frame_count - frames_to_mix;
 
-	if (frame_count <= skip_mixed_frames)
-		return;
-	frame_count -= skip_mixed_frames;
+	while (frames_to_mix) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_mix);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = src[ch[c]] & mask[c];
+					dest[c] = sat_int16((int32_t)dest[c] + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = q_mults_16x16(src[ch[c]], gain[c], shift);
+					dest[c] = sat_int16((int32_t)dest[c] + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
 
-	/* audio_stream_wrap() is needed here and it is just below in a loop */
-	ptr = (int16_t *)stream->w_ptr + mixed_frames * stream->channels + channel_index;
+		frames_to_mix -= frames;
+	}
 
-	while (frame_count) {
-		ptr = audio_stream_wrap(stream, ptr);
-		while (frame_count && ptr < (int16_t *)stream->end_addr) {
-			*ptr = 0;
-			ptr += stream->channels;
-			frame_count--;
-		}
+	while (frames_to_copy) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_copy);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++)
+					dest[c] = src[ch[c]] & mask[c];
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = q_mults_16x16(src[ch[c]], gain[c], shift);
+					dest[c] = (int16_t)x;
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+
+		frames_to_copy -= frames;
 	}
 }
 #endif	/* CONFIG_FORMAT_S16LE */
@@ -441,6 +618,93 @@ static void mix_channel_s24(struct audio_stream __sparse_cache *sink, uint8_t si
 	}
 }
 
+/* Remaps and mixes all sink channels in a single pass over the source and
+ * sink frames. The sink frames are written in order, so that the stream is
+ * walked only once regardless of the channel count.
+ */
+static void remap_channels_s24(struct audio_stream __sparse_cache *sink, uint32_t start_frame,
+			       uint32_t mixed_frames,
+			       const struct audio_stream __sparse_cache *source,
+			       uint32_t frame_count, const struct mixin_remap *remap)
+{
+	/* local copy of the tables, the sink stores cannot alias with them */
+	const struct mixin_remap r = *remap;
+	const uint8_t *ch = r.source_channel;
+	const int32_t *mask = r.mask;
+	const uint16_t *gain = r.gain;
+	const int sink_channels = sink->channels;
+	const int source_channels = source->channels;
+	const int shift = IPC4_MIXIN_GAIN_SHIFT;
+	uint32_t frames_to_mix, frames_to_copy;
+	uint32_t frames, i;
+	int32_t *dest, *src;
+	int32_t x;
+	int c;
+
+	dest = (int32_t *)sink->w_ptr + start_frame * sink_channels;
+	src = (int32_t *)source->r_ptr;
+
+	assert(mixed_frames >= start_frame);
+	frames_to_mix = MIN(mixed_frames - start_frame, frame_count);
+	frames_to_copy = frame_count - frames_to_mix;
+
+	while (frames_to_mix) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_mix);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = sign_extend_s24(src[ch[c]] & mask[c]);
+					dest[c] = sat_int24(sign_extend_s24(dest[c]) + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = sign_extend_s24(src[ch[c]]);
+					x = (int32_t)q_mults_32x32(x, gain[c], shift);
+					dest[c] = sat_int24(sign_extend_s24(dest[c]) + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+
+		frames_to_mix -= frames;
+	}
+
+	while (frames_to_copy) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_copy);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++)
+					dest[c] = src[ch[c]] & mask[c];
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = sign_extend_s24(src[ch[c]]);
+					dest[c] = (int32_t)q_mults_32x32(x, gain[c], shift);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+
+		frames_to_copy -= frames;
+	}
+}
 #endif	/* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -517,29 +781,90 @@ static void mix_channel_s32(struct audio_stream __sparse_cache *sink, uint8_t si
 	}
 }
 
-static void mute_channel_s32(struct audio_stream __sparse_cache *stream, uint8_t channel_index,
-			     uint32_t start_frame, uint32_t mixed_frames, uint32_t frame_count)
+/* Remaps and mixes all sink channels in a single pass over the source and
+ * sink frames. The sink frames are written in order, so that the stream is
+ * walked only once regardless of the channel count.
+ */
+static void remap_channels_s32(struct audio_stream __sparse_cache *sink, uint32_t start_frame,
+			       uint32_t mixed_frames,
+			       const struct audio_stream __sparse_cache *source,
+			       uint32_t frame_count, const struct mixin_remap *remap)
 {
-	uint32_t skip_mixed_frames;
-	int32_t *ptr;
+	/* local copy of the tables, the sink stores cannot alias with them */
+	const struct mixin_remap r = *remap;
+	const uint8_t *ch = r.source_channel;
+	const int32_t *mask = r.mask;
+	const uint16_t *gain = r.gain;
+	const int sink_channels = sink->channels;
+	const int source_channels = source->channels;
+	const int shift = IPC4_MIXIN_GAIN_SHIFT;
+	uint32_t frames_to_mix, frames_to_copy;
+	uint32_t frames, i;
+	int32_t *dest, *src;
+	int64_t x;
+	int c;
+
+	dest = (int32_t *)sink->w_ptr + start_frame * sink_channels;
+	src = (int32_t *)source->r_ptr;
 
 	assert(mixed_frames >= start_frame);
-	skip_mixed_frames = mixed_frames - start_frame;
+	frames_to_mix = MIN(mixed_frames - start_frame, frame_count);
+	frames_to_copy = frame_count - frames_to_mix;
 
-	if (frame_count <= skip_mixed_frames)
-		return;
-	frame_count -= skip_mixed_frames;
+	while (frames_to_mix) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_mix);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = src[ch[c]] & mask[c];
+					dest[c] = sat_int32((int64_t)dest[c] + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = q_mults_32x32(src[ch[c]], gain[c], shift);
+					dest[c] = sat_int32((int64_t)dest[c] + x);
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
 
-	/* audio_stream_wrap() is needed here and it is just below in a loop */
-	ptr = (int32_t *)stream->w_ptr + mixed_frames * stream->channels + channel_index;
+		frames_to_mix -= frames;
+	}
 
-	while (frame_count) {
-		ptr = audio_stream_wrap(stream, ptr);
-		while (frame_count && ptr < (int32_t *)stream->end_addr) {
-			*ptr = 0;
-			ptr += stream->channels;
-			frame_count--;
-		}
+	while (frames_to_copy) {
+		src = audio_stream_wrap(source, src);
+		dest = audio_stream_wrap(sink, dest);
+		frames = remap_frames_without_wrap(sink, dest, source, src, frames_to_copy);
+		if (!frames)
+			return;
+
+		if (r.unity_gain)
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++)
+					dest[c] = src[ch[c]] & mask[c];
+				src += source_channels;
+				dest += sink_channels;
+			}
+		else
+			for (i = 0; i < frames; i++) {
+				for (c = 0; c < sink_channels; c++) {
+					x = q_mults_32x32(src[ch[c]], gain[c], shift);
+					dest[c] = (int32_t)x;
+				}
+				src += source_channels;
+				dest += sink_channels;
+			}
+
+		frames_to_copy -= frames;
 	}
 }
 #endif	/* CONFIG_FORMAT_S32LE */
@@ -569,15 +894,23 @@ static int mix_and_remap(struct comp_dev *dev, const struct mixin_data *mixin_da
 					mixed_frames * sink->channels, source, 0, 1,
 					frame_count * sink->channels, sink_config->gain);
 	} else if (sink_config->mixer_mode == IPC4_MIXER_CHANNEL_REMAPPING_MODE) {
+		struct mixin_remap remap;
 		int i;
 
+		if (sink->channels > PLATFORM_MAX_CHANNELS) {
+			comp_err(dev, "Too many sink channels for remap: %u", sink->channels);
+			return -EINVAL;
+		}
+
+		remap.unity_gain = sink_config->gain == IPC4_MIXIN_UNITY_GAIN;
 		for (i = 0; i < sink->channels; i++) {
 			uint8_t source_channel =
 				(sink_config->output_channel_map >> (i * 4)) & 0xf;
 
 			if (source_channel == 0xf) {
-				mixin_data->mute_channel(sink, i, start_frame, mixed_frames,
-							 frame_count);
+				remap.source_channel[i] = 0;
+				remap.mask[i] = 0;
+				remap.gain[i] = 0;
 			} else {
 				if (source_channel >= source->channels) {
 					comp_err(dev, "Out of range chmap: 0x%x, src channels: %u",
@@ -585,12 +918,14 @@ static int mix_and_remap(struct comp_dev *dev, const struct mixin_data *mixin_da
 						 source->channels);
 					return -EINVAL;
 				}
-				mixin_data->mix_channel(sink, i, sink->channels, start_frame,
-							mixed_frames, source, source_channel,
-							source->channels, frame_count,
-							sink_config->gain);
+				remap.source_channel[i] = source_channel;
+				remap.mask[i] = -1;
+				remap.gain[i] = sink_config->gain;
 			}
 		}
+
+		mixin_data->remap_channels(sink, start_frame, mixed_frames, source, frame_count,
+					   &remap);
 	} else {
 		comp_err(dev, "Unexpected mixer mode: %d", sink_config->mixer_mode);
 		return -EINVAL;
@@ -635,12 +970,15 @@ static void silence(struct audio_stream __sparse_cache *stream, uint32_t start_f
  * mixed data. Every mixin calls xxx_consume() on its processed source data, but
  * they do not call xxx_produce(). That is done on mixout side in mixout_copy().
  *
+ * A mixin running on another core than mixout does the same on the partial
+ * buffer of its core instead of the mixout sink buffer.
+ *
  * Since there is no garantie that mixout processing is done in time we have
  * to account for a possibility having not yet produced data in mixout sink
  * buffer that was written there on previous run(s) of mixin_copy(). So for each
- * mixin <--> mixout pair we track consumed_yet_not_produced data amount.
- * That value is also used in mixout_copy() to calculate how many data was
- * actually mixed and so xxx_produce() is called for that amount.
+ * mixin <--> mixout pair the mixed frames counter is tracked and compared to
+ * mixout produced frames. That value is also used in mixout_copy() to calculate
+ * how many data was actually mixed and so xxx_produce() is called for that amount.
  */
 static int mixin_copy(struct comp_dev *dev)
 {
@@ -654,6 +992,7 @@ static int mixin_copy(struct comp_dev *dev)
 	struct list_item *blist;
 	uint32_t bytes_to_consume_from_source_buf;
 	uint32_t frames_to_copy;
+	int core = dev->ipc_config.core;
 	int i, ret;
 
 	comp_dbg(dev, "mixin_copy()");
@@ -668,7 +1007,7 @@ static int mixin_copy(struct comp_dev *dev)
 
 	/* first, let's find out how many frames can be now processed --
 	 * it is a nimimal value among frames available in source buffer
-	 * and frames free in each connected mixout sink buffer.
+	 * and frames free in each connected mixout sink or partial buffer.
 	 */
 	active_mixout_cnt = 0;
 
@@ -679,10 +1018,10 @@ static int mixin_copy(struct comp_dev *dev)
 		uint16_t sink_id;
 		struct comp_buffer *sink;
 		struct mixout_data *mixout_data;
-		struct mixed_data_info __sparse_cache *mixed_data_info;
+		struct mixed_data_info *mixed_data_info;
 		struct mixout_source_info *src_info;
 		struct comp_buffer __sparse_cache *sink_c;
-		uint32_t free_frames;
+		uint32_t free_frames, start_frame, produced;
 
 		/* unused buffer between mixin and mixout */
 		unused_in_between_buf = buffer_from_list(blist, struct comp_buffer,
@@ -698,45 +1037,56 @@ static int mixin_copy(struct comp_dev *dev)
 		sinks_ids[active_mixout_cnt] = sink_id;
 		active_mixout_cnt++;
 
-		sink = list_first_item(&mixout->bsink_list, struct comp_buffer, source_list);
-
 		mixout_data = comp_get_drvdata(mixout);
-		mixed_data_info = mixed_data_info_acquire(mixout_data->mixed_data_info);
+		mixed_data_info = mixout_data->mixed_data_info;
+
+		/* source table and partial buffers are written back by mixout bind */
+		if (core != mixout->ipc_config.core)
+			dcache_invalidate_region((__sparse_force void __sparse_cache *)
+						 mixed_data_info, sizeof(*mixed_data_info));
+
 		src_info = find_mixout_source_info(mixed_data_info, dev);
 		if (!src_info) {
 			comp_err(dev, "No source info");
-			mixed_data_info_release(mixed_data_info);
 			buffer_release(source_c);
 			return -EINVAL;
 		}
 
-		sink_c = buffer_acquire(sink);
+		if (core == mixout->ipc_config.core) {
+			sink = list_first_item(&mixout->bsink_list, struct comp_buffer,
+					       source_list);
+			sink_c = buffer_acquire(sink);
 
-		/* Normally this should never happen as we checked above
-		 * that mixout is in active state and so its sink buffer
-		 * should be already initialized in mixout .params().
-		 */
-		if (!sink_c->hw_params_configured) {
-			comp_err(dev, "Uninitialized mixout sink buffer!");
+			/* Normally this should never happen as we checked above
+			 * that mixout is in active state and so its sink buffer
+			 * should be already initialized in mixout .params().
+			 */
+			if (!sink_c->hw_params_configured) {
+				comp_err(dev, "Uninitialized mixout sink buffer!");
+				buffer_release(sink_c);
+				buffer_release(source_c);
+				return -EINVAL;
+			}
+
+			free_frames = audio_stream_get_free_frames(&sink_c->stream);
 			buffer_release(sink_c);
-			mixed_data_info_release(mixed_data_info);
-			buffer_release(source_c);
-			return -EINVAL;
-		}
+		} else {
+			if (!mixed_data_info->core_info[core].partial) {
+				comp_err(dev, "No partial buffer for core %d", core);
+				buffer_release(source_c);
+				return -EINVAL;
+			}
 
-		free_frames = audio_stream_get_free_frames(&sink_c->stream);
+			free_frames = mixed_data_info->partial_frames;
+		}
 
 		/* mixout sink buffer may still have not yet produced data -- data
-		 * consumed and written there by mixin on previous mixin_copy() run.
+		 * mixed there by mixin on previous mixin_copy() run.
 		 * We do NOT want to overwrite that data.
 		 */
-		assert(free_frames >= src_info->consumed_yet_not_produced_frames);
-		sinks_free_frames = MIN(sinks_free_frames,
-					free_frames -
-					src_info->consumed_yet_not_produced_frames);
-
-		buffer_release(sink_c);
-		mixed_data_info_release(mixed_data_info);
+		produced = mixed_frames_read(&mixed_data_info->produced_frames);
+		start_frame = mixed_frames_ahead(&src_info->mixed_frames, produced, free_frames);
+		sinks_free_frames = MIN(sinks_free_frames, free_frames - start_frame);
 	}
 
 	bytes_to_consume_from_source_buf = 0;
@@ -766,52 +1116,65 @@ static int mixin_copy(struct comp_dev *dev)
 		struct comp_dev *mixout;
 		struct comp_buffer *sink;
 		struct mixout_data *mixout_data;
-		struct mixed_data_info __sparse_cache *mixed_data_info;
+		struct mixed_data_info *mixed_data_info;
 		struct mixout_source_info *src_info;
-		uint32_t start_frame;
-		struct comp_buffer __sparse_cache *sink_c;
+		struct mixout_core_info *core_info;
+		uint32_t start_frame, mixed_frames, produced, limit;
+		struct comp_buffer __sparse_cache *sink_c = NULL;
+		struct audio_stream __sparse_cache partial;
+		struct audio_stream __sparse_cache *stream;
 		uint32_t writeback_size;
 
 		mixout = active_mixouts[i];
-		sink = list_first_item(&mixout->bsink_list, struct comp_buffer, source_list);
-
 		mixout_data = comp_get_drvdata(mixout);
-		mixed_data_info = mixed_data_info_acquire(mixout_data->mixed_data_info);
+		mixed_data_info = mixout_data->mixed_data_info;
+		core_info = &mixed_data_info->core_info[core];
 		src_info = find_mixout_source_info(mixed_data_info, dev);
 		if (!src_info) {
 			comp_err(dev, "No source info");
-			mixed_data_info_release(mixed_data_info);
 			buffer_release(source_c);
 			return -EINVAL;
 		}
 
+		produced = mixed_frames_read(&mixed_data_info->produced_frames);
+
+		if (core == mixout->ipc_config.core) {
+			sink = list_first_item(&mixout->bsink_list, struct comp_buffer,
+					       source_list);
+			sink_c = buffer_acquire(sink);
+			stream = &sink_c->stream;
+			limit = audio_stream_get_free_frames(stream);
+		} else {
+			mixout_partial_stream(mixed_data_info, core, produced, &partial);
+			stream = &partial;
+			limit = mixed_data_info->partial_frames;
+		}
+
 		/* Skip data from previous run(s) not yet produced in mixout_copy().
 		 * Normally start_frame would be 0 unless mixout pipeline has serious
 		 * performance problems with processing data on time in mixout.
 		 */
-		start_frame = src_info->consumed_yet_not_produced_frames;
+		start_frame = mixed_frames_ahead(&src_info->mixed_frames, produced, limit);
+		mixed_frames = mixed_frames_ahead(&core_info->mixed_frames, produced, limit);
 		assert(sinks_free_frames >= start_frame);
 
-		sink_c = buffer_acquire(sink);
-
 		/* if source does not produce any data but mixin is in active state -- generate
 		 * silence instead of that source data
 		 */
 		if (source_avail_frames == 0) {
 			/* generate silence */
-			silence(&sink_c->stream, start_frame, mixed_data_info->mixed_frames,
-				frames_to_copy);
+			silence(stream, start_frame, mixed_frames, frames_to_copy);
 		} else {
 			/* basically, if sink buffer has no data -- copy source data there, if
 			 * sink buffer has some data (written by another mixin) mix that data
 			 * with source data.
 			 */
-			ret = mix_and_remap(dev, mixin_data, sinks_ids[i], &sink_c->stream,
-					    start_frame, mixed_data_info->mixed_frames,
+			ret = mix_and_remap(dev, mixin_data, sinks_ids[i], stream,
+					    start_frame, mixed_frames,
 					    &source_c->stream, frames_to_copy);
 			if (ret < 0) {
-				buffer_release(sink_c);
-				mixed_data_info_release(mixed_data_info);
+				if (sink_c)
+					buffer_release(sink_c);
 				buffer_release(source_c);
 				return ret;
 			}
@@ -821,18 +1184,22 @@ static int mixin_copy(struct comp_dev *dev)
 		 * of frames_to_copy size (converted to bytes, of course). However, seems
 		 * there is no appropreate API. Anyway, start_frame would be 0 most of the time.
 		 */
-		writeback_size = audio_stream_period_bytes(&sink_c->stream,
-							   frames_to_copy + start_frame);
-		if (writeback_size > 0)
-			buffer_stream_writeback(sink_c, writeback_size);
-		buffer_release(sink_c);
-
-		src_info->consumed_yet_not_produced_frames += frames_to_copy;
+		writeback_size = audio_stream_period_bytes(stream, frames_to_copy + start_frame);
+		if (sink_c) {
+			if (writeback_size > 0)
+				buffer_stream_writeback(sink_c, writeback_size);
+			buffer_release(sink_c);
+		} else if (writeback_size > 0) {
+			audio_stream_writeback(stream, writeback_size);
+		}
 
-		if (frames_to_copy + start_frame > mixed_data_info->mixed_frames)
-			mixed_data_info->mixed_frames = frames_to_copy + start_frame;
+		/* data must be in memory before the counters let mixout read it */
+		mixed_frames_publish(&src_info->mixed_frames,
+				     produced + start_frame + frames_to_copy);
 
-		mixed_data_info_release(mixed_data_info);
+		if (frames_to_copy + start_frame > mixed_frames)
+			mixed_frames_publish(&core_info->mixed_frames,
+					     produced + start_frame + frames_to_copy);
 	}
 
 	if (bytes_to_consume_from_source_buf > 0)
@@ -842,23 +1209,72 @@ static int mixin_copy(struct comp_dev *dev)
 	return 0;
 }
 
-/* mixout just calls xxx_produce() on data mixed into its sink buffer by
- * mixins.
+/* Adds the partial buffers of mixins running on other cores to frames of the
+ * mixout sink buffer about to be produced.
+ */
+static void mixout_reduce_partials(struct comp_dev *dev,
+				   struct audio_stream __sparse_cache *sink,
+				   uint32_t produced, uint32_t frames)
+{
+	struct mixout_data *mixout_data = comp_get_drvdata(dev);
+	struct mixed_data_info *mdi = mixout_data->mixed_data_info;
+	struct mixout_core_info *local = &mdi->core_info[dev->ipc_config.core];
+	struct audio_stream __sparse_cache partial;
+	uint32_t sink_mixed, local_mixed, n;
+	uint32_t reduced_frames = 0;
+	int core;
+
+	local_mixed = mixed_frames_ahead(&local->mixed_frames, produced,
+					 audio_stream_get_free_frames(sink));
+	sink_mixed = local_mixed;
+
+	for (core = 0; core < CONFIG_CORE_COUNT; core++) {
+		if (core == dev->ipc_config.core || !mdi->core_info[core].partial)
+			continue;
+
+		n = MIN(frames, mixed_frames_ahead(&mdi->core_info[core].mixed_frames, produced,
+						   mdi->partial_frames));
+		if (!n)
+			continue;
+
+		mixout_partial_stream(mdi, core, produced, &partial);
+		audio_stream_invalidate(&partial, audio_stream_period_bytes(&partial, n));
+
+		/* channels are interleaved the same way, mix them as a single channel */
+		mixout_data->mix_channel(sink, 0, 1, 0, sink_mixed * sink->channels,
+					 &partial, 0, 1, n * sink->channels,
+					 IPC4_MIXIN_UNITY_GAIN);
+		sink_mixed = MAX(sink_mixed, n);
+		reduced_frames = MAX(reduced_frames, n);
+	}
+
+	if (!reduced_frames)
+		return;
+
+	audio_stream_writeback(sink, audio_stream_period_bytes(sink, reduced_frames));
+	if (sink_mixed > local_mixed)
+		mixed_frames_publish(&local->mixed_frames, produced + sink_mixed);
+}
+
+/* mixout adds the partial buffers of other cores and calls xxx_produce() on
+ * data mixed into its sink buffer by mixins.
  */
 static int mixout_copy(struct comp_dev *dev)
 {
 	struct mixout_data *mixout_data;
-	struct mixed_data_info __sparse_cache *mixed_data_info;
+	struct mixed_data_info *mixed_data_info;
 	struct list_item *blist;
 	uint32_t frames_to_produce = INT32_MAX;
+	uint32_t produced;
 
 	comp_dbg(dev, "mixout_copy()");
 
 	mixout_data = comp_get_drvdata(dev);
-	mixed_data_info = mixed_data_info_acquire(mixout_data->mixed_data_info);
+	mixed_data_info = mixout_data->mixed_data_info;
+	produced = mixed_frames_read(&mixed_data_info->produced_frames);
 
-	/* iterate over all connected mixins to find minimal value of frames they consumed
-	 * (i.e., mixed into mixout sink buffer). That is the amount that can/should be
+	/* iterate over all connected mixins to find minimal value of frames they mixed
+	 * into mixout sink or partial buffer. That is the amount that can/should be
 	 * produced now.
 	 */
 	list_for_item(blist, &dev->bsource_list) {
@@ -873,47 +1289,37 @@ static int mixout_copy(struct comp_dev *dev)
 		src_info = find_mixout_source_info(mixed_data_info, mixin);
 		if (!src_info) {
 			comp_err(dev, "No source info");
-			mixed_data_info_release(mixed_data_info);
 			return -EINVAL;
 		}
 
 		/* Inactive sources should not block other active sources */
 		if (comp_get_state(dev, mixin) == COMP_STATE_ACTIVE)
 			frames_to_produce = MIN(frames_to_produce,
-						src_info->consumed_yet_not_produced_frames);
+						mixed_frames_ahead(&src_info->mixed_frames,
+								   produced, INT32_MAX));
 	}
 
 	if (frames_to_produce > 0 && frames_to_produce < INT32_MAX) {
-		int i;
 		struct comp_buffer *sink;
 		struct comp_buffer __sparse_cache *sink_c;
 
-		for (i = 0; i < MIXOUT_MAX_SOURCES; i++) {
-			if (!mixed_data_info->source_info[i].mixin)
-				continue;
-
-			if (mixed_data_info->source_info[i].consumed_yet_not_produced_frames >=
-				frames_to_produce)
-				mixed_data_info->source_info[i].consumed_yet_not_produced_frames -=
-					frames_to_produce;
-			else
-				mixed_data_info->source_info[i].consumed_yet_not_produced_frames =
-					0;
-		}
-
-		assert(mixed_data_info->mixed_frames >= frames_to_produce);
-		mixed_data_info->mixed_frames -= frames_to_produce;
-
 		sink = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
 		sink_c = buffer_acquire(sink);
-		/* writeback is already done in mixin while mixing */
+
+		/* mixins on other cores are not limited by sink free space */
+		frames_to_produce = MIN(frames_to_produce,
+					audio_stream_get_free_frames(&sink_c->stream));
+
+		/* writeback of local mixins data is already done in mixin while mixing */
+		mixout_reduce_partials(dev, &sink_c->stream, produced, frames_to_produce);
 		comp_update_buffer_produce(sink_c,
 					   audio_stream_period_bytes(&sink_c->stream,
 								     frames_to_produce));
 		buffer_release(sink_c);
-	}
 
-	mixed_data_info_release(mixed_data_info);
+		mixed_frames_publish(&mixed_data_info->produced_frames,
+				     produced + frames_to_produce);
+	}
 
 	return 0;
 }
@@ -926,25 +1332,36 @@ static int mixin_reset(struct comp_dev *dev)
 
 	mixin_data = comp_get_drvdata(dev);
 	mixin_data->mix_channel = NULL;
-	mixin_data->mute_channel = NULL;
+	mixin_data->remap_channels = NULL;
 
 	comp_set_state(dev, COMP_TRIGGER_RESET);
 
 	return 0;
 }
 
+/* Clears the source info table and restarts all frame counters */
+static void mixed_data_info_clear(struct mixed_data_info *mdi)
+{
+	int i;
+
+	memset(mdi->source_info, 0, sizeof(mdi->source_info));
+	atomic_set(&mdi->produced_frames, 0);
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		atomic_set(&mdi->core_info[i].mixed_frames, 0);
+
+	dcache_writeback_region((__sparse_force void __sparse_cache *)mdi, sizeof(*mdi));
+}
+
 static int mixout_reset(struct comp_dev *dev)
 {
 	struct mixout_data *mixout_data;
-	struct mixed_data_info __sparse_cache *mixed_data_info;
 	struct list_item *blist;
 
 	comp_dbg(dev, "mixout_reset()");
 
 	mixout_data = comp_get_drvdata(dev);
-	mixed_data_info = mixed_data_info_acquire(mixout_data->mixed_data_info);
-	memset(mixed_data_info->source_info, 0, sizeof(mixed_data_info->source_info));
-	mixed_data_info_release(mixed_data_info);
+	mixout_data->mix_channel = NULL;
+	mixed_data_info_clear(mixout_data->mixed_data_info);
 
 	if (dev->pipeline->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
 		list_for_item(blist, &dev->bsource_list) {
@@ -1004,19 +1421,19 @@ static int mixin_prepare(struct comp_dev *dev)
 #if CONFIG_FORMAT_S16LE
 	case SOF_IPC_FRAME_S16_LE:
 		md->mix_channel = mix_channel_s16;
-		md->mute_channel = mute_channel_s16;
+		md->remap_channels = remap_channels_s16;
 		break;
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
 	case SOF_IPC_FRAME_S24_4LE:
 		md->mix_channel = mix_channel_s24;
-		md->mute_channel = mute_channel_s32;	/* yes, 32 is correct */
+		md->remap_channels = remap_channels_s24;
 		break;
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
 	case SOF_IPC_FRAME_S32_LE:
 		md->mix_channel = mix_channel_s32;
-		md->mute_channel = mute_channel_s32;
+		md->remap_channels = remap_channels_s32;
 		break;
 #endif /* CONFIG_FORMAT_S32LE */
 	default:
@@ -1037,8 +1454,10 @@ static int mixin_prepare(struct comp_dev *dev)
 static int mixout_prepare(struct comp_dev *dev)
 {
 	struct mixout_data *md;
+	struct comp_buffer *sink;
+	struct comp_buffer __sparse_cache *sink_c;
+	enum sof_ipc_frame fmt;
 	int ret;
-	struct list_item *blist;
 
 	comp_dbg(dev, "mixout_prepare()");
 
@@ -1047,18 +1466,31 @@ static int mixout_prepare(struct comp_dev *dev)
 
 	md = comp_get_drvdata(dev);
 
-	list_for_item(blist, &dev->bsource_list) {
-		struct comp_buffer *unused_in_between_buf;
-		struct comp_dev *mixin;
-
-		unused_in_between_buf = buffer_from_list(blist, struct comp_buffer,
-							 PPL_DIR_UPSTREAM);
-		mixin = buffer_get_comp(unused_in_between_buf, PPL_DIR_UPSTREAM);
+	sink = list_first_item(&dev->bsink_list, struct comp_buffer,
+			       source_list);
+	sink_c = buffer_acquire(sink);
+	fmt = sink_c->stream.valid_sample_fmt;
+	buffer_release(sink_c);
 
-		if (mixin->pipeline && mixin->pipeline->core != dev->pipeline->core) {
-			coherent_shared_thread(md->mixed_data_info, c);
-			break;
-		}
+	switch (fmt) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		md->mix_channel = mix_channel_s16;
+		break;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		md->mix_channel = mix_channel_s24;
+		break;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		md->mix_channel = mix_channel_s32;
+		break;
+#endif /* CONFIG_FORMAT_S32LE */
+	default:
+		comp_err(dev, "unsupported data format");
+		return -EINVAL;
 	}
 
 	ret = comp_set_state(dev, COMP_TRIGGER_PREPARE);
@@ -1227,13 +1659,13 @@ static int mixout_bind(struct comp_dev *dev, void *data)
 	struct ipc4_module_bind_unbind *bu;
 	int src_id;
 	struct mixout_data *md;
-	struct mixed_data_info __sparse_cache *mixed_data_info;
+	struct mixed_data_info *mixed_data_info;
 
 	bu = (struct ipc4_module_bind_unbind *)data;
 	src_id = IPC4_COMP_ID(bu->primary.r.module_id, bu->primary.r.instance_id);
 
 	md = comp_get_drvdata(dev);
-	mixed_data_info = mixed_data_info_acquire(md->mixed_data_info);
+	mixed_data_info = md->mixed_data_info;
 
 	/*
 	 * If dev->ipc_config.id == src_id then we're called for the downstream
@@ -1243,14 +1675,38 @@ static int mixout_bind(struct comp_dev *dev, void *data)
 		/* new mixin -> mixout */
 		struct comp_dev *mixin;
 		struct mixout_source_info *source_info;
+		struct mixout_core_info *core_info;
 
 		mixin = ipc4_get_comp_dev(src_id);
 		if (!mixin) {
 			comp_err(dev, "mixout_bind: no source with ID %d found", src_id);
-			mixed_data_info_release(mixed_data_info);
 			return -EINVAL;
 		}
 
+		/* mixins on other cores mix into the partial buffer of their core */
+		core_info = &mixed_data_info->core_info[mixin->ipc_config.core];
+		if (mixin->ipc_config.core != dev->ipc_config.core && !core_info->partial) {
+			core_info->partial = rballoc(0, SOF_MEM_CAPS_RAM,
+						     mixed_data_info->partial_frames *
+						     get_frame_bytes(mixed_data_info->frame_fmt,
+								     mixed_data_info->channels));
+			if (!core_info->partial) {
+				comp_err(dev, "mixout_bind: no memory for core %d partial buffer",
+					 mixin->ipc_config.core);
+				return -ENOMEM;
+			}
+
+			/* no stale lines of this core may be evicted over mixin data */
+			dcache_invalidate_region((__sparse_force void __sparse_cache *)
+						 core_info->partial,
+						 mixed_data_info->partial_frames *
+						 get_frame_bytes(mixed_data_info->frame_fmt,
+								 mixed_data_info->channels));
+
+			atomic_set(&core_info->mixed_frames,
+				   atomic_read(&mixed_data_info->produced_frames));
+		}
+
 		source_info = find_mixout_source_info(mixed_data_info, mixin);
 		if (source_info) {
 			/* this should never happen as source_info should
@@ -1262,15 +1718,15 @@ static int mixout_bind(struct comp_dev *dev, void *data)
 		if (!source_info) {
 			/* no free space in source_info table */
 			comp_err(dev, "Too many mixout inputs!");
-			mixed_data_info_release(mixed_data_info);
 			return -ENOMEM;
 		}
 		source_info->mixin = mixin;
-		source_info->consumed_yet_not_produced_frames = 0;
+		atomic_set(&source_info->mixed_frames,
+			   atomic_read(&mixed_data_info->produced_frames));
+		dcache_writeback_region((__sparse_force void __sparse_cache *)mixed_data_info,
+					sizeof(*mixed_data_info));
 	}
 
-	mixed_data_info_release(mixed_data_info);
-
 	return 0;
 }
 
@@ -1279,18 +1735,17 @@ static int mixout_unbind(struct comp_dev *dev, void *data)
 	struct ipc4_module_bind_unbind *bu;
 	int src_id;
 	struct mixout_data *md;
-	struct mixed_data_info __sparse_cache *mixed_data_info;
+	struct mixed_data_info *mixed_data_info;
 
 	bu = (struct ipc4_module_bind_unbind *)data;
 	src_id = IPC4_COMP_ID(bu->primary.r.module_id, bu->primary.r.instance_id);
 
 	md = comp_get_drvdata(dev);
-	mixed_data_info = mixed_data_info_acquire(md->mixed_data_info);
+	mixed_data_info = md->mixed_data_info;
 
 	/* mixout -> new sink */
 	if (dev->ipc_config.id == src_id) {
-		mixed_data_info->mixed_frames = 0;
-		memset(mixed_data_info->source_info, 0, sizeof(mixed_data_info->source_info));
+		mixed_data_info_clear(mixed_data_info);
 	} else { /* new mixin -> mixout */
 		struct comp_dev *mixin;
 		struct mixout_source_info *source_info;
@@ -1298,17 +1753,17 @@ static int mixout_unbind(struct comp_dev *dev, void *data)
 		mixin = ipc4_get_comp_dev(src_id);
 		if (!mixin) {
 			comp_err(dev, "mixout_bind: no source with ID %d found", src_id);
-			mixed_data_info_release(mixed_data_info);
 			return -EINVAL;
 		}
 
 		source_info = find_mixout_source_info(mixed_data_info, mixin);
-		if (source_info)
+		if (source_info) {
 			memset(source_info, 0, sizeof(*source_info));
+			dcache_writeback_region((__sparse_force void __sparse_cache *)source_info,
+						sizeof(*source_info));
+		}
 	}
 
-	mixed_data_info_release(mixed_data_info);
-
 	return 0;
 }
 
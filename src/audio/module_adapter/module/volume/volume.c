@@ -360,6 +360,7 @@ static void reset_state(struct vol_data *cd)
 	cd->vol_ramp_active = false;
 	cd->vol_ramp_frames = 0;
 	cd->vol_ramp_elapsed_frames = 0;
+	cd->ramp_zc_state = false;
 	cd->sample_rate = 0;
 }
 
@@ -1061,6 +1062,25 @@ static void volume_update_current_vol_ipc4(struct vol_data *cd)
 #endif
 }
 
+/**
+ * \brief Checks if a zero crossing ramp still holds some channel gain.
+ * \param[in] cd Volume component private data.
+ * \return True if a channel has not reached the target gain.
+ */
+static bool volume_ramp_zc_pending(struct vol_data *cd)
+{
+	int i;
+
+	if (!cd->ramp_zc_state)
+		return false;
+
+	for (i = 0; i < cd->channels; i++)
+		if (cd->ramp_zc_vol[i] != cd->volume[i])
+			return true;
+
+	return false;
+}
+
 /*
  * \brief Copies and processes stream data.
  * \param[in,out] mod Volume processing module handle
@@ -1072,12 +1092,36 @@ static int volume_process(struct processing_module *mod,
 			  struct output_stream_buffer *output_buffers, int num_output_buffers)
 {
 	struct vol_data *cd = module_get_private_data(mod);
+	int32_t start_volume[SOF_IPC_MAX_CHANNELS];
 	uint32_t avail_frames = input_buffers[0].size;
 	uint32_t frames;
 	int64_t prev_sum = 0;
 
 	comp_dbg(mod->dev, "volume_process()");
 
+	/* With a ramp processing function the ramp gain is advanced to the end
+	 * of the period and the gain is interpolated per frame in one pass. The
+	 * zero crossing ramp is handled by the processing function too, it keeps
+	 * running after the ramp until every held gain has reached the target.
+	 */
+	if (cd->scale_vol_ramp && avail_frames &&
+	    (!cd->ramp_finished || volume_ramp_zc_pending(cd))) {
+		volume_update_current_vol_ipc4(cd);
+		memcpy_s(start_volume, sizeof(start_volume), cd->volume, sizeof(cd->volume));
+		if (!cd->ramp_finished) {
+			if (cd->vol_ramp_active)
+				cd->vol_ramp_elapsed_frames += avail_frames;
+
+			volume_ramp(mod);
+		}
+
+		cd->scale_vol_ramp(mod, &input_buffers[0], &output_buffers[0], avail_frames,
+				   start_volume);
+		return 0;
+	}
+
+	cd->ramp_zc_state = false;
+
 	while (avail_frames) {
 		volume_update_current_vol_ipc4(cd);
 
@@ -1218,6 +1262,8 @@ static int volume_prepare(struct processing_module *mod)
 		goto err;
 	}
 
+	cd->scale_vol_ramp = vol_get_ramp_processing_function(cd->scale_vol);
+
 	cd->zc_get = vol_get_zc_function(dev, sink_c);
 	if (!cd->zc_get) {
 		comp_err(dev, "volume_prepare(): invalid cd->zc_get");
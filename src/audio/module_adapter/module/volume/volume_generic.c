@@ -28,6 +28,131 @@ LOG_MODULE_DECLARE(volume_generic, CONFIG_SOF_LOG_LEVEL);
 
 #ifdef CONFIG_GENERIC
 
+/** \brief Extra fractional bits for the per frame ramp gain increment. */
+#define VOL_RAMP_STEP_FRAC_BITS	16
+
+/**
+ * \brief Per channel state of the ramp gain trajectory within a period.
+ */
+struct vol_ramp_state {
+	int64_t gain[SOF_IPC_MAX_CHANNELS];	/**< trajectory gain with extra fraction */
+	int64_t step[SOF_IPC_MAX_CHANNELS];	/**< trajectory gain increment per frame */
+	int32_t vol[SOF_IPC_MAX_CHANNELS];	/**< gain held until zero crossing */
+	int32_t prev[SOF_IPC_MAX_CHANNELS];	/**< previous sample for zero crossing */
+	bool zc;				/**< snap gain at zero crossings */
+};
+
+/**
+ * \brief Initializes the ramp gain trajectory.
+ * \param[in] cd Volume component private data.
+ * \param[out] rs Ramp state to initialize.
+ * \param[in] start_volume Gain of each channel in start of the period.
+ * \param[in] frames Number of frames in the period.
+ * \param[in] nch Number of channels.
+ * \return True if the caller needs to set the previous samples for the
+ *	   zero crossing detection.
+ *
+ * The gain is linearly interpolated from start_volume to the current volume
+ * that volume_ramp() has computed for the end of the period, so the last
+ * frame of the period is processed with the end gain. The gain held until
+ * zero crossing and the last sample continue from the previous period.
+ */
+static bool vol_ramp_init(struct vol_data *cd, struct vol_ramp_state *rs,
+			  const int32_t *start_volume, uint32_t frames, int nch)
+{
+	int64_t delta;
+	int j;
+
+	rs->zc = cd->ramp_type == SOF_VOLUME_LINEAR_ZC;
+	for (j = 0; j < nch; j++) {
+		delta = (int64_t)(cd->volume[j] - start_volume[j]) << VOL_RAMP_STEP_FRAC_BITS;
+		rs->gain[j] = (int64_t)start_volume[j] << VOL_RAMP_STEP_FRAC_BITS;
+		rs->step[j] = delta / (int64_t)frames;
+		rs->vol[j] = cd->ramp_zc_state ? cd->ramp_zc_vol[j] : start_volume[j];
+		rs->prev[j] = cd->ramp_zc_prev[j];
+	}
+
+	return rs->zc && !cd->ramp_zc_state;
+}
+
+/**
+ * \brief Stores the zero crossing state for the next period.
+ * \param[in,out] cd Volume component private data.
+ * \param[in] rs Ramp state.
+ * \param[in] nch Number of channels.
+ */
+static void vol_ramp_save(struct vol_data *cd, const struct vol_ramp_state *rs, int nch)
+{
+	int j;
+
+	if (!rs->zc)
+		return;
+
+	for (j = 0; j < nch; j++) {
+		cd->ramp_zc_vol[j] = rs->vol[j];
+		cd->ramp_zc_prev[j] = rs->prev[j];
+	}
+
+	cd->ramp_zc_state = true;
+}
+
+/**
+ * \brief Advances the ramp gain trajectory of a channel by n frames.
+ * \param[in,out] rs Ramp state.
+ * \param[in] j Channel index.
+ * \param[out] vol Gain to apply for each frame.
+ * \param[in] n Number of frames.
+ *
+ * The gains are computed in a separate pass so that the sample loops of the
+ * processing functions are a plain vectorizable multiply of two arrays.
+ */
+static inline void vol_ramp_gains(struct vol_ramp_state *rs, int j, int32_t *vol, int n)
+{
+	int64_t gain = rs->gain[j];
+	const int64_t step = rs->step[j];
+	int i;
+
+	for (i = 0; i < n; i++) {
+		gain += step;
+		vol[i] = (int32_t)(gain >> VOL_RAMP_STEP_FRAC_BITS);
+	}
+
+	rs->gain[j] = gain;
+}
+
+/**
+ * \brief Holds the ramp gains of a channel until the next zero crossing.
+ * \param[in,out] rs Ramp state.
+ * \param[in] j Channel index.
+ * \param[in,out] vol Trajectory gains, replaced by the gains to apply.
+ * \param[in] sign Samples of the channel as 32 bit values for the sign test.
+ * \param[in] n Number of frames.
+ *
+ * A sign change between consecutive samples of the channel snaps the applied
+ * gain to the trajectory. Between the crossings the previous gain is held.
+ */
+static inline void vol_ramp_zc_hold(struct vol_ramp_state *rs, int j, int32_t *vol,
+				    const int32_t *sign, int n)
+{
+	int32_t hold = rs->vol[j];
+	int32_t prev = rs->prev[j];
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if ((sign[i] ^ prev) < 0)
+			hold = vol[i];
+
+		prev = sign[i];
+		vol[i] = hold;
+	}
+
+	rs->vol[j] = hold;
+	rs->prev[j] = prev;
+}
+
+/** \brief Number of frames of gains computed at a time for the ramp. */
+#define VOL_RAMP_BLOCK_FRAMES	64
+
 #if CONFIG_FORMAT_S24LE
 /**
  * \brief Volume s24 to s24 multiply function
@@ -102,6 +227,92 @@ static void vol_s24_to_s24(struct processing_module *mod, struct input_stream_bu
 	/* update peak vol */
 	peak_vol_update(cd);
 }
+
+/**
+ * \brief Volume ramp processing from 24/32 bit to 24/32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Source buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] start_volume Gain of each channel in start of the period.
+ *
+ * Copy and scale volume with per frame interpolated gain from 24/32 bit
+ * source buffer to 24/32 bit destination buffer.
+ */
+static void vol_s24_to_s24_ramp(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				const int32_t *start_volume)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	struct vol_ramp_state rs;
+	int32_t vol[VOL_RAMP_BLOCK_FRAMES];
+	int32_t sign[VOL_RAMP_BLOCK_FRAMES];
+	int32_t *x, *x0;
+	int32_t *y, *y0;
+	int nmax, n, i, j, k, m;
+	bool split;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int32_t tmp = INT_MIN(32);
+#endif
+
+	x = source->r_ptr;
+	y = sink->w_ptr;
+
+	if (vol_ramp_init(cd, &rs, start_volume, frames, nch))
+		for (j = 0; j < nch; j++)
+			rs.prev[j] = sign_extend_s24(*(int32_t *)audio_stream_wrap(source, x + j));
+
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+
+		/* process whole frames, a frame split by the wrap is done alone */
+		split = n < nch;
+		n = split ? nch : n - n % nch;
+		for (j = 0; j < nch; j++) {
+			x0 = split ? audio_stream_wrap(source, x + j) : x + j;
+			y0 = split ? audio_stream_wrap(sink, y + j) : y + j;
+			for (i = 0; i < n; i += m * nch) {
+				m = MIN((n - i) / nch, VOL_RAMP_BLOCK_FRAMES);
+				vol_ramp_gains(&rs, j, vol, m);
+				if (rs.zc) {
+					for (k = 0; k < m; k++)
+						sign[k] = sign_extend_s24(x0[k * nch]);
+
+					vol_ramp_zc_hold(&rs, j, vol, sign, m);
+				}
+
+				for (k = 0; k < m; k++) {
+					*y0 = vol_mult_s24_to_s24(*x0, vol[k]);
+#if CONFIG_COMP_PEAK_VOL
+					tmp = MAX(*y0, tmp);
+#endif
+					x0 += nch;
+					y0 += nch;
+				}
+			}
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = tmp;
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+
+	vol_ramp_save(cd, &rs, nch);
+
+	/* update peak vol */
+	peak_vol_update(cd);
+}
 #endif /* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -169,6 +380,93 @@ static void vol_s32_to_s32(struct processing_module *mod, struct input_stream_bu
 	/* update peak vol */
 	peak_vol_update(cd);
 }
+
+/**
+ * \brief Volume ramp processing from 32 bit to 32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Source buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] start_volume Gain of each channel in start of the period.
+ *
+ * Copy and scale volume with per frame interpolated gain from 32 bit
+ * source buffer to 32 bit destination buffer.
+ */
+static void vol_s32_to_s32_ramp(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				const int32_t *start_volume)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	struct vol_ramp_state rs;
+	int32_t vol[VOL_RAMP_BLOCK_FRAMES];
+	int32_t sign[VOL_RAMP_BLOCK_FRAMES];
+	int32_t *x, *x0;
+	int32_t *y, *y0;
+	int nmax, n, i, j, k, m;
+	bool split;
+	const int nch = source->channels;
+	const int shift = Q_SHIFT_BITS_64(31, VOL_QXY_Y, 31);
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int32_t tmp = INT_MIN(32);
+#endif
+
+	x = source->r_ptr;
+	y = sink->w_ptr;
+
+	if (vol_ramp_init(cd, &rs, start_volume, frames, nch))
+		for (j = 0; j < nch; j++)
+			rs.prev[j] = *(int32_t *)audio_stream_wrap(source, x + j);
+
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+
+		/* process whole frames, a frame split by the wrap is done alone */
+		split = n < nch;
+		n = split ? nch : n - n % nch;
+		for (j = 0; j < nch; j++) {
+			x0 = split ? audio_stream_wrap(source, x + j) : x + j;
+			y0 = split ? audio_stream_wrap(sink, y + j) : y + j;
+			for (i = 0; i < n; i += m * nch) {
+				m = MIN((n - i) / nch, VOL_RAMP_BLOCK_FRAMES);
+				vol_ramp_gains(&rs, j, vol, m);
+				if (rs.zc) {
+					for (k = 0; k < m; k++)
+						sign[k] = x0[k * nch];
+
+					vol_ramp_zc_hold(&rs, j, vol, sign, m);
+				}
+
+				for (k = 0; k < m; k++) {
+					*y0 = q_multsr_sat_32x32(*x0, vol[k], shift);
+#if CONFIG_COMP_PEAK_VOL
+					tmp = MAX(*y0, tmp);
+#endif
+					x0 += nch;
+					y0 += nch;
+				}
+			}
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = tmp;
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+
+	vol_ramp_save(cd, &rs, nch);
+
+	/* update peak vol */
+	peak_vol_update(cd);
+}
 #endif /* CONFIG_FORMAT_S32LE */
 
 #if CONFIG_FORMAT_S16LE
@@ -233,17 +531,104 @@ static void vol_s16_to_s16(struct processing_module *mod, struct input_stream_bu
 	/* update peak vol */
 	peak_vol_update(cd);
 }
+
+/**
+ * \brief Volume ramp processing from 16 bit to 16 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Source buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] start_volume Gain of each channel in start of the period.
+ *
+ * Copy and scale volume with per frame interpolated gain from 16 bit
+ * source buffer to 16 bit destination buffer.
+ */
+static void vol_s16_to_s16_ramp(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				const int32_t *start_volume)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	struct vol_ramp_state rs;
+	int32_t vol[VOL_RAMP_BLOCK_FRAMES];
+	int32_t sign[VOL_RAMP_BLOCK_FRAMES];
+	int16_t *x, *x0;
+	int16_t *y, *y0;
+	int nmax, n, i, j, k, m;
+	bool split;
+	const int nch = source->channels;
+	const int shift = Q_SHIFT_BITS_32(15, VOL_QXY_Y, 15);
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int16_t tmp = INT_MIN(16);
+#endif
+
+	x = source->r_ptr;
+	y = sink->w_ptr;
+
+	if (vol_ramp_init(cd, &rs, start_volume, frames, nch))
+		for (j = 0; j < nch; j++)
+			rs.prev[j] = *(int16_t *)audio_stream_wrap(source, x + j);
+
+	bsource->consumed += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = VOL_BYTES_TO_S16_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = VOL_BYTES_TO_S16_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+
+		/* process whole frames, a frame split by the wrap is done alone */
+		split = n < nch;
+		n = split ? nch : n - n % nch;
+		for (j = 0; j < nch; j++) {
+			x0 = split ? audio_stream_wrap(source, x + j) : x + j;
+			y0 = split ? audio_stream_wrap(sink, y + j) : y + j;
+			for (i = 0; i < n; i += m * nch) {
+				m = MIN((n - i) / nch, VOL_RAMP_BLOCK_FRAMES);
+				vol_ramp_gains(&rs, j, vol, m);
+				if (rs.zc) {
+					for (k = 0; k < m; k++)
+						sign[k] = x0[k * nch];
+
+					vol_ramp_zc_hold(&rs, j, vol, sign, m);
+				}
+
+				for (k = 0; k < m; k++) {
+					*y0 = q_multsr_sat_32x32_16(*x0, vol[k], shift);
+#if CONFIG_COMP_PEAK_VOL
+					tmp = MAX(*y0, tmp);
+#endif
+					x0 += nch;
+					y0 += nch;
+				}
+			}
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = tmp;
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+
+	vol_ramp_save(cd, &rs, nch);
+
+	/* update peak vol */
+	peak_vol_update(cd);
+}
 #endif /* CONFIG_FORMAT_S16LE */
 
 const struct comp_func_map volume_func_map[] = {
 #if CONFIG_FORMAT_S16LE
-	{ SOF_IPC_FRAME_S16_LE, vol_s16_to_s16 },
+	{ SOF_IPC_FRAME_S16_LE, vol_s16_to_s16, vol_s16_to_s16_ramp },
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
-	{ SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24, vol_s24_to_s24_ramp },
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
-	{ SOF_IPC_FRAME_S32_LE, vol_s32_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, vol_s32_to_s32, vol_s32_to_s32_ramp },
 #endif /* CONFIG_FORMAT_S32LE */
 };
 
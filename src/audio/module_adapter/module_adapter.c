@@ -228,25 +228,33 @@ int module_adapter_prepare(struct comp_dev *dev)
 	 * generate output once started (same situation happens for compress streams
 	 * as well).
 	 */
-	if (md->mpd.in_buff_size > mod->period_bytes) {
-		buff_periods = (md->mpd.in_buff_size % mod->period_bytes) ?
-			       (md->mpd.in_buff_size / mod->period_bytes) + 2 :
-			       (md->mpd.in_buff_size / mod->period_bytes) + 1;
-	} else {
-		buff_periods = (mod->period_bytes % md->mpd.in_buff_size) ?
-			       (mod->period_bytes / md->mpd.in_buff_size) + 2 :
-			       (mod->period_bytes / md->mpd.in_buff_size) + 1;
-	}
-
 	/*
-	 * deep_buffer_bytes is a measure of how many bytes we need to send to the DAI before
-	 * the module starts producing samples. In a normal copy() walk it might be possible that
-	 * the first period_bytes copied to input_buffer might not be enough for the processing
-	 * to begin. So, in order to prevent the DAI from starving, it needs to be fed zeroes until
-	 * the module starts processing and generating output samples.
+	 * deep_buff_bytes is the level of processed data the local sink buffer has to reach
+	 * before it starts feeding the sink. Until then the sink is fed zeroes, so that the DAI
+	 * does not starve while the module gathers the input it needs to start processing.
+	 *
+	 * The local buffer works as a double buffer: the output of one process() call is drained
+	 * period by period while the module gathers the input for the next one. So it's enough
+	 * to start once the local buffer covers the periods spent gathering in_buff_size bytes
+	 * of input plus one period of headroom for the period in which process() runs, rather
+	 * than a whole extra deep buffer.
 	 */
-	if (md->mpd.in_buff_size != mod->period_bytes)
-		mod->deep_buff_bytes = MIN(mod->period_bytes, md->mpd.in_buff_size) * buff_periods;
+	if (md->mpd.in_buff_size != mod->period_bytes) {
+		struct comp_buffer *source = list_first_item(&dev->bsource_list,
+							     struct comp_buffer, sink_list);
+		uint32_t source_period_bytes = audio_stream_period_bytes(&source->stream,
+									 dev->frames);
+
+		if (source_period_bytes)
+			buff_periods = ceil_divide(md->mpd.in_buff_size, source_period_bytes);
+		else
+			buff_periods = ceil_divide(md->mpd.in_buff_size, mod->period_bytes);
+
+		mod->deep_buff_bytes = mod->period_bytes * (MAX(buff_periods, 1) + 1);
+	}
+
+	mod->deep_buff_fill_min = UINT32_MAX;
+	mod->deep_buff_fill_max = 0;
 
 	if (md->mpd.out_buff_size > mod->period_bytes) {
 		buff_periods = (md->mpd.out_buff_size % mod->period_bytes) ?
@@ -266,9 +274,12 @@ int module_adapter_prepare(struct comp_dev *dev)
 	buff_size = MAX(mod->period_bytes, md->mpd.out_buff_size) * buff_periods;
 	mod->output_buffer_size = buff_size;
 
+	/* the start threshold can't be above what the local buffer holds */
+	mod->deep_buff_bytes = MIN(mod->deep_buff_bytes, buff_size);
+
 	/* allocate memory for input buffer data */
 	list_for_item(blist, &dev->bsource_list) {
-		size_t size = MAX(mod->deep_buff_bytes, mod->period_bytes);
+		size_t size = MAX(md->mpd.in_buff_size, mod->period_bytes);
 
 		mod->input_buffers[i].data = (__sparse_force void __sparse_cache *)rballoc(0,
 									SOF_MEM_CAPS_RAM, size);
@@ -457,16 +468,12 @@ ca_copy_from_module_to_sink(const struct audio_stream __sparse_cache *sink,
  */
 static void generate_zeroes(struct comp_buffer __sparse_cache *sink, uint32_t bytes)
 {
-	uint32_t tmp, copy_bytes = bytes;
-	void *ptr;
+	bytes = MIN(bytes, audio_stream_get_free_bytes(&sink->stream));
+	if (!bytes)
+		return;
 
-	while (copy_bytes) {
-		ptr = audio_stream_wrap(&sink->stream, sink->stream.w_ptr);
-		tmp = audio_stream_bytes_without_wrap(&sink->stream, ptr);
-		tmp = MIN(tmp, copy_bytes);
-		ptr = (char *)ptr + tmp;
-		copy_bytes -= tmp;
-	}
+	audio_stream_set_zero(&sink->stream, bytes);
+	buffer_stream_writeback(sink, bytes);
 	comp_update_buffer_produce(sink, bytes);
 }
 
@@ -477,14 +484,16 @@ static void module_copy_samples(struct comp_dev *dev, struct comp_buffer __spars
 	struct comp_copy_limits cl;
 	uint32_t copy_bytes;
 
+	uint32_t avail = audio_stream_get_avail_bytes(&src_buffer->stream);
+
 	if (mod->deep_buff_bytes) {
-		if (mod->deep_buff_bytes >= audio_stream_get_avail_bytes(&src_buffer->stream)) {
+		if (avail < mod->deep_buff_bytes) {
 			generate_zeroes(sink_buffer, mod->period_bytes);
 			return;
 		}
 
-		comp_dbg(dev, "module_copy_samples(): deep buffering has ended after gathering %d bytes of processed data",
-			 audio_stream_get_avail_bytes(&src_buffer->stream));
+		comp_info(dev, "module_copy_samples(): deep buffering has ended after gathering %u bytes of processed data, threshold %u",
+			  avail, mod->deep_buff_bytes);
 		mod->deep_buff_bytes = 0;
 	} else if (!produced) {
 		comp_dbg(dev, "module_copy_samples(): nothing processed in this call");
@@ -492,10 +501,14 @@ static void module_copy_samples(struct comp_dev *dev, struct comp_buffer __spars
 		 * No data produced anything in this period but there still be data in the buffer
 		 * to copy to sink
 		 */
-		if (audio_stream_get_avail_bytes(&src_buffer->stream) < mod->period_bytes)
+		if (avail < mod->period_bytes)
 			return;
 	}
 
+	/* track the local buffer level, it's only traced on reset to check the headroom */
+	mod->deep_buff_fill_min = MIN(mod->deep_buff_fill_min, avail);
+	mod->deep_buff_fill_max = MAX(mod->deep_buff_fill_max, avail);
+
 	comp_get_copy_limits(src_buffer, sink_buffer, &cl);
 	copy_bytes = cl.frames * cl.source_frame_bytes;
 	if (!copy_bytes)
@@ -592,7 +605,7 @@ int module_adapter_copy(struct comp_dev *dev)
 	struct comp_buffer __sparse_cache *source_c = NULL, *sink_c = NULL;
 	struct comp_copy_limits c;
 	struct list_item *blist;
-	size_t size = MAX(mod->deep_buff_bytes, mod->period_bytes);
+	size_t size = MAX(md->mpd.in_buff_size, mod->period_bytes);
 	uint32_t min_free_frames = UINT_MAX;
 	int ret, i = 0;
 
@@ -856,9 +869,15 @@ int module_adapter_reset(struct comp_dev *dev)
 		comp_err(dev, "module_adapter_reset(): failed with error: %d", ret);
 	}
 
-	if (!mod->simple_copy)
+	if (!mod->simple_copy) {
+		if (mod->deep_buff_fill_max)
+			comp_info(dev, "module_adapter_reset(): local buffer fill min %u max %u size %u",
+				  mod->deep_buff_fill_min, mod->deep_buff_fill_max,
+				  mod->output_buffer_size);
+
 		for (i = 0; i < mod->num_output_buffers; i++)
 			rfree((__sparse_force void *)mod->output_buffers[i].data);
+	}
 
 	rfree(mod->output_buffers);
 
@@ -18,52 +18,46 @@ static void multiband_drc_default_pass(const struct comp_dev *dev,
 	audio_stream_copy(source, 0, sink, 0, source->channels * frames);
 }
 
+typedef void (*multiband_drc_band_func)(struct drc_state *state,
+					const struct sof_drc_params *p,
+					int32_t (*buf)[MULTIBAND_DRC_BLOCK_FRAMES],
+					int nch, int frames);
+
 static void multiband_drc_process_emp_crossover(struct multiband_drc_state *state,
 						crossover_split split_func,
-						int32_t *buf_src,
-						int32_t *buf_sink,
 						int enable_emp,
 						int nch,
-						int nband)
+						int nband,
+						int frames)
 {
-	struct iir_state_df2t *emp_s;
-	struct crossover_state *crossover_s;
-	int32_t *buf_sink_band;
+	int32_t *buf_sink_band[SOF_MULTIBAND_DRC_MAX_BANDS];
 	int ch, band;
-	int32_t emp_out;
-	int32_t crossover_out[nband];
 
 	for (ch = 0; ch < nch; ch++) {
-		emp_s = &state->emphasis[ch];
-		crossover_s = &state->crossover[ch];
-
 		if (enable_emp)
-			emp_out = iir_df2t(emp_s, *buf_src);
-		else
-			emp_out = *buf_src;
-
-		split_func(emp_out, crossover_out, crossover_s);
-		buf_sink_band = buf_sink;
-		for (band = 0; band < nband; band++) {
-			*buf_sink_band = crossover_out[band];
-			buf_sink_band += PLATFORM_MAX_CHANNELS;
-		}
+			iir_df2t_block(&state->emphasis[ch], state->buf[ch], state->buf[ch],
+				       frames);
+
+		for (band = 0; band < nband; band++)
+			buf_sink_band[band] = state->band_buf[band][ch];
 
-		buf_src++;
-		buf_sink++;
+		split_func(state->buf[ch], buf_sink_band, &state->crossover[ch], frames);
 	}
 }
 
 #if CONFIG_FORMAT_S16LE
 static void multiband_drc_s16_process_drc(struct drc_state *state,
 					  const struct sof_drc_params *p,
-					  int32_t *buf_src,
-					  int32_t *buf_sink,
-					  int nch)
+					  int32_t (*buf)[MULTIBAND_DRC_BLOCK_FRAMES],
+					  int nch,
+					  int frames)
 {
-	int16_t *pd_write;
-	int16_t *pd_read;
+	int16_t *pd_buf;
+	int32_t *band_buf;
 	int ch;
+	int i;
+	int n, w, r;
+	int offset = 0;
 	int pd_write_index;
 	int pd_read_index;
 
@@ -73,33 +67,42 @@ static void multiband_drc_s16_process_drc(struct drc_state *state,
 		state->processed = 1;
 	}
 
-	pd_write_index = state->pre_delay_write_index;
-	pd_read_index = state->pre_delay_read_index;
-
-	for (ch = 0; ch < nch; ++ch) {
-		pd_write = (int16_t *)state->pre_delay_buffers[ch] + pd_write_index;
-		pd_read = (int16_t *)state->pre_delay_buffers[ch] + pd_read_index;
-		*pd_write = sat_int16(Q_SHIFT_RND(*buf_src, 31, 15));
-		*buf_sink = *pd_read << 16;
-
-		buf_src++;
-		buf_sink++;
-	}
-
-	pd_write_index = (pd_write_index + 1) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
-	pd_read_index = (pd_read_index + 1) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
-	state->pre_delay_write_index = pd_write_index;
-	state->pre_delay_read_index = pd_read_index;
-
-	/* Only perform delay frames by early return here if not enabled */
-	if (!p->enabled)
-		return;
+	/* The delay line is run in place in the band buffers, in parts
+	 * that end at the division boundaries.
+	 */
+	while (offset < frames) {
+		pd_write_index = state->pre_delay_write_index;
+		pd_read_index = state->pre_delay_read_index;
+		n = DRC_DIVISION_FRAMES - (pd_write_index & DRC_DIVISION_FRAMES_MASK);
+		n = MIN(n, frames - offset);
+
+		for (ch = 0; ch < nch; ++ch) {
+			pd_buf = (int16_t *)state->pre_delay_buffers[ch];
+			band_buf = &buf[ch][offset];
+			for (i = 0; i < n; i++) {
+				w = (pd_write_index + i) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+				r = (pd_read_index + i) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+				pd_buf[w] = sat_int16(Q_SHIFT_RND(band_buf[i], 31, 15));
+				band_buf[i] = pd_buf[r] << 16;
+			}
+		}
 
-	/* Process the input division (32 frames). */
-	if (!(pd_write_index & DRC_DIVISION_FRAMES_MASK)) {
-		drc_update_detector_average(state, p, 2, nch);
-		drc_update_envelope(state, p);
-		drc_compress_output(state, p, 2, nch);
+		pd_write_index = (pd_write_index + n) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+		pd_read_index = (pd_read_index + n) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+		state->pre_delay_write_index = pd_write_index;
+		state->pre_delay_read_index = pd_read_index;
+		offset += n;
+
+		/* Only perform delay frames if not enabled */
+		if (!p->enabled)
+			continue;
+
+		/* Process the input division (32 frames). */
+		if (!(pd_write_index & DRC_DIVISION_FRAMES_MASK)) {
+			drc_update_detector_average(state, p, 2, nch);
+			drc_update_envelope(state, p);
+			drc_compress_output(state, p, 2, nch);
+		}
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -107,13 +110,17 @@ static void multiband_drc_s16_process_drc(struct drc_state *state,
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 static void multiband_drc_s32_process_drc(struct drc_state *state,
 					  const struct sof_drc_params *p,
-					  int32_t *buf_src,
-					  int32_t *buf_sink,
-					  int nch)
+					  int32_t (*buf)[MULTIBAND_DRC_BLOCK_FRAMES],
+					  int nch,
+					  int frames)
 {
-	int32_t *pd_write;
-	int32_t *pd_read;
+	int32_t *pd_buf;
+	int32_t *band_buf;
+	int32_t tmp;
 	int ch;
+	int i;
+	int n, w, r;
+	int offset = 0;
 	int pd_write_index;
 	int pd_read_index;
 
@@ -123,73 +130,78 @@ static void multiband_drc_s32_process_drc(struct drc_state *state,
 		state->processed = 1;
 	}
 
-	pd_write_index = state->pre_delay_write_index;
-	pd_read_index = state->pre_delay_read_index;
-
-	for (ch = 0; ch < nch; ++ch) {
-		pd_write = (int32_t *)state->pre_delay_buffers[ch] + pd_write_index;
-		pd_read = (int32_t *)state->pre_delay_buffers[ch] + pd_read_index;
-		*pd_write = *buf_src;
-		*buf_sink = *pd_read;
-
-		buf_src++;
-		buf_sink++;
-	}
-
-	pd_write_index = (pd_write_index + 1) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
-	pd_read_index = (pd_read_index + 1) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
-	state->pre_delay_write_index = pd_write_index;
-	state->pre_delay_read_index = pd_read_index;
-
-	/* Only perform delay frames by early return here if not enabled */
-	if (!p->enabled)
-		return;
+	/* The delay line is run in place in the band buffers, in parts
+	 * that end at the division boundaries.
+	 */
+	while (offset < frames) {
+		pd_write_index = state->pre_delay_write_index;
+		pd_read_index = state->pre_delay_read_index;
+		n = DRC_DIVISION_FRAMES - (pd_write_index & DRC_DIVISION_FRAMES_MASK);
+		n = MIN(n, frames - offset);
+
+		for (ch = 0; ch < nch; ++ch) {
+			pd_buf = (int32_t *)state->pre_delay_buffers[ch];
+			band_buf = &buf[ch][offset];
+			for (i = 0; i < n; i++) {
+				w = (pd_write_index + i) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+				r = (pd_read_index + i) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+				tmp = band_buf[i];
+				band_buf[i] = pd_buf[r];
+				pd_buf[w] = tmp;
+			}
+		}
 
-	/* Process the input division (32 frames). */
-	if (!(pd_write_index & DRC_DIVISION_FRAMES_MASK)) {
-		drc_update_detector_average(state, p, 4, nch);
-		drc_update_envelope(state, p);
-		drc_compress_output(state, p, 4, nch);
+		pd_write_index = (pd_write_index + n) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+		pd_read_index = (pd_read_index + n) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+		state->pre_delay_write_index = pd_write_index;
+		state->pre_delay_read_index = pd_read_index;
+		offset += n;
+
+		/* Only perform delay frames if not enabled */
+		if (!p->enabled)
+			continue;
+
+		/* Process the input division (32 frames). */
+		if (!(pd_write_index & DRC_DIVISION_FRAMES_MASK)) {
+			drc_update_detector_average(state, p, 4, nch);
+			drc_update_envelope(state, p);
+			drc_compress_output(state, p, 4, nch);
+		}
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
 static void multiband_drc_process_deemp(struct multiband_drc_state *state,
-					int32_t *buf_src,
-					int32_t *buf_sink,
 					int enable_deemp,
 					int nch,
-					int nband)
+					int nband,
+					int frames)
 {
 	struct iir_state_df2t *deemp_s;
-	int32_t *buf_src_band;
-	int ch, band;
-	int32_t mix_out;
+	int32_t *buf_sink;
+	int ch, band, i;
 
 	for (ch = 0; ch < nch; ch++) {
 		deemp_s = &state->deemphasis[ch];
+		buf_sink = state->buf[ch];
 
-		buf_src_band = buf_src;
-		mix_out = 0;
-		for (band = 0; band < nband; band++) {
-			mix_out = sat_int32((int64_t)mix_out + *buf_src_band);
-			buf_src_band += PLATFORM_MAX_CHANNELS;
-		}
+		for (i = 0; i < frames; i++)
+			buf_sink[i] = state->band_buf[0][ch][i];
 
-		if (enable_deemp)
-			*buf_sink = iir_df2t(deemp_s, mix_out);
-		else
-			*buf_sink = mix_out;
+		for (band = 1; band < nband; band++)
+			for (i = 0; i < frames; i++)
+				buf_sink[i] = sat_int32((int64_t)buf_sink[i] +
+							state->band_buf[band][ch][i]);
 
-		buf_src++;
-		buf_sink++;
+		if (enable_deemp)
+			iir_df2t_block(deemp_s, buf_sink, buf_sink, frames);
 	}
 }
 
- /* This graph illustrates the buffers declared in the following default functions, as the example
-  * of a 3-band Multiband DRC:
+ /* This graph illustrates the buffers used by the block processing, as the example of a
+  * 3-band Multiband DRC:
   *
-  *            :buf_src[nch]                            :buf_drc_sink[nch*nband]
+  *            :buf[nch][]                              :band_buf[nband][nch][]
   *            :                                        :
   *            :                           o-[]-> DRC0 -[]--o
   *            :                           | :          :   |
@@ -199,8 +211,32 @@ static void multiband_drc_process_deemp(struct multiband_drc_state *state,
   *                                        | :          :   |               :
   *                                        o-[]-> DRC2 -[]--o               :
   *                                          :                              :
-  *                                          :buf_drc_src[nch*nband]        :buf_sink[nch]
+  *                                          :band_buf[nband][nch][]        :buf[nch][]
+  *
+  * A block of up to MULTIBAND_DRC_BLOCK_FRAMES frames is de-interleaved to buf, then every
+  * stage processes the whole block per channel or per band before the next stage runs. The
+  * DRC of each band keeps its delay line and division timing, so the output is the same as
+  * with frame by frame processing.
   */
+static void multiband_drc_process_block(struct multiband_drc_comp_data *cd,
+					multiband_drc_band_func drc_func,
+					int nch, int frames)
+{
+	struct multiband_drc_state *state = &cd->state;
+	int nband = cd->config->num_bands;
+	int enable_emp_deemp = cd->config->enable_emp_deemp;
+	int band;
+
+	multiband_drc_process_emp_crossover(state, cd->crossover_split, enable_emp_deemp,
+					    nch, nband, frames);
+
+	for (band = 0; band < nband; ++band)
+		drc_func(&state->drc[band], &cd->config->drc_coef[band], state->band_buf[band],
+			 nch, frames);
+
+	multiband_drc_process_deemp(state, enable_emp_deemp, nch, nband, frames);
+}
+
 #if CONFIG_FORMAT_S16LE
 static void multiband_drc_s16_default(const struct comp_dev *dev,
 				      const struct audio_stream __sparse_cache *source,
@@ -209,22 +245,13 @@ static void multiband_drc_s16_default(const struct comp_dev *dev,
 {
 	struct multiband_drc_comp_data *cd = comp_get_drvdata(dev);
 	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
 	int16_t *x = source->r_ptr;
 	int16_t *y = sink->w_ptr;
-	int band;
 	int nbuf;
 	int npcm;
 	int ch;
-	int i;
+	int i, j, n;
 	int nch = source->channels;
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -232,33 +259,22 @@ static void multiband_drc_s16_default(const struct comp_dev *dev,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s16(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x << 16;
-				x++;
+		for (i = 0; i < npcm; i += n * nch) {
+			n = MIN((npcm - i) / nch, MULTIBAND_DRC_BLOCK_FRAMES);
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					state->buf[ch][j] = *x << 16;
+					x++;
+				}
 			}
 
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s16_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
-			}
-
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
+			multiband_drc_process_block(cd, multiband_drc_s16_process_drc, nch, n);
 
-			for (ch = 0; ch < nch; ch++) {
-				*y = sat_int16(Q_SHIFT_RND(buf_sink[ch], 31, 15));
-				y++;
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y = sat_int16(Q_SHIFT_RND(state->buf[ch][j], 31, 15));
+					y++;
+				}
 			}
 		}
 		samples -= npcm;
@@ -276,22 +292,13 @@ static void multiband_drc_s24_default(const struct comp_dev *dev,
 {
 	struct multiband_drc_comp_data *cd = comp_get_drvdata(dev);
 	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
 	int32_t *x = source->r_ptr;
 	int32_t *y = sink->w_ptr;
-	int band;
 	int nbuf;
 	int npcm;
 	int ch;
-	int i;
+	int i, j, n;
 	int nch = source->channels;
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -299,33 +306,22 @@ static void multiband_drc_s24_default(const struct comp_dev *dev,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s24(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x << 8;
-				x++;
-			}
-
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s32_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+		for (i = 0; i < npcm; i += n * nch) {
+			n = MIN((npcm - i) / nch, MULTIBAND_DRC_BLOCK_FRAMES);
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					state->buf[ch][j] = *x << 8;
+					x++;
+				}
 			}
 
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
+			multiband_drc_process_block(cd, multiband_drc_s32_process_drc, nch, n);
 
-			for (ch = 0; ch < nch; ch++) {
-				*y = sat_int24(Q_SHIFT_RND(buf_sink[ch], 31, 23));
-				y++;
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y = sat_int24(Q_SHIFT_RND(state->buf[ch][j], 31, 23));
+					y++;
+				}
 			}
 		}
 		samples -= npcm;
@@ -343,22 +339,13 @@ static void multiband_drc_s32_default(const struct comp_dev *dev,
 {
 	struct multiband_drc_comp_data *cd = comp_get_drvdata(dev);
 	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
 	int32_t *x = source->r_ptr;
 	int32_t *y = sink->w_ptr;
-	int band;
 	int nbuf;
 	int npcm;
 	int ch;
-	int i;
+	int i, j, n;
 	int nch = source->channels;
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -366,33 +353,22 @@ static void multiband_drc_s32_default(const struct comp_dev *dev,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s32(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x;
-				x++;
-			}
-
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s32_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+		for (i = 0; i < npcm; i += n * nch) {
+			n = MIN((npcm - i) / nch, MULTIBAND_DRC_BLOCK_FRAMES);
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					state->buf[ch][j] = *x;
+					x++;
+				}
 			}
 
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
+			multiband_drc_process_block(cd, multiband_drc_s32_process_drc, nch, n);
 
-			for (ch = 0; ch < nch; ch++) {
-				*y = buf_sink[ch];
-				y++;
+			for (j = 0; j < n; j++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y = state->buf[ch][j];
+					y++;
+				}
 			}
 		}
 		samples -= npcm;
@@ -10,9 +10,11 @@
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
 #include <sof/audio/mux.h>
+#include <sof/debug/panic.h>
 #include <rtos/bit.h>
 #include <sof/common.h>
 #include <ipc/stream.h>
+#include <rtos/string.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -50,6 +52,47 @@ static void demux_check_for_wrap(struct audio_stream __sparse_cache *sink,
 	}
 }
 
+/* Consecutive elements copying consecutive channels of a stream to
+ * consecutive channels of the sink form a run, that is copied as a block
+ * of samples per frame. The run lengths are found once per call and the
+ * elements of a run keep their pointers in sync.
+ */
+static uint32_t mux_look_up_runs(const struct mux_look_up *lookup, uint32_t *runs)
+{
+	const struct mux_copy_elem *first;
+	uint32_t num_runs = 0;
+	uint32_t elem = 0;
+	uint32_t len;
+
+	while (elem < lookup->num_elems) {
+		first = &lookup->copy_elem[elem];
+		len = 1;
+		while (elem + len < lookup->num_elems &&
+		       first[len].stream_id == first->stream_id &&
+		       first[len].in_ch == first->in_ch + len &&
+		       first[len].out_ch == first->out_ch + len)
+			len++;
+
+		runs[num_runs++] = len;
+		elem += len;
+	}
+
+	return num_runs;
+}
+
+static void mux_look_up_advance(struct mux_copy_elem *elem, uint32_t len,
+				uint32_t samples, size_t sample_bytes)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		elem[i].src = (uint8_t *)elem[i].src +
+			samples * elem[i].src_inc * sample_bytes;
+		elem[i].dest = (uint8_t *)elem[i].dest +
+			samples * elem[i].dest_inc * sample_bytes;
+	}
+}
+
 #if CONFIG_FORMAT_S16LE
 
 static uint32_t demux_calc_frames_without_wrap_s16(struct comp_dev *dev,
@@ -153,6 +196,41 @@ static void demux_init_look_up_pointers_s16(struct comp_dev *dev,
 	}
 }
 
+/* copy frames of a run of len channels, whole frames are contiguous */
+static void mux_copy_run_s16(struct mux_copy_elem *elem, uint32_t len,
+			     uint32_t frames)
+{
+	const int16_t *src = elem->src;
+	int16_t *dst = elem->dest;
+	const uint32_t src_inc = elem->src_inc;
+	const uint32_t dest_inc = elem->dest_inc;
+	size_t bytes;
+	uint32_t i, j;
+	int ret;
+
+	if (len == src_inc && len == dest_inc) {
+		bytes = frames * len * sizeof(*dst);
+		ret = memcpy_s(dst, bytes, src, bytes);
+		assert(!ret);
+	} else if (len == 1) {
+		for (i = 0; i < frames; i++) {
+			*dst = *src;
+			src += src_inc;
+			dst += dest_inc;
+		}
+	} else {
+		for (i = 0; i < frames; i++) {
+			for (j = 0; j < len; j++)
+				dst[j] = src[j];
+
+			src += src_inc;
+			dst += dest_inc;
+		}
+	}
+
+	mux_look_up_advance(elem, len, frames, sizeof(*dst));
+}
+
 /**
  * Source stream are routed to sinks with regard to look up table based on
  * routing bitmasks from mux_stream_data structures array. Each sink channel
@@ -169,9 +247,9 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 			const struct audio_stream __sparse_cache *source, uint32_t frames,
 			struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int16_t *src;
-	int16_t *dst;
+	uint32_t runs[PLATFORM_MAX_CHANNELS];
+	uint32_t num_runs;
+	uint32_t run;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
@@ -181,6 +259,7 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 		return;
 
 	demux_init_look_up_pointers_s16(dev, sink, source, lookup);
+	num_runs = mux_look_up_runs(lookup, runs);
 
 	while (frames) {
 		frames_without_wrap =
@@ -189,17 +268,9 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 
 		frames_without_wrap = MIN(frames, frames_without_wrap);
 
-		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int16_t *)lookup->copy_elem[elem].src;
-				dst = (int16_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
-		}
+		for (elem = 0, run = 0; run < num_runs; elem += runs[run++])
+			mux_copy_run_s16(&lookup->copy_elem[elem], runs[run],
+					 frames_without_wrap);
 
 		demux_check_for_wrap(sink, source, lookup);
 
@@ -223,9 +294,9 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		      const struct audio_stream __sparse_cache **sources, uint32_t frames,
 		      struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int16_t *src;
-	int16_t *dst;
+	uint32_t runs[PLATFORM_MAX_CHANNELS];
+	uint32_t num_runs;
+	uint32_t run;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
@@ -235,6 +306,7 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		return;
 
 	mux_init_look_up_pointers_s16(dev, sink, sources, lookup);
+	num_runs = mux_look_up_runs(lookup, runs);
 
 	while (frames) {
 		frames_without_wrap =
@@ -243,17 +315,9 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 
 		frames_without_wrap = MIN(frames, frames_without_wrap);
 
-		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int16_t *)lookup->copy_elem[elem].src;
-				dst = (int16_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
-		}
+		for (elem = 0, run = 0; run < num_runs; elem += runs[run++])
+			mux_copy_run_s16(&lookup->copy_elem[elem], runs[run],
+					 frames_without_wrap);
 
 		mux_check_for_wrap(sink, sources, lookup);
 
@@ -365,6 +429,41 @@ static void demux_init_look_up_pointers_s32(struct comp_dev *dev,
 	}
 }
 
+/* copy frames of a run of len channels, whole frames are contiguous */
+static void mux_copy_run_s32(struct mux_copy_elem *elem, uint32_t len,
+			     uint32_t frames)
+{
+	const int32_t *src = elem->src;
+	int32_t *dst = elem->dest;
+	const uint32_t src_inc = elem->src_inc;
+	const uint32_t dest_inc = elem->dest_inc;
+	size_t bytes;
+	uint32_t i, j;
+	int ret;
+
+	if (len == src_inc && len == dest_inc) {
+		bytes = frames * len * sizeof(*dst);
+		ret = memcpy_s(dst, bytes, src, bytes);
+		assert(!ret);
+	} else if (len == 1) {
+		for (i = 0; i < frames; i++) {
+			*dst = *src;
+			src += src_inc;
+			dst += dest_inc;
+		}
+	} else {
+		for (i = 0; i < frames; i++) {
+			for (j = 0; j < len; j++)
+				dst[j] = src[j];
+
+			src += src_inc;
+			dst += dest_inc;
+		}
+	}
+
+	mux_look_up_advance(elem, len, frames, sizeof(*dst));
+}
+
 /**
  * Source stream are routed to sinks with regard to look up table based on
  * routing bitmasks from mux_stream_data structures array. Each sink channel
@@ -381,9 +480,9 @@ static void demux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache
 			const struct audio_stream __sparse_cache *source, uint32_t frames,
 			struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int32_t *src;
-	int32_t *dst;
+	uint32_t runs[PLATFORM_MAX_CHANNELS];
+	uint32_t num_runs;
+	uint32_t run;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
@@ -393,6 +492,7 @@ static void demux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache
 		return;
 
 	demux_init_look_up_pointers_s32(dev, sink, source, lookup);
+	num_runs = mux_look_up_runs(lookup, runs);
 
 	while (frames) {
 		frames_without_wrap =
@@ -401,17 +501,9 @@ static void demux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache
 
 		frames_without_wrap = MIN(frames, frames_without_wrap);
 
-		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int32_t *)lookup->copy_elem[elem].src;
-				dst = (int32_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
-		}
+		for (elem = 0, run = 0; run < num_runs; elem += runs[run++])
+			mux_copy_run_s32(&lookup->copy_elem[elem], runs[run],
+					 frames_without_wrap);
 
 		demux_check_for_wrap(sink, source, lookup);
 
@@ -435,9 +527,9 @@ static void mux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		      const struct audio_stream __sparse_cache **sources, uint32_t frames,
 		      struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int32_t *src;
-	int32_t *dst;
+	uint32_t runs[PLATFORM_MAX_CHANNELS];
+	uint32_t num_runs;
+	uint32_t run;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
@@ -447,6 +539,7 @@ static void mux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		return;
 
 	mux_init_look_up_pointers_s32(dev, sink, sources, lookup);
+	num_runs = mux_look_up_runs(lookup, runs);
 
 	while (frames) {
 		frames_without_wrap =
@@ -455,17 +548,9 @@ static void mux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 
 		frames_without_wrap = MIN(frames, frames_without_wrap);
 
-		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int32_t *)lookup->copy_elem[elem].src;
-				dst = (int32_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
-		}
+		for (elem = 0, run = 0; run < num_runs; elem += runs[run++])
+			mux_copy_run_s32(&lookup->copy_elem[elem], runs[run],
+					 frames_without_wrap);
 
 		mux_check_for_wrap(sink, sources, lookup);
 
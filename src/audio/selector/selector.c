@@ -408,6 +408,15 @@ static int selector_copy(struct comp_dev *dev)
 
 	sink_c = buffer_acquire(sink);
 
+	/* forward the source data to the aliased sink without copying */
+	if (cd->alias) {
+		sink_bytes = buffer_alias_forward(source_c, sink_c);
+		comp_dbg(dev, "selector_copy(), forwarded 0x%x", sink_bytes);
+		buffer_release(sink_c);
+		buffer_release(source_c);
+		return 0;
+	}
+
 	frames = audio_stream_avail_frames(&source_c->stream, &sink_c->stream);
 	source_bytes = frames * audio_stream_frame_bytes(&source_c->stream);
 	sink_bytes = frames * audio_stream_frame_bytes(&sink_c->stream);
@@ -480,6 +489,20 @@ static int selector_prepare(struct comp_dev *dev)
 
 	sink_size = sink_c->stream.size;
 
+	/* When all the channels are passed through the sink buffer can use
+	 * the source buffer data. The source buffer needs to have space for
+	 * the next period while the consumer has not read the previous one.
+	 */
+	buffer_alias_clear(sink_c);
+	cd->alias = false;
+	if (cd->config.out_channels_count > 1 &&
+	    cd->source_format == cd->sink_format &&
+	    source_c->stream.channels == sink_c->stream.channels &&
+	    source_c->stream.size >= 2 * cd->source_period_bytes)
+		cd->alias = !buffer_alias(sink_c, source_c);
+
+	comp_info(dev, "selector_prepare(): alias = %u", cd->alias);
+
 	buffer_release(sink_c);
 	buffer_release(source_c);
 
@@ -530,9 +553,20 @@ static int selector_reset(struct comp_dev *dev)
 {
 	int ret;
 	struct comp_data *cd = comp_get_drvdata(dev);
+	struct comp_buffer *sinkb;
+	struct comp_buffer __sparse_cache *sink_c;
 
 	comp_info(dev, "selector_reset()");
 
+	if (cd->alias) {
+		sinkb = list_first_item(&dev->bsink_list, struct comp_buffer,
+					source_list);
+		sink_c = buffer_acquire(sinkb);
+		buffer_alias_clear(sink_c);
+		buffer_release(sink_c);
+		cd->alias = false;
+	}
+
 	cd->source_period_bytes = 0;
 	cd->sink_period_bytes = 0;
 	cd->sel_func = NULL;
@@ -18,6 +18,7 @@
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <sof/math/trig.h>
 #include <sof/platform.h>
 #include <rtos/string.h>
@@ -79,6 +80,7 @@ struct tone_state {
 	int32_t ramp_step; /* Amplitude ramp step Q1.31 */
 	int32_t w; /* Angle radians Q4.28 */
 	int32_t w_step; /* Angle step Q4.28 */
+	struct cordic_cmpx rot; /* Rotation by w_step cos + j*sin Q2.30 */
 	uint32_t block_count;
 	uint32_t repeat_count;
 	uint32_t repeats; /* Number of repeats for tone (sweep steps) */
@@ -98,7 +100,7 @@ struct comp_data {
 			  uint32_t frames);
 };
 
-static int32_t tonegen(struct tone_state *sg);
+static void tonegen(struct tone_state *sg, int32_t *dest, int stride, int n);
 static void tonegen_control(struct tone_state *sg);
 static void tonegen_update_f(struct tone_state *sg, int32_t f);
 
@@ -112,6 +114,7 @@ static inline void tone_circ_inc_wrap(int32_t **ptr, int32_t *end, size_t size)
 		*ptr = (int32_t *)((size_t)*ptr - size);
 }
 
+/* The channels are generated one at a time up to the buffer wrap */
 static void tone_s32_default(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 			     uint32_t frames)
 {
@@ -123,43 +126,77 @@ static void tone_s32_default(struct comp_dev *dev, struct audio_stream __sparse_
 	int n_min;
 	int nch = cd->channels;
 
-	n = frames * nch;
+	n = frames;
 	while (n > 0) {
-		n_wrap_dest = (int32_t *)sink->end_addr - dest;
+		n_wrap_dest = ((int32_t *)sink->end_addr - dest) / nch;
 		n_min = (n < n_wrap_dest) ? n : n_wrap_dest;
 		/* Process until wrap or completed n */
-		while (n_min > 0) {
-			n -= nch;
-			n_min -= nch;
-			for (i = 0; i < nch; i++) {
-				tonegen_control(&cd->sg[i]);
-				*dest = tonegen(&cd->sg[i]);
-				dest++;
-			}
-		}
+		for (i = 0; i < nch; i++)
+			tonegen(&cd->sg[i], dest + i, nch, n_min);
+
+		n -= n_min;
+		dest += n_min * nch;
 		tone_circ_inc_wrap(&dest, sink->end_addr, sink->size);
 	}
 }
 
-static int32_t tonegen(struct tone_state *sg)
+/* Generate n samples of the tone with constant amplitude. The sine is
+ * computed with CORDIC only for the first sample and the rest come from
+ * rotating the quadrature oscillator by w_step. The oscillator is
+ * seeded again from the phase for every call, so the rounding errors of
+ * the recursion do not accumulate over more than one 125 us block.
+ */
+static void tonegen_run(struct tone_state *sg, int32_t *dest, int stride, int n)
 {
-	int64_t sine;
+	struct cordic_cmpx osc;
 	int64_t w;
-	/* sg->w is angle in Q4.28 radians format, sin() returns Q1.31 */
-	/* sg->a is amplitude as Q1.31 */
-	sine =
-		q_mults_32x32(sin_fixed_32b(sg->w), sg->a,
-			      Q_SHIFT_BITS_64(31, 31, 31));
-
-	/* Next point */
-	w = (int64_t)sg->w + sg->w_step;
-	sg->w = (w > PI_MUL2_Q4_28)
-		? (int32_t)(w - PI_MUL2_Q4_28) : (int32_t)w;
-
-	if (sg->mute)
-		return 0;
-	else
-		return (int32_t)sine; /* Q1.31 no saturation need */
+	int32_t re;
+	int i;
+
+	if (sg->mute) {
+		for (i = 0; i < n; i++) {
+			*dest = 0;
+			dest += stride;
+		}
+	} else {
+		/* osc is cos + j*sin of the angle Q2.30, sg->a is amplitude as Q1.31 */
+		cmpx_exp_32b(sg->w, &osc);
+		for (i = 0; i < n; i++) {
+			*dest = sat_int32(q_mults_32x32(osc.im, sg->a,
+							Q_SHIFT_BITS_64(30, 31, 31)));
+			dest += stride;
+
+			/* Next point */
+			re = (int32_t)Q_SHIFT_RND((int64_t)osc.re * sg->rot.re -
+						  (int64_t)osc.im * sg->rot.im, 60, 30);
+			osc.im = (int32_t)Q_SHIFT_RND((int64_t)osc.im * sg->rot.re +
+						      (int64_t)osc.re * sg->rot.im, 60, 30);
+			osc.re = re;
+		}
+	}
+
+	/* Phase of the next point, kept in 0 .. 2*pi */
+	w = ((int64_t)sg->w + (int64_t)sg->w_step * n) % PI_MUL2_Q4_28;
+	sg->w = (int32_t)w;
+}
+
+/* Generate n samples to dest with stride. The control is updated at the
+ * start of every 125 us block and the samples until the next update are
+ * generated in one run.
+ */
+static void tonegen(struct tone_state *sg, int32_t *dest, int stride, int n)
+{
+	int run;
+
+	while (n > 0) {
+		tonegen_control(sg);
+		run = (int)sg->samples_in_block - (int)sg->sample_count;
+		run = MAX(MIN(run, n), 1);
+		sg->sample_count += run - 1;
+		tonegen_run(sg, dest, stride, run);
+		dest += run * stride;
+		n -= run;
+	}
 }
 
 static void tonegen_control(struct tone_state *sg)
@@ -309,6 +346,7 @@ static void tonegen_update_f(struct tone_state *sg, int32_t f)
 	w_tmp = q_multsr_32x32(sg->f, sg->c, Q_SHIFT_BITS_64(16, 31, 28));
 	w_tmp = (w_tmp > PI_Q4_28) ? PI_Q4_28 : w_tmp; /* Limit to pi Q4.28 */
 	sg->w_step = (int32_t)w_tmp;
+	cmpx_exp_32b(sg->w_step, &sg->rot);
 }
 
 static void tonegen_reset(struct tone_state *sg)
@@ -320,6 +358,8 @@ static void tonegen_reset(struct tone_state *sg)
 	sg->f = TONE_FREQUENCY_DEFAULT;
 	sg->w = 0;
 	sg->w_step = 0;
+	sg->rot.re = ONE_Q2_30;
+	sg->rot.im = 0;
 
 	sg->block_count = 0;
 	sg->repeat_count = 0;
@@ -357,6 +397,8 @@ static int tonegen_init(struct tone_state *sg, int32_t fs, int32_t f, int32_t a)
 
 	if (idx < 0) {
 		sg->w_step = 0;
+		sg->rot.re = ONE_Q2_30;
+		sg->rot.im = 0;
 		return -EINVAL;
 	}
 
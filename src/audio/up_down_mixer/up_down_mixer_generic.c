@@ -0,0 +1,981 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/up_down_mixer/up_down_mixer.h>
+
+#if UP_DOWN_MIXER_GENERIC
+
+#include <sof/audio/format.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The helpers below reproduce the HiFi3 fractional operations used by the
+ * optimized version, so both versions produce bit exact output.
+ */
+
+/* Q1.31 x Q1.31 -> Q1.63 multiply with saturation, as AE_MULF32S */
+static inline int64_t udm_mulf32(int32_t x, int32_t y)
+{
+	if (x == INT32_MIN && y == INT32_MIN)
+		return INT64_MAX;
+
+	return ((int64_t)x * y) * 2;
+}
+
+/* 64 bit saturating addition, as accumulation of AE_MULAF32S */
+static inline int64_t udm_add_sat64(int64_t acc, int64_t x)
+{
+	uint64_t sum = (uint64_t)acc + (uint64_t)x;
+
+	/* overflow only when both operands have the sign other than the sum */
+	if ((int64_t)((acc ^ sum) & (x ^ sum)) < 0)
+		return acc < 0 ? INT64_MIN : INT64_MAX;
+
+	return (int64_t)sum;
+}
+
+static inline int64_t udm_mulaf32(int64_t acc, int32_t x, int32_t y)
+{
+	return udm_add_sat64(acc, udm_mulf32(x, y));
+}
+
+/* Q1.63 to Q1.31 with symmetric rounding and saturation, as AE_ROUND32F64SSYM */
+static inline int32_t udm_round32f64(int64_t x)
+{
+	uint64_t mag = x < 0 ? -(uint64_t)x : (uint64_t)x;
+
+	mag = (mag + (1ULL << 31)) >> 32;
+	if (x < 0)
+		return mag > (1ULL << 31) ? INT32_MIN : -(int64_t)mag;
+
+	return mag > INT32_MAX ? INT32_MAX : (int32_t)mag;
+}
+
+/* Q1.15 x Q1.15 -> Q1.31 multiply with saturation, as AE_MULF16SS */
+static inline int32_t udm_mulf16(int16_t x, int16_t y)
+{
+	if (x == INT16_MIN && y == INT16_MIN)
+		return INT32_MAX;
+
+	return ((int32_t)x * y) * 2;
+}
+
+/* Q1.31 to Q1.15 with symmetric rounding and saturation, as AE_ROUND16X4F32SSYM */
+static inline int16_t udm_round16f32(int32_t x)
+{
+	int64_t mag = x < 0 ? -(int64_t)x : x;
+
+	mag = (mag + (1 << 15)) >> 16;
+	if (x < 0)
+		return mag > 32768 ? INT16_MIN : (int16_t)-mag;
+
+	return mag > INT16_MAX ? INT16_MAX : (int16_t)mag;
+}
+
+/* 16 bit sample loaded to 24 bits in 32 bit container, as AE_L16M */
+static inline int32_t udm_load16m(const int16_t *x)
+{
+	return (int32_t)*x * (1 << 8);
+}
+
+/* Pointer to a channel in the first frame of interleaved 32 bit data */
+static inline int32_t *udm_channel32(const uint8_t *data, channel_map map,
+				     enum ipc4_channel_index channel)
+{
+	return (int32_t *)(data + (get_channel_location(map, channel) << 2));
+}
+
+/* Pointer to a channel in the first frame of interleaved 16 bit data */
+static inline int16_t *udm_channel16(const uint8_t *data, channel_map map,
+				     enum ipc4_channel_index channel)
+{
+	return (int16_t *)(data + (get_channel_location(map, channel) << 1));
+}
+
+void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_left_surround = udm_channel32(out_data, out_channel_map,
+						      CHANNEL_LEFT_SURROUND);
+	int32_t *output_right_surround = udm_channel32(out_data, out_channel_map,
+						       CHANNEL_RIGHT_SURROUND);
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 2); ++i) {
+		output_left[i * 6] = in_ptr[i];
+		output_right[i * 6] = in_ptr[i];
+		output_center[i * 6] = 0;
+		output_left_surround[i * 6] = in_ptr[i];
+		output_right_surround[i * 6] = in_ptr[i];
+		output_lfe[i * 6] = 0;
+	}
+}
+
+void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_left_surround = udm_channel32(out_data, out_channel_map,
+						      CHANNEL_LEFT_SURROUND);
+	int32_t *output_right_surround = udm_channel32(out_data, out_channel_map,
+						       CHANNEL_RIGHT_SURROUND);
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int16_t *in_ptr = (const int16_t *)in_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 1); ++i) {
+		int32_t sample = (int32_t)in_ptr[i] << 16;
+
+		output_left[i * 6] = sample;
+		output_right[i * 6] = sample;
+		output_center[i * 6] = 0;
+		output_left_surround[i * 6] = sample;
+		output_right_surround[i * 6] = sample;
+		output_lfe[i * 6] = 0;
+	}
+}
+
+/* Output surround slots of 5.1, falling back to the side channels of 5.1 Surround */
+static void get_surround_slots(channel_map map, uint8_t *left_surround_slot,
+			       uint8_t *right_surround_slot)
+{
+	*left_surround_slot = get_channel_location(map, CHANNEL_LEFT_SURROUND);
+	*right_surround_slot = get_channel_location(map, CHANNEL_RIGHT_SURROUND);
+
+	if (*left_surround_slot == CHANNEL_INVALID && *right_surround_slot == CHANNEL_INVALID) {
+		*left_surround_slot = get_channel_location(map, CHANNEL_LEFT_SIDE);
+		*right_surround_slot = get_channel_location(map, CHANNEL_RIGHT_SIDE);
+	}
+}
+
+void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	uint8_t left_surround_slot;
+	uint8_t right_surround_slot;
+	uint32_t i;
+
+	get_surround_slots(out_channel_map, &left_surround_slot, &right_surround_slot);
+
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_left_surround = (int32_t *)(out_data + (left_surround_slot << 2));
+	int32_t *output_right_surround = (int32_t *)(out_data + (right_surround_slot << 2));
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+
+	for (i = 0; i < (in_size >> 3); ++i) {
+		output_left[i * 6] = in_ptr[i * 2];
+		output_right[i * 6] = in_ptr[i * 2 + 1];
+		output_center[i * 6] = 0;
+		output_left_surround[i * 6] = in_ptr[i * 2];
+		output_right_surround[i * 6] = in_ptr[i * 2 + 1];
+		output_lfe[i * 6] = 0;
+	}
+}
+
+void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	uint8_t left_surround_slot;
+	uint8_t right_surround_slot;
+	uint32_t i;
+
+	get_surround_slots(out_channel_map, &left_surround_slot, &right_surround_slot);
+
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_left_surround = (int32_t *)(out_data + (left_surround_slot << 2));
+	int32_t *output_right_surround = (int32_t *)(out_data + (right_surround_slot << 2));
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int16_t *in_ptr = (const int16_t *)in_data;
+
+	for (i = 0; i < (in_size >> 2); ++i) {
+		int32_t left = (int32_t)in_ptr[i * 2] << 16;
+		int32_t right = (int32_t)in_ptr[i * 2 + 1] << 16;
+
+		output_left[i * 6] = left;
+		output_right[i * 6] = right;
+		output_center[i * 6] = 0;
+		output_left_surround[i * 6] = left;
+		output_right_surround[i * 6] = right;
+		output_lfe[i * 6] = 0;
+	}
+}
+
+void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_left_surround = udm_channel32(out_data, out_channel_map,
+						      CHANNEL_LEFT_SURROUND);
+	int32_t *output_right_surround = udm_channel32(out_data, out_channel_map,
+						       CHANNEL_RIGHT_SURROUND);
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	int32_t *output_left_side = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT_SIDE);
+	int32_t *output_right_side = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT_SIDE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 3); ++i) {
+		output_left[i * 8] = in_ptr[i * 2];
+		output_right[i * 8] = in_ptr[i * 2 + 1];
+		output_center[i * 8] = 0;
+		output_left_surround[i * 8] = in_ptr[i * 2];
+		output_right_surround[i * 8] = in_ptr[i * 2 + 1];
+		output_lfe[i * 8] = 0;
+		output_left_side[i * 8] = 0;
+		output_right_side[i * 8] = 0;
+	}
+}
+
+/* The HiFi3 version copies through 24 bit registers, the 8 LSB are cleared */
+void shiftcopy32bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t *in_ptr = (const int32_t *)in_data;
+	int32_t *out_ptr = (int32_t *)out_data;
+	size_t i;
+
+	for (i = 0; i < (in_size >> 2); ++i) {
+		out_ptr[i * 2] = in_ptr[i] & 0xffffff00;
+		out_ptr[i * 2 + 1] = in_ptr[i] & 0xffffff00;
+	}
+}
+
+void shiftcopy32bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t *in_ptr = (const int32_t *)in_data;
+	int32_t *out_ptr = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 2); ++i)
+		out_ptr[i] = in_ptr[i] & 0xffffff00;
+}
+
+void downmix32bit_2_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int32_t *input_lfe = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LFE);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 3);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		int64_t tmp_left = udm_mulf32(input_left[i * 3], coefficient_left);
+		int64_t tmp_right = udm_mulf32(input_right[i * 3], coefficient_right);
+
+		tmp_left = udm_mulaf32(tmp_left, input_lfe[i * 3], coefficient_lfe);
+		tmp_right = udm_mulaf32(tmp_right, input_lfe[i * 3], coefficient_lfe);
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+void downmix32bit_3_0(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_center = udm_channel32(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 3);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		int64_t tmp_left = udm_mulf32(input_left[i * 3], coefficient_left);
+		int64_t tmp_right;
+
+		tmp_left = udm_mulaf32(tmp_left, input_center[i * 3], coefficient_center);
+		tmp_right = udm_mulf32(input_center[i * 3], coefficient_center);
+		tmp_right = udm_mulaf32(tmp_right, input_right[i * 3], coefficient_right);
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+void downmix32bit_3_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_center = udm_channel32(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int32_t *input_lfe = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LFE);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 4);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		int64_t tmp_left = udm_mulf32(input_left[i * 4], coefficient_left);
+		int64_t tmp_right;
+
+		tmp_left = udm_mulaf32(tmp_left, input_center[i * 4], coefficient_center);
+		tmp_right = udm_mulf32(input_center[i * 4], coefficient_center);
+		tmp_right = udm_mulaf32(tmp_right, input_right[i * 4], coefficient_right);
+		tmp_left = udm_mulaf32(tmp_left, input_lfe[i * 4], coefficient_lfe);
+		tmp_right = udm_mulaf32(tmp_right, input_lfe[i * 4], coefficient_lfe);
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+void downmix32bit(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		  const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_surround =
+		cd->downmix_coefficients[CHANNEL_LEFT_SURROUND];
+	const int32_t coefficient_right_surround =
+		cd->downmix_coefficients[CHANNEL_RIGHT_SURROUND];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+
+	/* See what channels are available. */
+	bool left = (get_channel_location(cd->in_channel_map, CHANNEL_LEFT) != 0xF);
+	bool center = (get_channel_location(cd->in_channel_map, CHANNEL_CENTER) != 0xF);
+	bool right = (get_channel_location(cd->in_channel_map, CHANNEL_RIGHT) != 0xF);
+	bool left_surround =
+		(get_channel_location(cd->in_channel_map, CHANNEL_LEFT_SURROUND) != 0xF);
+	bool right_surround =
+		(get_channel_location(cd->in_channel_map, CHANNEL_RIGHT_SURROUND) != 0xF);
+	bool lfe = (get_channel_location(cd->in_channel_map, CHANNEL_LFE) != 0xF);
+	bool left_surround_to_right = cd->in_channel_config == IPC4_CHANNEL_CONFIG_4_POINT_0;
+
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_center = udm_channel32(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int32_t *input_left_surround = udm_channel32(in_data, cd->in_channel_map,
+							   CHANNEL_LEFT_SURROUND);
+	const int32_t *input_right_surround = udm_channel32(in_data, cd->in_channel_map,
+							    CHANNEL_RIGHT_SURROUND);
+	const int32_t *input_lfe = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LFE);
+
+	/** Calculate number of samples in a single channel. */
+	const uint32_t number_of_samples_in_one_channel = (in_size / cd->in_channel_no) >> 2;
+	const size_t channel_no = cd->in_channel_no;
+	int32_t *output = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < number_of_samples_in_one_channel; i++) {
+		const size_t frame = i * channel_no;
+		int64_t tmp_left = 0;
+		int64_t tmp_right = 0;
+
+		if (left)
+			tmp_left = udm_mulaf32(tmp_left, input_left[frame], coefficient_left);
+		if (center) {
+			tmp_left = udm_mulaf32(tmp_left, input_center[frame], coefficient_center);
+			tmp_right = udm_mulaf32(tmp_right, input_center[frame],
+						coefficient_center);
+		}
+		if (right)
+			tmp_right = udm_mulaf32(tmp_right, input_right[frame], coefficient_right);
+		if (left_surround) {
+			tmp_left = udm_mulaf32(tmp_left, input_left_surround[frame],
+					       coefficient_left_surround);
+			if (left_surround_to_right)
+				tmp_right = udm_mulaf32(tmp_right, input_left_surround[frame],
+							coefficient_left_surround);
+		}
+		if (right_surround)
+			tmp_right = udm_mulaf32(tmp_right, input_right_surround[frame],
+						coefficient_right_surround);
+		if (lfe) {
+			tmp_left = udm_mulaf32(tmp_left, input_lfe[frame], coefficient_lfe);
+			tmp_right = udm_mulaf32(tmp_right, input_lfe[frame], coefficient_lfe);
+		}
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+void downmix32bit_4_0(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_surround =
+		cd->downmix_coefficients[CHANNEL_LEFT_SURROUND];
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_center = udm_channel32(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int32_t *input_left_surround = udm_channel32(in_data, cd->in_channel_map,
+							   CHANNEL_LEFT_SURROUND);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 4);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		int64_t tmp_left = udm_mulf32(input_left[i * 4], coefficient_left);
+		int64_t tmp_right;
+
+		tmp_left = udm_mulaf32(tmp_left, input_center[i * 4], coefficient_center);
+		tmp_right = udm_mulf32(input_center[i * 4], coefficient_center);
+		tmp_right = udm_mulaf32(tmp_right, input_right[i * 4], coefficient_right);
+
+		/* for 4.0 left surround if propagated to both left and right output channels */
+		tmp_left = udm_mulaf32(tmp_left, input_left_surround[i * 4],
+				       coefficient_left_surround);
+		tmp_right = udm_mulaf32(tmp_right, input_left_surround[i * 4],
+					coefficient_left_surround);
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+/* Mono downmix of four channels used by the 5.0, 3.1, 4.0, Quatro, 5.1 and 7.1
+ * to mono routines, with the frame of channel_no channels.
+ */
+static void downmix32bit_4ch_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+				  const uint32_t in_size, uint8_t * const out_data,
+				  const enum ipc4_channel_index channels[4],
+				  const uint32_t channel_no)
+{
+	const int32_t coefficient_0 = cd->downmix_coefficients[channels[0]];
+	const int32_t coefficient_1 = cd->downmix_coefficients[channels[1]];
+	const int32_t coefficient_2 = cd->downmix_coefficients[channels[2]];
+	const int32_t coefficient_3 = cd->downmix_coefficients[channels[3]];
+	const int32_t *input_0 = udm_channel32(in_data, cd->in_channel_map, channels[0]);
+	const int32_t *input_1 = udm_channel32(in_data, cd->in_channel_map, channels[1]);
+	const int32_t *input_2 = udm_channel32(in_data, cd->in_channel_map, channels[2]);
+	const int32_t *input_3 = udm_channel32(in_data, cd->in_channel_map, channels[3]);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), channel_no);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		const size_t frame = i * channel_no;
+		int64_t tmp = udm_mulf32(input_0[frame], coefficient_0);
+
+		tmp = udm_mulaf32(tmp, input_1[frame], coefficient_1);
+		tmp = udm_mulaf32(tmp, input_2[frame], coefficient_2);
+		tmp = udm_mulaf32(tmp, input_3[frame], coefficient_3);
+
+		output[i] = udm_round32f64(tmp);
+	}
+}
+
+void downmix32bit_5_0_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_CENTER, CHANNEL_RIGHT, CHANNEL_CENTER_SURROUND
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 5);
+}
+
+/* 5.1 and 7.1 to stereo, the center and LFE contributions are shared */
+static void downmix32bit_surround(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+				  const uint32_t in_size, uint8_t * const out_data,
+				  const enum ipc4_channel_index ls,
+				  const enum ipc4_channel_index rs,
+				  const bool sides, const uint32_t channel_no)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_surround = cd->downmix_coefficients[ls];
+	const int32_t coefficient_right_surround = cd->downmix_coefficients[rs];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+	const int32_t coefficient_left_side = cd->downmix_coefficients[CHANNEL_LEFT_SIDE];
+	const int32_t coefficient_right_side = cd->downmix_coefficients[CHANNEL_RIGHT_SIDE];
+	const int32_t *input_left = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int32_t *input_center = udm_channel32(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int32_t *input_right = udm_channel32(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int32_t *input_left_surround = udm_channel32(in_data, cd->in_channel_map, ls);
+	const int32_t *input_right_surround = udm_channel32(in_data, cd->in_channel_map, rs);
+	const int32_t *input_lfe = udm_channel32(in_data, cd->in_channel_map, CHANNEL_LFE);
+	const int32_t *input_left_side = udm_channel32(in_data, cd->in_channel_map,
+						       CHANNEL_LEFT_SIDE);
+	const int32_t *input_right_side = udm_channel32(in_data, cd->in_channel_map,
+							CHANNEL_RIGHT_SIDE);
+	int32_t *output = (int32_t *)out_data;
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), channel_no);
+	uint32_t i;
+
+	for (i = 0; i < frames; ++i) {
+		const size_t frame = i * channel_no;
+		int64_t tmp_left = udm_mulf32(input_center[frame], coefficient_center);
+		int64_t tmp_right;
+
+		tmp_left = udm_mulaf32(tmp_left, input_lfe[frame], coefficient_lfe);
+		tmp_right = tmp_left;
+
+		tmp_left = udm_mulaf32(tmp_left, input_left[frame], coefficient_left);
+		tmp_right = udm_mulaf32(tmp_right, input_right[frame], coefficient_right);
+		tmp_left = udm_mulaf32(tmp_left, input_left_surround[frame],
+				       coefficient_left_surround);
+		tmp_right = udm_mulaf32(tmp_right, input_right_surround[frame],
+					coefficient_right_surround);
+		if (sides) {
+			tmp_left = udm_mulaf32(tmp_left, input_left_side[frame],
+					       coefficient_left_side);
+			tmp_right = udm_mulaf32(tmp_right, input_right_side[frame],
+						coefficient_right_side);
+		}
+
+		output[i * 2] = udm_round32f64(tmp_left);
+		output[i * 2 + 1] = udm_round32f64(tmp_right);
+	}
+}
+
+void downmix32bit_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	/* Must support also 5.1 Surround */
+	const bool surround_5_1_channel_map =
+		get_channel_location(cd->in_channel_map, CHANNEL_LEFT_SURROUND) ==
+			CHANNEL_INVALID &&
+		get_channel_location(cd->in_channel_map, CHANNEL_RIGHT_SURROUND) ==
+			CHANNEL_INVALID;
+
+	if (surround_5_1_channel_map)
+		downmix32bit_surround(cd, in_data, in_size, out_data, CHANNEL_LEFT_SIDE,
+				      CHANNEL_RIGHT_SIDE, false, 6);
+	else
+		downmix32bit_surround(cd, in_data, in_size, out_data, CHANNEL_LEFT_SURROUND,
+				      CHANNEL_RIGHT_SURROUND, false, 6);
+}
+
+void downmix32bit_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	downmix32bit_surround(cd, in_data, in_size, out_data, CHANNEL_LEFT_SURROUND,
+			      CHANNEL_RIGHT_SURROUND, true, 8);
+}
+
+void shiftcopy16bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	const int16_t *in_ptrs = (const int16_t *)in_data;
+	int32_t *out_ptrs = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 1); ++i) {
+		out_ptrs[i * 2] = (int32_t)in_ptrs[i] << 16;
+		out_ptrs[i * 2 + 1] = (int32_t)in_ptrs[i] << 16;
+	}
+}
+
+void shiftcopy16bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	const int16_t *in_ptrs = (const int16_t *)in_data;
+	int32_t *out_ptrs = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 1); ++i)
+		out_ptrs[i] = (int32_t)in_ptrs[i] << 16;
+}
+
+void downmix16bit(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		  const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_surround =
+		cd->downmix_coefficients[CHANNEL_LEFT_SURROUND];
+	const int32_t coefficient_right_surround =
+		cd->downmix_coefficients[CHANNEL_RIGHT_SURROUND];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+
+	/* See what channels are available. */
+	bool left = (get_channel_location(cd->in_channel_map, CHANNEL_LEFT) != 0xF);
+	bool center = (get_channel_location(cd->in_channel_map, CHANNEL_CENTER) != 0xF);
+	bool right = (get_channel_location(cd->in_channel_map, CHANNEL_RIGHT) != 0xF);
+	bool left_surround =
+		(get_channel_location(cd->in_channel_map, CHANNEL_LEFT_SURROUND) != 0xF);
+	bool right_surround =
+		(get_channel_location(cd->in_channel_map, CHANNEL_RIGHT_SURROUND) != 0xF);
+	bool lfe = (get_channel_location(cd->in_channel_map, CHANNEL_LFE) != 0xF);
+	bool left_surround_to_right = cd->in_channel_config == IPC4_CHANNEL_CONFIG_4_POINT_0;
+
+	const int16_t *input_left = udm_channel16(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int16_t *input_center = udm_channel16(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int16_t *input_right = udm_channel16(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int16_t *input_left_surround = udm_channel16(in_data, cd->in_channel_map,
+							   CHANNEL_LEFT_SURROUND);
+	const int16_t *input_right_surround = udm_channel16(in_data, cd->in_channel_map,
+							    CHANNEL_RIGHT_SURROUND);
+	const int16_t *input_lfe = udm_channel16(in_data, cd->in_channel_map, CHANNEL_LFE);
+
+	/** Calculate number of samples in a single channel. */
+	const uint32_t number_of_samples_in_one_channel = (in_size / cd->in_channel_no) >> 1;
+	const size_t channel_no = cd->in_channel_no;
+	int32_t *output = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < number_of_samples_in_one_channel; i++) {
+		const size_t frame = i * channel_no;
+		int64_t tmp_left = 0;
+		int64_t tmp_right = 0;
+
+		if (left)
+			tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_left[frame]),
+					       coefficient_left);
+		if (center) {
+			tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_center[frame]),
+					       coefficient_center);
+			tmp_right = udm_mulaf32(tmp_right, udm_load16m(&input_center[frame]),
+						coefficient_center);
+		}
+		if (right)
+			tmp_right = udm_mulaf32(tmp_right, udm_load16m(&input_right[frame]),
+						coefficient_right);
+		if (left_surround) {
+			tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_left_surround[frame]),
+					       coefficient_left_surround);
+			if (left_surround_to_right)
+				tmp_right = udm_mulaf32(tmp_right,
+							udm_load16m(&input_left_surround[frame]),
+							coefficient_left_surround);
+		}
+		if (right_surround)
+			tmp_right = udm_mulaf32(tmp_right,
+						udm_load16m(&input_right_surround[frame]),
+						coefficient_right_surround);
+		if (lfe) {
+			tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_lfe[frame]),
+					       coefficient_lfe);
+			tmp_right = udm_mulaf32(tmp_right, udm_load16m(&input_lfe[frame]),
+						coefficient_lfe);
+		}
+
+		/* 24 bit result to 32 bit container, without saturation as AE_SLAI32 */
+		output[i * 2] = (int32_t)((uint32_t)udm_round32f64(tmp_left) << 8);
+		output[i * 2 + 1] = (int32_t)((uint32_t)udm_round32f64(tmp_right) << 8);
+	}
+}
+
+void downmix16bit_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		      const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_center = cd->downmix_coefficients[CHANNEL_CENTER];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_surround =
+		cd->downmix_coefficients[CHANNEL_LEFT_SURROUND];
+	const int32_t coefficient_right_surround =
+		cd->downmix_coefficients[CHANNEL_RIGHT_SURROUND];
+	const int32_t coefficient_lfe = cd->downmix_coefficients[CHANNEL_LFE];
+	const int16_t *input_left = udm_channel16(in_data, cd->in_channel_map, CHANNEL_LEFT);
+	const int16_t *input_center = udm_channel16(in_data, cd->in_channel_map, CHANNEL_CENTER);
+	const int16_t *input_right = udm_channel16(in_data, cd->in_channel_map, CHANNEL_RIGHT);
+	const int16_t *input_left_surround = udm_channel16(in_data, cd->in_channel_map,
+							   CHANNEL_LEFT_SURROUND);
+	const int16_t *input_right_surround = udm_channel16(in_data, cd->in_channel_map,
+							    CHANNEL_RIGHT_SURROUND);
+	const int16_t *input_lfe = udm_channel16(in_data, cd->in_channel_map, CHANNEL_LFE);
+
+	/** Calculate number of samples in a single channel. */
+	const uint32_t number_of_samples_in_one_channel = (in_size / cd->in_channel_no) >> 1;
+	const size_t channel_no = cd->in_channel_no;
+	int32_t *output = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < number_of_samples_in_one_channel; i++) {
+		const size_t frame = i * channel_no;
+		int64_t tmp_left = udm_mulf32(udm_load16m(&input_center[frame]),
+					      coefficient_center);
+		int64_t tmp_right;
+
+		tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_lfe[frame]), coefficient_lfe);
+		tmp_right = tmp_left;
+
+		tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_left[frame]),
+				       coefficient_left);
+		tmp_right = udm_mulaf32(tmp_right, udm_load16m(&input_right[frame]),
+					coefficient_right);
+		tmp_left = udm_mulaf32(tmp_left, udm_load16m(&input_left_surround[frame]),
+				       coefficient_left_surround);
+		tmp_right = udm_mulaf32(tmp_right, udm_load16m(&input_right_surround[frame]),
+					coefficient_right_surround);
+
+		output[i * 2] = (int32_t)((uint32_t)udm_round32f64(tmp_left) << 8);
+		output[i * 2 + 1] = (int32_t)((uint32_t)udm_round32f64(tmp_right) << 8);
+	}
+}
+
+void downmix16bit_4ch_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	const int16_t *input_data = (const int16_t *)in_data;
+	int16_t *output_data = (int16_t *)out_data;
+	int16_t coeffs[4];
+	size_t i;
+	int ch;
+
+	/* The HiFi3 version takes the 16 LSB of the coefficients. */
+	for (ch = 0; ch < 4; ch++)
+		coeffs[ch] = (int16_t)cd->downmix_coefficients[get_channel_index(cd->in_channel_map,
+										  ch)];
+
+	for (i = 0; i < in_size / (sizeof(int16_t)); i += 4) {
+		/* accumulate in the vector element order of the HiFi3 version */
+		int32_t tmp = udm_mulf16(input_data[i + 3], coeffs[3]);
+
+		for (ch = 2; ch >= 0; ch--)
+			tmp = sat_int32((int64_t)tmp + udm_mulf16(input_data[i + ch], coeffs[ch]));
+
+		*output_data++ = udm_round16f32(tmp);
+	}
+}
+
+void downmix32bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	const int32_t downmix_coefficient = 1073741568;
+	const int32_t *input = (const int32_t *)in_data;
+	int32_t *output = (int32_t *)out_data;
+	uint32_t i;
+
+	for (i = 0; i < (in_size >> 3); ++i) {
+		int64_t tmp = udm_mulf32(input[i * 2], downmix_coefficient);
+
+		tmp = udm_mulaf32(tmp, input[i * 2 + 1], downmix_coefficient);
+		output[i] = udm_round32f64(tmp);
+	}
+}
+
+void downmix16bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	size_t idx;
+
+	const uint16_t *in_data16 = (uint16_t *)in_data;
+	uint16_t *out_data16 = (uint16_t *)out_data;
+
+	for (idx = 0; idx < (in_size / 4); ++idx)
+		out_data16[idx] = (in_data16[2 * idx] / 2) + (in_data16[2 * idx + 1] / 2);
+}
+
+void downmix32bit_3_1_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_CENTER, CHANNEL_RIGHT, CHANNEL_LFE
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 4);
+}
+
+void downmix32bit_4_0_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_CENTER, CHANNEL_RIGHT, CHANNEL_CENTER_SURROUND
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 4);
+}
+
+void downmix32bit_quatro_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			      const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_LEFT_SURROUND, CHANNEL_RIGHT, CHANNEL_RIGHT_SURROUND
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 4);
+}
+
+void downmix32bit_5_1_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_CENTER, CHANNEL_RIGHT, CHANNEL_CENTER_SURROUND
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 6);
+}
+
+void downmix32bit_7_1_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	static const enum ipc4_channel_index channels[4] = {
+		CHANNEL_LEFT, CHANNEL_CENTER, CHANNEL_RIGHT, CHANNEL_CENTER_SURROUND
+	};
+
+	downmix32bit_4ch_mono(cd, in_data, in_size, out_data, channels, 8);
+}
+
+void downmix32bit_7_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			     const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	uint8_t left_surround_slot;
+	uint8_t right_surround_slot;
+	uint32_t i;
+
+	get_surround_slots(out_channel_map, &left_surround_slot, &right_surround_slot);
+
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_side_left = (int32_t *)(out_data + (left_surround_slot << 2));
+	int32_t *output_side_right = (int32_t *)(out_data + (right_surround_slot << 2));
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+
+	for (i = 0; i < (in_size >> 5); ++i) {
+		output_left[i * 6] = in_ptr[i * 8];
+		output_right[i * 6] = in_ptr[i * 8 + 2];
+		output_center[i * 6] = in_ptr[i * 8 + 1];
+		output_lfe[i * 6] = in_ptr[i * 8 + 5];
+	}
+
+	/* The HiFi3 version pairs the coefficients for the surround and side
+	 * channels in this order.
+	 */
+	const int32_t coefficient_left = cd->downmix_coefficients[CHANNEL_LEFT];
+	const int32_t coefficient_right = cd->downmix_coefficients[CHANNEL_RIGHT];
+	const int32_t coefficient_left_side = cd->downmix_coefficients[CHANNEL_LEFT_SIDE];
+	const int32_t coefficient_right_side = cd->downmix_coefficients[CHANNEL_RIGHT_SIDE];
+	const int32_t *input_left_surround = udm_channel32(in_data, cd->in_channel_map,
+							   CHANNEL_LEFT_SURROUND);
+	const int32_t *input_right_surround = udm_channel32(in_data, cd->in_channel_map,
+							    CHANNEL_RIGHT_SURROUND);
+	const int32_t *input_left_side = udm_channel32(in_data, cd->in_channel_map,
+						       CHANNEL_LEFT_SIDE);
+	const int32_t *input_right_side = udm_channel32(in_data, cd->in_channel_map,
+							CHANNEL_RIGHT_SIDE);
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 8);
+
+	for (i = 0; i < frames; ++i) {
+		int64_t tmp_left_side = udm_mulf32(input_left_surround[i * 8], coefficient_left);
+		int64_t tmp_right_side = udm_mulf32(input_left_surround[i * 8],
+						    coefficient_right_side);
+
+		tmp_left_side = udm_mulaf32(tmp_left_side, input_right_surround[i * 8],
+					    coefficient_left_side);
+		tmp_right_side = udm_mulaf32(tmp_right_side, input_right_surround[i * 8],
+					     coefficient_right);
+		tmp_left_side = udm_mulaf32(tmp_left_side, input_left_side[i * 8],
+					    coefficient_left);
+		tmp_right_side = udm_mulaf32(tmp_right_side, input_right_side[i * 8],
+					     coefficient_right);
+
+		output_side_left[i * 6] = udm_round32f64(tmp_left_side);
+		output_side_right[i * 6] = udm_round32f64(tmp_right_side);
+	}
+}
+
+void upmix32bit_4_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			   const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	uint8_t left_surround_slot;
+	uint8_t right_surround_slot;
+	uint32_t i;
+
+	get_surround_slots(out_channel_map, &left_surround_slot, &right_surround_slot);
+
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_side_left = (int32_t *)(out_data + (left_surround_slot << 2));
+	int32_t *output_side_right = (int32_t *)(out_data + (right_surround_slot << 2));
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+
+	for (i = 0; i < (in_size >> 4); ++i) {
+		output_left[i * 6] = in_ptr[i * 4];
+		output_right[i * 6] = in_ptr[i * 4 + 2];
+		output_center[i * 6] = in_ptr[i * 4 + 1];
+		output_lfe[i * 6] = 0;
+	}
+
+	const int32_t coefficient_left_surround =
+		cd->downmix_coefficients[CHANNEL_LEFT_SURROUND];
+	const int32_t coefficient_right_surround =
+		cd->downmix_coefficients[CHANNEL_RIGHT_SURROUND];
+	const int32_t *input_center_surround = udm_channel32(in_data, cd->in_channel_map,
+							     CHANNEL_CENTER_SURROUND);
+	const uint32_t frames = DIV_ROUND_UP(in_size / sizeof(int32_t), 4);
+
+	for (i = 0; i < frames; ++i) {
+		int32_t cs = input_center_surround[i * 4];
+
+		output_side_left[i * 6] = udm_round32f64(udm_mulf32(cs, coefficient_left_surround));
+		output_side_right[i * 6] = udm_round32f64(udm_mulf32(cs,
+								     coefficient_right_surround));
+	}
+}
+
+void upmix32bit_quatro_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			      const uint32_t in_size, uint8_t * const out_data)
+{
+	channel_map out_channel_map = cd->out_channel_map;
+	uint8_t left_surround_slot = get_channel_location(out_channel_map, CHANNEL_LEFT_SURROUND);
+	uint8_t right_surround_slot = get_channel_location(out_channel_map,
+							   CHANNEL_RIGHT_SURROUND);
+	uint32_t i;
+
+	/* Must support also 5.1 Surround, the HiFi3 version looks up the side
+	 * channels in the input channel map.
+	 */
+	if (left_surround_slot == CHANNEL_INVALID && right_surround_slot == CHANNEL_INVALID) {
+		left_surround_slot = get_channel_location(cd->in_channel_map, CHANNEL_LEFT_SIDE);
+		right_surround_slot = get_channel_location(cd->in_channel_map, CHANNEL_RIGHT_SIDE);
+	}
+
+	int32_t *output_left = udm_channel32(out_data, out_channel_map, CHANNEL_LEFT);
+	int32_t *output_center = udm_channel32(out_data, out_channel_map, CHANNEL_CENTER);
+	int32_t *output_right = udm_channel32(out_data, out_channel_map, CHANNEL_RIGHT);
+	int32_t *output_side_left = (int32_t *)(out_data + (left_surround_slot << 2));
+	int32_t *output_side_right = (int32_t *)(out_data + (right_surround_slot << 2));
+	int32_t *output_lfe = udm_channel32(out_data, out_channel_map, CHANNEL_LFE);
+	const int32_t *in_ptr = (const int32_t *)in_data;
+
+	for (i = 0; i < (in_size >> 4); ++i) {
+		output_left[i * 6] = in_ptr[i * 4];
+		output_right[i * 6] = in_ptr[i * 4 + 1];
+		output_center[i * 6] = 0;
+		output_side_left[i * 6] = in_ptr[i * 4 + 2];
+		output_side_right[i * 6] = in_ptr[i * 4 + 3];
+		output_lfe[i * 6] = 0;
+	}
+}
+
+#endif /* UP_DOWN_MIXER_GENERIC */
@@ -6,7 +6,7 @@
 
 #include <sof/audio/up_down_mixer/up_down_mixer.h>
 
-#if defined(__XCC__) && XCHAL_HAVE_HIFI3
+#if UP_DOWN_MIXER_HIFI3
 
 #include <xtensa/tie/xt_hifi3.h>
 #include <errno.h>
@@ -1915,6 +1915,4 @@ void upmix32bit_quatro_to_5_1(struct up_down_mixer_data *cd, const uint8_t * con
 	}
 }
 
-#else
-	#error "Only hifi3 version supported."
-#endif
+#endif /* UP_DOWN_MIXER_HIFI3 */
@@ -38,4 +38,31 @@ struct sof_ipc_dbg_mem_usage {
 	struct sof_ipc_dbg_mem_usage_elem elems[];	/**< memory usage information */
 } __attribute__((packed, aligned(4)));
 
+/**
+ * ABI3.25
+ * Run time statistics of a low latency task. The times are in ticks of
+ * the scheduling domain clock and the percentiles are upper bounds with
+ * a resolution of a quarter of a power of two.
+ */
+struct sof_ipc_dbg_task_load_elem {
+	uint32_t uid;		/**< task uuid entry address, as in the trace */
+	uint32_t core;		/**< core running the task */
+	uint32_t budget;	/**< ticks in a task period, 0 if not periodic */
+	uint32_t runs;		/**< number of runs */
+	uint32_t overruns;	/**< runs longer than the budget */
+	uint32_t p50;		/**< median run time */
+	uint32_t p99;		/**< run time not exceeded by 99% of the runs */
+	uint32_t p999;		/**< run time not exceeded by 99.9% of the runs */
+	uint32_t max;		/**< longest run time */
+	uint32_t reserved;	/**< reserved for future use */
+} __attribute__((packed, aligned(4)));
+
+/** ABI3.25 */
+struct sof_ipc_dbg_task_load {
+	struct sof_ipc_reply rhdr;			/**< generic IPC reply header */
+	uint32_t reserved[4];				/**< reserved for future use */
+	uint32_t num_elems;				/**< elems[] counter */
+	struct sof_ipc_dbg_task_load_elem elems[];	/**< statistics per task */
+} __attribute__((packed, aligned(4)));
+
 #endif /* __IPC_DEBUG_H__ */
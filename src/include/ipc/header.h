@@ -310,6 +310,7 @@ struct ipc_cmd_hdr;
  */
 
 #define SOF_IPC_DEBUG_MEM_USAGE			SOF_CMD_TYPE(0x001)
+#define SOF_IPC_DEBUG_TASK_LOAD			SOF_CMD_TYPE(0x002)
 
 /** @} */
 
@@ -26,6 +26,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/* Select optimized code variant when xt-xcc compiler is used */
+#if defined __XCC__
+#include <xtensa/config/core-isa.h>
+#if XCHAL_HAVE_HIFI3 == 1
+#define ARIA_GENERIC	0
+#define ARIA_HIFI3	1
+#else
+#define ARIA_GENERIC	1
+#define ARIA_HIFI3	0
+#endif /* XCHAL_HAVE_HIFI3 */
+#else
+/* GCC */
+#define ARIA_GENERIC	1
+#define ARIA_HIFI3	0
+#endif /* __XCC__ */
+
 /** \brief Aria max gain states */
 #define ARIA_MAX_GAIN_STATES 10
 
@@ -36,4 +36,22 @@
 #define ASRC_HIFI3	0 /* Disable HiFi3  */
 #endif /* Autoarch */
 
+/* The generic version collects the output frames into blocks and
+ * calculates their impulse responses at once. The Farrow polynomial
+ * evaluation then runs independent multiply chains for the frames of
+ * a block that the compiler can schedule or vectorize. The frames of a
+ * block may be separated by consumed input frames, so the ring buffers
+ * keep ASRC_BLOCK_HISTORY frames of extra history. The HiFi3 version
+ * keeps the per frame processing with its hand optimized kernels.
+ */
+#if ASRC_GENERIC == 1
+#define ASRC_BLOCK_MODE		1
+#define ASRC_BLOCK_FRAMES	2
+#define ASRC_BLOCK_HISTORY	32
+#else
+#define ASRC_BLOCK_MODE		0
+#define ASRC_BLOCK_FRAMES	1
+#define ASRC_BLOCK_HISTORY	0
+#endif
+
 #endif /* __SOF_AUDIO_ASRC_ASRC_CONFIG_H__ */
@@ -165,7 +165,8 @@ struct asrc_farrow {
 	const int32_t *polyphase_filters; /*!< Pointer to the filter */
 					  /*!< coefficients */
 	int32_t *impulse_response; /*!< Pointer to the impulse response */
-				   /*!< for generating one output sample */
+				   /*!< for generating one output sample, */
+				   /*!< or a block of them in block mode */
 
 	/* PROGRAM + general */
 	bool is_initialised;	/*!< Flag is set to true after */
@@ -652,4 +653,28 @@ void asrc_calc_impulse_response_n5(struct asrc_farrow *src_obj);
 void asrc_calc_impulse_response_n6(struct asrc_farrow *src_obj);
 void asrc_calc_impulse_response_n7(struct asrc_farrow *src_obj);
 
+/*
+ * Block processing versions of the above. The impulse responses of
+ * @p num_frames output frames are calculated at once from the given
+ * time values and stored one after another, filter_length bins for
+ * each frame. The block FIR filters each frame from the ring buffer
+ * position that was current for it. The number of frames must not
+ * exceed ASRC_BLOCK_FRAMES.
+ */
+void asrc_calc_impulse_response_block(struct asrc_farrow *src_obj,
+				      const uint32_t *time_value,
+				      int num_frames);
+
+void asrc_fir_filter16_block(struct asrc_farrow *src_obj,
+			     int16_t **output_buffers,
+			     const int *write_position,
+			     const int *index_output_frame,
+			     int num_frames);
+
+void asrc_fir_filter32_block(struct asrc_farrow *src_obj,
+			     int32_t **output_buffers,
+			     const int *write_position,
+			     const int *index_output_frame,
+			     int num_frames);
+
 #endif /* IAS_SRC_FARROW_H */
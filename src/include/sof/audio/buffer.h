@@ -149,6 +149,11 @@ struct comp_buffer {
 
 	bool hw_params_configured; /**< indicates whether hw params were set */
 	bool walking;		/**< indicates if the buffer is being walked */
+
+	/* aliasing of the source buffer data, see buffer_alias() */
+	void *own_addr;		/**< own data while aliased, NULL if not aliased */
+	uint32_t own_size;	/**< size of own data while aliased */
+	uint32_t alias_avail;	/**< avail bytes after the last forward */
 };
 
 /* Only to be used for synchronous same-core notifications! */
@@ -183,6 +188,22 @@ struct comp_buffer *buffer_alloc(uint32_t size, uint32_t caps, uint32_t align);
 struct comp_buffer *buffer_new(const struct sof_ipc_buffer *desc);
 int buffer_set_size(struct comp_buffer __sparse_cache *buffer, uint32_t size);
 void buffer_free(struct comp_buffer *buffer);
+
+/*
+ * Buffer aliasing for components that pass the data through unmodified.
+ * The sink buffer of such component is set to use the data of its source
+ * buffer and buffer_alias_forward() replaces the copy. The data is then
+ * released in the source buffer only when the consumer of the sink buffer
+ * has read it. Only buffers read by a processing component of the same
+ * pipeline can be aliased, the DMA of host and DAI components is set up
+ * with the buffer address before prepare.
+ */
+int buffer_alias(struct comp_buffer __sparse_cache *sink,
+		 struct comp_buffer __sparse_cache *source);
+void buffer_alias_clear(struct comp_buffer __sparse_cache *sink);
+uint32_t buffer_alias_forward(struct comp_buffer __sparse_cache *source,
+			      struct comp_buffer __sparse_cache *sink);
+
 void buffer_zero(struct comp_buffer __sparse_cache *buffer);
 
 /* called by a component after producing data into this buffer */
@@ -241,6 +262,7 @@ static inline void buffer_reset_pos(struct comp_buffer __sparse_cache *buffer, v
 {
 	/* reset rw pointers and avail/free bytes counters */
 	audio_stream_reset(&buffer->stream);
+	buffer->alias_avail = 0;
 
 	/* clear buffer contents */
 	buffer_zero(buffer);
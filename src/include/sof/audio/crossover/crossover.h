@@ -72,13 +72,19 @@ typedef void (*crossover_process)(const struct comp_dev *dev,
 				  int32_t num_sinks,
 				  uint32_t frames);
 
-typedef void (*crossover_split)(int32_t in, int32_t out[],
-				struct crossover_state *state);
+typedef void (*crossover_split)(const int32_t *in, int32_t *out[],
+				struct crossover_state *state, int frames);
+
+/* Number of frames the processing functions split at a time */
+#define CROSSOVER_BLOCK_FRAMES 32
 
 /* Crossover component private data */
 struct comp_data {
 	/**< filter state */
 	struct crossover_state state[PLATFORM_MAX_CHANNELS];
+	/**< input and band outputs of a block, per channel */
+	int32_t in[PLATFORM_MAX_CHANNELS][CROSSOVER_BLOCK_FRAMES];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][PLATFORM_MAX_CHANNELS][CROSSOVER_BLOCK_FRAMES];
 	struct comp_data_blob_handler *model_handler;
 	struct sof_crossover_config *config;      /**< pointer to setup blob */
 	enum sof_ipc_frame source_format;         /**< source frame format */
@@ -143,13 +149,15 @@ static inline crossover_split crossover_find_split_func(int32_t num_sinks)
 }
 
 /*
- * \brief Runs input in through the LR4 filter and returns it's output.
+ * \brief Runs a block of frames in through the LR4 filter to out. The
+ *        out can be the same buffer as in.
  */
-static inline int32_t crossover_generic_process_lr4(int32_t in,
-						    struct iir_state_df2t *lr4)
+static inline void crossover_generic_process_lr4_block(const int32_t *in, int32_t *out,
+						       struct iir_state_df2t *lr4,
+						       int frames)
 {
 	/* Cascade two biquads with same coefficients in series. */
-	return iir_df2t(lr4, in);
+	iir_df2t_block(lr4, out, in, frames);
 }
 
 #endif //  __SOF_AUDIO_CROSSOVER_CROSSOVER_H__
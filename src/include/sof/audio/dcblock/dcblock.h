@@ -15,9 +15,17 @@
 struct audio_stream;
 struct comp_dev;
 
+/**
+ * \brief Number of first order sections that can be cascaded. The blob
+ * has PLATFORM_MAX_CHANNELS R coefficients for every section, so the
+ * order of the filter is chosen by the size of the blob.
+ */
+#define DCBLOCK_MAX_SECTIONS 2
+
+/** \brief State of one section for all channels, indexed by channel. */
 struct dcblock_state {
-	int32_t x_prev; /**< state variable referring to x[n-1] */
-	int32_t y_prev; /**< state variable referring to y[n-1] */
+	int32_t x_prev[PLATFORM_MAX_CHANNELS]; /**< state variables referring to x[n-1] */
+	int32_t y_prev[PLATFORM_MAX_CHANNELS]; /**< state variables referring to y[n-1] */
 };
 
 /**
@@ -32,10 +40,12 @@ typedef void (*dcblock_func)(const struct comp_dev *dev,
 /* DC Blocking Filter component private data */
 struct comp_data {
 	/**< filters state */
-	struct dcblock_state state[PLATFORM_MAX_CHANNELS];
+	struct dcblock_state state[DCBLOCK_MAX_SECTIONS];
 
 	/** coefficients for the processing function */
-	int32_t R_coeffs[PLATFORM_MAX_CHANNELS];
+	int32_t R_coeffs[DCBLOCK_MAX_SECTIONS][PLATFORM_MAX_CHANNELS];
+
+	int sections; /**< number of cascaded sections in use */
 
 	enum sof_ipc_frame source_format;
 	enum sof_ipc_frame sink_format;
@@ -117,4 +117,19 @@ int32_t drc_inv_fixed(int32_t x, int32_t precision_x, int32_t precision_y);
 int32_t drc_asin_fixed(int32_t x); /* Input:Q2.30 Output:Q2.30 */
 #endif /* !DRC_USE_CORDIC_ASIN */
 
+/*
+ * Batch versions that process n values, typically a full DRC_DIVISION_FRAMES
+ * division, in one call. The loops have no data dependent branches so they
+ * can be software pipelined or vectorized. The log and inverse versions give
+ * the same results as the single value functions. The exp and sin versions
+ * use table and polynomial approximations that are more accurate than
+ * exp_fixed() and drc_sin_fixed(). Output y can be the same array as x.
+ */
+void drc_lin2db_fixed_array(int32_t *y, const int32_t *x, int n); /* Input:Q6.26 Output:Q11.21 */
+void drc_log_fixed_array(int32_t *y, const int32_t *x, int n); /* Input:Q6.26 Output:Q6.26 */
+void drc_inv_fixed_array(int32_t *y, const int32_t *x, int n, int32_t precision_x,
+			 int32_t precision_y);
+void drc_exp_fixed_array(int32_t *y, const int32_t *x, int n); /* Input:Q5.27 Output:Q12.20 */
+void drc_sin_fixed_array(int32_t *y, const int32_t *x, int n); /* Input:Q2.30 Output:Q1.31 */
+
 #endif //  __SOF_AUDIO_DRC_DRC_MATH_H__
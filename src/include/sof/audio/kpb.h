@@ -16,12 +16,20 @@ struct comp_buffer;
 
 /* KPB internal defines */
 
+#if CONFIG_KPB_HISTORY_ADPCM
+/** ADPCM coded history is less than third of PCM, so it is kept three times longer. */
+#define KPB_HISTORY_TIME_FACTOR 3
+#else
+#define KPB_HISTORY_TIME_FACTOR 1
+#endif
+
 #if CONFIG_TIGERLAKE
-#define KPB_MAX_BUFF_TIME 3000 /**< time of buffering in miliseconds */
+/**< time of buffering in miliseconds */
+#define KPB_MAX_BUFF_TIME (3000 * KPB_HISTORY_TIME_FACTOR)
 #define HOST_WAKEUP_TIME 1000 /* aprox. time of host DMA wakup from suspend [ms] */
 #else
 /** Due to memory constraints on non-TGL platforms, the buffers are smaller. */
-#define KPB_MAX_BUFF_TIME 2100 /**< time of buffering in miliseconds */
+#define KPB_MAX_BUFF_TIME (2100 * KPB_HISTORY_TIME_FACTOR)
 #define HOST_WAKEUP_TIME 0 /* aprox. time of host DMA wakup from suspend [ms] */
 #endif
 
@@ -121,6 +129,14 @@ struct history_buffer {
 	struct history_buffer *prev; /**< next history buffer */
 };
 
+/* Draining statistics */
+struct kpb_drain_stats {
+	size_t host_consumed; /**< bytes consumed from sink while draining */
+	uint32_t bursts; /**< number of copies to sink */
+	size_t max_burst; /**< largest copy to sink */
+	uint64_t catch_up_time; /**< cycles until real time stream is copied to host */
+};
+
 /* Draining task data */
 struct draining_data {
 	struct comp_buffer *sink;
@@ -134,11 +150,43 @@ struct draining_data {
 	struct comp_dev *dev;
 	bool sync_mode_on;
 	enum comp_copy_type copy_type;
+	size_t burst_min; /**< initial free space in sink for a copy */
+	size_t burst_max; /**< limit of free space in sink for a copy */
+	struct kpb_drain_stats stats;
+};
+
+/** Number of frames coded in an ADPCM history block */
+#define KPB_ADPCM_BLOCK_FRAMES 64
+/** Size of an ADPCM history block: coder state of each channel followed
+ * by 4 bit codes of the interleaved samples.
+ */
+#define KPB_ADPCM_BLOCK_SIZE(ch) ((ch) * sizeof(struct kpb_adpcm_state) + \
+	KPB_ADPCM_BLOCK_FRAMES * (ch) / 2)
+
+/* IMA ADPCM coder state of a channel, also the block header */
+struct kpb_adpcm_state {
+	int16_t predictor; /**< predicted sample */
+	uint8_t index; /**< step size index */
+	uint8_t reserved;
+};
+
+/* ADPCM history codec data */
+struct kpb_history_codec {
+	struct kpb_adpcm_state enc[KPB_MAX_SUPPORTED_CHANNELS]; /**< encoder state */
+	size_t frame_bytes; /**< PCM frame size */
+	size_t pcm_block_size; /**< PCM bytes coded in a block */
+	size_t block_size; /**< size of a coded block */
+	size_t frames_staged; /**< frames coded in block not yet buffered */
+	size_t drain_fill; /**< bytes of drain_block read from history */
+	int32_t pcm[KPB_ADPCM_BLOCK_FRAMES * KPB_MAX_SUPPORTED_CHANNELS];
+	int32_t drain_pcm[KPB_ADPCM_BLOCK_FRAMES * KPB_MAX_SUPPORTED_CHANNELS];
+	uint8_t block[KPB_ADPCM_BLOCK_SIZE(KPB_MAX_SUPPORTED_CHANNELS)];
+	uint8_t drain_block[KPB_ADPCM_BLOCK_SIZE(KPB_MAX_SUPPORTED_CHANNELS)];
 };
 
 struct history_data {
 	size_t buffer_size; /**< size of internal history buffer */
-	size_t buffered; /**< amount of buffered data */
+	size_t buffered; /**< amount of buffered data, coded size with ADPCM */
 	size_t free; /** spce we can use to write new data */
 	struct history_buffer *c_hb; /**< current buffer used for writing */
 };
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_AUDIO_KPB_ADPCM_H__
+#define __SOF_AUDIO_KPB_ADPCM_H__
+
+#include <sof/audio/format.h>
+#include <sof/audio/kpb.h>
+#include <sof/math/numbers.h>
+#include <rtos/string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Largest IMA ADPCM step size index */
+#define KPB_ADPCM_MAX_INDEX 88
+
+/**
+ * \brief IMA ADPCM step size.
+ * \param[in] index - step size index, up to KPB_ADPCM_MAX_INDEX.
+ */
+static inline int32_t kpb_adpcm_step(int index)
+{
+	static const int16_t steps[KPB_ADPCM_MAX_INDEX + 1] = {
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+		19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+		50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+		130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+		337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+		876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+		2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+		5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+		15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+	};
+
+	return steps[index];
+}
+
+/**
+ * \brief Updates coder state with a code, shared by encoder and decoder.
+ * \param[in,out] st - coder state of the channel.
+ * \param[in] code - 4 bit code.
+ * \return Decoded sample.
+ */
+static inline int16_t kpb_adpcm_update(struct kpb_adpcm_state *st, uint8_t code)
+{
+	/* step size index change for code magnitude */
+	static const int8_t index_adjust[] = {-1, -1, -1, -1, 2, 4, 6, 8};
+	int32_t step = kpb_adpcm_step(st->index);
+	int32_t diff = step >> 3;
+	int index;
+
+	if (code & 4)
+		diff += step;
+	if (code & 2)
+		diff += step >> 1;
+	if (code & 1)
+		diff += step >> 2;
+
+	st->predictor = sat_int16(st->predictor + (code & 8 ? -diff : diff));
+	index = st->index + index_adjust[code & 7];
+	st->index = MAX(0, MIN(index, KPB_ADPCM_MAX_INDEX));
+
+	return st->predictor;
+}
+
+/**
+ * \brief Codes a sample.
+ * \param[in,out] st - coder state of the channel.
+ * \param[in] x - sample.
+ * \return 4 bit code.
+ */
+static inline uint8_t kpb_adpcm_encode(struct kpb_adpcm_state *st, int16_t x)
+{
+	int32_t step = kpb_adpcm_step(st->index);
+	int32_t diff = x - st->predictor;
+	uint8_t code = 0;
+
+	if (diff < 0) {
+		code = 8;
+		diff = -diff;
+	}
+
+	if (diff >= step) {
+		code |= 4;
+		diff -= step;
+	}
+
+	step >>= 1;
+	if (diff >= step) {
+		code |= 2;
+		diff -= step;
+	}
+
+	step >>= 1;
+	if (diff >= step)
+		code |= 1;
+
+	kpb_adpcm_update(st, code);
+
+	return code;
+}
+
+/**
+ * \brief Loads the decoder state of every channel from a block header.
+ * \param[out] st - coder state of the channels.
+ * \param[in] header - block header.
+ * \param[in] channels - number of channels.
+ *
+ * The step size index is limited, so a header read from a wrong offset is
+ * decoded to noise but never indexes outside of the step size table.
+ */
+static inline void kpb_adpcm_load_state(struct kpb_adpcm_state *st, const uint8_t *header,
+					size_t channels)
+{
+	size_t c;
+
+	memcpy_s(st, channels * sizeof(*st), header, channels * sizeof(*st));
+	for (c = 0; c < channels; c++)
+		st[c].index = MIN(st[c].index, KPB_ADPCM_MAX_INDEX);
+}
+
+#endif /* __SOF_AUDIO_KPB_ADPCM_H__ */
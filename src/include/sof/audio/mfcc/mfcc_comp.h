@@ -30,6 +30,11 @@
  */
 #define MFCC_FFT_BITS	16
 
+/* Output cepstral coefficients frame is magic (2) plus num_ceps int16_t samples. The
+ * frames are written back to back into the sink and the rest of period is zero filled.
+ */
+#define MFCC_MAGIC_SAMPLES	2
+
 struct audio_stream;
 struct comp_dev;
 
@@ -89,14 +94,20 @@ struct mfcc_cepstral_lifter {
 
 struct mfcc_state {
 	struct mfcc_buffer buf; /**< Circular buffer for input data */
+	struct mfcc_buffer out_buf; /**< Circular buffer for output cepstral frames */
 	struct mfcc_pre_emph emph; /**< Pre-emphasis filter */
 	struct mfcc_fft fft; /**< FFT related */
 	struct dct_plan_16 dct; /**< DCT related */
 	struct psy_mel_filterbank melfb; /**< Mel filter bank */
 	struct mfcc_cepstral_lifter lifter; /**< Cepstral lifter coefficients */
-	struct mat_matrix_16b *mel_spectra; /**< Pointer to scratch */
-	struct mat_matrix_16b *cepstral_coef; /**< Pointer to scratch */
-	int32_t *power_spectra; /**< Pointer to scratch */
+	struct mat_matrix_16b *dct_transposed; /**< DCT matrix transpose, num_ceps x num_mel_bins */
+	struct mat_matrix_16b *mel_spectra; /**< Mel spectra of hops, max_hops x num_mel_bins */
+	struct mat_matrix_16b *cepstral_coef; /**< Cepstral coefficients, max_hops x num_ceps */
+#if MFCC_FFT_BITS == 16
+	int32_t *power_spectra; /**< half_fft_size */
+#else
+	int64_t *power_spectra; /**< half_fft_size */
+#endif
 	int16_t buf_avail;
 	int16_t *buffers;
 	int16_t *prev_data; /**< prev_data_size */
@@ -104,7 +115,9 @@ struct mfcc_state {
 	int16_t *triangles;
 	int source_channel;
 	int buffer_size;
+	int out_buffer_size;
 	int prev_data_size;
+	int max_hops;
 	int low_freq;
 	int high_freq;
 	int sample_rate;
@@ -17,6 +17,9 @@
 
 #ifdef UNIT_TEST
 void sys_comp_mixer_init(void);
+#if CONFIG_IPC_MAJOR_4
+void sys_comp_mixin_init(void);
+#endif
 #endif
 
 #define MIXER_GENERIC
@@ -161,6 +161,8 @@ struct processing_module {
 	struct comp_dev *dev;
 	uint32_t period_bytes; /** pipeline period bytes */
 	uint32_t deep_buff_bytes; /**< copy start threshold */
+	uint32_t deep_buff_fill_min; /**< lowest local buffer level seen while copying */
+	uint32_t deep_buff_fill_max; /**< highest local buffer level seen while copying */
 	uint32_t output_buffer_size; /**< size of local buffer to save produced samples */
 	struct input_stream_buffer *input_buffers;
 	struct output_stream_buffer *output_buffers;
@@ -16,6 +16,12 @@
 #include <sof/math/iir_df2t.h>
 #include <user/multiband_drc.h>
 
+/* The processing runs all the stages for a block of frames at a time.
+ * The block matches the DRC division so that a block normally ends where
+ * the band compressors update their gain envelopes.
+ */
+#define MULTIBAND_DRC_BLOCK_FRAMES DRC_DIVISION_FRAMES
+
 /**
  * Stores the state of the sub-components in Multiband DRC
  */
@@ -24,6 +30,13 @@ struct multiband_drc_state {
 	struct crossover_state crossover[PLATFORM_MAX_CHANNELS];
 	struct drc_state drc[SOF_MULTIBAND_DRC_MAX_BANDS];
 	struct iir_state_df2t deemphasis[PLATFORM_MAX_CHANNELS];
+
+	/* Block buffers for the processing stages, stored per channel and
+	 * per band so that each stage reads and writes contiguous frames.
+	 */
+	int32_t buf[PLATFORM_MAX_CHANNELS][MULTIBAND_DRC_BLOCK_FRAMES];
+	int32_t band_buf[SOF_MULTIBAND_DRC_MAX_BANDS][PLATFORM_MAX_CHANNELS]
+			[MULTIBAND_DRC_BLOCK_FRAMES];
 };
 
 typedef void (*multiband_drc_func)(const struct comp_dev *dev,
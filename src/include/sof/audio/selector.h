@@ -22,6 +22,7 @@
 #endif
 #include <user/selector.h>
 #include <user/trace.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 struct comp_buffer;
@@ -62,6 +63,7 @@ struct comp_data {
 	enum sof_ipc_frame sink_format;		/**< sink frame format */
 	struct sof_sel_config config;	/**< component configuration data */
 	sel_func sel_func;	/**< channel selector processing function */
+	bool alias;		/**< sink buffer aliases the source buffer */
 };
 
 /** \brief Selector processing functions map. */
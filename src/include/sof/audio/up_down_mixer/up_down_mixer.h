@@ -21,6 +21,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/* Select optimized code variant when xt-xcc compiler is used */
+#if defined __XCC__
+#include <xtensa/config/core-isa.h>
+#if XCHAL_HAVE_HIFI3 == 1
+#define UP_DOWN_MIXER_GENERIC	0
+#define UP_DOWN_MIXER_HIFI3	1
+#else
+#define UP_DOWN_MIXER_GENERIC	1
+#define UP_DOWN_MIXER_HIFI3	0
+#endif /* XCHAL_HAVE_HIFI3 */
+#else
+/* GCC */
+#define UP_DOWN_MIXER_GENERIC	1
+#define UP_DOWN_MIXER_HIFI3	0
+#endif /* __XCC__ */
+
 /** This type is introduced for better readability. */
 typedef const int32_t *downmix_coefficients;
 
@@ -115,6 +115,15 @@ struct sof_ipc_ctrl_value_chan;
 typedef void (*vol_scale_func)(struct processing_module *mod, struct input_stream_buffer *source,
 			       struct output_stream_buffer *sink, uint32_t frames);
 
+/**
+ * \brief volume ramp processing function interface, the gain of each channel
+ * is interpolated per frame from start_volume to the current volume
+ */
+typedef void (*vol_ramp_scale_func)(struct processing_module *mod,
+				    struct input_stream_buffer *source,
+				    struct output_stream_buffer *sink, uint32_t frames,
+				    const int32_t *start_volume);
+
 /**
  * \brief volume interface for function getting nearest zero crossing frame
  */
@@ -140,6 +149,8 @@ struct vol_data {
 	int32_t mvolume[SOF_IPC_MAX_CHANNELS];	/**< mute volume */
 	int32_t rvolume[SOF_IPC_MAX_CHANNELS];	/**< ramp start volume */
 	int32_t ramp_coef[SOF_IPC_MAX_CHANNELS]; /**< parameter for slope */
+	int32_t ramp_zc_vol[SOF_IPC_MAX_CHANNELS]; /**< ramp gain held until zero crossing */
+	int32_t ramp_zc_prev[SOF_IPC_MAX_CHANNELS]; /**< last sample for zero crossing */
 	/**< store current volume 4 times for scale_vol function */
 	int32_t *vol;
 	uint32_t initial_ramp;			/**< ramp space in ms */
@@ -155,7 +166,9 @@ struct vol_data {
 	bool muted[SOF_IPC_MAX_CHANNELS];	/**< set if channel is muted */
 	bool vol_ramp_active;			/**< set if volume is ramped */
 	bool ramp_finished;			/**< control ramp launch */
+	bool ramp_zc_state;			/**< zero crossing state from previous period */
 	vol_scale_func scale_vol;		/**< volume processing function */
+	vol_ramp_scale_func scale_vol_ramp;	/**< ramp processing function, optional */
 	vol_zc_func zc_get;			/**< function getting nearest zero crossing frame */
 	vol_ramp_func ramp_func;		/**< function for ramp shape */
 };
@@ -164,6 +177,7 @@ struct vol_data {
 struct comp_func_map {
 	uint16_t frame_fmt;	/**< frame format */
 	vol_scale_func func;	/**< volume processing function */
+	vol_ramp_scale_func ramp_func;	/**< volume ramp processing function */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
@@ -224,6 +238,23 @@ static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
 }
 #endif
 
+/**
+ * \brief Retrieves volume ramp processing function matching the volume
+ * processing function. NULL if the ramp is processed in chunks instead.
+ * \param[in] func Volume processing function.
+ */
+static inline vol_ramp_scale_func vol_get_ramp_processing_function(vol_scale_func func)
+{
+	int i;
+
+	for (i = 0; i < volume_func_count; i++) {
+		if (volume_func_map[i].func == func)
+			return volume_func_map[i].ramp_func;
+	}
+
+	return NULL;
+}
+
 static inline void peak_vol_update(struct vol_data *cd)
 {
 #if CONFIG_COMP_PEAK_VOL
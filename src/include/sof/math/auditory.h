@@ -85,7 +85,8 @@ int psy_get_mel_filterbank(struct psy_mel_filterbank *mel_fb);
  * \param[in]  mel_fb        Struct with filterbank parameters and filter coefficients to apply.
  * \param[in]  fft_out       Array of complex numbers from FFT in Q1.15 format.
  * \param[out] power_spectra Array of linear power spectra, needed scratch are that is half + 1
- *                           side of fft_out. The data can be discarded after if no use.
+ *                           side of fft_out, 32 bit Q2.30 values without normalize shift.
+ *                           The data can be discarded after if no use.
  * \param[out] mel_log       Array of Q9.7 log/log10/10log10 format Mel band energies.
  * \param[in]  bitshift      A shift left scale that has been possibly applied to FFT. This will
  *                           be subtracted from the log or decibels notation.
@@ -100,12 +101,13 @@ void psy_apply_mel_filterbank_16(struct psy_mel_filterbank *mel_fb, struct icomp
  * \param[in]  mel_fb        Struct with filterbank parameters and filter coefficients to apply.
  * \param[in]  fft_out       Array of complex numbers from FFT in Q1.31 format.
  * \param[out] power_spectra Array of linear power spectra, needed scratch are that is half + 1
- *                           side of fft_out. The data can be discarded after if no use.
+ *                           side of fft_out, 64 bit Q2.62 values without normalize shift.
+ *                           The data can be discarded after if no use.
  * \param[out] mel_log       Array of Q9.7 log/log10/10log10 format Mel band energies.
  * \param[in]  bitshift      A shift left scale that has been possibly applied to FFT. This will
  *                           be subtracted from the log or decibels notation.
  */
 void psy_apply_mel_filterbank_32(struct psy_mel_filterbank *mel_fb, struct icomplex32 *fft_out,
-				 int32_t *power_spectra, int16_t *mel_log, int bitshift);
+				 int64_t *power_spectra, int16_t *mel_log, int bitshift);
 
 #endif /* __SOF_MATH_AUDITORY_H__ */
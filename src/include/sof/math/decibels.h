@@ -16,7 +16,14 @@
 #define DB2LIN_FIXED_INPUT_QY 24
 #define DB2LIN_FIXED_OUTPUT_QY 20
 
+/* Number of values the array versions process at a time */
+#define EXP_FIXED_VEC_BLOCK 8
+
 int32_t exp_fixed(int32_t x); /* Input is Q5.27, output is Q12.20 */
 int32_t db2lin_fixed(int32_t x); /* Input is Q8.24, output is Q12.20 */
 
+/* Array versions of the above, bit exact with them */
+void exp_fixed_vec(const int32_t *x, int32_t *y, int n);
+void db2lin_fixed_vec(const int32_t *db, int32_t *y, int n);
+
 #endif /* __SOF_MATH_DECIBELS_H__ */
@@ -75,6 +75,8 @@ void iir_reset_df2t(struct iir_state_df2t *iir);
 
 int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x);
 
+void iir_df2t_block(struct iir_state_df2t *iir, int32_t *y, const int32_t *x, int n);
+
 /* Inline functions with or without HiFi3 intrinsics */
 #if IIR_HIFI3
 #include "iir_df2t_hifi3.h"
@@ -23,6 +23,20 @@ struct mat_matrix_16b {
 	int16_t data[];
 };
 
+struct mat_matrix_32b {
+	int16_t rows;
+	int16_t columns;
+	int16_t fractions;
+	int16_t reserved;
+	int32_t data[];
+};
+
+/* Number of output columns those are computed together in matrix multiply. The
+ * accumulators of a block are kept in registers while a row of a is multiplied
+ * with the block of contiguous data in rows of b.
+ */
+#define MAT_BLOCK_COLUMNS	8
+
 static inline void mat_init_16b(struct mat_matrix_16b *mat, int16_t rows, int16_t columns,
 				int16_t fractions)
 {
@@ -75,8 +89,95 @@ static inline int16_t *mat_get_row_vector_16b(struct mat_matrix_16b *mat, int ro
 	return mat->data + row * mat->columns;
 }
 
+static inline void mat_init_32b(struct mat_matrix_32b *mat, int16_t rows, int16_t columns,
+				int16_t fractions)
+{
+	mat->rows = rows;
+	mat->columns = columns;
+	mat->fractions = fractions;
+}
+
+static inline struct mat_matrix_32b *mat_matrix_alloc_32b(int16_t rows, int16_t columns,
+							  int16_t fractions)
+{
+	struct mat_matrix_32b *mat;
+	const int mat_size = sizeof(int32_t) * rows * columns + sizeof(struct mat_matrix_32b);
+
+	mat = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, mat_size);
+	if (mat)
+		mat_init_32b(mat, rows, columns, fractions);
+
+	return mat;
+}
+
+static inline void mat_copy_from_linear_32b(struct mat_matrix_32b *mat, const int32_t *lin_data)
+{
+	size_t bytes = sizeof(int32_t) * mat->rows * mat->columns;
+
+	memcpy_s(mat->data, bytes, lin_data, bytes);
+}
+
+static inline int32_t mat_get_scalar_32b(struct mat_matrix_32b *mat, int row, int col)
+{
+	return mat->data[col + row * mat->columns];
+}
+
+static inline void mat_set_scalar_32b(struct mat_matrix_32b *mat, int row, int col, int32_t val)
+{
+	mat->data[col + row * mat->columns] = val;
+}
+
+static inline int32_t *mat_get_row_vector_32b(struct mat_matrix_32b *mat, int row)
+{
+	return mat->data + row * mat->columns;
+}
+
 int mat_multiply(struct mat_matrix_16b *a, struct mat_matrix_16b *b, struct mat_matrix_16b *c);
 
+/**
+ * \brief Matrix multiply c = a * b with pre-transposed b.
+ *
+ * The matrix b is given as its transpose bt of size (c columns, a columns). Both
+ * a and bt are then accessed as contiguous rows that is the fastest form for a
+ * constant b, e.g. a DCT or weights matrix, that can be transposed once in setup.
+ * The result is bit exact with mat_multiply().
+ *
+ * \param[in]  a   Matrix a, Qx.y
+ * \param[in]  bt  Transposed matrix b, Qx.y
+ * \param[out] c   Result matrix, Qx.y
+ * \return        Zero if success, -EINVAL if matrix sizes don't match.
+ */
+int mat_multiply_transposed(struct mat_matrix_16b *a, struct mat_matrix_16b *bt,
+			    struct mat_matrix_16b *c);
+
+/**
+ * \brief Matrix multiply c = a * b with 16 bit a and b and 32 bit saturated result.
+ * \param[in]  a   Matrix a, 16 bit Qx.y
+ * \param[in]  b   Matrix b, 16 bit Qx.y
+ * \param[out] c   Result matrix, 32 bit Qx.y
+ * \return        Zero if success, -EINVAL if matrix sizes don't match.
+ */
+int mat_multiply_16b_32b(struct mat_matrix_16b *a, struct mat_matrix_16b *b,
+			 struct mat_matrix_32b *c);
+
+/**
+ * \brief Matrix multiply c = a * b with 32 bit a and 16 bit b and 32 bit saturated result.
+ * \param[in]  a   Matrix a, 32 bit Qx.y
+ * \param[in]  b   Matrix b, 16 bit Qx.y
+ * \param[out] c   Result matrix, 32 bit Qx.y
+ * \return        Zero if success, -EINVAL if matrix sizes don't match.
+ */
+int mat_multiply_32b_16b(struct mat_matrix_32b *a, struct mat_matrix_16b *b,
+			 struct mat_matrix_32b *c);
+
+/**
+ * \brief Transpose matrix, at = a'.
+ * \param[in]  a   Matrix to transpose
+ * \param[out] at  Transposed matrix of size (a columns, a rows), the fractions is copied
+ * \return        Zero if success, -EINVAL if matrix sizes don't match.
+ */
+int mat_transpose_16b(struct mat_matrix_16b *a, struct mat_matrix_16b *at);
+
 int mat_multiply_elementwise(struct mat_matrix_16b *a, struct mat_matrix_16b *b,
 			     struct mat_matrix_16b *c);
 
@@ -21,6 +21,7 @@
 #define CORDIC_15B_TABLE_SIZE		15
 #define CORDIC_30B_ITABLE_SIZE		30
 #define CORDIC_16B_ITABLE_SIZE		16
+#define CORDIC_VEC_BLOCK		16
 
 typedef enum {
 	EN_32B_CORDIC_SINE,
@@ -41,6 +42,18 @@ void cordic_approx(int32_t th_rad_fxp, int32_t a_idx, int32_t *sign, int32_t *b_
 int32_t is_scalar_cordic_acos(int32_t realvalue, int16_t numiters);
 int32_t is_scalar_cordic_asin(int32_t realvalue, int16_t numiters);
 void cmpx_cexp(int32_t sign, int32_t b_yn, int32_t xn, cordic_cfg type, struct cordic_cmpx *cexp);
+
+/**
+ * Array versions of sin_fixed_32b(), cos_fixed_32b(), sin_fixed_16b() and
+ * cos_fixed_16b(). Both sine and cosine come from the same rotation, and
+ * the angles are processed in blocks of CORDIC_VEC_BLOCK. The results are
+ * bit exact with the scalar functions. Either output can be NULL if only
+ * the other one is needed.
+ * Input is Q4.28, output is Q1.31 or Q1.15
+ */
+void sin_cos_fixed_32b_vec(const int32_t *th_rad_fxp, int32_t *sin_out, int32_t *cos_out, int n);
+void sin_cos_fixed_16b_vec(const int32_t *th_rad_fxp, int16_t *sin_out, int16_t *cos_out, int n);
+
 /* Input is Q4.28, output is Q1.31 */
 /**
  * Compute fixed point cordicsine with table lookup and interpolation
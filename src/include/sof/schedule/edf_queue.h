@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_SCHEDULE_EDF_QUEUE_H__
+#define __SOF_SCHEDULE_EDF_QUEUE_H__
+
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/task.h>
+#include <stdint.h>
+
+/*
+ * EDF run queue kept as a binary min heap of tasks ordered by deadline,
+ * so the earliest deadline task is found in constant time and adding or
+ * removing a task costs O(log n). The heap storage is provided by the
+ * caller, so none of the operations allocate memory.
+ */
+struct edf_queue {
+	struct task **tasks;	/* heap storage */
+	uint32_t size;		/* number of tasks the storage fits */
+	uint32_t count;		/* number of queued tasks */
+	uint32_t seq;		/* order of queueing for equal deadlines */
+};
+
+/* earliest deadline task or NULL if the queue is empty */
+static inline struct task *edf_queue_peek(struct edf_queue *queue)
+{
+	return queue->count ? queue->tasks[0] : NULL;
+}
+
+static inline bool edf_queue_contains(struct task *task)
+{
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+
+	return edf_pdata->queue_index >= 0;
+}
+
+/* replace the heap storage, returns the previous one for the caller to free */
+struct task **edf_queue_set_storage(struct edf_queue *queue, struct task **tasks,
+				    uint32_t size);
+
+int edf_queue_push(struct edf_queue *queue, struct task *task, uint64_t deadline);
+
+void edf_queue_remove(struct edf_queue *queue, struct task *task);
+
+#endif /* __SOF_SCHEDULE_EDF_QUEUE_H__ */
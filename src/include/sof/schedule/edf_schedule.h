@@ -20,6 +20,9 @@
 
 struct edf_task_pdata {
 	void *ctx;
+	uint64_t deadline;	/**< deadline the task was queued with */
+	uint32_t seq;		/**< queueing order among equal deadlines */
+	int32_t queue_index;	/**< position in the run queue, -1 if not queued */
 };
 
 int scheduler_init_edf(void);
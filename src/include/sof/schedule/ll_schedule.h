@@ -19,6 +19,7 @@
 #include <stdint.h>
 
 struct ll_schedule_domain;
+struct task_load;
 
 /* ll tracing */
 extern struct tr_ctx ll_tr;
@@ -32,6 +33,13 @@ struct ll_task_pdata {
 	uint64_t period;
 	uint16_t ratio;		/**< ratio of periods compared to the registrable task */
 	uint16_t skip_cnt;	/**< how many times the task was skipped for execution */
+	uint32_t order;		/**< position of the task in the priority ordered list */
+	struct task *task;	/**< task owning the data */
+	struct list_item start_list;	/**< entry in the start time ordered list */
+	struct list_item run_list;	/**< entry in the list of tasks due to run */
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct task_load *load;		/**< run time statistics */
+#endif
 };
 
 #if !defined(__ZEPHYR__) || defined(CONFIG_IMX)
@@ -41,6 +49,9 @@ int schedule_task_init_ll(struct task *task,
 			  const struct sof_uuid_entry *uid, uint16_t type,
 			  uint16_t priority, enum task_state (*run)(void *data),
 			  void *data, uint16_t core, uint32_t flags);
+
+/* run time statistics of the task, NULL if they are not collected */
+struct task_load *schedule_ll_task_load(struct task *task);
 #else
 int zephyr_ll_scheduler_init(struct ll_schedule_domain *domain);
 
@@ -14,6 +14,7 @@
 #include <sof/lib/cpu.h>
 #include <rtos/clk.h>
 #include <sof/lib/memory.h>
+#include <sof/list.h>
 #include <sof/sof.h>
 #include <rtos/spinlock.h>
 #include <sof/trace/trace.h>
@@ -57,6 +58,9 @@ struct ll_schedule_domain {
 	void *priv_data;		/**< pointer to private data */
 	bool enabled[CONFIG_CORE_COUNT];		/**< enabled cores */
 	const struct ll_schedule_domain_ops *ops;	/**< domain ops */
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct list_item task_loads;	/**< load statistics of the scheduled tasks */
+#endif
 };
 
 #define ll_sch_domain_set_pdata(domain, data) ((domain)->priv_data = (data))
@@ -97,6 +101,9 @@ static inline struct ll_schedule_domain *domain_init
 	k_spinlock_init(&domain->lock);
 	atomic_init(&domain->total_num_tasks, 0);
 	atomic_init(&domain->enabled_cores, 0);
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	list_init(&domain->task_loads);
+#endif
 
 	return domain;
 }
@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_SCHEDULE_TASK_LOAD_H__
+#define __SOF_SCHEDULE_TASK_LOAD_H__
+
+#include <sof/list.h>
+#include <stdint.h>
+
+struct task;
+
+/*
+ * Run time statistics of a periodic task kept in a fixed size log scale
+ * histogram. Every power of two range of run times is split in
+ * TASK_LOAD_SUB_BUCKETS equal buckets, so a percentile read from it is
+ * within 1 / TASK_LOAD_SUB_BUCKETS of the real value over the whole
+ * 32 bit range.
+ */
+#define TASK_LOAD_SUB_BITS	2
+#define TASK_LOAD_SUB_BUCKETS	(1 << TASK_LOAD_SUB_BITS)
+#define TASK_LOAD_BUCKETS	((32 - TASK_LOAD_SUB_BITS + 1) * TASK_LOAD_SUB_BUCKETS)
+
+struct task_load {
+	struct list_item list;		/**< entry in the list of tracked tasks */
+	struct task *task;		/**< task the statistics belong to */
+	uint32_t budget;		/**< run time available in a period, 0 if none */
+	uint32_t runs;			/**< number of runs in the histogram */
+	uint32_t overruns;		/**< runs longer than the budget */
+	uint32_t max;			/**< longest run */
+	uint32_t hist[TASK_LOAD_BUCKETS];	/**< runs per run time bucket */
+};
+
+void task_load_init(struct task_load *load, struct task *task);
+
+/* account one run of the task */
+void task_load_add(struct task_load *load, uint32_t time);
+
+/* run time not exceeded by permille / 1000 of the runs */
+uint32_t task_load_percentile(const struct task_load *load, uint32_t permille);
+
+#endif /* __SOF_SCHEDULE_TASK_LOAD_H__ */
@@ -46,6 +46,8 @@
 #include <user/trace.h>
 #include <ipc/probe.h>
 #include <sof/probe/probe.h>
+#include <sof/schedule/ll_schedule_domain.h>
+#include <sof/schedule/task_load.h>
 
 #include <errno.h>
 #include <math.h>
@@ -1494,6 +1496,71 @@ static int ipc_glb_test_mem_usage(uint32_t header)
 }
 #endif
 
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+static int fill_task_load_elems(struct ll_schedule_domain *domain, int elem_number,
+				struct sof_ipc_dbg_task_load_elem *elems)
+{
+	struct task_load *load;
+	struct list_item *tlist;
+	k_spinlock_key_t key;
+	int i = 0;
+
+	if (!domain)
+		return 0;
+
+	key = k_spin_lock(&domain->lock);
+
+	list_for_item(tlist, &domain->task_loads) {
+		if (i == elem_number)
+			break;
+
+		load = container_of(tlist, struct task_load, list);
+		elems[i].uid = (uint32_t)(uintptr_t)load->task->uid;
+		elems[i].core = load->task->core;
+		elems[i].budget = load->budget;
+		elems[i].runs = load->runs;
+		elems[i].overruns = load->overruns;
+		elems[i].p50 = task_load_percentile(load, 500);
+		elems[i].p99 = task_load_percentile(load, 990);
+		elems[i].p999 = task_load_percentile(load, 999);
+		elems[i].max = load->max;
+		i++;
+	}
+
+	k_spin_unlock(&domain->lock, key);
+
+	return i;
+}
+
+static int ipc_glb_debug_task_load(uint32_t header)
+{
+	/* as many tasks as fit in a reply */
+	int elem_cnt = (SOF_IPC_MSG_MAX_SIZE - sizeof(struct sof_ipc_dbg_task_load)) /
+		       sizeof(struct sof_ipc_dbg_task_load_elem);
+	struct sof_ipc_dbg_task_load *task_load;
+	struct sof_ipc_dbg_task_load_elem *elems;
+	int n;
+
+	task_load = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, 0, SOF_IPC_MSG_MAX_SIZE);
+	if (!task_load)
+		return -ENOMEM;
+
+	elems = task_load->elems;
+	n = fill_task_load_elems(timer_domain_get(), elem_cnt, elems);
+	n += fill_task_load_elems(dma_domain_get(), elem_cnt - n, elems + n);
+
+	task_load->rhdr.hdr.cmd = header;
+	task_load->rhdr.hdr.size = sizeof(*task_load) + n * sizeof(*elems);
+	task_load->num_elems = n;
+
+	/* write task statistics to the outbox */
+	mailbox_hostbox_write(0, task_load, task_load->rhdr.hdr.size);
+
+	rfree(task_load);
+	return 1;
+}
+#endif
+
 static int ipc_glb_debug_message(uint32_t header)
 {
 	uint32_t cmd = iCS(header);
@@ -1502,6 +1569,10 @@ static int ipc_glb_debug_message(uint32_t header)
 #if CONFIG_DEBUG_MEMORY_USAGE_SCAN
 	case SOF_IPC_DEBUG_MEM_USAGE:
 		return ipc_glb_test_mem_usage(header);
+#endif
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	case SOF_IPC_DEBUG_TASK_LOAD:
+		return ipc_glb_debug_task_load(header);
 #endif
 	default:
 		tr_err(&ipc_tr, "ipc: unknown debug header 0x%x", header);
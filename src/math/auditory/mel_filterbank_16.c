@@ -28,22 +28,20 @@ void psy_apply_mel_filterbank_16(struct psy_mel_filterbank *fb, struct icomplex1
 	int lshift;
 
 	/* A FFT out bin is used several times in Mel bands conversion, so first
-	 * convert FFT to real power spectra, p = (a + bi)(a - bi) = a^2 + b^2
+	 * convert FFT to real power spectra, p = (a + bi)(a - bi) = a^2 + b^2.
+	 * The power is computed once and the normalizing shift is applied when
+	 * the power is integrated with the triangles.
 	 */
 	pmax = 0;
 	for (i = 0; i < fb->half_fft_bins; i++) {
 		p = (int32_t)fft_out[i].real * fft_out[i].real +
 			(int32_t)fft_out[i].imag * fft_out[i].imag;
+		power_spectra[i] = p;
 		pmax = MAX(pmax, p);
 	}
 
 	/* Power spectra is Q2.30 */
 	lshift = norm_int32(pmax);
-	for (i = 0; i < fb->half_fft_bins; i++) {
-		p = (int32_t)fft_out[i].real * fft_out[i].real +
-			(int32_t)fft_out[i].imag * fft_out[i].imag;
-		power_spectra[i] = p << lshift;
-	}
 
 	for (i = 0; i < fb->mel_bins; i++) {
 		/* Integrate power spectrum with Mel filter bank triangle weights */
@@ -58,7 +56,8 @@ void psy_apply_mel_filterbank_16(struct psy_mel_filterbank *fb, struct icomplex1
 		 * to be later scaled with fb->scale.
 		 */
 		for (j = 0; j < num_bins; j++)
-			pp += (int64_t)power_spectra[start_bin + j] * fb->data[coef_idx + j];
+			pp += (int64_t)(power_spectra[start_bin + j] << lshift) *
+				fb->data[coef_idx + j];
 
 		/* Convert Mel band energy from Q19.45 to Q7.25 that has sufficient headroom
 		 * for worst-case all ones FFT output. Log2() function input is unsigned Q32.0,
@@ -12,11 +12,12 @@
 #include <stdint.h>
 
 void psy_apply_mel_filterbank_32(struct psy_mel_filterbank *fb, struct icomplex32 *fft_out,
-				 int32_t *power_spectra, int16_t *mel_log, int bitshift)
+				 int64_t *power_spectra, int16_t *mel_log, int bitshift)
 {
 	int64_t pmax;
 	int64_t p;
 	int32_t log_arg;
+	int32_t ps;
 	int32_t log;
 	int next_idx;
 	int start_bin;
@@ -27,23 +28,21 @@ void psy_apply_mel_filterbank_32(struct psy_mel_filterbank *fb, struct icomplex3
 	int lshift;
 
 	/* A FFT out bin is used several times in Mel bands conversion, so first
-	 * convert FFT to real power spectra, p = (a + bi)(a - bi) = a^2 + b^2
+	 * convert FFT to real power spectra, p = (a + bi)(a - bi) = a^2 + b^2.
+	 * The power is computed once and the normalizing shift is applied when
+	 * the power is integrated with the triangles.
 	 */
 	pmax = 0;
 	for (i = 0; i < fb->half_fft_bins; i++) {
 		p = (int64_t)fft_out[i].real * fft_out[i].real +
 			(int64_t)fft_out[i].imag * fft_out[i].imag;
+		power_spectra[i] = p;
 		pmax = MAX(pmax, p);
 	}
 
 	/* Product Q2.62, convert to 2.30 */
 	pmax = sat_int32(pmax >> 32);
 	lshift = norm_int32(pmax);
-	for (i = 0; i < fb->half_fft_bins; i++) {
-		p = (int64_t)fft_out[i].real * fft_out[i].real +
-			(int64_t)fft_out[i].imag * fft_out[i].imag;
-		power_spectra[i] = Q_SHIFT_RND(p << lshift, 62, 30);
-	}
 
 	for (i = 0; i < fb->mel_bins; i++) {
 		/* Integrate power spectrum with Mel filter bank triangle weights */
@@ -57,8 +56,10 @@ void psy_apply_mel_filterbank_32(struct psy_mel_filterbank *fb, struct icomplex3
 		/* Accumulate power as Q3.45 (Q2.30 x Q1.15). Note that filter bank need
 		 * to be later scaled with fb->scale.
 		 */
-		for (j = 0; j < num_bins; j++)
-			p += (int64_t)power_spectra[start_bin + j] * fb->data[coef_idx + j];
+		for (j = 0; j < num_bins; j++) {
+			ps = Q_SHIFT_RND(power_spectra[start_bin + j] << lshift, 62, 30);
+			p += (int64_t)ps * fb->data[coef_idx + j];
+		}
 
 		/* Convert Mel band energy from Q19.45 to Q7.25 that has sufficient headroom
 		 * for worst-case all ones FFT output. Log2() function input is unsigned Q32.0,
@@ -6,12 +6,28 @@
 //
 //
 
+#include <sof/common.h>
 #include <sof/math/log.h>
 
 /* Defines Constant*/
 #define BASE2LOG_WRAP_SCHAR_BITS 0xFF
 #define BASE2LOG_UPPERBYTES 0xFFFFFF
 #define BASE2LOG_WORDLENGTH 0x1F
+
+/* log2(1 + i / 128) in Q16.16 */
+static const int32_t iv1[129] = {
+	    0,   736,  1466,  2190,  2909,  3623,  4331,  5034,  5732,  6425,  7112,  7795,
+	 8473,  9146,  9814, 10477, 11136, 11791, 12440, 13086, 13727, 14363, 14996, 15624,
+	16248, 16868, 17484, 18096, 18704, 19308, 19909, 20505, 21098, 21687, 22272, 22854,
+	23433, 24007, 24579, 25146, 25711, 26272, 26830, 27384, 27936, 28484, 29029, 29571,
+	30109, 30645, 31178, 31707, 32234, 32758, 33279, 33797, 34312, 34825, 35334, 35841,
+	36346, 36847, 37346, 37842, 38336, 38827, 39316, 39802, 40286, 40767, 41246, 41722,
+	42196, 42667, 43137, 43603, 44068, 44530, 44990, 45448, 45904, 46357, 46809, 47258,
+	47705, 48150, 48593, 49034, 49472, 49909, 50344, 50776, 51207, 51636, 52063, 52488,
+	52911, 53332, 53751, 54169, 54584, 54998, 55410, 55820, 56229, 56635, 57040, 57443,
+	57845, 58245, 58643, 59039, 59434, 59827, 60219, 60609, 60997, 61384, 61769, 62152,
+	62534, 62915, 63294, 63671, 64047, 64421, 64794, 65166, 65536};
+
 /**
  *  Base-2 logarithm log2(n)
  *
@@ -36,18 +52,6 @@
  */
 int32_t base2_logarithm(uint32_t u)
 {
-	static const int32_t iv1[129] = {
-	    0,	   736,	  1466,	 2190,	2909,  3623,  4331,  5034,  5732,  6425,  7112,	 7795,
-	    8473,  9146,  9814,	 10477, 11136, 11791, 12440, 13086, 13727, 14363, 14996, 15624,
-	    16248, 16868, 17484, 18096, 18704, 19308, 19909, 20505, 21098, 21687, 22272, 22854,
-	    23433, 24007, 24579, 25146, 25711, 26272, 26830, 27384, 27936, 28484, 29029, 29571,
-	    30109, 30645, 31178, 31707, 32234, 32758, 33279, 33797, 34312, 34825, 35334, 35841,
-	    36346, 36847, 37346, 37842, 38336, 38827, 39316, 39802, 40286, 40767, 41246, 41722,
-	    42196, 42667, 43137, 43603, 44068, 44530, 44990, 45448, 45904, 46357, 46809, 47258,
-	    47705, 48150, 48593, 49034, 49472, 49909, 50344, 50776, 51207, 51636, 52063, 52488,
-	    52911, 53332, 53751, 54169, 54584, 54998, 55410, 55820, 56229, 56635, 57040, 57443,
-	    57845, 58245, 58643, 59039, 59434, 59827, 60219, 60609, 60997, 61384, 61769, 62152,
-	    62534, 62915, 63294, 63671, 64047, 64421, 64794, 65166, 65536};
 	static const int8_t iv[256] = {
 	    8, 7, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
 	    3, 3, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
@@ -120,3 +124,32 @@ int32_t base2_logarithm(uint32_t u)
 	return s_v + (((x & BASE2LOG_UPPERBYTES) * (int64_t)(l2_i - l3_i)) >> 24);
 }
 
+/**
+ * Array version of base2_logarithm(), bit exact with it. The number of
+ * leading zeros is counted with clz() instead of the byte table and the
+ * interpolation index is taken directly from the normalized value.
+ *
+ * Arguments	: const uint32_t *u, input range [1 to 4294967295], Q32.0
+ *		  int32_t *y, output range [0 to 32], Q16.16
+ *		  int n, number of values
+ */
+void base2_logarithm_vec(const uint32_t *u, int32_t *y, int n)
+{
+	uint32_t x;
+	int32_t l1_i;
+	int32_t l2_i;
+	int num_left_shifts;
+	int idx;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		num_left_shifts = clz(u[i]);
+		/* 1 <= x < 2 with one integer bit */
+		x = u[i] << num_left_shifts;
+		idx = (x >> 24) - 128;
+		l1_i = iv1[idx];
+		l2_i = iv1[idx + 1];
+		y[i] = ((BASE2LOG_WORDLENGTH - num_left_shifts) << 16) + l1_i +
+		       (((x & BASE2LOG_UPPERBYTES) * (int64_t)(l2_i - l1_i)) >> 24);
+	}
+}
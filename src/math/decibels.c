@@ -6,6 +6,7 @@
 
 #include <sof/audio/format.h>
 #include <sof/math/decibels.h>
+#include <sof/math/numbers.h>
 #include <stdint.h>
 
 #define ONE_Q20         Q_CONVERT_FLOAT(1.0, 20)	  /* Use Q12.20 */
@@ -115,3 +116,136 @@ int32_t exp_fixed(int32_t x)
 
 	return y;
 }
+
+/* One term of the series in exp_small_fixed() for a block of values.
+ * When inlined with a constant denominator the division can be done
+ * by compiler with a multiplication.
+ */
+static inline void exp_small_fixed_term(int64_t *num, const int32_t *x, int32_t *y,
+					int32_t den, int n)
+{
+	int j;
+
+	for (j = 0; j < n; j++) {
+		num[j] = Q_SHIFT_RND(num[j] * x[j], 52, 23);
+		y[j] += (int32_t)(num[j] / den);
+	}
+}
+
+/* Exponent of a block of small values, the same series as in
+ * exp_small_fixed() but with the terms as the outer loop. The
+ * loop over the block has no dependencies between the elements.
+ * The result is bit exact with exp_small_fixed().
+ *
+ * The input is Q3.29
+ * The output is Q9.23
+ */
+static void exp_small_fixed_block(const int32_t *x, int32_t *y, int n)
+{
+	int64_t num[EXP_FIXED_VEC_BLOCK];
+	int j;
+
+	for (j = 0; j < n; j++) {
+		num[j] = Q_SHIFT_RND(x[j], 29, 23);
+		y[j] = (int32_t)num[j];
+	}
+
+	/* Numerator is x^k, denominator is k! */
+	exp_small_fixed_term(num, x, y, 2, n);
+	exp_small_fixed_term(num, x, y, 6, n);
+	exp_small_fixed_term(num, x, y, 24, n);
+	exp_small_fixed_term(num, x, y, 120, n);
+	exp_small_fixed_term(num, x, y, 720, n);
+	exp_small_fixed_term(num, x, y, 5040, n);
+	exp_small_fixed_term(num, x, y, 40320, n);
+	exp_small_fixed_term(num, x, y, 362880, n);
+	exp_small_fixed_term(num, x, y, 3628800, n);
+	exp_small_fixed_term(num, x, y, 39916800, n);
+
+	for (j = 0; j < n; j++)
+		y[j] += ONE_Q23;
+}
+
+/* Array version of exp_fixed(), bit exact with it.
+ *
+ * Input  is Q5.27, -16.0 .. +16.0, but note the input range limitation
+ * Output is Q12.20, 0.0 .. +2048.0
+ */
+void exp_fixed_vec(const int32_t *x, int32_t *y, int n)
+{
+	int32_t xs[EXP_FIXED_VEC_BLOCK];
+	int32_t y0[EXP_FIXED_VEC_BLOCK];
+	int8_t shift[EXP_FIXED_VEC_BLOCK];
+	int32_t acc;
+	int i0, i, j;
+	int m;
+
+	for (i0 = 0; i0 < n; i0 += EXP_FIXED_VEC_BLOCK) {
+		m = MIN(n - i0, EXP_FIXED_VEC_BLOCK);
+
+		/* Out of range values are computed as zero and replaced
+		 * after the series to keep the block loops uniform.
+		 */
+		for (j = 0; j < m; j++) {
+			xs[j] = x[i0 + j];
+			shift[j] = 0;
+			if (xs[j] < Q_CONVERT_FLOAT(-11.5, 27) ||
+			    xs[j] > Q_CONVERT_FLOAT(7.6245, 27))
+				xs[j] = 0;
+
+			while (xs[j] >= TWO_Q27 || xs[j] <= MINUS_TWO_Q27) {
+				xs[j] >>= 1;
+				shift[j]++;
+			}
+
+			xs[j] = Q_SHIFT_LEFT(xs[j], 27, 29);
+		}
+
+		exp_small_fixed_block(xs, y0, m);
+
+		for (j = 0; j < m; j++) {
+			if (x[i0 + j] < Q_CONVERT_FLOAT(-11.5, 27)) {
+				y[i0 + j] = 0;
+				continue;
+			}
+
+			if (x[i0 + j] > Q_CONVERT_FLOAT(7.6245, 27)) {
+				y[i0 + j] = INT32_MAX;
+				continue;
+			}
+
+			y0[j] = Q_SHIFT_RND(y0[j], 23, 20);
+			acc = ONE_Q20;
+			for (i = 0; i < (1 << shift[j]); i++)
+				acc = (int32_t)Q_MULTSR_32X32((int64_t)acc, y0[j], 20, 20, 20);
+
+			y[i0 + j] = acc;
+		}
+	}
+}
+
+/* Array version of db2lin_fixed(), bit exact with it.
+ *
+ * Input is Q8.24 (max 128.0)
+ * output is Q12.20 (max 2048.0)
+ */
+void db2lin_fixed_vec(const int32_t *db, int32_t *y, int n)
+{
+	int32_t arg[EXP_FIXED_VEC_BLOCK];
+	int i0, j;
+	int m;
+
+	for (i0 = 0; i0 < n; i0 += EXP_FIXED_VEC_BLOCK) {
+		m = MIN(n - i0, EXP_FIXED_VEC_BLOCK);
+
+		/* Q8.24 x Q5.27, result needs to be Q5.27. Below -100 dB the
+		 * argument is set under the exp_fixed_vec() range to get zero.
+		 */
+		for (j = 0; j < m; j++)
+			arg[j] = db[i0 + j] < Q_CONVERT_FLOAT(-100.0, 24) ? INT32_MIN :
+				 (int32_t)Q_MULTSR_32X32((int64_t)db[i0 + j], LOG10_DIV20_Q27,
+							 24, 27, 27);
+
+		exp_fixed_vec(arg, &y[i0], m);
+	}
+}
@@ -6,6 +6,7 @@
 //         Liam Girdwood <liam.r.girdwood@linux.intel.com>
 //         Keyon Jie <yang.jie@linux.intel.com>
 
+#include <rtos/string.h>
 #include <sof/audio/format.h>
 #include <sof/math/iir_df2t.h>
 #include <user/eq.h>
@@ -105,4 +106,59 @@ int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x)
 	return out;
 }
 
+/* Block version of iir_df2t() for filters that have all the biquads in
+ * series. Every biquad processes the whole block with its coefficients
+ * and delays kept in local variables, the result is the same as with
+ * calling iir_df2t() for every sample. The output y can be the same
+ * buffer as input x.
+ */
+void iir_df2t_block(struct iir_state_df2t *iir, int32_t *y, const int32_t *x, int n)
+{
+	const int32_t *in = x;
+	int64_t acc;
+	int64_t d0;
+	int64_t d1;
+	int32_t tmp;
+	int32_t *coef;
+	int i;
+	int j;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads) {
+		if (y != x)
+			memcpy_s(y, n * sizeof(int32_t), x, n * sizeof(int32_t));
+
+		return;
+	}
+
+	/* Filters with parallel sections use the per sample version */
+	if (iir->biquads != iir->biquads_in_series) {
+		for (i = 0; i < n; i++)
+			y[i] = iir_df2t(iir, x[i]);
+
+		return;
+	}
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	for (j = 0; j < iir->biquads; j++) {
+		coef = &iir->coef[j * SOF_EQ_IIR_NBIQUAD_DF2T];
+		d0 = iir->delay[j * IIR_DF2T_NUM_DELAYS];
+		d1 = iir->delay[j * IIR_DF2T_NUM_DELAYS + 1];
+		for (i = 0; i < n; i++) {
+			acc = ((int64_t)coef[4]) * in[i] + d0; /* Coef b0 */
+			tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+			d0 = d1 + ((int64_t)coef[3]) * in[i] + ((int64_t)coef[1]) * tmp;
+			d1 = ((int64_t)coef[2]) * in[i] + ((int64_t)coef[0]) * tmp;
+			acc = ((int64_t)coef[6]) * tmp; /* Gain */
+			y[i] = sat_int32(Q_SHIFT_RND(acc, 45 + coef[5], 31));
+		}
+
+		iir->delay[j * IIR_DF2T_NUM_DELAYS] = d0;
+		iir->delay[j * IIR_DF2T_NUM_DELAYS + 1] = d1;
+
+		/* Next biquad in series processes the output of this one */
+		in = y;
+	}
+}
+
 #endif
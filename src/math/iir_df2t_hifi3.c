@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <errno.h>
+#include <rtos/string.h>
 #include <sof/audio/format.h>
 #include <sof/math/iir_df2t.h>
 #include <user/eq.h>
@@ -132,4 +133,99 @@ int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x)
 	return out;
 }
 
+/* Block version of iir_df2t() for filters that have all the biquads in
+ * series. Every biquad processes the whole block with its coefficients
+ * and delays kept in registers, the result is the same as with calling
+ * iir_df2t() for every sample. The output y can be the same buffer as
+ * input x.
+ */
+void iir_df2t_block(struct iir_state_df2t *iir, int32_t *y, const int32_t *x, int n)
+{
+	ae_f64 acc;
+	ae_f64 d0;
+	ae_f64 d1;
+	ae_valign align;
+	ae_f32x2 coef_a2a1;
+	ae_f32x2 coef_b2b1;
+	ae_f32x2 coef_b0shift;
+	ae_f32x2 gain;
+	ae_f32 in;
+	ae_f32 tmp;
+	ae_f32x2 *coefp;
+	ae_f64 *delayp;
+	const int32_t *src = x;
+	int i;
+	int j;
+	int shift;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads) {
+		if (y != x)
+			memcpy_s(y, n * sizeof(int32_t), x, n * sizeof(int32_t));
+
+		return;
+	}
+
+	/* Filters with parallel sections use the per sample version */
+	if (iir->biquads != iir->biquads_in_series) {
+		for (i = 0; i < n; i++)
+			y[i] = iir_df2t(iir, x[i]);
+
+		return;
+	}
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	coefp = (ae_f32x2 *)&iir->coef[0];
+	delayp = (ae_f64 *)&iir->delay[0];
+	for (j = 0; j < iir->biquads; j++) {
+		align = AE_LA64_PP(coefp);
+		AE_LA32X2_IP(coef_a2a1, align, coefp);
+		AE_LA32X2_IP(coef_b2b1, align, coefp);
+		AE_LA32X2_IP(coef_b0shift, align, coefp);
+		AE_LA32X2_IP(gain, align, coefp);
+		shift = AE_SEL32_LL(coef_b0shift, coef_b0shift);
+
+		/* The delays are kept Q18.46 in the loop, see iir_df2t() */
+		d0 = AE_SRAI64(delayp[0], 1);
+		d1 = AE_SRAI64(delayp[1], 1);
+		for (i = 0; i < n; i++) {
+			in = src[i];
+			acc = d0;
+			AE_MULAF32R_HH(acc, coef_b0shift, in); /* Coef b0 */
+			acc = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+			tmp = AE_ROUND32F48SSYM(acc); /* Round to Q1.31 */
+
+			/* Compute 1st delay d0 */
+			acc = d1;
+			AE_MULAF32R_LL(acc, coef_b2b1, in); /* Coef b1 */
+			AE_MULAF32R_LL(acc, coef_a2a1, tmp); /* Coef a1 */
+			d0 = AE_SRAI64(AE_SLAI64S(acc, 1), 1);
+
+			/* Compute delay d1 */
+			acc = AE_MULF32R_HH(coef_b2b1, in); /* Coef b2 */
+			AE_MULAF32R_HH(acc, coef_a2a1, tmp); /* Coef a2 */
+			d1 = AE_SRAI64(AE_SLAI64S(acc, 1), 1);
+
+			/* Apply gain Q18.14 x Q1.31 -> Q34.30 */
+			acc = AE_MULF32R_HH(gain, tmp); /* Gain */
+			acc = AE_SLAI64S(acc, 17); /* Convert to Q17.47 */
+			acc = AE_SRAA64(acc, shift);
+			y[i] = AE_ROUND32F48SSYM(acc);
+		}
+
+		/* Store the delays Q17.47 */
+		delayp[0] = AE_SLAI64S(d0, 1);
+		delayp[1] = AE_SLAI64S(d1, 1);
+		delayp += IIR_DF2T_NUM_DELAYS;
+
+		/* The coefp needs rewind by one int32_t due to odd number of
+		 * words in coefficient block.
+		 */
+		coefp = (ae_f32x2 *)((int32_t *)coefp - 1);
+
+		/* Next biquad in series processes the output of this one */
+		src = y;
+	}
+}
+
 #endif
@@ -31,3 +31,16 @@ uint32_t ln_int32(uint32_t numerator)
 	return((uint32_t)Q_SHIFT_RND((int64_t)base2_logarithm(numerator) *
 				     ONE_OVER_LOG2_E, 64, 32));
 }
+
+/* Array version of ln_int32(), bit exact with it. The base-2 logarithms are
+ * computed in place to the output.
+ */
+void ln_int32_vec(const uint32_t *numerator, uint32_t *y, int n)
+{
+	int32_t *log2_y = (int32_t *)y;
+	int i;
+
+	base2_logarithm_vec(numerator, log2_y, n);
+	for (i = 0; i < n; i++)
+		y[i] = (uint32_t)Q_SHIFT_RND((int64_t)log2_y[i] * ONE_OVER_LOG2_E, 64, 32);
+}
@@ -4,57 +4,233 @@
 //
 // Author: Seppo Ingalsuo <seppo.ingalsuo@linux.intel.com>
 
+#include <sof/audio/format.h>
 #include <sof/math/matrix.h>
+#include <sof/math/numbers.h>
 #include <errno.h>
 #include <stdint.h>
 
+/* Shift sum of products to result Qx.y with rounding. If all data is Q0 the
+ * shift_minus_one is -1 and the sum is used as such.
+ */
+static inline int64_t mat_shift_round(int64_t s, int shift_minus_one)
+{
+	if (shift_minus_one == -1)
+		return s;
+
+	return ((s >> shift_minus_one) + 1) >> 1;
+}
+
+/* The multiply functions compute a row of c in blocks of MAT_BLOCK_COLUMNS. For
+ * every element of a row of a the contiguous block of a row of b is multiply
+ * accumulated to the block accumulators. This avoids the stride of b columns
+ * access for every product and the inner loop can be vectorized by compiler.
+ * The full blocks use the constant length loop for that.
+ */
+static inline void mat_block_mac_16b(int64_t *acc, const int16_t *x, const int16_t *y,
+				     int len, int stride, int n)
+{
+	int j, k;
+
+	for (j = 0; j < n; j++)
+		acc[j] = 0;
+
+	if (n == MAT_BLOCK_COLUMNS) {
+		for (k = 0; k < len; k++) {
+			for (j = 0; j < MAT_BLOCK_COLUMNS; j++)
+				acc[j] += (int32_t)x[k] * y[j];
+
+			y += stride;
+		}
+	} else {
+		for (k = 0; k < len; k++) {
+			for (j = 0; j < n; j++)
+				acc[j] += (int32_t)x[k] * y[j];
+
+			y += stride;
+		}
+	}
+}
+
+static inline void mat_block_mac_32b(int64_t *acc, const int32_t *x, const int16_t *y,
+				     int len, int stride, int n)
+{
+	int j, k;
+
+	for (j = 0; j < n; j++)
+		acc[j] = 0;
+
+	if (n == MAT_BLOCK_COLUMNS) {
+		for (k = 0; k < len; k++) {
+			for (j = 0; j < MAT_BLOCK_COLUMNS; j++)
+				acc[j] += (int64_t)x[k] * y[j];
+
+			y += stride;
+		}
+	} else {
+		for (k = 0; k < len; k++) {
+			for (j = 0; j < n; j++)
+				acc[j] += (int64_t)x[k] * y[j];
+
+			y += stride;
+		}
+	}
+}
+
 int mat_multiply(struct mat_matrix_16b *a, struct mat_matrix_16b *b, struct mat_matrix_16b *c)
 {
-	int64_t s;
+	int64_t acc[MAT_BLOCK_COLUMNS];
 	int16_t *x;
-	int16_t *y;
-	int16_t *z = c->data;
-	int i, j, k;
-	int y_inc = b->columns;
+	int16_t *z;
+	int i, j;
+	int j0;
+	int n;
 	const int shift_minus_one = a->fractions + b->fractions - c->fractions - 1;
 
 	if (a->columns != b->rows || a->rows != c->rows || b->columns != c->columns)
 		return -EINVAL;
 
-	/* If all data is Q0 */
-	if (shift_minus_one == -1) {
-		for (i = 0; i < a->rows; i++) {
-			for (j = 0; j < b->columns; j++) {
-				s = 0;
-				x = a->data + a->columns * i;
-				y = b->data + j;
-				for (k = 0; k < b->rows; k++) {
-					s += (int32_t)(*x) * (*y);
-					x++;
-					y += y_inc;
-				}
-				*z = (int16_t)s; /* For Q16.0 */
-				z++;
+	for (i = 0; i < a->rows; i++) {
+		x = mat_get_row_vector_16b(a, i);
+		z = mat_get_row_vector_16b(c, i);
+		for (j0 = 0; j0 < b->columns; j0 += MAT_BLOCK_COLUMNS) {
+			n = MIN(b->columns - j0, MAT_BLOCK_COLUMNS);
+			mat_block_mac_16b(acc, x, b->data + j0, a->columns, b->columns, n);
+			for (j = 0; j < n; j++)
+				z[j0 + j] = (int16_t)mat_shift_round(acc[j], shift_minus_one);
+		}
+	}
+
+	return 0;
+}
+
+int mat_multiply_transposed(struct mat_matrix_16b *a, struct mat_matrix_16b *bt,
+			    struct mat_matrix_16b *c)
+{
+	int64_t s0, s1, s2, s3;
+	int16_t *x;
+	int16_t *y0;
+	int16_t *y1;
+	int16_t *y2;
+	int16_t *y3;
+	int16_t *z;
+	int i, j, k;
+	const int shift_minus_one = a->fractions + bt->fractions - c->fractions - 1;
+
+	if (a->columns != bt->columns || a->rows != c->rows || bt->rows != c->columns)
+		return -EINVAL;
+
+	/* Four outputs are computed together to reuse the loaded row of a */
+	for (i = 0; i < a->rows; i++) {
+		x = mat_get_row_vector_16b(a, i);
+		z = mat_get_row_vector_16b(c, i);
+		for (j = 0; j < bt->rows - 3; j += 4) {
+			y0 = mat_get_row_vector_16b(bt, j);
+			y1 = y0 + bt->columns;
+			y2 = y1 + bt->columns;
+			y3 = y2 + bt->columns;
+			s0 = 0;
+			s1 = 0;
+			s2 = 0;
+			s3 = 0;
+			for (k = 0; k < a->columns; k++) {
+				s0 += (int32_t)x[k] * y0[k];
+				s1 += (int32_t)x[k] * y1[k];
+				s2 += (int32_t)x[k] * y2[k];
+				s3 += (int32_t)x[k] * y3[k];
 			}
+
+			z[j] = (int16_t)mat_shift_round(s0, shift_minus_one);
+			z[j + 1] = (int16_t)mat_shift_round(s1, shift_minus_one);
+			z[j + 2] = (int16_t)mat_shift_round(s2, shift_minus_one);
+			z[j + 3] = (int16_t)mat_shift_round(s3, shift_minus_one);
 		}
 
-		return 0;
+		/* The remaining outputs */
+		for (; j < bt->rows; j++) {
+			y0 = mat_get_row_vector_16b(bt, j);
+			s0 = 0;
+			for (k = 0; k < a->columns; k++)
+				s0 += (int32_t)x[k] * y0[k];
+
+			z[j] = (int16_t)mat_shift_round(s0, shift_minus_one);
+		}
 	}
 
+	return 0;
+}
+
+int mat_multiply_16b_32b(struct mat_matrix_16b *a, struct mat_matrix_16b *b,
+			 struct mat_matrix_32b *c)
+{
+	int64_t acc[MAT_BLOCK_COLUMNS];
+	int16_t *x;
+	int32_t *z;
+	int i, j;
+	int j0;
+	int n;
+	const int shift_minus_one = a->fractions + b->fractions - c->fractions - 1;
+
+	if (a->columns != b->rows || a->rows != c->rows || b->columns != c->columns)
+		return -EINVAL;
+
 	for (i = 0; i < a->rows; i++) {
-		for (j = 0; j < b->columns; j++) {
-			s = 0;
-			x = a->data + a->columns * i;
-			y = b->data + j;
-			for (k = 0; k < b->rows; k++) {
-				s += (int32_t)(*x) * (*y);
-				x++;
-				y += y_inc;
-			}
-			*z = (int16_t)(((s >> shift_minus_one) + 1) >> 1); /*Shift to Qx.y */
-			z++;
+		x = mat_get_row_vector_16b(a, i);
+		z = mat_get_row_vector_32b(c, i);
+		for (j0 = 0; j0 < b->columns; j0 += MAT_BLOCK_COLUMNS) {
+			n = MIN(b->columns - j0, MAT_BLOCK_COLUMNS);
+			mat_block_mac_16b(acc, x, b->data + j0, a->columns, b->columns, n);
+			for (j = 0; j < n; j++)
+				z[j0 + j] = sat_int32(mat_shift_round(acc[j], shift_minus_one));
 		}
 	}
+
+	return 0;
+}
+
+int mat_multiply_32b_16b(struct mat_matrix_32b *a, struct mat_matrix_16b *b,
+			 struct mat_matrix_32b *c)
+{
+	int64_t acc[MAT_BLOCK_COLUMNS];
+	int32_t *x;
+	int32_t *z;
+	int i, j;
+	int j0;
+	int n;
+	const int shift_minus_one = a->fractions + b->fractions - c->fractions - 1;
+
+	if (a->columns != b->rows || a->rows != c->rows || b->columns != c->columns)
+		return -EINVAL;
+
+	for (i = 0; i < a->rows; i++) {
+		x = mat_get_row_vector_32b(a, i);
+		z = mat_get_row_vector_32b(c, i);
+		for (j0 = 0; j0 < b->columns; j0 += MAT_BLOCK_COLUMNS) {
+			n = MIN(b->columns - j0, MAT_BLOCK_COLUMNS);
+			mat_block_mac_32b(acc, x, b->data + j0, a->columns, b->columns, n);
+			for (j = 0; j < n; j++)
+				z[j0 + j] = sat_int32(mat_shift_round(acc[j], shift_minus_one));
+		}
+	}
+
+	return 0;
+}
+
+int mat_transpose_16b(struct mat_matrix_16b *a, struct mat_matrix_16b *at)
+{
+	int16_t *x;
+	int i, j;
+
+	if (a->rows != at->columns || a->columns != at->rows)
+		return -EINVAL;
+
+	at->fractions = a->fractions;
+	for (i = 0; i < a->rows; i++) {
+		x = mat_get_row_vector_16b(a, i);
+		for (j = 0; j < a->columns; j++)
+			mat_set_scalar_16b(at, j, i, x[j]);
+	}
+
 	return 0;
 }
 
@@ -10,6 +10,7 @@
 #include <sof/audio/format.h>
 #include <sof/math/trig.h>
 #include <sof/math/cordic.h>
+#include <sof/math/numbers.h>
 #include <stdint.h>
 
 /* Use a local definition to avoid adding a dependency on <math.h> */
@@ -42,21 +43,17 @@ const int32_t cord_arcsincos_q30fl  = Q_CONVERT_FLOAT(1.0000000000000000, 30);
 /**
  * CORDIC-based approximation of sine, cosine and complex exponential
  */
-void cordic_approx(int32_t th_rad_fxp, int32_t a_idx, int32_t *sign, int32_t *b_yn, int32_t *xn,
-		   int32_t *th_cdc_fxp)
+/* Addition or subtraction by a multiple of pi/2 is done in the data type
+ * of the input. When the fraction length is 29, then the quantization error
+ * introduced by the addition or subtraction of pi/2 is done with 29 bits of
+ * precision.Input range of cordicsin must be in the range [-2*pi, 2*pi),
+ * a signed type with fractionLength = wordLength-4 will fit this range
+ * without overflow.Increase of fractionLength makes the addition or
+ * subtraction of a multiple of pi/2 more precise
+ */
+static inline int32_t cordic_range_reduce(int32_t th_rad_fxp, int32_t *sign)
 {
-	int32_t b_idx;
-	int32_t xtmp;
-	int32_t ytmp;
 	*sign = 1;
-	/* Addition or subtraction by a multiple of pi/2 is done in the data type
-	 * of the input. When the fraction length is 29, then the quantization error
-	 * introduced by the addition or subtraction of pi/2 is done with 29 bits of
-	 * precision.Input range of cordicsin must be in the range [-2*pi, 2*pi),
-	 * a signed type with fractionLength = wordLength-4 will fit this range
-	 * without overflow.Increase of fractionLength makes the addition or
-	 * subtraction of a multiple of pi/2 more precise
-	 */
 	if (th_rad_fxp > cord_sincos_piovertwo_q28fl) {
 		if ((th_rad_fxp - cord_sincos_piovertwo_q29fl) <= cord_sincos_piovertwo_q28fl) {
 			th_rad_fxp -= cord_sincos_piovertwo_q29fl;
@@ -73,6 +70,17 @@ void cordic_approx(int32_t th_rad_fxp, int32_t a_idx, int32_t *sign, int32_t *b_
 		}
 	}
 
+	return th_rad_fxp;
+}
+
+void cordic_approx(int32_t th_rad_fxp, int32_t a_idx, int32_t *sign, int32_t *b_yn, int32_t *xn,
+		   int32_t *th_cdc_fxp)
+{
+	int32_t b_idx;
+	int32_t xtmp;
+	int32_t ytmp;
+
+	th_rad_fxp = cordic_range_reduce(th_rad_fxp, sign);
 	th_rad_fxp <<= 2;
 	*b_yn = 0;
 	*xn = cordic_sine_cos_lut_q29fl;
@@ -100,6 +108,103 @@ void cordic_approx(int32_t th_rad_fxp, int32_t a_idx, int32_t *sign, int32_t *b_
 	*th_cdc_fxp = th_rad_fxp;
 }
 
+/* The same rotations as in cordic_approx() for a block of angles. The
+ * iterations are the outer loop and the direction of every rotation is
+ * applied with a sign mask instead of a branch, so the inner loop over
+ * the block can be vectorized by compiler. The result is bit exact with
+ * cordic_approx(). The angles are overwritten with the sign multiplied
+ * sine and the cosine is returned in xn.
+ */
+static void cordic_approx_block(int32_t *th, int32_t *xn, int32_t a_idx, int n)
+{
+	int32_t yn[CORDIC_VEC_BLOCK];
+	int32_t sign[CORDIC_VEC_BLOCK];
+	int32_t xtmp;
+	int32_t ytmp;
+	int32_t m;
+	int b_idx;
+	int j;
+
+	for (j = 0; j < n; j++) {
+		th[j] = cordic_range_reduce(th[j], &sign[j]) << 2;
+		xn[j] = cordic_sine_cos_lut_q29fl;
+		yn[j] = 0;
+	}
+
+	/* the first rotation starts from the unit vector on x axis */
+	for (j = 0; j < n; j++) {
+		m = th[j] >> 31;
+		th[j] -= (cordic_lookup[0] ^ m) - m;
+		yn[j] += (cordic_sine_cos_lut_q29fl ^ m) - m;
+	}
+
+	for (b_idx = 1; b_idx < a_idx; b_idx++) {
+		for (j = 0; j < n; j++) {
+			xtmp = xn[j] >> b_idx;
+			ytmp = yn[j] >> b_idx;
+			m = th[j] >> 31;
+			th[j] -= (cordic_lookup[b_idx] ^ m) - m;
+			xn[j] -= (ytmp ^ m) - m;
+			yn[j] += (xtmp ^ m) - m;
+		}
+	}
+
+	for (j = 0; j < n; j++) {
+		th[j] = sign[j] * yn[j];
+		xn[j] *= sign[j];
+	}
+}
+
+void sin_cos_fixed_32b_vec(const int32_t *th_rad_fxp, int32_t *sin_out, int32_t *cos_out, int n)
+{
+	int32_t s[CORDIC_VEC_BLOCK];
+	int32_t c[CORDIC_VEC_BLOCK];
+	int i0, j;
+	int m;
+
+	for (i0 = 0; i0 < n; i0 += CORDIC_VEC_BLOCK) {
+		m = MIN(n - i0, CORDIC_VEC_BLOCK);
+		for (j = 0; j < m; j++)
+			s[j] = th_rad_fxp[i0 + j];
+
+		cordic_approx_block(s, c, CORDIC_31B_TABLE_SIZE, m);
+
+		/* convert Q2.30 to Q1.31 format */
+		if (sin_out)
+			for (j = 0; j < m; j++)
+				sin_out[i0 + j] = sat_int32(Q_SHIFT_LEFT((int64_t)s[j], 30, 31));
+
+		if (cos_out)
+			for (j = 0; j < m; j++)
+				cos_out[i0 + j] = sat_int32(Q_SHIFT_LEFT((int64_t)c[j], 30, 31));
+	}
+}
+
+void sin_cos_fixed_16b_vec(const int32_t *th_rad_fxp, int16_t *sin_out, int16_t *cos_out, int n)
+{
+	int32_t s[CORDIC_VEC_BLOCK];
+	int32_t c[CORDIC_VEC_BLOCK];
+	int i0, j;
+	int m;
+
+	for (i0 = 0; i0 < n; i0 += CORDIC_VEC_BLOCK) {
+		m = MIN(n - i0, CORDIC_VEC_BLOCK);
+		for (j = 0; j < m; j++)
+			s[j] = th_rad_fxp[i0 + j];
+
+		cordic_approx_block(s, c, CORDIC_15B_TABLE_SIZE, m);
+
+		/* convert Q2.30 to Q1.15 format */
+		if (sin_out)
+			for (j = 0; j < m; j++)
+				sin_out[i0 + j] = sat_int16(Q_SHIFT_RND(s[j], 30, 15));
+
+		if (cos_out)
+			for (j = 0; j < m; j++)
+				cos_out[i0 + j] = sat_int16(Q_SHIFT_RND(c[j], 30, 15));
+	}
+}
+
 /**
  * CORDIC-based approximation for inverse cosine
  * Arguments	: int32_t cosvalue
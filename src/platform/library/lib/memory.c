@@ -174,8 +174,7 @@ void platform_init_memmap(struct sof *sof)
 	for (i = 1; i < CONFIG_CORE_COUNT; i++) {
 		/* .system init */
 		sof->memory_map->system[i].heap =
-				(unsigned long)malloc(HEAP_SYSTEM_S_SIZE) +
-			((i - 1) * SOF_CORE_S_SIZE);
+				(unsigned long)malloc(HEAP_SYSTEM_S_SIZE);
 		sof->memory_map->system[i].size = HEAP_SYSTEM_S_SIZE;
 		sof->memory_map->system[i].info.free = HEAP_SYSTEM_S_SIZE;
 		sof->memory_map->system[i].caps = SOF_MEM_CAPS_RAM |
@@ -187,8 +186,7 @@ void platform_init_memmap(struct sof *sof)
 		sof->memory_map->system_runtime[i].map =
 			uncached_block_map(sys_rt_heap_map[i]);
 		sof->memory_map->system_runtime[i].heap =
-			(unsigned long)malloc(HEAP_SYS_RUNTIME_S_SIZE) +
-			((i - 1) * SOF_CORE_S_SIZE) + HEAP_SYSTEM_S_SIZE;
+			(unsigned long)malloc(HEAP_SYS_RUNTIME_S_SIZE);
 		sof->memory_map->system_runtime[i].size =
 			HEAP_SYS_RUNTIME_S_SIZE;
 		sof->memory_map->system_runtime[i].info.free =
@@ -6,12 +6,20 @@
 
 #define _GNU_SOURCE
 
+#include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/topology.h>
+#include <sof/math/numbers.h>
 #include <sof/schedule/task.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
+#include <sof/schedule/task_load.h>
+#include <rtos/atomic.h>
 #include <rtos/wait.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -19,6 +27,7 @@
 #include <stdint.h>
 #include <pthread.h>
 #include <poll.h>
+#include <sched.h>
 
  /* scheduler testbench definition */
 
@@ -28,15 +37,60 @@ DECLARE_SOF_UUID("ll-schedule", ll_sched_uuid, 0x77de2074, 0x828c, 0x4044,
 
 DECLARE_TR_CTX(ll_tr, SOF_UUID(ll_sched_uuid), LOG_LEVEL_INFO);
 
+/* immutable snapshot of the tasks of a vcore, read without locks */
+struct ll_run_queue {
+	int count;
+	struct task *tasks[];
+};
+
 struct ll_vcore {
 	struct list_item list; /* list of tasks in priority queue */
-	pthread_mutex_t list_mutex;
+	pthread_mutex_t list_mutex; /* serializes the run queue updates */
+	struct ll_run_queue *queue; /* published snapshot of list */
 	pthread_t thread_id;
 	int vcore_ready;
+	int joinable;
 	int core_id;
+	atomic_t tick; /* number of ticks started on this vcore */
+	atomic_t epoch; /* epoch the thread reads the run queues in, 0 if not reading */
+};
+
+/* per task scheduling data */
+struct ll_vcore_task {
+	atomic_t claim;		/* twice the last tick run, plus one while running */
+	bool stealable;		/* no buffer shared with another pipeline */
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct task_load load;	/* run time statistics in ns */
+#endif
+};
+
+/* memory that may still be seen by a vcore thread reading the run queues */
+struct ll_retired {
+	struct list_item list;
+	void *ptr;
+	int32_t epoch; /* epoch the memory was retired in */
 };
 
 static int tick_period_us;
+static struct ll_vcore *ll_vcores;
+static __thread struct ll_vcore *ll_current;
+
+/*
+ * Run queue updates are published with a single pointer exchange and the
+ * previous snapshot is freed once every vcore thread has left the epoch it
+ * was retired in, so the vcore threads never take a lock to run their tasks.
+ */
+static atomic_t ll_epoch;
+static pthread_mutex_t ll_retired_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct list_item ll_retired_list;
+static atomic_t ll_retired_count;
+
+/*
+ * With work stealing enabled all vcore threads are started and an idle
+ * vcore runs the tasks of other vcores that have not been run yet in the
+ * current tick of their owner core.
+ */
+static bool ll_work_stealing;
 
 /**
  * Implement an override of how cores defined in SOF topology
@@ -58,17 +112,268 @@ static unsigned int sof_host_core_base(void)
 	return host_core;
 }
 
+static bool sof_host_work_stealing(void)
+{
+	const char *env = getenv("SOF_HOST_WORK_STEALING");
+
+	return env && atoi(env) > 0;
+}
+
+/*
+ * Claim the task for the given tick of its owner core. A task runs at most
+ * once per owner tick and never on two vcores at the same time.
+ */
+static bool ll_task_claim(struct task *task, int32_t tick)
+{
+	struct ll_vcore_task *pdata = ll_sch_get_pdata(task);
+	int32_t claim = atomic_read(&pdata->claim);
+
+	if ((claim & 1) || claim >= 2 * tick)
+		return false;
+
+	return __sync_bool_compare_and_swap(&pdata->claim.value, claim, 2 * tick - 1);
+}
+
+static void ll_task_release(struct task *task)
+{
+	struct ll_vcore_task *pdata = ll_sch_get_pdata(task);
+
+	atomic_add(&pdata->claim, 1);
+}
+
+static void ll_read_lock(struct ll_vcore *vc)
+{
+	atomic_set(&vc->epoch, atomic_read(&ll_epoch));
+	/* the epoch must be visible before any run queue is loaded */
+	__sync_synchronize();
+}
+
+static void ll_read_unlock(struct ll_vcore *vc)
+{
+	__sync_synchronize();
+	atomic_set(&vc->epoch, 0);
+}
+
+static struct ll_run_queue *ll_run_queue_get(struct ll_vcore *vc)
+{
+	return __atomic_load_n(&vc->queue, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * True when no vcore thread can still see memory retired in epoch. This
+ * includes the calling vcore thread, a task removed from an LL task is still
+ * in the run queue the thread iterates.
+ */
+static bool ll_epoch_passed(int32_t epoch)
+{
+	int32_t reader;
+	int i;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		reader = atomic_read(&ll_vcores[i].epoch);
+		if (reader && reader < epoch)
+			return false;
+	}
+
+	return true;
+}
+
+/* free the retired memory no vcore thread can see anymore */
+static void ll_reclaim(bool all)
+{
+	struct list_item *rlist, *rlist_;
+	struct ll_retired *retired;
+
+	pthread_mutex_lock(&ll_retired_mutex);
+
+	list_for_item_safe(rlist, rlist_, &ll_retired_list) {
+		retired = container_of(rlist, struct ll_retired, list);
+		if (!all && !ll_epoch_passed(retired->epoch))
+			continue;
+
+		list_item_del(&retired->list);
+		free(retired->ptr);
+		free(retired);
+		atomic_sub(&ll_retired_count, 1);
+	}
+
+	pthread_mutex_unlock(&ll_retired_mutex);
+}
+
+/* free ptr once the vcore threads reading the run queues are done with it */
+static void ll_retire(void *ptr)
+{
+	struct ll_retired *retired;
+
+	if (!ptr)
+		return;
+
+	retired = malloc(sizeof(*retired));
+	if (!retired) {
+		/* can't defer it, leak rather than free it under a reader */
+		fprintf(stderr, "error: failed to retire LL run queue memory\n");
+		return;
+	}
+
+	retired->ptr = ptr;
+	retired->epoch = atomic_add(&ll_epoch, 1) + 1;
+
+	pthread_mutex_lock(&ll_retired_mutex);
+	list_item_append(&retired->list, &ll_retired_list);
+	atomic_add(&ll_retired_count, 1);
+	pthread_mutex_unlock(&ll_retired_mutex);
+}
+
+/*
+ * Wait until the other vcore threads have left the run queues they read
+ * before the last update. A vcore thread calling this from a task must not
+ * wait for itself nor for the other vcores that might wait for it.
+ */
+static void ll_synchronize(void)
+{
+	int32_t epoch;
+
+	if (ll_current)
+		return;
+
+	epoch = atomic_add(&ll_epoch, 1) + 1;
+	while (!ll_epoch_passed(epoch))
+		sched_yield();
+}
+
+/* publish a new snapshot of the task list, caller holds the list mutex of vc */
+static int ll_run_queue_update(struct ll_vcore *vc)
+{
+	struct ll_run_queue *queue, *old;
+	struct list_item *tlist;
+	int count = 0;
+
+	list_for_item(tlist, &vc->list)
+		count++;
+
+	queue = malloc(sizeof(*queue) + count * sizeof(queue->tasks[0]));
+	if (!queue)
+		return -ENOMEM;
+
+	queue->count = 0;
+	list_for_item(tlist, &vc->list)
+		queue->tasks[queue->count++] = container_of(tlist, struct task, list);
+
+	old = __atomic_exchange_n(&vc->queue, queue, __ATOMIC_ACQ_REL);
+	ll_retire(old);
+
+	return 0;
+}
+
+/* caller is in a run queue read section */
+static void ll_task_run(struct task *task)
+{
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct ll_vcore_task *pdata = ll_sch_get_pdata(task);
+#endif
+	struct timespec td0, td1;
+	uint64_t delta;
+
+	/* a task cancelled since it was claimed keeps its new state */
+	if (!__sync_bool_compare_and_swap(&task->state, SOF_TASK_STATE_QUEUED,
+					  SOF_TASK_STATE_RUNNING)) {
+		ll_task_release(task);
+		return;
+	}
+
+	/* run task and time it */
+	clock_gettime(CLOCK_MONOTONIC, &td0);
+	task->ops.run(task->data);
+	clock_gettime(CLOCK_MONOTONIC, &td1);
+
+	/*
+	 * Only re-queue if not cancelled, the claim of a cancelled task is
+	 * reset when it is scheduled again.
+	 */
+	if (__sync_bool_compare_and_swap(&task->state, SOF_TASK_STATE_RUNNING,
+					 SOF_TASK_STATE_QUEUED))
+		ll_task_release(task);
+
+	/* Calculate average task exec time */
+	delta = (td1.tv_sec - td0.tv_sec) * 1000000000;
+	delta += td1.tv_nsec - td0.tv_nsec;
+	task->start += delta / 1000;
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	task_load_add(&pdata->load, MIN(delta, UINT32_MAX));
+#endif
+}
+
+/*
+ * Run stealable tasks of other vcores that are still waiting for the
+ * current tick of their owner. Returns the number of tasks run.
+ */
+static int ll_steal_tasks(struct ll_vcore *vc)
+{
+	struct ll_vcore *victim;
+	struct ll_run_queue *queue;
+	struct task *task;
+	struct ll_vcore_task *pdata;
+	int stolen = 0;
+	int i, j;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		victim = ll_vcores + i;
+		queue = ll_run_queue_get(victim);
+		if (victim == vc || !queue)
+			continue;
+
+		for (j = 0; j < queue->count; j++) {
+			task = queue->tasks[j];
+			pdata = ll_sch_get_pdata(task);
+
+			if (task->state != SOF_TASK_STATE_QUEUED || !pdata->stealable ||
+			    !ll_task_claim(task, atomic_read(&victim->tick)))
+				continue;
+
+			ll_task_run(task);
+			stolen++;
+		}
+	}
+
+	return stolen;
+}
+
+static bool ll_run_queue_empty(struct ll_vcore *vc)
+{
+	struct ll_run_queue *queue = ll_run_queue_get(vc);
+
+	return !queue || !queue->count;
+}
+
+/* vcore threads keep running while any vcore has tasks in work stealing mode */
+static bool ll_vcore_idle(struct ll_vcore *vc)
+{
+	int i;
+
+	if (!ll_work_stealing)
+		return true;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		if (ll_vcores + i != vc && !ll_run_queue_empty(ll_vcores + i))
+			return false;
+
+	return true;
+}
+
 static void *ll_thread(void *data)
 {
 	struct ll_vcore *vc = data;
-	struct timespec ts, td0, td1;
-	struct list_item *tlist, *tlist_;
+	struct ll_run_queue *queue;
+	struct timespec ts;
 	struct task *task;
 	int err;
-	uint64_t delta;
+	int stolen, n, i;
+	int32_t tick;
 	cpu_set_t cpuset;
 	pthread_t thread;
 
+	ll_current = vc;
+
 	/* Set affinity mask to pipeline core */
 	thread = pthread_self();
 	CPU_ZERO(&cpuset);
@@ -108,43 +413,44 @@ static void *ll_thread(void *data)
 		}
 
 		/* LL time slice now running at this point */
-		pthread_mutex_lock(&vc->list_mutex);
+		tick = atomic_add(&vc->tick, 1) + 1;
+		ll_read_lock(vc);
+		queue = ll_run_queue_get(vc);
 
 		/* list empty then return */
-		if (list_is_empty(&vc->list)) {
-			pthread_mutex_unlock(&vc->list_mutex);
+		if ((!queue || !queue->count) && ll_vcore_idle(vc)) {
+			ll_read_unlock(vc);
 			fprintf(stdout, "LL scheduler thread exit - list empty\n");
 			break;
 		}
 
 		/* iterate through the task list */
-		list_for_item_safe(tlist, tlist_, &vc->list) {
-			task = container_of(tlist, struct task, list);
+		for (i = 0; queue && i < queue->count; i++) {
+			task = queue->tasks[i];
 
-			/* only run queued tasks */
-			if (task->state == SOF_TASK_STATE_QUEUED) {
-				task->state = SOF_TASK_STATE_RUNNING;
-				pthread_mutex_unlock(&vc->list_mutex);
-
-				/* run task and time it */
-				clock_gettime(CLOCK_MONOTONIC, &td0);
-				task->ops.run(task->data);
-				clock_gettime(CLOCK_MONOTONIC, &td1);
+			/* only run queued tasks, stolen ones are already claimed */
+			if (task->state == SOF_TASK_STATE_QUEUED && ll_task_claim(task, tick))
+				ll_task_run(task);
+		}
 
-				pthread_mutex_lock(&vc->list_mutex);
+		/* help the other vcores until there is nothing left in their tick */
+		stolen = 0;
+		if (ll_work_stealing) {
+			do {
+				n = ll_steal_tasks(vc);
+				stolen += n;
+			} while (n);
+		}
 
-				/* only re-queue if not cancelled */
-				if (task->state == SOF_TASK_STATE_RUNNING)
-					task->state = SOF_TASK_STATE_QUEUED;
+		ll_read_unlock(vc);
 
-				/* Calculate average task exec time */
-				delta = (td1.tv_sec - td0.tv_sec) * 1000000;
-				delta += (td1.tv_nsec - td0.tv_nsec) / 1000;
-				task->start += delta;
-			}
-		}
+		/* free what the tasks of this tick have removed from run queues */
+		if (atomic_read(&ll_retired_count))
+			ll_reclaim(false);
 
-		pthread_mutex_unlock(&vc->list_mutex);
+		/* don't spin on the other run queues in batch mode */
+		if (ll_work_stealing && !stolen && !tick_period_us)
+			sched_yield();
 	}
 
 out:
@@ -153,84 +459,250 @@ out:
 	return NULL;
 }
 
-static int schedule_ll_task_complete(void *data, struct task *task)
+/*
+ * A pipeline task can run on any vcore when no buffer connects its pipeline
+ * to a pipeline of another task.
+ */
+static bool ll_task_is_independent(struct task *task)
 {
-	struct ll_vcore *vc = data;
+	struct ipc *ipc = ipc_get();
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	struct pipeline *src, *sink;
+	bool pipeline_task = false;
+
+	if (!ipc)
+		return false;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+
+		switch (icd->type) {
+		case COMP_TYPE_PIPELINE:
+			if (icd->pipeline->pipe_task == task)
+				pipeline_task = true;
+			break;
+		case COMP_TYPE_BUFFER:
+			if (!icd->cb->source || !icd->cb->sink)
+				break;
+
+			src = icd->cb->source->pipeline;
+			sink = icd->cb->sink->pipeline;
+			if (!src || !sink || src == sink)
+				break;
+
+			if (src->pipe_task == task || sink->pipe_task == task)
+				return false;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return pipeline_task;
+}
+
+static int ll_vcore_start(struct ll_vcore *vc)
+{
+	pthread_attr_t attr;
+	struct sched_param param;
+	int err;
+	bool valid_attr = false;
+	uid_t uid = getuid();
+	uid_t euid = geteuid();
+
+	/* reap the previous thread of this vcore if it has exited */
+	if (__sync_bool_compare_and_swap(&vc->joinable, 1, 0))
+		pthread_join(vc->thread_id, NULL);
+
+	/* do we have elevated privileges to attempt RT priority */
+	if (uid < 0 || uid != euid) {
+		/* attempt to set thread priority - needs suid */
+		printf("ll schedule: set RT priority\n");
+		err = pthread_attr_init(&attr);
+		if (err) {
+			printf("error: can't create thread attr %d %s\n",
+			       err, strerror(err));
+			goto create;
+		}
+
+		err = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+		if (err) {
+			printf("error: can't set thread policy %d %s\n",
+			       err, strerror(err));
+			goto create;
+		}
+		param.sched_priority = 80;
+		err = pthread_attr_setschedparam(&attr, &param);
+		if (err) {
+			printf("error: can't set thread sched param %d %s\n",
+			       err, strerror(err));
+			goto create;
+		}
+		err = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+		if (err) {
+			printf("error: can't set thread inherit %d %s\n",
+			       err, strerror(err));
+			goto create;
+		}
+		valid_attr = true;
+	}
+
+create:
+	/* nope, so start thread for this virtual core */
+	vc->vcore_ready = 1;
+	err = pthread_create(&vc->thread_id, valid_attr ? &attr : NULL,
+			     ll_thread, vc);
+	if (err) {
+		fprintf(stderr, "error: failed to create LL thread for vcore %d %s\n",
+			vc->core_id, strerror(err));
+		vc->vcore_ready = 0;
+		return -err;
+	}
+
+	vc->joinable = 1;
+
+	return 0;
+}
+
+/* wait for the LL threads that run out of tasks */
+static void ll_vcore_join(struct ll_vcore *vc)
+{
+	bool idle;
+	int i;
+
+	if (!ll_work_stealing) {
+		if (__sync_bool_compare_and_swap(&vc->joinable, 1, 0))
+			pthread_join(vc->thread_id, NULL);
+		return;
+	}
+
+	/*
+	 * The caller may not be a vcore thread with a read section of its own,
+	 * so keep the run queues from being reclaimed while they are read.
+	 */
+	pthread_mutex_lock(&ll_retired_mutex);
+	idle = ll_vcore_idle(vc);
+	pthread_mutex_unlock(&ll_retired_mutex);
+	if (!idle)
+		return;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		if (__sync_bool_compare_and_swap(&ll_vcores[i].joinable, 1, 0))
+			pthread_join(ll_vcores[i].thread_id, NULL);
+}
+
+/*
+ * Remove the task from the run queue of its vcore. Once this returns the
+ * task is not run anymore and, unless called from an LL task, not running.
+ */
+static int ll_task_remove(struct ll_vcore *vc, struct task *task,
+			  enum task_state state)
+{
+	bool empty;
+	int ret;
 
-	/* task is complete so remove it from list */
 	pthread_mutex_lock(&vc->list_mutex);
+	task->state = state;
 	list_item_del(&task->list);
-	task->state = SOF_TASK_STATE_COMPLETED;
+	ret = ll_run_queue_update(vc);
+	empty = list_is_empty(&vc->list);
 	pthread_mutex_unlock(&vc->list_mutex);
 
-	return 0;
+	ll_synchronize();
+	ll_reclaim(false);
+
+	/* list empty then return */
+	if (empty)
+		ll_vcore_join(vc);
+
+	return ret;
+}
+
+/* vcore of the task, NULL if the task core has no vcore */
+static struct ll_vcore *ll_task_vcore(void *data, struct task *task)
+{
+	if (task->core >= CONFIG_CORE_COUNT) {
+		tr_err(&ll_tr, "ll_task_vcore(): task core %d, only %d cores",
+		       task->core, CONFIG_CORE_COUNT);
+		return NULL;
+	}
+
+	return (struct ll_vcore *)data + task->core;
+}
+
+static int schedule_ll_task_complete(void *data, struct task *task)
+{
+	struct ll_vcore *vc = ll_task_vcore(data, task);
+
+	if (!vc)
+		return -EINVAL;
+
+	/* task is complete so remove it from list */
+	return ll_task_remove(vc, task, SOF_TASK_STATE_COMPLETED);
 }
 
 /* schedule new LL task */
 static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			    uint64_t period)
 {
-	struct ll_vcore *vc = data;
-	pthread_attr_t attr;
-	struct sched_param param;
+	struct ll_vcore *vc = ll_task_vcore(data, task);
+	struct ll_vcore_task *pdata = ll_sch_get_pdata(task);
 	int err;
-	bool valid_attr = false;
-	uid_t uid = getuid();
-	uid_t euid = geteuid();
+	int i;
+
+	if (!vc)
+		return -EINVAL;
+
+	if (!pdata) {
+		pdata = calloc(1, sizeof(*pdata));
+		if (!pdata)
+			return -ENOMEM;
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+		task_load_init(&pdata->load, task);
+#endif
+		ll_sch_set_pdata(task, pdata);
+	}
 
-	/* add task to list */
+	/* not run yet in the current tick of the vcore */
+	atomic_set(&pdata->claim, 2 * atomic_read(&vc->tick));
+	pdata->stealable = ll_work_stealing && ll_task_is_independent(task);
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	pdata->load.budget = MIN(period * 1000, UINT32_MAX);
+#endif
+
+	/* add task to list and publish it */
 	pthread_mutex_lock(&vc->list_mutex);
 	list_item_prepend(&task->list, &vc->list);
 	task->state = SOF_TASK_STATE_QUEUED;
 	task->start = 0;
+	err = ll_run_queue_update(vc);
+	if (err < 0) {
+		list_item_del(&task->list);
+		task->state = SOF_TASK_STATE_INIT;
+	}
 	pthread_mutex_unlock(&vc->list_mutex);
 
+	if (err < 0)
+		return err;
+
 	/* is vcore thread running ? */
 	if (!vc->vcore_ready) {
-		/* do we have elevated privileges to attempt RT priority */
-		if (uid < 0 || uid != euid) {
-			/* attempt to set thread priority - needs suid */
-			printf("ll schedule: set RT priority\n");
-			err = pthread_attr_init(&attr);
-			if (err) {
-				printf("error: can't create thread attr %d %s\n",
-				       err, strerror(err));
-				goto create;
-			}
+		err = ll_vcore_start(vc);
+		if (err < 0)
+			return err;
+	}
 
-			err = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
-			if (err) {
-				printf("error: can't set thread policy %d %s\n",
-				       err, strerror(err));
-				goto create;
-			}
-			param.sched_priority = 80;
-			err = pthread_attr_setschedparam(&attr, &param);
-			if (err) {
-				printf("error: can't set thread sched param %d %s\n",
-				       err, strerror(err));
-				goto create;
-			}
-			err = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
-			if (err) {
-				printf("error: can't set thread inherit %d %s\n",
-				       err, strerror(err));
-				goto create;
-			}
-			valid_attr = true;
-		}
+	if (!ll_work_stealing)
+		return 0;
 
-create:
-		/* nope, so start thread for this virtual core */
-		err = pthread_create(&vc->thread_id, valid_attr ? &attr : NULL,
-				     ll_thread, &vc[task->core]);
-		if (err < 0) {
-			fprintf(stderr, "error: failed to create LL thread for vcore %d %s\n",
-				task->core, strerror(err));
-			return err;
+	/* idle vcores need a thread to steal tasks */
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		if (!ll_vcores[i].vcore_ready) {
+			err = ll_vcore_start(ll_vcores + i);
+			if (err < 0)
+				return err;
 		}
-
-		vc->vcore_ready = 1;
 	}
 
 	return 0;
@@ -238,48 +710,55 @@ create:
 
 static void ll_scheduler_free(void *data, uint32_t flags)
 {
+	struct ll_vcore *vcore = data;
+	int i;
+
+	ll_reclaim(true);
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		free(vcore[i].queue);
+
 	free(data);
 }
 
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_cancel(void *data, struct task *task)
 {
-	struct ll_vcore *vc = data;
-
-	pthread_mutex_lock(&vc->list_mutex);
-	/* delete task */
-	task->state = SOF_TASK_STATE_CANCEL;
-	list_item_del(&task->list);
+	struct ll_vcore *vc = ll_task_vcore(data, task);
 
-	/* list empty then return */
-	if (list_is_empty(&vc->list)) {
-		pthread_mutex_unlock(&vc->list_mutex);
-		pthread_join(vc->thread_id, NULL);
-	} else {
-		pthread_mutex_unlock(&vc->list_mutex);
-	}
+	if (!vc)
+		return -EINVAL;
 
-	return 0;
+	/* delete task */
+	return ll_task_remove(vc, task, SOF_TASK_STATE_CANCEL);
 }
 
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_free(void *data, struct task *task)
 {
-	struct ll_vcore *vc = data;
+	struct ll_vcore *vc = ll_task_vcore(data, task);
+	int ret;
 
-	pthread_mutex_lock(&vc->list_mutex);
-	task->state = SOF_TASK_STATE_FREE;
-	list_item_del(&task->list);
+	if (!vc)
+		return -EINVAL;
 
-	/* list empty then return */
-	if (list_is_empty(&vc->list)) {
-		pthread_mutex_unlock(&vc->list_mutex);
-		pthread_join(vc->thread_id, NULL);
-	} else {
-		pthread_mutex_unlock(&vc->list_mutex);
-	}
+	ret = ll_task_remove(vc, task, SOF_TASK_STATE_FREE);
 
-	return 0;
+	ll_retire(ll_sch_get_pdata(task));
+	ll_sch_set_pdata(task, NULL);
+
+	return ret;
+}
+
+struct task_load *schedule_ll_task_load(struct task *task)
+{
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct ll_vcore_task *pdata = ll_sch_get_pdata(task);
+
+	return pdata ? &pdata->load : NULL;
+#else
+	return NULL;
+#endif
 }
 
 static struct scheduler_ops schedule_ll_ops = {
@@ -315,12 +794,19 @@ int scheduler_init_ll(struct ll_schedule_domain *domain)
 		return -ENOMEM;
 
 	core_zero = sof_host_core_base();
+	ll_work_stealing = sof_host_work_stealing();
+	atomic_init(&ll_epoch, 1);
+	atomic_init(&ll_retired_count, 0);
+	list_init(&ll_retired_list);
 
 	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
 		list_init(&vcore[i].list);
+		pthread_mutex_init(&vcore[i].list_mutex, NULL);
 		vcore[i].core_id = core_zero + i;
 	}
 
+	ll_vcores = vcore;
+
 	scheduler_init(SOF_SCHEDULE_LL_TIMER, &schedule_ll_ops, vcore);
 
 	return 0;
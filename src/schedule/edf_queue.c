@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/schedule/edf_queue.h>
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/task.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+static inline struct edf_task_pdata *edf_queue_pdata(struct edf_queue *queue, uint32_t i)
+{
+	return edf_sch_get_pdata(queue->tasks[i]);
+}
+
+/*
+ * Tasks to be run ASAP keep the order they were queued in. Other equal
+ * deadlines prefer the latest queued task, as the former scan of the task
+ * list did.
+ */
+static bool edf_queue_before(struct edf_task_pdata *a, struct edf_task_pdata *b)
+{
+	if (a->deadline != b->deadline)
+		return a->deadline < b->deadline;
+
+	if (a->deadline == SOF_TASK_DEADLINE_NOW)
+		return (int32_t)(a->seq - b->seq) < 0;
+
+	return (int32_t)(a->seq - b->seq) > 0;
+}
+
+static void edf_queue_place(struct edf_queue *queue, struct task *task, uint32_t i)
+{
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+
+	queue->tasks[i] = task;
+	edf_pdata->queue_index = i;
+}
+
+static void edf_queue_sift_up(struct edf_queue *queue, uint32_t i)
+{
+	struct task *task = queue->tasks[i];
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+	uint32_t parent;
+
+	while (i) {
+		parent = (i - 1) >> 1;
+		if (!edf_queue_before(edf_pdata, edf_queue_pdata(queue, parent)))
+			break;
+
+		edf_queue_place(queue, queue->tasks[parent], i);
+		i = parent;
+	}
+
+	edf_queue_place(queue, task, i);
+}
+
+static void edf_queue_sift_down(struct edf_queue *queue, uint32_t i)
+{
+	struct task *task = queue->tasks[i];
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+	uint32_t child;
+
+	for (child = 2 * i + 1; child < queue->count; child = 2 * i + 1) {
+		if (child + 1 < queue->count &&
+		    edf_queue_before(edf_queue_pdata(queue, child + 1),
+				     edf_queue_pdata(queue, child)))
+			child++;
+
+		if (!edf_queue_before(edf_queue_pdata(queue, child), edf_pdata))
+			break;
+
+		edf_queue_place(queue, queue->tasks[child], i);
+		i = child;
+	}
+
+	edf_queue_place(queue, task, i);
+}
+
+struct task **edf_queue_set_storage(struct edf_queue *queue, struct task **tasks,
+				    uint32_t size)
+{
+	struct task **old = queue->tasks;
+	uint32_t i;
+
+	for (i = 0; i < queue->count; i++)
+		tasks[i] = old[i];
+
+	queue->tasks = tasks;
+	queue->size = size;
+
+	return old;
+}
+
+int edf_queue_push(struct edf_queue *queue, struct task *task, uint64_t deadline)
+{
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+
+	if (queue->count == queue->size)
+		return -ENOSPC;
+
+	edf_pdata->deadline = deadline;
+	edf_pdata->seq = queue->seq++;
+
+	queue->tasks[queue->count] = task;
+	edf_queue_sift_up(queue, queue->count++);
+
+	return 0;
+}
+
+void edf_queue_remove(struct edf_queue *queue, struct task *task)
+{
+	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
+	uint32_t i = edf_pdata->queue_index;
+
+	if (edf_pdata->queue_index < 0)
+		return;
+
+	edf_pdata->queue_index = -1;
+
+	/* move the last task to the hole and restore the heap order */
+	if (i == --queue->count)
+		return;
+
+	queue->tasks[i] = queue->tasks[queue->count];
+	if (i && edf_queue_before(edf_queue_pdata(queue, i),
+				  edf_queue_pdata(queue, (i - 1) >> 1)))
+		edf_queue_sift_up(queue, i);
+	else
+		edf_queue_sift_down(queue, i);
+}
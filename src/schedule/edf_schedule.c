@@ -13,7 +13,9 @@
 #include <rtos/clk.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
+#include <sof/schedule/edf_queue.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
@@ -30,7 +32,8 @@ DECLARE_SOF_UUID("edf-schedule", edf_sched_uuid, 0x77de2074, 0x828c, 0x4044,
 DECLARE_TR_CTX(edf_tr, SOF_UUID(edf_sched_uuid), LOG_LEVEL_INFO);
 
 struct edf_schedule_data {
-	struct list_item list;	/* list of tasks in priority queue */
+	struct edf_queue queue;	/* queued and running tasks by deadline */
+	uint32_t num_tasks;	/* number of initialized tasks */
 	uint32_t clock;
 	int irq;
 };
@@ -44,7 +47,7 @@ static void schedule_edf(struct edf_schedule_data *edf_sch);
 static void schedule_edf_task_run(struct task *task, void *data)
 {
 	while (1) {
-		/* execute task run function and remove task from the list
+		/* execute task run function and remove task from the run queue
 		 * only if completed
 		 */
 		if (task_run(task) == SOF_TASK_STATE_COMPLETED)
@@ -58,45 +61,52 @@ static void schedule_edf_task_run(struct task *task, void *data)
 static void edf_scheduler_run(void *data)
 {
 	struct edf_schedule_data *edf_sch = data;
-	uint64_t deadline_next = SOF_TASK_DEADLINE_IDLE;
-	struct task *task_next = NULL;
-	struct list_item *tlist;
-	struct task *task;
-	uint64_t deadline;
+	struct task *task_next;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "edf_scheduler_run()");
 
 	irq_local_disable(flags);
 
-	/* find next task to run */
-	list_for_item(tlist, &edf_sch->list) {
-		task = container_of(tlist, struct task, list);
+	/* find next task to run, dropping the ones no longer schedulable */
+	while ((task_next = edf_queue_peek(&edf_sch->queue)) &&
+	       task_next->state != SOF_TASK_STATE_QUEUED &&
+	       task_next->state != SOF_TASK_STATE_RUNNING)
+		edf_queue_remove(&edf_sch->queue, task_next);
 
-		if (task->state != SOF_TASK_STATE_QUEUED &&
-		    task->state != SOF_TASK_STATE_RUNNING)
-			continue;
+	irq_local_enable(flags);
 
-		deadline = task_get_deadline(task);
+	/* schedule next pending task */
+	if (task_next)
+		schedule_edf_task_running(data, task_next);
+}
+
+/*
+ * Make sure the run queue fits all initialized tasks, so that queueing a
+ * task never allocates memory with interrupts disabled.
+ */
+static int edf_queue_reserve(struct edf_schedule_data *edf_sch, uint32_t num_tasks)
+{
+	struct task **tasks;
+	uint32_t size;
+	uint32_t flags;
 
-		if (deadline == SOF_TASK_DEADLINE_NOW) {
-			/* task needs to be scheduled ASAP */
-			task_next = task;
-			break;
-		}
+	if (num_tasks <= edf_sch->queue.size)
+		return 0;
 
-		/* get earliest deadline */
-		if (deadline <= deadline_next) {
-			deadline_next = deadline;
-			task_next = task;
-		}
-	}
+	size = MAX(num_tasks, edf_sch->queue.size * 2);
+	tasks = rzalloc(SOF_MEM_ZONE_SYS_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			sizeof(*tasks) * size);
+	if (!tasks)
+		return -ENOMEM;
 
+	irq_local_disable(flags);
+	tasks = edf_queue_set_storage(&edf_sch->queue, tasks, size);
 	irq_local_enable(flags);
 
-	/* schedule next pending task */
-	if (task_next)
-		schedule_edf_task_running(data, task_next);
+	rfree(tasks);
+
+	return 0;
 }
 
 static int schedule_edf_task(void *data, struct task *task, uint64_t start,
@@ -104,6 +114,7 @@ static int schedule_edf_task(void *data, struct task *task, uint64_t start,
 {
 	struct edf_schedule_data *edf_sch = data;
 	uint32_t flags;
+	int ret;
 	(void) period; /* not used */
 	(void) start; /* not used */
 
@@ -118,8 +129,13 @@ static int schedule_edf_task(void *data, struct task *task, uint64_t start,
 		return -EALREADY;
 	}
 
-	/* add task to the list */
-	list_item_append(&task->list, &edf_sch->list);
+	/* add task to the run queue */
+	ret = edf_queue_push(&edf_sch->queue, task, task_get_deadline(task));
+	if (ret < 0) {
+		tr_err(&edf_tr, "schedule_edf_task(), run queue full");
+		irq_local_enable(flags);
+		return ret;
+	}
 
 	task->state = SOF_TASK_STATE_QUEUED;
 
@@ -134,6 +150,7 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 			   const struct task_ops *ops,
 			   void *data, uint16_t core, uint32_t flags)
 {
+	struct edf_schedule_data *edf_sch = scheduler_get_data(SOF_SCHEDULE_EDF);
 	struct edf_task_pdata *edf_pdata = NULL;
 	int ret;
 
@@ -145,6 +162,12 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 	if (edf_sch_get_pdata(task))
 		return -EEXIST;
 
+	ret = edf_queue_reserve(edf_sch, edf_sch->num_tasks + 1);
+	if (ret < 0) {
+		tr_err(&edf_tr, "schedule_task_init_edf(): run queue alloc failed");
+		return ret;
+	}
+
 	edf_pdata = rzalloc(SOF_MEM_ZONE_SYS_RUNTIME, 0, SOF_MEM_CAPS_RAM,
 			    sizeof(*edf_pdata));
 	if (!edf_pdata) {
@@ -152,6 +175,7 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 		return -ENOMEM;
 	}
 
+	edf_pdata->queue_index = -1;
 	edf_sch_set_pdata(task, edf_pdata);
 
 	task->ops.complete = ops->complete;
@@ -160,10 +184,11 @@ int schedule_task_init_edf(struct task *task, const struct sof_uuid_entry *uid,
 	if (task_context_alloc(&edf_pdata->ctx) < 0)
 		goto error;
 	if (task_context_init(edf_pdata->ctx, &schedule_edf_task_run,
-			      task, scheduler_get_data(SOF_SCHEDULE_EDF),
-			      task->core, NULL, 0) < 0)
+			      task, edf_sch, task->core, NULL, 0) < 0)
 		goto error;
 
+	edf_sch->num_tasks++;
+
 	/* flush for secondary core */
 	if (!cpu_is_primary(task->core))
 		dcache_writeback_invalidate_region(edf_pdata,
@@ -198,6 +223,7 @@ static int schedule_edf_task_running(void *data, struct task *task)
 
 static int schedule_edf_task_complete(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "schedule_edf_task_complete()");
@@ -207,7 +233,7 @@ static int schedule_edf_task_complete(void *data, struct task *task)
 	task_complete(task);
 
 	task->state = SOF_TASK_STATE_COMPLETED;
-	list_item_del(&task->list);
+	edf_queue_remove(&edf_sch->queue, task);
 
 	irq_local_enable(flags);
 
@@ -216,6 +242,7 @@ static int schedule_edf_task_complete(void *data, struct task *task)
 
 static int schedule_edf_task_cancel(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	uint32_t flags;
 
 	tr_dbg(&edf_tr, "schedule_edf_task_cancel()");
@@ -225,7 +252,7 @@ static int schedule_edf_task_cancel(void *data, struct task *task)
 	/* cancel and delete only if queued */
 	if (task->state == SOF_TASK_STATE_QUEUED) {
 		task->state = SOF_TASK_STATE_CANCEL;
-		list_item_del(&task->list);
+		edf_queue_remove(&edf_sch->queue, task);
 	}
 
 	irq_local_enable(flags);
@@ -235,12 +262,15 @@ static int schedule_edf_task_cancel(void *data, struct task *task)
 
 static int schedule_edf_task_free(void *data, struct task *task)
 {
+	struct edf_schedule_data *edf_sch = data;
 	struct edf_task_pdata *edf_pdata = edf_sch_get_pdata(task);
 	uint32_t flags;
 
 	irq_local_disable(flags);
 
 	task->state = SOF_TASK_STATE_FREE;
+	edf_queue_remove(&edf_sch->queue, task);
+	edf_sch->num_tasks--;
 
 	task_context_free(edf_pdata->ctx);
 	edf_pdata->ctx = NULL;
@@ -260,7 +290,6 @@ int scheduler_init_edf(void)
 
 	edf_sch = rzalloc(SOF_MEM_ZONE_SYS, 0, SOF_MEM_CAPS_RAM,
 			  sizeof(*edf_sch));
-	list_init(&edf_sch->list);
 	edf_sch->clock = PLATFORM_DEFAULT_CLOCK;
 
 	scheduler_init(SOF_SCHEDULE_EDF, &schedule_edf_ops, edf_sch);
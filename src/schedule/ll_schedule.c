@@ -24,6 +24,7 @@
 #include <sof/schedule/ll_schedule_domain.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
+#include <sof/schedule/task_load.h>
 #include <rtos/spinlock.h>
 #include <ipc/topology.h>
 
@@ -69,6 +70,8 @@ DECLARE_TR_CTX(ll_tr, SOF_UUID(ll_sched_uuid), LOG_LEVEL_INFO);
 /* one instance of data allocated per core */
 struct ll_schedule_data {
 	struct list_item tasks;			/* list of ll tasks */
+	struct list_item start_list;		/* waiting tasks ordered by start */
+	struct list_item run_list;		/* pending tasks in tasks list order */
 	atomic_t num_tasks;			/* number of ll tasks */
 #if CONFIG_PERFORMANCE_COUNTERS
 	struct perf_cnt_data pcd;
@@ -97,17 +100,91 @@ static void perf_avg_ll_sched_trace(struct perf_cnt_data *pcd, int ignored)
 
 #endif
 
+/* put the task into the start ordered list, tasks with equal start are FIFO */
+static void schedule_ll_start_insert(struct ll_schedule_data *sch,
+				     struct task *task)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+	struct ll_task_pdata *curr;
+	struct list_item *tlist;
+
+	list_item_del(&pdata->start_list);
+
+	/* a rescheduled task usually has the latest start, search from the tail */
+	list_for_item_prev(tlist, &sch->start_list) {
+		curr = container_of(tlist, struct ll_task_pdata, start_list);
+		if (curr->task->start <= task->start)
+			break;
+	}
+
+	list_item_prepend(&pdata->start_list, tlist);
+}
+
+/* number the tasks so the run list can keep the order of the tasks list */
+static void schedule_ll_tasks_renumber(struct ll_schedule_data *sch)
+{
+	struct ll_task_pdata *pdata;
+	struct list_item *tlist;
+	uint32_t order = 0;
+
+	list_for_item(tlist, &sch->tasks) {
+		pdata = ll_sch_get_pdata(container_of(tlist, struct task, list));
+		pdata->order = order++;
+	}
+}
+
+/* move the task from the start ordered list to the run list */
+static void schedule_ll_task_pending(struct ll_schedule_data *sch,
+				     struct task *task)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+	struct ll_task_pdata *curr;
+	struct list_item *tlist;
+
+	task->state = SOF_TASK_STATE_PENDING;
+	list_item_del(&pdata->start_list);
+
+	list_for_item_prev(tlist, &sch->run_list) {
+		curr = container_of(tlist, struct ll_task_pdata, run_list);
+		if (curr->order < pdata->order)
+			break;
+	}
+
+	list_item_prepend(&pdata->run_list, tlist);
+}
+
 static bool schedule_ll_is_pending(struct ll_schedule_data *sch)
 {
 	struct ll_schedule_domain *domain = sch->domain;
+	struct ll_task_pdata *pdata;
 	struct list_item *tlist;
 	struct task *task;
 	uint32_t pending_count = 0;
-	struct comp_dev *sched_comp;
+	struct comp_dev *sched_comp = NULL;
 	k_spinlock_key_t key;
 
 	key = k_spin_lock(&domain->lock);
 
+	if (domain->type == SOF_SCHEDULE_LL_TIMER) {
+		/*
+		 * Timer tasks are due in start order, so only the due ones
+		 * and the first one still in the future are visited.
+		 */
+		while (!list_is_empty(&sch->start_list)) {
+			pdata = list_first_item(&sch->start_list,
+						struct ll_task_pdata, start_list);
+			if (!domain_is_pending(domain, pdata->task, &sched_comp))
+				break;
+
+			schedule_ll_task_pending(sch, pdata->task);
+			pending_count++;
+		}
+
+		k_spin_unlock(&domain->lock, key);
+
+		return pending_count > 0;
+	}
+
 	do {
 		sched_comp = NULL;
 
@@ -124,7 +201,7 @@ static bool schedule_ll_is_pending(struct ll_schedule_data *sch)
 				continue;
 
 			if (domain_is_pending(domain, task, &sched_comp)) {
-				task->state = SOF_TASK_STATE_PENDING;
+				schedule_ll_task_pending(sch, task);
 				pending_count++;
 			}
 		}
@@ -135,6 +212,30 @@ static bool schedule_ll_is_pending(struct ll_schedule_data *sch)
 	return pending_count > 0;
 }
 
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+/* caller should hold the domain lock */
+static void schedule_ll_load_track(struct ll_schedule_data *sch,
+				   struct task *task, uint64_t period)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
+	pdata->load->budget = sch->domain->ticks_per_ms * period / 1000;
+	list_item_append(&pdata->load->list, &sch->domain->task_loads);
+}
+
+/* caller should hold the domain lock */
+static void schedule_ll_load_untrack(struct task *task)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
+	list_item_del(&pdata->load->list);
+}
+#else
+static inline void schedule_ll_load_track(struct ll_schedule_data *sch,
+					  struct task *task, uint64_t period) { }
+static inline void schedule_ll_load_untrack(struct task *task) { }
+#endif
+
 static void schedule_ll_task_update_start(struct ll_schedule_data *sch,
 					  struct task *task)
 {
@@ -152,6 +253,7 @@ static void schedule_ll_task_done(struct ll_schedule_data *sch,
 {
 	/* Remove from the task list, schedule_task_cancel() won't handle it again */
 	list_item_del(&task->list);
+	schedule_ll_load_untrack(task);
 
 	/* unregister the task */
 	domain_unregister(sch->domain, task, atomic_sub(&sch->num_tasks, 1) - 1);
@@ -168,6 +270,8 @@ static void schedule_ll_task_done(struct ll_schedule_data *sch,
 #ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
 static inline void dsp_load_check(struct task *task, uint32_t cycles0, uint32_t cycles1)
 {
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+	struct task_load *load = pdata->load;
 	uint32_t diff;
 
 	if (cycles1 > cycles0)
@@ -175,18 +279,16 @@ static inline void dsp_load_check(struct task *task, uint32_t cycles0, uint32_t
 	else
 		diff = UINT32_MAX - cycles0 + cycles1;
 
-	task->cycles_sum += diff;
-
-	if (task->cycles_max < diff)
-		task->cycles_max = diff;
+	task_load_add(load, diff);
 
-	if (++task->cycles_cnt == 1 << CHECKS_WINDOW_SIZE) {
-		task->cycles_sum >>= CHECKS_WINDOW_SIZE;
-		tr_info(&ll_tr, "task %p %pU avg %u, max %u", task, task->uid,
-			task->cycles_sum, task->cycles_max);
-		task->cycles_sum = 0;
-		task->cycles_max = 0;
-		task->cycles_cnt = 0;
+	/* the statistics are kept, only the log is periodic */
+	if (!(load->runs & ((1 << CHECKS_WINDOW_SIZE) - 1))) {
+		tr_info(&ll_tr, "task %p %pU p50 %u, p99 %u", task, task->uid,
+			task_load_percentile(load, 500),
+			task_load_percentile(load, 990));
+		tr_info(&ll_tr, "task %p p999 %u, max %u, overruns %u", task,
+			task_load_percentile(load, 999), load->max,
+			load->overruns);
 	}
 }
 #endif
@@ -194,28 +296,23 @@ static inline void dsp_load_check(struct task *task, uint32_t cycles0, uint32_t
 static void schedule_ll_tasks_execute(struct ll_schedule_data *sch)
 {
 	struct ll_schedule_domain *domain = sch->domain;
-	struct list_item *wlist;
+	struct ll_task_pdata *pdata;
 	struct task *task;
 	k_spinlock_key_t key;
 
-	/* check each task in the list for pending */
-	wlist = sch->tasks.next;
-
 	/*
-	 * Cannot use list_for_item(_safe)() because the task can cancel some
-	 * other tasks, removing them from the list. This happens, e.g. when
-	 * a pipeline task terminates a DMIC task.
+	 * Always take the head of the run list, because the task can cancel
+	 * some other tasks, removing them from the list. This happens, e.g.
+	 * when a pipeline task terminates a DMIC task.
 	 */
-	while (wlist != &sch->tasks) {
+	while (!list_is_empty(&sch->run_list)) {
 #ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
 		uint32_t cycles0, cycles1;
 #endif
-		task = list_item(wlist, struct task, list);
-
-		if (task->state != SOF_TASK_STATE_PENDING) {
-			wlist = task->list.next;
-			continue;
-		}
+		pdata = list_first_item(&sch->run_list, struct ll_task_pdata,
+					run_list);
+		task = pdata->task;
+		list_item_del(&pdata->run_list);
 
 		tr_dbg(&ll_tr, "task %p %pU being started...", task, task->uid);
 
@@ -230,8 +327,6 @@ static void schedule_ll_tasks_execute(struct ll_schedule_data *sch)
 		 */
 		task->state = task_run(task);
 
-		wlist = task->list.next;
-
 		key = k_spin_lock(&domain->lock);
 
 		/* do we need to reschedule this task */
@@ -240,6 +335,11 @@ static void schedule_ll_tasks_execute(struct ll_schedule_data *sch)
 		} else {
 			/* update task's start time */
 			schedule_ll_task_update_start(sch, task);
+
+			/* the task might have been cancelled while running */
+			if (!list_is_empty(&task->list))
+				schedule_ll_start_insert(sch, task);
+
 			tr_dbg(&ll_tr, "task %p uid %pU finished, next period ticks %u, domain->next_tick %u",
 			       task, task->uid, (uint32_t)task->start,
 			       (uint32_t)domain->next_tick);
@@ -256,26 +356,21 @@ static void schedule_ll_tasks_execute(struct ll_schedule_data *sch)
 
 static void schedule_ll_client_reschedule(struct ll_schedule_data *sch)
 {
-	struct list_item *tlist;
-	struct task *task;
+	struct ll_task_pdata *pdata;
 	struct task *task_take = NULL;
 	uint64_t next_tick = sch->domain->new_target_tick;
 
 	/* rearm only if there is work to do */
-	if (atomic_read(&sch->domain->total_num_tasks)) {
-		/* traverse to set timer according to the earliest task */
-		list_for_item(tlist, &sch->tasks) {
-			task = container_of(tlist, struct task, list);
-
-			/* only check tasks asked for rescheduling */
-			if (task->state != SOF_TASK_STATE_RESCHEDULE)
-				continue;
-
-			/* update to use the earlier tick */
-			if (task->start < next_tick) {
-				next_tick = task->start;
-				task_take = task;
-			}
+	if (atomic_read(&sch->domain->total_num_tasks) &&
+	    !list_is_empty(&sch->start_list)) {
+		/* the earliest waiting task is at the head of the list */
+		pdata = list_first_item(&sch->start_list, struct ll_task_pdata,
+					start_list);
+
+		/* update to use the earlier tick */
+		if (pdata->task->start < next_tick) {
+			next_tick = pdata->task->start;
+			task_take = pdata->task;
 		}
 
 		tr_dbg(&ll_tr,
@@ -374,6 +469,8 @@ static int schedule_ll_domain_set(struct ll_schedule_data *sch,
 		goto done;
 	}
 
+	schedule_ll_load_track(sch, task, period);
+
 	tr_dbg(&ll_tr, "task->start %u next_tick %u",
 	       (unsigned int)task->start,
 	       (unsigned int)domain->next_tick);
@@ -443,6 +540,7 @@ static void schedule_ll_domain_clear(struct ll_schedule_data *sch,
 
 	/* unregister the task */
 	domain_unregister(domain, task, atomic_read(&sch->num_tasks));
+	schedule_ll_load_untrack(task);
 
 	tr_info(&ll_tr, "num_tasks %ld total_num_tasks %ld",
 		atomic_read(&sch->num_tasks),
@@ -578,6 +676,8 @@ static int schedule_ll_task_common(struct ll_schedule_data *sch, struct task *ta
 		goto out;
 	}
 
+	schedule_ll_tasks_renumber(sch);
+	schedule_ll_start_insert(sch, task);
 
 out:
 	irq_local_enable(flags);
@@ -633,6 +733,22 @@ int schedule_task_init_ll(struct task *task,
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	/* read by the IPC core, so kept in shared memory */
+	ll_pdata->load = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM,
+				 sizeof(*ll_pdata->load));
+	if (!ll_pdata->load) {
+		tr_err(&ll_tr, "schedule_task_init_ll(): load alloc failed");
+		rfree(ll_pdata);
+		return -ENOMEM;
+	}
+
+	task_load_init(ll_pdata->load, task);
+#endif
+
+	ll_pdata->task = task;
+	list_init(&ll_pdata->start_list);
+	list_init(&ll_pdata->run_list);
 	ll_sch_set_pdata(task, ll_pdata);
 
 	return 0;
@@ -642,12 +758,22 @@ static int schedule_ll_task_free(void *data, struct task *task)
 {
 	struct ll_task_pdata *ll_pdata;
 	uint32_t flags;
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct ll_schedule_data *sch = data;
+	k_spinlock_key_t key;
+#endif
 
 	irq_local_disable(flags);
 
 	/* release the resources */
 	task->state = SOF_TASK_STATE_FREE;
 	ll_pdata = ll_sch_get_pdata(task);
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	key = k_spin_lock(&sch->domain->lock);
+	schedule_ll_load_untrack(task);
+	k_spin_unlock(&sch->domain->lock, key);
+	rfree(ll_pdata->load);
+#endif
 	rfree(ll_pdata);
 	ll_sch_set_pdata(task, NULL);
 
@@ -656,9 +782,21 @@ static int schedule_ll_task_free(void *data, struct task *task)
 	return 0;
 }
 
+struct task_load *schedule_ll_task_load(struct task *task)
+{
+#ifdef CONFIG_SCHEDULE_LOG_CYCLE_STATISTICS
+	struct ll_task_pdata *ll_pdata = ll_sch_get_pdata(task);
+
+	return ll_pdata ? ll_pdata->load : NULL;
+#else
+	return NULL;
+#endif
+}
+
 static int schedule_ll_task_cancel(void *data, struct task *task)
 {
 	struct ll_schedule_data *sch = data;
+	struct ll_task_pdata *pdata;
 	struct list_item *tlist;
 	struct task *curr_task;
 	uint32_t flags;
@@ -678,6 +816,9 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 			/* remove work from list */
 			task->state = SOF_TASK_STATE_CANCEL;
 			list_item_del(&task->list);
+			pdata = ll_sch_get_pdata(task);
+			list_item_del(&pdata->start_list);
+			list_item_del(&pdata->run_list);
 
 			break;
 		}
@@ -691,6 +832,7 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 static int reschedule_ll_task(void *data, struct task *task, uint64_t start)
 {
 	struct ll_schedule_data *sch = data;
+	struct ll_task_pdata *pdata;
 	struct list_item *tlist;
 	struct task *curr_task;
 	uint32_t flags;
@@ -709,6 +851,11 @@ static int reschedule_ll_task(void *data, struct task *task, uint64_t start)
 		if (curr_task == task) {
 			/* set start time */
 			task->start = time;
+
+			/* keep the start order if the task is waiting */
+			pdata = ll_sch_get_pdata(task);
+			if (!list_is_empty(&pdata->start_list))
+				schedule_ll_start_insert(sch, task);
 			goto out;
 		}
 	}
@@ -742,10 +889,14 @@ static void ll_scheduler_recalculate_tasks(struct ll_schedule_data *sch,
 					   struct clock_notify_data *clk_data)
 {
 	uint64_t current = sof_cycle_get_64_atomic();
+	struct ll_task_pdata *pdata;
+	struct list_item waiting;
 	struct list_item *tlist;
 	struct task *task;
 	uint64_t delta_ms;
 
+	list_init(&waiting);
+
 	list_for_item(tlist, &sch->tasks) {
 		task = container_of(tlist, struct task, list);
 		delta_ms = (task->start - current) /
@@ -754,6 +905,18 @@ static void ll_scheduler_recalculate_tasks(struct ll_schedule_data *sch,
 		task->start = delta_ms ?
 			current + sch->domain->ticks_per_ms * delta_ms :
 			current + (sch->domain->ticks_per_ms >> 3);
+
+		/* the start order may change, the waiting tasks are sorted again */
+		pdata = ll_sch_get_pdata(task);
+		if (!list_is_empty(&pdata->start_list)) {
+			list_item_del(&pdata->start_list);
+			list_item_append(&pdata->start_list, &waiting);
+		}
+	}
+
+	while (!list_is_empty(&waiting)) {
+		pdata = list_first_item(&waiting, struct ll_task_pdata, start_list);
+		schedule_ll_start_insert(sch, pdata->task);
 	}
 }
 
@@ -781,6 +944,8 @@ int scheduler_init_ll(struct ll_schedule_domain *domain)
 	/* initialize scheduler private data */
 	sch = rzalloc(SOF_MEM_ZONE_SYS, 0, SOF_MEM_CAPS_RAM, sizeof(*sch));
 	list_init(&sch->tasks);
+	list_init(&sch->start_list);
+	list_init(&sch->run_list);
 	atomic_init(&sch->num_tasks, 0);
 	sch->domain = domain;
 
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/common.h>
+#include <sof/list.h>
+#include <sof/math/numbers.h>
+#include <sof/schedule/task_load.h>
+#include <stdint.h>
+#include <string.h>
+
+/* values below TASK_LOAD_SUB_BUCKETS have a bucket of their own */
+static uint32_t task_load_bucket(uint32_t time)
+{
+	int msb;
+
+	if (time < TASK_LOAD_SUB_BUCKETS)
+		return time;
+
+	msb = 31 - clz(time);
+
+	return (msb - TASK_LOAD_SUB_BITS + 1) * TASK_LOAD_SUB_BUCKETS +
+	       ((time >> (msb - TASK_LOAD_SUB_BITS)) & (TASK_LOAD_SUB_BUCKETS - 1));
+}
+
+/* largest run time falling into the bucket */
+static uint32_t task_load_bucket_max(uint32_t bucket)
+{
+	uint32_t shift;
+
+	if (bucket < TASK_LOAD_SUB_BUCKETS)
+		return bucket;
+
+	shift = bucket / TASK_LOAD_SUB_BUCKETS - 1;
+
+	return ((uint64_t)(TASK_LOAD_SUB_BUCKETS + bucket % TASK_LOAD_SUB_BUCKETS + 1)
+		<< shift) - 1;
+}
+
+void task_load_init(struct task_load *load, struct task *task)
+{
+	memset(load, 0, sizeof(*load));
+	list_init(&load->list);
+	load->task = task;
+}
+
+void task_load_add(struct task_load *load, uint32_t time)
+{
+	int i;
+
+	/* halve the history instead of wrapping, the percentiles stay valid */
+	if (load->runs == UINT32_MAX) {
+		load->runs = 0;
+		for (i = 0; i < TASK_LOAD_BUCKETS; i++) {
+			load->hist[i] >>= 1;
+			load->runs += load->hist[i];
+		}
+	}
+
+	load->hist[task_load_bucket(time)]++;
+	load->runs++;
+
+	if (load->budget && time > load->budget)
+		load->overruns++;
+
+	if (time > load->max)
+		load->max = time;
+}
+
+uint32_t task_load_percentile(const struct task_load *load, uint32_t permille)
+{
+	uint64_t target;
+	uint64_t count = 0;
+	int i;
+
+	if (!load->runs)
+		return 0;
+
+	/* number of runs the percentile has to cover, rounded up */
+	target = MAX(((uint64_t)load->runs * permille + 999) / 1000, 1);
+
+	for (i = 0; i < TASK_LOAD_BUCKETS; i++) {
+		count += load->hist[i];
+		if (count >= target)
+			return MIN(task_load_bucket_max(i), load->max);
+	}
+
+	return load->max;
+}
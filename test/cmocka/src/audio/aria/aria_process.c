@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/aria/aria.h>
+#include <sof/audio/component.h>
+
+#define MAX_CHANNELS	8
+#define MAX_GROUPS	9
+#define MAX_SAMPLES	(MAX_CHANNELS * MAX_GROUPS + 1)
+
+static uint32_t lcg_state;
+
+static uint32_t lcg(void)
+{
+	lcg_state = lcg_state * 1664525u + 1013904223u;
+	return lcg_state;
+}
+
+/* Gain applied as AE_MULFP32X2RS followed by AE_SLAA32S */
+static int32_t ref_apply_gain(int32_t gain, int32_t x, size_t att)
+{
+	int64_t prod = (int64_t)gain * x;
+
+	prod = prod < 0 ? -((-prod + (1LL << 30)) >> 31) : (prod + (1LL << 30)) >> 31;
+	prod *= 1LL << att;
+
+	return prod > INT32_MAX ? INT32_MAX : prod < INT32_MIN ? INT32_MIN : prod;
+}
+
+static int32_t ref_load(const struct aria_data *cd, size_t *pos)
+{
+	int32_t x = cd->data[*pos];
+
+	if (++*pos == cd->buff_size)
+		*pos = 0;
+
+	return x;
+}
+
+/*
+ * Model of the HiFi3 aria_algo_get_data() control flow. The HiFi3 version
+ * loads sample pairs from 8 byte aligned addresses, so a buffer position at
+ * an odd sample is processed alone first. With an odd channel count the
+ * pairs then straddle the sample groups: such a pair takes the gain of the
+ * previous group for its first sample and of the next group for the second
+ * one. The sample left over from the pairs takes the last gain.
+ */
+static void ref_get_data(const struct aria_data *cd, int32_t *out, size_t size)
+{
+	int32_t gain_begin = cd->gains[(cd->gain_state + 2) % ARIA_MAX_GAIN_STATES];
+	int32_t gain_end = cd->gains[(cd->gain_state + 3) % ARIA_MAX_GAIN_STATES];
+	size_t pos = (cd->buff_pos + cd->offset) % cd->buff_size;
+	size_t odd_detect = ALIGN_DOWN(size, 2);
+	size_t groups = size / cd->chan_cnt;
+	size_t acc = 0;
+	size_t idx, ch;
+	int32_t gain, next_gain, step;
+
+	for (idx = 1; idx < ARIA_MAX_GAIN_STATES - 1; ++idx) {
+		gain_begin = MIN(gain_begin, cd->gains[(cd->gain_state + idx + 2) %
+						       ARIA_MAX_GAIN_STATES]);
+		gain_end = MIN(gain_end, cd->gains[(cd->gain_state + idx + 3) %
+						   ARIA_MAX_GAIN_STATES]);
+	}
+
+	step = (gain_end - gain_begin) / (int32_t)groups;
+	gain = gain_begin;
+
+	if (pos & 1) {
+		*out++ = ref_apply_gain(gain, ref_load(cd, &pos), cd->att);
+		acc = -cd->chan_cnt;
+		odd_detect = ALIGN_DOWN(size - 1, 2);
+	}
+
+	for (idx = 0; idx < groups; idx++) {
+		for (ch = 0; ch < cd->chan_cnt / 2; ch++) {
+			*out++ = ref_apply_gain(gain, ref_load(cd, &pos), cd->att);
+			*out++ = ref_apply_gain(gain, ref_load(cd, &pos), cd->att);
+		}
+		acc += cd->chan_cnt;
+		next_gain = gain_begin + (idx + 1) * step;
+		if ((acc % 2) && acc <= odd_detect) {
+			*out++ = ref_apply_gain(gain, ref_load(cd, &pos), cd->att);
+			*out++ = ref_apply_gain(next_gain, ref_load(cd, &pos), cd->att);
+		}
+		gain = next_gain;
+	}
+
+	if (acc > odd_detect)
+		*out = ref_apply_gain(gain, cd->data[pos], cd->att);
+}
+
+/* Run aria_algo_get_data() on random data and gains at the current position */
+static void check_get_data(struct comp_dev *dev, struct aria_data *cd, size_t size)
+{
+	int32_t out[MAX_SAMPLES];
+	int32_t ref[MAX_SAMPLES];
+	size_t i;
+
+	cd->gain_state = lcg() % ARIA_MAX_GAIN_STATES;
+	for (i = 0; i < ARIA_MAX_GAIN_STATES; i++)
+		cd->gains[i] = lcg() % 2 ? (int32_t)(lcg() >> 1) :
+			       (int32_t)((1U << (31 - cd->att)) - 1);
+	for (i = 0; i < cd->buff_size; i++)
+		cd->data[i] = lcg();
+
+	memset(ref, 0, sizeof(ref));
+	memset(out, 0, sizeof(out));
+	ref_get_data(cd, ref, size);
+	aria_algo_get_data(dev, out, size);
+
+	for (i = 0; i < size; i++)
+		if (out[i] != ref[i])
+			fail_msg("channels %zu groups %zu pos %zu att %zu sample %zu: %d != %d",
+				 cd->chan_cnt, cd->smpl_group_cnt, cd->buff_pos, cd->att, i,
+				 out[i], ref[i]);
+}
+
+static void test_aria_get_data(void **state)
+{
+	static const size_t group_counts[] = { 1, 2, 3, 5, MAX_GROUPS };
+	int32_t data[MAX_SAMPLES];
+	struct comp_dev dev;
+	struct aria_data cd;
+	size_t chan_cnt, g, pos, att, size;
+
+	(void)state;
+
+	memset(&dev, 0, sizeof(dev));
+	memset(&cd, 0, sizeof(cd));
+	dev.priv_data = &cd;
+	cd.data = data;
+
+	lcg_state = 1;
+	for (chan_cnt = 1; chan_cnt <= MAX_CHANNELS; chan_cnt++) {
+		for (g = 0; g < ARRAY_SIZE(group_counts); g++) {
+			/* as set up by aria_algo_init() */
+			cd.chan_cnt = chan_cnt;
+			cd.smpl_group_cnt = group_counts[g];
+			size = chan_cnt * cd.smpl_group_cnt;
+			cd.buff_size = ALIGN_UP(size, 2);
+			cd.offset = size % 2;
+
+			for (pos = 0; pos < cd.buff_size; pos++) {
+				/* an even channel count never starts at an odd sample */
+				if (!(chan_cnt & 1) && ((pos + cd.offset) & 1))
+					continue;
+
+				cd.buff_pos = pos;
+				for (att = 0; att < 4; att++) {
+					cd.att = att;
+					check_get_data(&dev, &cd, size);
+				}
+			}
+		}
+	}
+}
+
+static void test_aria_calc_gain(void **state)
+{
+	struct comp_dev dev;
+	struct aria_data cd;
+	/* 8 byte aligned as the HiFi3 version requires */
+	int32_t data[MAX_SAMPLES] __aligned(8);
+	uint32_t max_abs, peak;
+	uint64_t gain;
+	size_t att, size, i;
+
+	(void)state;
+
+	memset(&dev, 0, sizeof(dev));
+	memset(&cd, 0, sizeof(cd));
+	dev.priv_data = &cd;
+
+	lcg_state = 2;
+	for (att = 0; att < 4; att++) {
+		cd.att = att;
+		for (size = 1; size <= MAX_SAMPLES; size++) {
+			/* peak from silence to full scale, INT32_MIN last */
+			peak = size == MAX_SAMPLES ? 0 : (uint32_t)(((uint64_t)INT32_MAX * size) /
+								   (MAX_SAMPLES - 1));
+			max_abs = 0;
+			for (i = 0; i < size; i++) {
+				data[i] = peak ? (int32_t)(lcg() % peak) : 0;
+				if (lcg() % 2)
+					data[i] = -data[i];
+			}
+			if (size == MAX_SAMPLES)
+				data[lcg() % size] = INT32_MIN;
+			else
+				data[lcg() % size] = lcg() % 2 ? (int32_t)peak : -(int32_t)peak;
+
+			for (i = 0; i < size; i++)
+				max_abs = MAX(max_abs, data[i] == INT32_MIN ? INT32_MAX :
+					      (uint32_t)(data[i] < 0 ? -data[i] : data[i]));
+
+			gain = (1ULL << (att + 32)) - 1;
+			if (max_abs > (0x7fffffffUL >> att))
+				gain = (0x7fffffffULL << 32) / max_abs;
+
+			aria_algo_calc_gain(&dev, 0, data, size);
+			assert_int_equal(cd.gains[0], (int32_t)(gain >> (att + 1)));
+		}
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_aria_get_data),
+		cmocka_unit_test(test_aria_calc_gain),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
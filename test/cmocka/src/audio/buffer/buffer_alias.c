@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/ipc/schedule.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define SOURCE_SIZE	48
+#define SINK_SIZE	16
+
+struct alias_test_state {
+	struct pipeline pipelines[2];
+	struct comp_dev passthrough;	/* component between the buffers */
+	struct comp_dev consumer;	/* reader of the sink buffer */
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+	uint8_t *sink_addr;		/* own data of the sink buffer */
+	uint8_t produced;		/* next byte written to the source */
+	uint8_t consumed;		/* next byte expected from the sink */
+};
+
+static int setup(void **state)
+{
+	struct sof_ipc_buffer source_desc = { .size = SOURCE_SIZE };
+	struct sof_ipc_buffer sink_desc = { .size = SINK_SIZE };
+	struct alias_test_state *ts = test_calloc(1, sizeof(*ts));
+
+	ts->source = buffer_new(&source_desc);
+	ts->sink = buffer_new(&sink_desc);
+	assert_non_null(ts->source);
+	assert_non_null(ts->sink);
+	ts->sink_addr = ts->sink->stream.addr;
+
+	/* passthrough -> sink -> consumer, all in the first pipeline */
+	ts->passthrough.pipeline = &ts->pipelines[0];
+	ts->consumer.pipeline = &ts->pipelines[0];
+	ts->consumer.ipc_config.type = SOF_COMP_VOLUME;
+	ts->source->sink = &ts->passthrough;
+	ts->sink->source = &ts->passthrough;
+	ts->sink->sink = &ts->consumer;
+
+	*state = ts;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct alias_test_state *ts = *state;
+
+	/* frees the own data of an aliased sink */
+	buffer_free(ts->sink);
+	buffer_free(ts->source);
+	test_free(ts);
+
+	return 0;
+}
+
+static void produce(struct alias_test_state *ts, uint32_t bytes)
+{
+	uint8_t *ptr;
+	uint32_t i;
+
+	for (i = 0; i < bytes; i++) {
+		ptr = audio_stream_write_frag(&ts->source->stream, i, sizeof(uint8_t));
+		*ptr = ts->produced++;
+	}
+	comp_update_buffer_produce(ts->source, bytes);
+}
+
+/* consumer reads the sink buffer, the data must be the source data */
+static void consume(struct alias_test_state *ts, uint32_t bytes)
+{
+	uint8_t *ptr;
+	uint32_t i;
+
+	for (i = 0; i < bytes; i++) {
+		ptr = audio_stream_read_frag(&ts->sink->stream, i, sizeof(uint8_t));
+		assert_int_equal(*ptr, ts->consumed++);
+	}
+	comp_update_buffer_consume(ts->sink, bytes);
+}
+
+/* after a forward both buffers have the same data at the same position */
+static void assert_in_sync(struct alias_test_state *ts)
+{
+	struct audio_stream *source = &ts->source->stream;
+	struct audio_stream *sink = &ts->sink->stream;
+
+	assert_ptr_equal(sink->r_ptr, source->r_ptr);
+	assert_ptr_equal(sink->w_ptr, source->w_ptr);
+	assert_int_equal(audio_stream_get_avail_bytes(sink),
+			 audio_stream_get_avail_bytes(source));
+}
+
+static void test_audio_buffer_alias(void **state)
+{
+	struct alias_test_state *ts = *state;
+
+	assert_int_equal(buffer_alias(ts->sink, ts->source), 0);
+
+	assert_ptr_equal(ts->sink->stream.addr, ts->source->stream.addr);
+	assert_int_equal(ts->sink->stream.size, SOURCE_SIZE);
+	assert_ptr_equal(ts->sink->own_addr, ts->sink_addr);
+	assert_int_equal(ts->sink->own_size, SINK_SIZE);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->sink->stream), 0);
+
+	/* an aliased buffer keeps its size */
+	assert_int_equal(buffer_set_size(ts->sink, 2 * SOURCE_SIZE), -EBUSY);
+}
+
+static void test_audio_buffer_alias_forward(void **state)
+{
+	struct alias_test_state *ts = *state;
+
+	assert_int_equal(buffer_alias(ts->sink, ts->source), 0);
+
+	/* produced data is forwarded and still in the source */
+	produce(ts, 24);
+	assert_int_equal(buffer_alias_forward(ts->source, ts->sink), 24);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->sink->stream), 24);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->source->stream), 24);
+
+	/* nothing new, the forward releases what the consumer has read */
+	consume(ts, 10);
+	assert_int_equal(buffer_alias_forward(ts->source, ts->sink), 0);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->source->stream), 14);
+	assert_int_equal(audio_stream_get_free_bytes(&ts->source->stream),
+			 SOURCE_SIZE - 14);
+	assert_in_sync(ts);
+
+	/* both at once */
+	produce(ts, 6);
+	consume(ts, 4);
+	assert_int_equal(buffer_alias_forward(ts->source, ts->sink), 6);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->source->stream), 16);
+	assert_in_sync(ts);
+
+	/* a forward without any change is a no-op */
+	assert_int_equal(buffer_alias_forward(ts->source, ts->sink), 0);
+	assert_in_sync(ts);
+}
+
+static void test_audio_buffer_alias_forward_wrap(void **state)
+{
+	static const uint32_t produce_bytes[] = { 20, 13, 7, 17, 5, 11 };
+	static const uint32_t consume_bytes[] = { 9, 19, 3, 14, 16, 8 };
+	struct alias_test_state *ts = *state;
+	uint32_t total = 0;
+	uint32_t bytes;
+	int wraps = 0;
+	int i;
+
+	assert_int_equal(buffer_alias(ts->sink, ts->source), 0);
+
+	for (i = 0; i < 60; i++) {
+		bytes = MIN(produce_bytes[i % ARRAY_SIZE(produce_bytes)],
+			    audio_stream_get_free_bytes(&ts->source->stream));
+		produce(ts, bytes);
+		total += bytes;
+		assert_int_equal(buffer_alias_forward(ts->source, ts->sink), bytes);
+		assert_in_sync(ts);
+
+		bytes = MIN(consume_bytes[i % ARRAY_SIZE(consume_bytes)],
+			    audio_stream_get_avail_bytes(&ts->sink->stream));
+		if ((char *)ts->sink->stream.r_ptr + bytes >= (char *)ts->sink->stream.end_addr)
+			wraps++;
+		consume(ts, bytes);
+	}
+
+	/* the last data the consumer has read is released too */
+	assert_int_equal(buffer_alias_forward(ts->source, ts->sink), 0);
+	assert_in_sync(ts);
+
+	assert_true(total > 10 * SOURCE_SIZE);
+	assert_true(wraps > 10);
+}
+
+static void test_audio_buffer_alias_clear(void **state)
+{
+	struct alias_test_state *ts = *state;
+	uint8_t source_data[SOURCE_SIZE];
+	uint8_t *ptr;
+	int ret;
+	int i;
+
+	assert_int_equal(buffer_alias(ts->sink, ts->source), 0);
+	produce(ts, SOURCE_SIZE - 8);
+	buffer_alias_forward(ts->source, ts->sink);
+	consume(ts, 30);
+	buffer_alias_forward(ts->source, ts->sink);
+
+	buffer_alias_clear(ts->sink);
+
+	/* back to own data, empty */
+	assert_null(ts->sink->own_addr);
+	assert_ptr_equal(ts->sink->stream.addr, ts->sink_addr);
+	assert_int_equal(ts->sink->stream.size, SINK_SIZE);
+	assert_ptr_equal(ts->sink->stream.end_addr, ts->sink_addr + SINK_SIZE);
+	assert_int_equal(audio_stream_get_avail_bytes(&ts->sink->stream), 0);
+	assert_int_equal(audio_stream_get_free_bytes(&ts->sink->stream), SINK_SIZE);
+
+	/* writes to the sink don't touch the source data */
+	ret = memcpy_s(source_data, sizeof(source_data), ts->source->stream.addr,
+		       SOURCE_SIZE);
+	assert_int_equal(ret, 0);
+	for (i = 0; i < SINK_SIZE; i++) {
+		ptr = audio_stream_write_frag(&ts->sink->stream, i, sizeof(uint8_t));
+		*ptr = ~source_data[i];
+	}
+	comp_update_buffer_produce(ts->sink, SINK_SIZE);
+	assert_memory_equal(ts->source->stream.addr, source_data, SOURCE_SIZE);
+
+	/* can be resized again, a second clear does nothing */
+	buffer_alias_clear(ts->sink);
+	assert_ptr_equal(ts->sink->stream.addr, ts->sink_addr);
+	assert_int_equal(buffer_set_size(ts->sink, 2 * SINK_SIZE), 0);
+}
+
+static void test_audio_buffer_alias_invalid(void **state)
+{
+	struct alias_test_state *ts = *state;
+
+	/* host and DAI program their DMA with the buffer address */
+	ts->consumer.ipc_config.type = SOF_COMP_DAI;
+	assert_int_equal(buffer_alias(ts->sink, ts->source), -EINVAL);
+	ts->consumer.ipc_config.type = SOF_COMP_HOST;
+	assert_int_equal(buffer_alias(ts->sink, ts->source), -EINVAL);
+	ts->consumer.ipc_config.type = SOF_COMP_VOLUME;
+
+	/* consumer scheduled by another pipeline */
+	ts->consumer.pipeline = &ts->pipelines[1];
+	assert_int_equal(buffer_alias(ts->sink, ts->source), -EINVAL);
+	ts->consumer.pipeline = &ts->pipelines[0];
+
+	/* no consumer */
+	ts->sink->sink = NULL;
+	assert_int_equal(buffer_alias(ts->sink, ts->source), -EINVAL);
+	ts->sink->sink = &ts->consumer;
+
+	/* shared with another core */
+	ts->source->c.shared = true;
+	assert_int_equal(buffer_alias(ts->sink, ts->source), -EINVAL);
+	ts->source->c.shared = false;
+
+	/* nothing has changed */
+	assert_null(ts->sink->own_addr);
+	assert_ptr_equal(ts->sink->stream.addr, ts->sink_addr);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_buffer_alias,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_alias_forward,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_alias_forward_wrap,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_alias_clear,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_alias_invalid,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
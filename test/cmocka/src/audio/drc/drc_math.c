@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/drc/drc.h>
+#include <sof/audio/drc/drc_math.h>
+#include <sof/audio/format.h>
+
+/* Number of test values, processed in DRC_DIVISION_FRAMES blocks */
+#define TEST_VALUES	(64 * DRC_DIVISION_FRAMES)
+
+/* Max relative error of drc_exp_fixed_array() for outputs over 1 LSB */
+#define EXP_REL_TOLERANCE	3.0e-8
+
+/* Max absolute error of drc_sin_fixed_array(), drc_sin_fixed() is 7.4e-5 */
+#define SIN_TOLERANCE		6.0e-7
+
+#define Q_TO_DOUBLE(x, q)	((double)(x) / ((int64_t)1 << (q)))
+
+static int32_t x[TEST_VALUES];
+static int32_t y[TEST_VALUES];
+
+static void fill_positive(void)
+{
+	int i;
+
+	/* Log spaced values over the whole positive int32_t range */
+	for (i = 0; i < TEST_VALUES; i++)
+		x[i] = (int32_t)exp(log(INT32_MAX) * (i + 1) / TEST_VALUES);
+
+	x[0] = 0;
+	x[1] = -1;
+}
+
+static void test_drc_log_fixed_array(void **state)
+{
+	int i;
+
+	(void)state;
+
+	fill_positive();
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_log_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES);
+
+	for (i = 0; i < TEST_VALUES; i++)
+		assert_int_equal(y[i], drc_log_fixed(x[i]));
+}
+
+static void test_drc_lin2db_fixed_array(void **state)
+{
+	int i;
+
+	(void)state;
+
+	fill_positive();
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_lin2db_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES);
+
+	for (i = 0; i < TEST_VALUES; i++)
+		assert_int_equal(y[i], drc_lin2db_fixed(x[i]));
+}
+
+static void test_drc_inv_fixed_array(void **state)
+{
+	int i;
+
+	(void)state;
+
+	fill_positive();
+	x[0] = 1;
+	x[1] = 2;
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_inv_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES, 31, 20);
+
+	for (i = 0; i < TEST_VALUES; i++)
+		assert_int_equal(y[i], drc_inv_fixed(x[i], 31, 20));
+
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_inv_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES, 12, 30);
+
+	for (i = 0; i < TEST_VALUES; i++)
+		assert_int_equal(y[i], drc_inv_fixed(x[i], 12, 30));
+}
+
+static void test_drc_exp_fixed_array(void **state)
+{
+	double ref;
+	double err;
+	double in;
+	int i;
+
+	(void)state;
+
+	/* Sweep -12.0 .. 8.0 in Q5.27 */
+	for (i = 0; i < TEST_VALUES; i++)
+		x[i] = Q_CONVERT_FLOAT(-12.0 + 20.0 * i / TEST_VALUES, 27);
+
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_exp_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES);
+
+	for (i = 0; i < TEST_VALUES; i++) {
+		in = Q_TO_DOUBLE(x[i], 27);
+		if (in < -11.5) {
+			assert_int_equal(y[i], 0);
+			continue;
+		}
+
+		if (in > 7.6245) {
+			assert_int_equal(y[i], INT32_MAX);
+			continue;
+		}
+
+		ref = exp(in);
+		err = fabs(Q_TO_DOUBLE(y[i], 20) - ref);
+		if (err * (1 << 20) <= 1.0)
+			continue;
+
+		if (err / ref > EXP_REL_TOLERANCE)
+			printf("%s: exp(%.10f) = %.10f, ref %.10f\n", __func__, in,
+			       Q_TO_DOUBLE(y[i], 20), ref);
+
+		assert_true(err / ref <= EXP_REL_TOLERANCE);
+	}
+}
+
+static void test_drc_sin_fixed_array(void **state)
+{
+	double ref;
+	double err;
+	int i;
+
+	(void)state;
+
+	/* Sweep the full Q2.30 input range */
+	for (i = 0; i < TEST_VALUES; i++)
+		x[i] = (int32_t)(INT32_MIN + (double)UINT32_MAX * i / (TEST_VALUES - 1));
+
+	for (i = 0; i < TEST_VALUES; i += DRC_DIVISION_FRAMES)
+		drc_sin_fixed_array(&y[i], &x[i], DRC_DIVISION_FRAMES);
+
+	for (i = 0; i < TEST_VALUES; i++) {
+		ref = sin(M_PI / 2 * Q_TO_DOUBLE(x[i], 30));
+		err = fabs(Q_TO_DOUBLE(y[i], 31) - ref);
+		if (err > SIN_TOLERANCE)
+			printf("%s: diff for %d = %.10f\n", __func__, x[i], err);
+
+		assert_true(err <= SIN_TOLERANCE);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_drc_log_fixed_array),
+		cmocka_unit_test(test_drc_lin2db_fixed_array),
+		cmocka_unit_test(test_drc_inv_fixed_array),
+		cmocka_unit_test(test_drc_exp_fixed_array),
+		cmocka_unit_test(test_drc_sin_fixed_array),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <sof/audio/kpb.h>
+#include <sof/audio/kpb_adpcm.h>
+
+/* Number of test blocks and channels */
+#define TEST_BLOCKS	16
+#define TEST_CHANNELS	2
+#define TEST_SAMPLES	(TEST_BLOCKS * KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS)
+
+/* Min signal to noise ratio of the decoded sine after the first block */
+#define MIN_SNR_DB	30.0
+
+static int16_t x[TEST_SAMPLES];
+static uint8_t codes[TEST_SAMPLES];
+static struct kpb_adpcm_state headers[TEST_BLOCKS][TEST_CHANNELS];
+
+static void encode(void)
+{
+	struct kpb_adpcm_state enc[TEST_CHANNELS] = { { 0 } };
+	int i, c;
+
+	/* 1 kHz and 3 kHz sines at 48 kHz */
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		c = i % TEST_CHANNELS;
+		x[i] = (int16_t)(20000.0 * sin(2.0 * M_PI * (1000.0 + 2000.0 * c) *
+					      (i / TEST_CHANNELS) / 48000.0));
+	}
+
+	/* every block starts with the coder state */
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		c = i % TEST_CHANNELS;
+		if (!(i % (KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS)))
+			memcpy_s(headers[i / (KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS)],
+				 sizeof(headers[0]), enc, sizeof(enc));
+
+		codes[i] = kpb_adpcm_encode(&enc[c], x[i]);
+	}
+}
+
+static void decode_block(int block, const uint8_t *header, int16_t *y)
+{
+	struct kpb_adpcm_state st[TEST_CHANNELS];
+	int n = block * KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS;
+	int i;
+
+	kpb_adpcm_load_state(st, header, TEST_CHANNELS);
+	for (i = 0; i < KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS; i++)
+		y[i] = kpb_adpcm_update(&st[i % TEST_CHANNELS], codes[n + i]);
+}
+
+static void test_kpb_adpcm_round_trip(void **state)
+{
+	int16_t y[KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS];
+	int16_t ref[KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS];
+	double signal = 0;
+	double noise = 0;
+	int block, i, n;
+
+	(void)state;
+
+	encode();
+
+	for (block = 0; block < TEST_BLOCKS; block++) {
+		decode_block(block, (const uint8_t *)headers[block], y);
+
+		/* a block decodes alone the same as in the continuous stream */
+		if (block) {
+			decode_block(block - 1, (const uint8_t *)headers[block - 1], ref);
+			for (i = 0; i < TEST_CHANNELS; i++)
+				assert_int_equal(headers[block][i].predictor,
+						 ref[ARRAY_SIZE(ref) - TEST_CHANNELS + i]);
+
+			n = block * KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS;
+			for (i = 0; i < ARRAY_SIZE(y); i++) {
+				signal += (double)x[n + i] * x[n + i];
+				noise += ((double)y[i] - x[n + i]) * ((double)y[i] - x[n + i]);
+			}
+		}
+	}
+
+	assert_true(10.0 * log10(signal / noise) > MIN_SNR_DB);
+}
+
+static void test_kpb_adpcm_bad_header(void **state)
+{
+	struct kpb_adpcm_state header[TEST_CHANNELS];
+	int16_t y[KPB_ADPCM_BLOCK_FRAMES * TEST_CHANNELS];
+	struct kpb_adpcm_state st[TEST_CHANNELS];
+	int i;
+
+	(void)state;
+
+	encode();
+
+	/* coded bytes read as a header give step indices out of the table */
+	memset(header, 0xff, sizeof(header));
+	kpb_adpcm_load_state(st, (const uint8_t *)header, TEST_CHANNELS);
+	for (i = 0; i < TEST_CHANNELS; i++)
+		assert_int_equal(st[i].index, KPB_ADPCM_MAX_INDEX);
+
+	decode_block(1, (const uint8_t *)header, y);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_kpb_adpcm_round_trip),
+		cmocka_unit_test(test_kpb_adpcm_bad_header),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+//
+
+#include "../../util.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/mixer.h>
+#include <ipc4/base-config.h>
+#include <ipc4/mixin_mixout.h>
+#include <ipc4/module.h>
+
+/* Mixins on the mixout core and on another core mix into one mixout. The cores
+ * are only simulated by the core id of the components, the copies are run one
+ * after another in the order the cores could run them.
+ */
+
+#define MIX_TEST_FRAMES		48
+#define MIX_TEST_CHANNELS	2
+#define MIX_TEST_PERIODS	8
+#define MIX_TEST_MIXINS		2
+
+#define MIX_TEST_MIXOUT_ID	IPC4_COMP_ID(2, 0)
+#define MIX_TEST_MIXIN_ID(i)	IPC4_COMP_ID(1, i)
+
+static struct comp_driver mixin_drv;
+static struct comp_driver mixout_drv;
+
+struct mix_test_state {
+	struct comp_dev *mixout;
+	struct comp_buffer *sink;
+	struct comp_dev *mixin[MIX_TEST_MIXINS];
+	struct comp_buffer *source[MIX_TEST_MIXINS];
+	struct comp_buffer *between[MIX_TEST_MIXINS];
+};
+
+static struct mix_test_state mix_state;
+
+/* Mocking comp_register here so we can create the components */
+int comp_register(struct comp_driver_info *info)
+{
+	if (info->drv->type == SOF_COMP_MIXER)
+		return memcpy_s(&mixout_drv, sizeof(mixout_drv), info->drv, sizeof(*info->drv));
+
+	return memcpy_s(&mixin_drv, sizeof(mixin_drv), info->drv, sizeof(*info->drv));
+}
+
+struct comp_dev *ipc4_get_comp_dev(uint32_t comp_id)
+{
+	int i;
+
+	for (i = 0; i < MIX_TEST_MIXINS; i++)
+		if (mix_state.mixin[i] && mix_state.mixin[i]->ipc_config.id == comp_id)
+			return mix_state.mixin[i];
+
+	return NULL;
+}
+
+static struct comp_dev *create_comp(struct comp_driver *drv, uint32_t id, uint32_t core)
+{
+	struct ipc4_base_module_cfg base_cfg = {
+		.obs = MIX_TEST_FRAMES * MIX_TEST_CHANNELS * sizeof(int32_t),
+		.audio_fmt = {
+			.sampling_frequency = 48000,
+			.depth = 32,
+			.valid_bit_depth = 32,
+			.channels_count = MIX_TEST_CHANNELS,
+			.s_type = IPC4_TYPE_SIGNED_INTEGER,
+		},
+	};
+	struct comp_ipc_config config = {
+		.id = id,
+		.core = core,
+	};
+	struct comp_dev *dev = drv->ops.create(drv, &config, &base_cfg);
+
+	assert_non_null(dev);
+	list_init(&dev->bsource_list);
+	list_init(&dev->bsink_list);
+
+	return dev;
+}
+
+static int setup_mixins(void **state, bool one_core)
+{
+	struct ipc4_module_bind_unbind bu;
+	struct comp_buffer *buffer;
+	uint32_t size = MIX_TEST_FRAMES * MIX_TEST_CHANNELS * sizeof(int32_t) * 4;
+	int i;
+
+	sys_comp_mixin_init();
+	sys_comp_mixer_init();
+
+	memset(&mix_state, 0, sizeof(mix_state));
+	mix_state.mixout = create_comp(&mixout_drv, MIX_TEST_MIXOUT_ID, 0);
+	mix_state.sink = create_test_sink(mix_state.mixout, 0, SOF_IPC_FRAME_S32_LE,
+					  MIX_TEST_CHANNELS, size);
+	mix_state.sink->stream.valid_sample_fmt = SOF_IPC_FRAME_S32_LE;
+	mix_state.sink->hw_params_configured = true;
+
+	for (i = 0; i < MIX_TEST_MIXINS; i++) {
+		/* the first mixin is on the mixout core and the others are not */
+		mix_state.mixin[i] = create_comp(&mixin_drv, MIX_TEST_MIXIN_ID(i),
+						 one_core ? 0 : i);
+		mix_state.source[i] = create_test_source(mix_state.mixin[i], 0,
+							 SOF_IPC_FRAME_S32_LE,
+							 MIX_TEST_CHANNELS, size);
+
+		/* unused buffer between mixin and mixout */
+		buffer = create_test_sink(mix_state.mixin[i], 0, SOF_IPC_FRAME_S32_LE,
+					  MIX_TEST_CHANNELS, size);
+		buffer->stream.valid_sample_fmt = SOF_IPC_FRAME_S32_LE;
+		free(buffer->sink);
+		buffer->source = mix_state.mixin[i];
+		buffer->sink = mix_state.mixout;
+		list_item_append(&buffer->sink_list, &mix_state.mixout->bsource_list);
+		mix_state.between[i] = buffer;
+
+		memset(&bu, 0, sizeof(bu));
+		bu.primary.r.module_id = IPC4_MOD_ID(MIX_TEST_MIXIN_ID(i));
+		bu.primary.r.instance_id = i;
+		assert_int_equal(mixout_drv.ops.bind(mix_state.mixout, &bu), 0);
+
+		assert_int_equal(mixin_drv.ops.prepare(mix_state.mixin[i]), 0);
+		mix_state.mixin[i]->state = COMP_STATE_ACTIVE;
+	}
+
+	assert_int_equal(mixout_drv.ops.prepare(mix_state.mixout), 0);
+	mix_state.mixout->state = COMP_STATE_ACTIVE;
+
+	*state = &mix_state;
+
+	return 0;
+}
+
+static int setup(void **state)
+{
+	return setup_mixins(state, false);
+}
+
+/* all mixins on the mixout core mix into the sink one after another */
+static int setup_one_core(void **state)
+{
+	return setup_mixins(state, true);
+}
+
+static int teardown(void **state)
+{
+	int i;
+
+	for (i = 0; i < MIX_TEST_MIXINS; i++) {
+		mix_state.between[i]->sink = NULL;
+		buffer_free(mix_state.between[i]);
+		free_test_source(mix_state.source[i]);
+		mixin_drv.ops.free(mix_state.mixin[i]);
+	}
+
+	free_test_sink(mix_state.sink);
+	mixout_drv.ops.free(mix_state.mixout);
+
+	return 0;
+}
+
+static int32_t mix_test_sample(int mixin, int period, int sample)
+{
+	return (mixin + 1) * 0x100000 + period * 0x1000 + sample;
+}
+
+static void fill_source(int mixin, int period)
+{
+	struct comp_buffer *source = mix_state.source[mixin];
+	int32_t *x = source->stream.w_ptr;
+	int i;
+
+	for (i = 0; i < MIX_TEST_FRAMES * MIX_TEST_CHANNELS; i++) {
+		x = audio_stream_wrap(&source->stream, x);
+		*x++ = mix_test_sample(mixin, period, i);
+	}
+
+	comp_update_buffer_produce(source, MIX_TEST_FRAMES * MIX_TEST_CHANNELS *
+				   sizeof(int32_t));
+}
+
+/* sum of the mixin sources as mixed in the normal mode */
+static int32_t mix_test_ref(int period, int sample)
+{
+	int32_t ref = 0;
+	int i;
+
+	for (i = 0; i < MIX_TEST_MIXINS; i++)
+		ref += mix_test_sample(i, period, sample);
+
+	return ref;
+}
+
+static void verify_sink(int period, int32_t (*mix_ref)(int period, int sample))
+{
+	struct comp_buffer *sink = mix_state.sink;
+	int32_t *y = sink->stream.r_ptr;
+	int i;
+
+	assert_int_equal(audio_stream_get_avail_frames(&sink->stream), MIX_TEST_FRAMES);
+
+	for (i = 0; i < MIX_TEST_FRAMES * MIX_TEST_CHANNELS; i++) {
+		y = audio_stream_wrap(&sink->stream, y);
+		assert_int_equal(*y++, mix_ref(period, i));
+	}
+
+	comp_update_buffer_consume(sink, MIX_TEST_FRAMES * MIX_TEST_CHANNELS *
+				   sizeof(int32_t));
+}
+
+static void test_mixin_mixout_cores(void **state)
+{
+	struct comp_dev *mixout = mix_state.mixout;
+	int period;
+	int i;
+
+	for (period = 0; period < MIX_TEST_PERIODS; period++) {
+		for (i = 0; i < MIX_TEST_MIXINS; i++)
+			fill_source(i, period);
+
+		/* the local mixin runs first, mixout must wait for the other core */
+		assert_int_equal(mixin_drv.ops.copy(mix_state.mixin[0]), 0);
+		assert_int_equal(mixout_drv.ops.copy(mixout), 0);
+		assert_int_equal(audio_stream_get_avail_frames(&mix_state.sink->stream), 0);
+
+		for (i = 1; i < MIX_TEST_MIXINS; i++)
+			assert_int_equal(mixin_drv.ops.copy(mix_state.mixin[i]), 0);
+
+		assert_int_equal(mixout_drv.ops.copy(mixout), 0);
+		verify_sink(period, mix_test_ref);
+	}
+}
+
+static void test_mixin_mixout_cores_remote_first(void **state)
+{
+	struct comp_dev *mixout = mix_state.mixout;
+	int period;
+	int i;
+
+	for (period = 0; period < MIX_TEST_PERIODS; period++) {
+		for (i = 0; i < MIX_TEST_MIXINS; i++)
+			fill_source(i, period);
+
+		/* the other core mixes ahead into its partial buffer */
+		for (i = MIX_TEST_MIXINS - 1; i >= 0; i--)
+			assert_int_equal(mixin_drv.ops.copy(mix_state.mixin[i]), 0);
+
+		assert_int_equal(mixout_drv.ops.copy(mixout), 0);
+		verify_sink(period, mix_test_ref);
+	}
+}
+
+/* Mixin 0 swaps the two channels at unity gain. Mixin 1 takes channel 0 at
+ * half gain and leaves channel 1 of the sink as is.
+ */
+#define MIX_TEST_REMAP_HALF_GAIN	(IPC4_MIXIN_UNITY_GAIN / 2)
+
+static int32_t remap_test_ref(int period, int sample)
+{
+	int frame = sample / MIX_TEST_CHANNELS;
+	int ch = sample % MIX_TEST_CHANNELS;
+	int32_t ref = mix_test_sample(0, period, frame * MIX_TEST_CHANNELS + 1 - ch);
+
+	if (!ch)
+		ref += q_mults_32x32(mix_test_sample(1, period, frame * MIX_TEST_CHANNELS),
+				     MIX_TEST_REMAP_HALF_GAIN, IPC4_MIXIN_GAIN_SHIFT);
+
+	return ref;
+}
+
+static void set_remap(struct comp_dev *mixin, uint32_t channel_map, uint16_t gain)
+{
+	struct ipc4_mixer_mode_config cfg;
+	int ret;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.mixer_mode_config_count = 1;
+	cfg.mixer_mode_sink_configs[0].mixer_mode = IPC4_MIXER_CHANNEL_REMAPPING_MODE;
+	cfg.mixer_mode_sink_configs[0].output_channel_count = MIX_TEST_CHANNELS;
+	cfg.mixer_mode_sink_configs[0].output_channel_map = channel_map;
+	cfg.mixer_mode_sink_configs[0].gain = gain;
+
+	ret = mixin_drv.ops.set_large_config(mixin, IPC4_MIXER_MODE, true, true, sizeof(cfg),
+					     (char *)&cfg);
+	assert_int_equal(ret, 0);
+}
+
+/* Moves the buffer pointers so that the buffer wraps in the middle of a period */
+static void skew_buffer(struct comp_buffer *buffer, uint32_t frames)
+{
+	uint32_t bytes = audio_stream_period_bytes(&buffer->stream, frames);
+
+	comp_update_buffer_produce(buffer, bytes);
+	comp_update_buffer_consume(buffer, bytes);
+}
+
+static void mixin_remap(void)
+{
+	struct comp_dev *mixout = mix_state.mixout;
+	int period;
+	int i;
+
+	set_remap(mix_state.mixin[0], 0xffffff01, IPC4_MIXIN_UNITY_GAIN);
+	set_remap(mix_state.mixin[1], 0xfffffff0, MIX_TEST_REMAP_HALF_GAIN);
+
+	/* the sources and the sink wrap at different frames of a period */
+	skew_buffer(mix_state.source[0], 5);
+	skew_buffer(mix_state.source[1], 11);
+	skew_buffer(mix_state.sink, 7);
+
+	for (period = 0; period < MIX_TEST_PERIODS; period++) {
+		for (i = 0; i < MIX_TEST_MIXINS; i++)
+			fill_source(i, period);
+
+		/* on one core the first mixin copies and the second one mixes */
+		for (i = 0; i < MIX_TEST_MIXINS; i++)
+			assert_int_equal(mixin_drv.ops.copy(mix_state.mixin[i]), 0);
+
+		assert_int_equal(mixout_drv.ops.copy(mixout), 0);
+		verify_sink(period, remap_test_ref);
+	}
+}
+
+static void test_mixin_remap_one_core(void **state)
+{
+	mixin_remap();
+}
+
+static void test_mixin_remap_cores(void **state)
+{
+	mixin_remap();
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_mixin_mixout_cores, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_mixin_mixout_cores_remote_first, setup,
+						teardown),
+		cmocka_unit_test_setup_teardown(test_mixin_remap_one_core, setup_one_core,
+						teardown),
+		cmocka_unit_test_setup_teardown(test_mixin_remap_cores, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -77,6 +77,11 @@ static uint8_t masks[][MUX_MAX_STREAMS][PLATFORM_MAX_CHANNELS] = {
 	  { 0x00, 0x01, },
 	  { 0x00, 0x00, 0x01, },
 	  { 0x00, 0x00, 0x00, 0x01, },},
+	{ { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80}, },
+	{ { 0x01, 0x02, },
+	  { 0x04, 0x08, },
+	  { 0x10, 0x20, },
+	  { 0x40, 0x80, }, },
 };
 
 static int setup_group(void **state)
@@ -259,13 +264,133 @@ static void test_demux_copy_proc_32(void **state)
 				    sizeof(expected_results[0]));
 }
 
-static char *get_test_name(int mask_index, const char *format_name)
+/* buffer sizes and positions of the wrap tests, in frames */
+#define WRAP_SOURCE_FRAMES	7
+#define WRAP_SOURCE_OFFSET	3
+#define WRAP_SINK_FRAMES	5
+#define WRAP_COPY_FRAMES	4
+#define WRAP_COPIES		6
+
+static const uint32_t wrap_sink_offsets[MUX_MAX_STREAMS] = { 1, 4, 0, 2 };
+
+/* move the buffer positions, so it wraps in the middle of a copy */
+static void skew_stream(struct audio_stream *stream, uint32_t frames)
+{
+	uint32_t bytes = frames * audio_stream_frame_bytes(stream);
+
+	audio_stream_produce(stream, bytes);
+	audio_stream_consume(stream, bytes);
+}
+
+/* unique non-zero sample of a channel in a frame */
+static int32_t wrap_sample(uint32_t frame, int channel)
+{
+	return ((frame & 0x7ff) << 4) | (channel + 1);
+}
+
+static void write_sample(struct audio_stream *stream, uint32_t idx, int32_t sample)
 {
-	int length = snprintf(NULL, 0, "test_demux_copy_%s_mask_%d",
+	int16_t *ptr16;
+	int32_t *ptr32;
+
+	if (stream->frame_fmt == SOF_IPC_FRAME_S16_LE) {
+		ptr16 = audio_stream_write_frag_s16(stream, idx);
+		*ptr16 = sample;
+	} else {
+		ptr32 = audio_stream_write_frag_s32(stream, idx);
+		*ptr32 = sample;
+	}
+}
+
+static int32_t read_sample(struct audio_stream *stream, uint32_t idx)
+{
+	int16_t *ptr16;
+	int32_t *ptr32;
+
+	if (stream->frame_fmt == SOF_IPC_FRAME_S16_LE) {
+		ptr16 = audio_stream_read_frag_s16(stream, idx);
+		return *ptr16;
+	}
+
+	ptr32 = audio_stream_read_frag_s32(stream, idx);
+	return *ptr32;
+}
+
+static int setup_wrap_test_case(void **state)
+{
+	struct test_data *td = *((struct test_data **)state);
+	struct sof_ipc_comp_process *ipc = create_demux_comp_ipc(td);
+	size_t frame_size = PLATFORM_MAX_CHANNELS * (td->format == SOF_IPC_FRAME_S16_LE ?
+						     sizeof(int16_t) : sizeof(int32_t));
+	int i;
+
+	td->dev = comp_new((struct sof_ipc_comp *)ipc);
+	free(ipc);
+
+	if (!td->dev)
+		return -EINVAL;
+
+	for (i = 0; i < MUX_MAX_STREAMS; ++i) {
+		td->sinks[i] = create_test_sink(td->dev, i, td->format, PLATFORM_MAX_CHANNELS,
+						WRAP_SINK_FRAMES * frame_size);
+		skew_stream(&td->sinks[i]->stream, wrap_sink_offsets[i]);
+	}
+
+	td->source = create_test_source(td->dev, MUX_MAX_STREAMS + 1, td->format,
+					PLATFORM_MAX_CHANNELS, WRAP_SOURCE_FRAMES * frame_size);
+	skew_stream(&td->source->stream, WRAP_SOURCE_OFFSET);
+
+	return comp_prepare(td->dev);
+}
+
+static void test_demux_copy_wrap(void **state)
+{
+	struct test_data *td = *((struct test_data **)state);
+	struct audio_stream *source = &td->source->stream;
+	struct audio_stream *sink;
+	uint32_t frame, copy;
+	int32_t sample;
+	int ch, i, j, k;
+
+	for (copy = 0; copy < WRAP_COPIES; ++copy) {
+		for (i = 0; i < WRAP_COPY_FRAMES * PLATFORM_MAX_CHANNELS; ++i) {
+			frame = copy * WRAP_COPY_FRAMES + i / PLATFORM_MAX_CHANNELS;
+			ch = i % PLATFORM_MAX_CHANNELS;
+			write_sample(source, i, wrap_sample(frame, ch));
+		}
+		audio_stream_produce(source, WRAP_COPY_FRAMES * audio_stream_frame_bytes(source));
+
+		assert_int_equal(comp_copy(td->dev), 0);
+
+		for (i = 0; i < MUX_MAX_STREAMS; ++i) {
+			sink = &td->sinks[i]->stream;
+			assert_int_equal(audio_stream_get_avail_frames(sink), WRAP_COPY_FRAMES);
+
+			for (j = 0; j < WRAP_COPY_FRAMES * PLATFORM_MAX_CHANNELS; ++j) {
+				frame = copy * WRAP_COPY_FRAMES + j / PLATFORM_MAX_CHANNELS;
+				ch = j % PLATFORM_MAX_CHANNELS;
+				sample = 0;
+
+				for (k = 0; k < PLATFORM_MAX_CHANNELS; ++k)
+					if (td->mask[i][ch] & BIT(k))
+						sample = wrap_sample(frame, k);
+
+				assert_int_equal(read_sample(sink, j), sample);
+			}
+
+			audio_stream_consume(sink, audio_stream_get_avail_bytes(sink));
+		}
+	}
+}
+
+static char *get_test_name(const char *test_name, int mask_index,
+			   const char *format_name)
+{
+	int length = snprintf(NULL, 0, "%s_%s_mask_%d", test_name,
 			      format_name, mask_index) + 1;
 	char *buffer = malloc(length);
 
-	snprintf(buffer, length, "test_demux_copy_%s_mask_%d",
+	snprintf(buffer, length, "%s_%s_mask_%d", test_name,
 		 format_name, mask_index);
 
 	return buffer;
@@ -273,13 +398,16 @@ static char *get_test_name(int mask_index, const char *format_name)
 
 int main(void)
 {
+	const int num_tests = ARRAY_SIZE(valid_formats) * ARRAY_SIZE(masks);
 	int i, j;
-	struct CMUnitTest tests[ARRAY_SIZE(valid_formats) * ARRAY_SIZE(masks)];
+	struct CMUnitTest tests[2 * num_tests];
 
 	for (i = 0; i < ARRAY_SIZE(valid_formats); ++i) {
 		for (j = 0; j < ARRAY_SIZE(masks); ++j) {
 			int ti = i * ARRAY_SIZE(masks) + j;
 			struct test_data *td = malloc(sizeof(struct test_data));
+			struct test_data *td_wrap = malloc(sizeof(struct test_data));
+			const char *format_name = NULL;
 
 			td->format = valid_formats[i];
 
@@ -289,19 +417,19 @@ int main(void)
 			switch (td->format) {
 #if CONFIG_FORMAT_S16LE
 			case SOF_IPC_FRAME_S16_LE:
-				tests[ti].name = get_test_name(j, "s16le");
+				format_name = "s16le";
 				tests[ti].test_func = test_demux_copy_proc_16;
 				break;
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
 			case SOF_IPC_FRAME_S24_4LE:
-				tests[ti].name = get_test_name(j, "s24_4le");
+				format_name = "s24_4le";
 				tests[ti].test_func = test_demux_copy_proc_24;
 				break;
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
 			case SOF_IPC_FRAME_S32_LE:
-				tests[ti].name = get_test_name(j, "s32le");
+				format_name = "s32le";
 				tests[ti].test_func = test_demux_copy_proc_32;
 				break;
 #endif /* CONFIG_FORMAT_S32LE */
@@ -313,9 +441,19 @@ int main(void)
 				return -EINVAL;
 			}
 
+			tests[ti].name = get_test_name("test_demux_copy", j, format_name);
 			tests[ti].initial_state = td;
 			tests[ti].setup_func = setup_test_case;
 			tests[ti].teardown_func = teardown_test_case;
+
+			/* the same routes over several frames and buffer wraps */
+			*td_wrap = *td;
+			tests[num_tests + ti].name = get_test_name("test_demux_copy_wrap", j,
+								   format_name);
+			tests[num_tests + ti].test_func = test_demux_copy_wrap;
+			tests[num_tests + ti].initial_state = td_wrap;
+			tests[num_tests + ti].setup_func = setup_wrap_test_case;
+			tests[num_tests + ti].teardown_func = teardown_test_case;
 		}
 	}
 
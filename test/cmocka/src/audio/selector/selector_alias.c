@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include "../../util.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/audio/selector.h>
+
+/* Pass-through of the selector with the sink buffer aliasing the source */
+
+#define SEL_FRAMES		4
+#define SEL_CHANNELS		2
+#define SEL_PERIOD_BYTES	(SEL_FRAMES * SEL_CHANNELS * sizeof(int16_t))
+/* not a multiple of the period, so the periods wrap at varying offsets */
+#define SEL_SOURCE_SIZE		(3 * SEL_PERIOD_BYTES + SEL_CHANNELS * sizeof(int16_t))
+#define SEL_SINK_SIZE		(2 * SEL_PERIOD_BYTES)
+
+struct sel_alias_state {
+	struct pipeline pipeline;
+	struct comp_dev *dev;
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+	void *sink_addr;
+	int16_t produced;
+	int16_t consumed;
+};
+
+static struct comp_driver selector_drv;
+
+/* Mocking comp_register here so we can create the component */
+int comp_register(struct comp_driver_info *info)
+{
+	return memcpy_s(&selector_drv, sizeof(selector_drv), info->drv,
+			sizeof(struct comp_driver));
+}
+
+static int setup(void **state)
+{
+	struct sof_sel_config config = {
+		.in_channels_count = SEL_CHANNELS,
+		.out_channels_count = SEL_CHANNELS,
+	};
+	struct ipc_config_process spec = {
+		.size = sizeof(config),
+		.data = (unsigned char *)&config,
+	};
+	struct comp_ipc_config ipc_config = {
+		.type = SOF_COMP_SELECTOR,
+	};
+	struct sel_alias_state *ss = test_calloc(1, sizeof(*ss));
+
+	ss->dev = selector_drv.ops.create(&selector_drv, &ipc_config, &spec);
+	assert_non_null(ss->dev);
+	ss->dev->drv = &selector_drv;
+	ss->dev->frames = SEL_FRAMES;
+	ss->dev->pipeline = &ss->pipeline;
+	list_init(&ss->dev->bsource_list);
+	list_init(&ss->dev->bsink_list);
+
+	ss->source = create_test_source(ss->dev, 0, SOF_IPC_FRAME_S16_LE,
+					SEL_CHANNELS, SEL_SOURCE_SIZE);
+	ss->source->sink = ss->dev;
+
+	/* the consumer is a processing component of the same pipeline */
+	ss->sink = create_test_sink(ss->dev, 0, SOF_IPC_FRAME_S16_LE,
+				    SEL_CHANNELS, SEL_SINK_SIZE);
+	ss->sink->source = ss->dev;
+	ss->sink->sink->pipeline = &ss->pipeline;
+	ss->sink_addr = ss->sink->stream.addr;
+
+	*state = ss;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct sel_alias_state *ss = *state;
+
+	selector_drv.ops.reset(ss->dev);
+	free_test_sink(ss->sink);
+	free_test_source(ss->source);
+	selector_drv.ops.free(ss->dev);
+	test_free(ss);
+
+	return 0;
+}
+
+static void produce_period(struct sel_alias_state *ss)
+{
+	struct audio_stream *stream = &ss->source->stream;
+	int16_t *w_ptr;
+	int i;
+
+	for (i = 0; i < SEL_FRAMES * SEL_CHANNELS; i++) {
+		w_ptr = audio_stream_write_frag_s16(stream, i);
+		*w_ptr = ss->produced++;
+	}
+	comp_update_buffer_produce(ss->source, SEL_PERIOD_BYTES);
+}
+
+static void consume_frames(struct sel_alias_state *ss, int frames)
+{
+	struct audio_stream *stream = &ss->sink->stream;
+	int16_t *r_ptr;
+	int i;
+
+	for (i = 0; i < frames * SEL_CHANNELS; i++) {
+		r_ptr = audio_stream_read_frag_s16(stream, i);
+		assert_int_equal(*r_ptr, ss->consumed++);
+	}
+	comp_update_buffer_consume(ss->sink, frames * SEL_CHANNELS * sizeof(int16_t));
+}
+
+static void test_selector_alias_passthrough(void **state)
+{
+	static const int frames[] = { 4, 1, 3, 6, 2, 5 };
+	struct sel_alias_state *ss = *state;
+	struct comp_data *cd = comp_get_drvdata(ss->dev);
+	struct audio_stream *source = &ss->source->stream;
+	struct audio_stream *sink = &ss->sink->stream;
+	int i, n;
+
+	assert_int_equal(selector_drv.ops.prepare(ss->dev), 0);
+	assert_true(cd->alias);
+	assert_ptr_equal(sink->addr, source->addr);
+
+	for (i = 0; i < 50; i++) {
+		if (audio_stream_get_free_bytes(source) >= SEL_PERIOD_BYTES)
+			produce_period(ss);
+
+		assert_int_equal(selector_drv.ops.copy(ss->dev), 0);
+
+		/* the source keeps the data the consumer has not read yet */
+		assert_ptr_equal(sink->r_ptr, source->r_ptr);
+		assert_ptr_equal(sink->w_ptr, source->w_ptr);
+		assert_int_equal(audio_stream_get_avail_bytes(sink),
+				 audio_stream_get_avail_bytes(source));
+
+		n = MIN(frames[i % ARRAY_SIZE(frames)], audio_stream_get_avail_frames(sink));
+		consume_frames(ss, n);
+	}
+
+	assert_true(ss->consumed > 5 * SEL_SOURCE_SIZE / sizeof(int16_t));
+
+	/* reset gives the sink its own data back */
+	assert_int_equal(selector_drv.ops.reset(ss->dev), 0);
+	assert_false(cd->alias);
+	assert_null(ss->sink->own_addr);
+	assert_ptr_equal(sink->addr, ss->sink_addr);
+	assert_int_equal(sink->size, SEL_SINK_SIZE);
+}
+
+static void test_selector_alias_copy(void **state)
+{
+	struct sel_alias_state *ss = *state;
+	struct comp_data *cd = comp_get_drvdata(ss->dev);
+
+	/* a single channel is selected, so the data is copied */
+	cd->config.out_channels_count = 1;
+	ss->sink->stream.channels = 1;
+	assert_int_equal(selector_drv.ops.prepare(ss->dev), 0);
+	assert_false(cd->alias);
+	assert_ptr_equal(ss->sink->stream.addr, ss->sink_addr);
+
+	/* the data is copied when the consumer is in another pipeline */
+	selector_drv.ops.reset(ss->dev);
+	cd->config.out_channels_count = SEL_CHANNELS;
+	ss->sink->stream.channels = SEL_CHANNELS;
+	ss->sink->sink->pipeline = NULL;
+	assert_int_equal(selector_drv.ops.prepare(ss->dev), 0);
+	assert_false(cd->alias);
+	assert_ptr_equal(ss->sink->stream.addr, ss->sink_addr);
+
+	produce_period(ss);
+	assert_int_equal(selector_drv.ops.copy(ss->dev), 0);
+	assert_int_equal(audio_stream_get_avail_bytes(&ss->source->stream), 0);
+	consume_frames(ss, SEL_FRAMES);
+}
+
+static int setup_group(void **state)
+{
+	sys_comp_selector_init();
+
+	return 0;
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_selector_alias_passthrough,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_selector_alias_copy,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup_group, NULL);
+}
@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/up_down_mixer/up_down_mixer.h>
+
+/* Frames per test buffer and number of random buffers per routine */
+#define TEST_FRAMES	32
+#define TEST_RUNS	64
+
+/* Max number of multiply-accumulate terms of one output channel */
+#define MAX_TERMS	5
+
+#define MAX_CHANNELS	8
+
+/*
+ * The reference below is a plain model of the HiFi3 dataflow: every term is
+ * a saturating Q1.31 x Q1.31 multiply accumulated with 64 bit saturation in
+ * the order of the HiFi3 code, then symmetric rounding to Q1.31. It is
+ * computed in 128 bits and does not share code with the generic version.
+ */
+struct ref_term {
+	enum ipc4_channel_index input;
+	enum ipc4_channel_index coefficient;
+};
+
+struct ref_output {
+	int num_terms;
+	struct ref_term terms[MAX_TERMS];
+};
+
+struct ref_case {
+	const char *name;
+	up_down_mixer_routine routine;
+	enum ipc4_channel_config in_config;
+	int in_channels;
+	int in_bits;
+	int out_channels;
+	struct ref_output out[2];
+};
+
+static int64_t ref_sat64(__int128 x)
+{
+	if (x > INT64_MAX)
+		return INT64_MAX;
+	if (x < INT64_MIN)
+		return INT64_MIN;
+	return (int64_t)x;
+}
+
+static int32_t ref_round32(int64_t x)
+{
+	__int128 mag = x < 0 ? -(__int128)x : x;
+	__int128 r;
+
+	mag = (mag + ((__int128)1 << 31)) >> 32;
+	r = x < 0 ? -mag : mag;
+	if (r > INT32_MAX)
+		return INT32_MAX;
+	if (r < INT32_MIN)
+		return INT32_MIN;
+	return (int32_t)r;
+}
+
+static int32_t ref_output_sample(const struct ref_output *out, channel_map map,
+				 const int32_t *coefs, const int32_t *frame)
+{
+	int64_t acc = 0;
+	int i;
+
+	for (i = 0; i < out->num_terms; i++) {
+		int32_t x = frame[get_channel_location(map, out->terms[i].input)];
+		int32_t c = coefs[out->terms[i].coefficient];
+
+		acc = ref_sat64((__int128)acc + ref_sat64((__int128)x * c * 2));
+	}
+
+	return ref_round32(acc);
+}
+
+#define L	CHANNEL_LEFT
+#define C	CHANNEL_CENTER
+#define R	CHANNEL_RIGHT
+#define LS	CHANNEL_LEFT_SURROUND
+#define CS	CHANNEL_CENTER_SURROUND
+#define RS	CHANNEL_RIGHT_SURROUND
+#define LSD	CHANNEL_LEFT_SIDE
+#define RSD	CHANNEL_RIGHT_SIDE
+#define LFE	CHANNEL_LFE
+
+#define T(in)		{ in, in }
+#define OUT(...)	{ .num_terms = sizeof((struct ref_term[]){ __VA_ARGS__ }) / \
+				       sizeof(struct ref_term), \
+			  .terms = { __VA_ARGS__ } }
+
+static const struct ref_case ref_cases[] = {
+	{ "downmix32bit_2_1", downmix32bit_2_1, IPC4_CHANNEL_CONFIG_2_POINT_1, 3, 32, 2,
+	  { OUT(T(L), T(LFE)), OUT(T(R), T(LFE)) } },
+	{ "downmix32bit_3_0", downmix32bit_3_0, IPC4_CHANNEL_CONFIG_3_POINT_0, 3, 32, 2,
+	  { OUT(T(L), T(C)), OUT(T(C), T(R)) } },
+	{ "downmix32bit_3_1", downmix32bit_3_1, IPC4_CHANNEL_CONFIG_3_POINT_1, 4, 32, 2,
+	  { OUT(T(L), T(C), T(LFE)), OUT(T(C), T(R), T(LFE)) } },
+	{ "downmix32bit_4_0", downmix32bit_4_0, IPC4_CHANNEL_CONFIG_4_POINT_0, 4, 32, 2,
+	  { OUT(T(L), T(C), T(LS)), OUT(T(C), T(R), T(LS)) } },
+	{ "downmix32bit quatro", downmix32bit, IPC4_CHANNEL_CONFIG_QUATRO, 4, 32, 2,
+	  { OUT(T(L), T(LS)), OUT(T(R), T(RS)) } },
+	{ "downmix32bit 4.0", downmix32bit, IPC4_CHANNEL_CONFIG_4_POINT_0, 4, 32, 2,
+	  { OUT(T(L), T(C), T(LS)), OUT(T(C), T(R), T(LS)) } },
+	{ "downmix32bit 5.0", downmix32bit, IPC4_CHANNEL_CONFIG_5_POINT_0, 5, 32, 2,
+	  { OUT(T(L), T(C), T(LS)), OUT(T(C), T(R), T(RS)) } },
+	{ "downmix32bit_5_1", downmix32bit_5_1, IPC4_CHANNEL_CONFIG_5_POINT_1, 6, 32, 2,
+	  { OUT(T(C), T(LFE), T(L), T(LS)), OUT(T(C), T(LFE), T(R), T(RS)) } },
+	{ "downmix32bit_7_1", downmix32bit_7_1, IPC4_CHANNEL_CONFIG_7_POINT_1, 8, 32, 2,
+	  { OUT(T(C), T(LFE), T(L), T(LS), T(LSD)), OUT(T(C), T(LFE), T(R), T(RS), T(RSD)) } },
+	{ "downmix32bit_5_0_mono", downmix32bit_5_0_mono, IPC4_CHANNEL_CONFIG_5_POINT_0, 5, 32, 1,
+	  { OUT(T(L), T(C), T(R), T(CS)) } },
+	{ "downmix32bit_3_1_mono", downmix32bit_3_1_mono, IPC4_CHANNEL_CONFIG_3_POINT_1, 4, 32, 1,
+	  { OUT(T(L), T(C), T(R), T(LFE)) } },
+	{ "downmix32bit_4_0_mono", downmix32bit_4_0_mono, IPC4_CHANNEL_CONFIG_4_POINT_0, 4, 32, 1,
+	  { OUT(T(L), T(C), T(R), T(CS)) } },
+	{ "downmix32bit_quatro_mono", downmix32bit_quatro_mono, IPC4_CHANNEL_CONFIG_QUATRO, 4, 32,
+	  1, { OUT(T(L), T(LS), T(R), T(RS)) } },
+	{ "downmix32bit_5_1_mono", downmix32bit_5_1_mono, IPC4_CHANNEL_CONFIG_5_POINT_1, 6, 32, 1,
+	  { OUT(T(L), T(C), T(R), T(CS)) } },
+	{ "downmix32bit_7_1_mono", downmix32bit_7_1_mono, IPC4_CHANNEL_CONFIG_7_POINT_1, 8, 32, 1,
+	  { OUT(T(L), T(C), T(R), T(CS)) } },
+	{ "downmix16bit 5.0", downmix16bit, IPC4_CHANNEL_CONFIG_5_POINT_0, 5, 16, 2,
+	  { OUT(T(L), T(C), T(LS)), OUT(T(C), T(R), T(RS)) } },
+	{ "downmix16bit 4.0", downmix16bit, IPC4_CHANNEL_CONFIG_4_POINT_0, 4, 16, 2,
+	  { OUT(T(L), T(C), T(LS)), OUT(T(C), T(R), T(LS)) } },
+	{ "downmix16bit_5_1", downmix16bit_5_1, IPC4_CHANNEL_CONFIG_5_POINT_1, 6, 16, 2,
+	  { OUT(T(C), T(LFE), T(L), T(LS)), OUT(T(C), T(LFE), T(R), T(RS)) } },
+};
+
+static uint32_t lcg_state;
+
+static uint32_t lcg(void)
+{
+	lcg_state = lcg_state * 1664525u + 1013904223u;
+	return lcg_state;
+}
+
+/* Random sample with a bias to the full scale values that saturate */
+static int32_t rand_sample(void)
+{
+	switch (lcg() % 8) {
+	case 0:
+		return INT32_MIN;
+	case 1:
+		return INT32_MAX;
+	default:
+		return (int32_t)lcg();
+	}
+}
+
+static void rand_coefficients(int32_t *coefs)
+{
+	int i;
+
+	for (i = 0; i < UP_DOWN_MIX_COEFFS_LENGTH; i++)
+		coefs[i] = rand_sample();
+}
+
+static void test_downmix_reference(void **state)
+{
+	int32_t in32[TEST_FRAMES * MAX_CHANNELS];
+	int16_t in16[TEST_FRAMES * MAX_CHANNELS];
+	int32_t out[TEST_FRAMES * 2];
+	int32_t coefs[UP_DOWN_MIX_COEFFS_LENGTH];
+	int32_t frame[MAX_CHANNELS];
+	struct up_down_mixer_data cd;
+	const struct ref_case *rc;
+	int run, i, ch;
+
+	(void)state;
+
+	lcg_state = 1;
+	for (rc = ref_cases; rc < ref_cases + ARRAY_SIZE(ref_cases); rc++) {
+		memset(&cd, 0, sizeof(cd));
+		cd.in_channel_no = rc->in_channels;
+		cd.in_channel_map = create_channel_map(rc->in_config);
+		cd.in_channel_config = rc->in_config;
+		cd.downmix_coefficients = coefs;
+
+		for (run = 0; run < TEST_RUNS; run++) {
+			rand_coefficients(coefs);
+			for (i = 0; i < TEST_FRAMES * rc->in_channels; i++) {
+				in32[i] = rand_sample();
+				in16[i] = in32[i] >> 16;
+			}
+
+			if (rc->in_bits == 16)
+				rc->routine(&cd, (uint8_t *)in16,
+					    TEST_FRAMES * rc->in_channels * sizeof(int16_t),
+					    (uint8_t *)out);
+			else
+				rc->routine(&cd, (uint8_t *)in32,
+					    TEST_FRAMES * rc->in_channels * sizeof(int32_t),
+					    (uint8_t *)out);
+
+			for (i = 0; i < TEST_FRAMES; i++) {
+				/* AE_L16M loads 16 bit samples as 24 bit */
+				for (ch = 0; ch < rc->in_channels; ch++)
+					frame[ch] = rc->in_bits == 16 ?
+						    in16[i * rc->in_channels + ch] * (1 << 8) :
+						    in32[i * rc->in_channels + ch];
+
+				for (ch = 0; ch < rc->out_channels; ch++) {
+					int32_t ref = ref_output_sample(&rc->out[ch],
+									cd.in_channel_map,
+									coefs, frame);
+
+					/* 24 bit result shifted up without saturation */
+					if (rc->in_bits == 16)
+						ref = (int32_t)((uint32_t)ref << 8);
+
+					if (out[i * rc->out_channels + ch] != ref)
+						fail_msg("%s run %d frame %d channel %d: %d != %d",
+							 rc->name, run, i, ch,
+							 out[i * rc->out_channels + ch], ref);
+				}
+			}
+		}
+	}
+}
+
+static void test_downmix32bit_stereo(void **state)
+{
+	static const struct ref_output mono = OUT(T(L), T(R));
+	channel_map in_map = create_channel_map(IPC4_CHANNEL_CONFIG_STEREO);
+	int32_t in[TEST_FRAMES * 2];
+	int32_t out[TEST_FRAMES];
+	int32_t coefs[UP_DOWN_MIX_COEFFS_LENGTH];
+	struct up_down_mixer_data cd;
+	int i;
+
+	(void)state;
+
+	memset(&cd, 0, sizeof(cd));
+	for (i = 0; i < UP_DOWN_MIX_COEFFS_LENGTH; i++)
+		coefs[i] = 1073741568;
+
+	lcg_state = 2;
+	for (i = 0; i < TEST_FRAMES * 2; i++)
+		in[i] = rand_sample();
+
+	downmix32bit_stereo(&cd, (uint8_t *)in, sizeof(in), (uint8_t *)out);
+
+	for (i = 0; i < TEST_FRAMES; i++)
+		assert_int_equal(out[i], ref_output_sample(&mono, in_map, coefs, &in[i * 2]));
+}
+
+static void test_downmix32bit_7_1_to_5_1(void **state)
+{
+	/* The HiFi3 version pairs the side outputs with these coefficients */
+	static const struct ref_output sides[2] = {
+		OUT({ LS, L }, { RS, LSD }, { LSD, L }),
+		OUT({ LS, RSD }, { RS, R }, { RSD, R }),
+	};
+	static const enum ipc4_channel_index copies[] = { L, C, R, LFE };
+	channel_map in_map = create_channel_map(IPC4_CHANNEL_CONFIG_7_POINT_1);
+	channel_map out_map = create_channel_map(IPC4_CHANNEL_CONFIG_5_POINT_1);
+	int32_t in[TEST_FRAMES * 8];
+	int32_t out[TEST_FRAMES * 6];
+	int32_t coefs[UP_DOWN_MIX_COEFFS_LENGTH];
+	struct up_down_mixer_data cd;
+	int run, i, ch;
+
+	(void)state;
+
+	memset(&cd, 0, sizeof(cd));
+	cd.in_channel_no = 8;
+	cd.in_channel_map = in_map;
+	cd.out_channel_map = out_map;
+	cd.downmix_coefficients = coefs;
+
+	lcg_state = 3;
+	for (run = 0; run < TEST_RUNS; run++) {
+		rand_coefficients(coefs);
+		for (i = 0; i < TEST_FRAMES * 8; i++)
+			in[i] = rand_sample();
+
+		downmix32bit_7_1_to_5_1(&cd, (uint8_t *)in, sizeof(in), (uint8_t *)out);
+
+		for (i = 0; i < TEST_FRAMES; i++) {
+			const int32_t *in_frame = &in[i * 8];
+			const int32_t *out_frame = &out[i * 6];
+
+			for (ch = 0; ch < ARRAY_SIZE(copies); ch++) {
+				enum ipc4_channel_index copy = copies[ch];
+
+				assert_int_equal(out_frame[get_channel_location(out_map, copy)],
+						 in_frame[get_channel_location(in_map, copy)]);
+			}
+
+			assert_int_equal(out_frame[get_channel_location(out_map, LS)],
+					 ref_output_sample(&sides[0], in_map, coefs, in_frame));
+			assert_int_equal(out_frame[get_channel_location(out_map, RS)],
+					 ref_output_sample(&sides[1], in_map, coefs, in_frame));
+		}
+	}
+}
+
+static void test_upmix32bit_4_0_to_5_1(void **state)
+{
+	static const struct ref_output sides[2] = {
+		OUT({ CS, LS }),
+		OUT({ CS, RS }),
+	};
+	channel_map in_map = create_channel_map(IPC4_CHANNEL_CONFIG_4_POINT_0);
+	channel_map out_map = create_channel_map(IPC4_CHANNEL_CONFIG_5_POINT_1);
+	int32_t in[TEST_FRAMES * 4];
+	int32_t out[TEST_FRAMES * 6];
+	int32_t coefs[UP_DOWN_MIX_COEFFS_LENGTH];
+	struct up_down_mixer_data cd;
+	int i;
+
+	(void)state;
+
+	memset(&cd, 0, sizeof(cd));
+	cd.in_channel_no = 4;
+	cd.in_channel_map = in_map;
+	cd.out_channel_map = out_map;
+	cd.downmix_coefficients = coefs;
+
+	lcg_state = 4;
+	rand_coefficients(coefs);
+	for (i = 0; i < TEST_FRAMES * 4; i++)
+		in[i] = rand_sample();
+
+	upmix32bit_4_0_to_5_1(&cd, (uint8_t *)in, sizeof(in), (uint8_t *)out);
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		const int32_t *in_frame = &in[i * 4];
+		const int32_t *out_frame = &out[i * 6];
+
+		assert_int_equal(out_frame[get_channel_location(out_map, L)], in_frame[0]);
+		assert_int_equal(out_frame[get_channel_location(out_map, C)], in_frame[1]);
+		assert_int_equal(out_frame[get_channel_location(out_map, R)], in_frame[2]);
+		assert_int_equal(out_frame[get_channel_location(out_map, LFE)], 0);
+		assert_int_equal(out_frame[get_channel_location(out_map, LS)],
+				 ref_output_sample(&sides[0], in_map, coefs, in_frame));
+		assert_int_equal(out_frame[get_channel_location(out_map, RS)],
+				 ref_output_sample(&sides[1], in_map, coefs, in_frame));
+	}
+}
+
+/* Q1.15 reference of the HiFi3 16 bit four channel to mono downmix */
+static int16_t ref_downmix16bit_4ch_mono(const int16_t *frame, const int16_t *coefs)
+{
+	int64_t acc = 0;
+	int64_t prod;
+	int ch;
+
+	/* accumulated from the last vector element as AE_MULF16SS_00 .. _33 */
+	for (ch = 3; ch >= 0; ch--) {
+		prod = (int64_t)frame[ch] * coefs[ch] * 2;
+		if (prod > INT32_MAX)
+			prod = INT32_MAX;
+		acc += prod;
+		if (acc > INT32_MAX)
+			acc = INT32_MAX;
+		if (acc < INT32_MIN)
+			acc = INT32_MIN;
+	}
+
+	prod = ((acc < 0 ? -acc : acc) + (1 << 15)) >> 16;
+	if (acc < 0)
+		prod = -prod;
+	if (prod > INT16_MAX)
+		return INT16_MAX;
+	if (prod < INT16_MIN)
+		return INT16_MIN;
+	return (int16_t)prod;
+}
+
+static void test_downmix16bit_4ch_mono(void **state)
+{
+	channel_map in_map = create_channel_map(IPC4_CHANNEL_CONFIG_QUATRO);
+	int16_t in[TEST_FRAMES * 4];
+	int16_t out[TEST_FRAMES];
+	int32_t coefs[UP_DOWN_MIX_COEFFS_LENGTH];
+	int16_t coefs16[4];
+	struct up_down_mixer_data cd;
+	int run, i, ch;
+
+	(void)state;
+
+	memset(&cd, 0, sizeof(cd));
+	cd.in_channel_no = 4;
+	cd.in_channel_map = in_map;
+	cd.downmix_coefficients = coefs;
+
+	lcg_state = 5;
+	for (run = 0; run < TEST_RUNS; run++) {
+		rand_coefficients(coefs);
+		for (ch = 0; ch < 4; ch++)
+			coefs16[ch] = (int16_t)coefs[get_channel_index(in_map, ch)];
+		for (i = 0; i < TEST_FRAMES * 4; i++)
+			in[i] = rand_sample() >> 16;
+
+		downmix16bit_4ch_mono(&cd, (uint8_t *)in, sizeof(in), (uint8_t *)out);
+
+		for (i = 0; i < TEST_FRAMES; i++)
+			assert_int_equal(out[i], ref_downmix16bit_4ch_mono(&in[i * 4], coefs16));
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_downmix_reference),
+		cmocka_unit_test(test_downmix32bit_stereo),
+		cmocka_unit_test(test_downmix32bit_7_1_to_5_1),
+		cmocka_unit_test(test_upmix32bit_4_0_to_5_1),
+		cmocka_unit_test(test_downmix16bit_4ch_mono),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
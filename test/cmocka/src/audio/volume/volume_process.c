@@ -72,6 +72,8 @@ static int setup(void **state)
 
 	/* set processing function and volume */
 	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev, vol_state->sinks[0]);
+	cd->scale_vol_ramp = vol_get_ramp_processing_function(cd->scale_vol);
+	cd->ramp_type = SOF_VOLUME_LINEAR;
 	set_volume(cd->volume, vol_parameters->volume, vol_state->parameters.channels);
 
 	/* assign test state */
@@ -287,6 +289,166 @@ static void test_audio_vol(void **state)
 	vol_state->verify(mod, vol_state->sinks[0], vol_state->sources[0]);
 }
 
+static void test_audio_vol_ramp(void **state)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
+
+	/* ramp processing is optional for the platform */
+	if (!cd->scale_vol_ramp)
+		skip();
+
+	switch (vol_state->sinks[0]->stream.frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		fill_source_s16(vol_state);
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		fill_source_s24(vol_state);
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+	case SOF_IPC_FRAME_FLOAT:
+		fill_source_s32(vol_state);
+		break;
+	case SOF_IPC_FRAME_S24_3LE:
+		/* TODO: add 3LE support */
+		break;
+	}
+
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+
+	/* ramp with start gain equal to end gain must match the constant gain */
+	cd->scale_vol_ramp(mod, vol_state->input_buffers[0], vol_state->output_buffers[0],
+			   mod->dev->frames, cd->volume);
+
+	vol_state->verify(mod, vol_state->sinks[0], vol_state->sources[0]);
+}
+
+/* zero crossing ramp test source has a sign change every VOL_ZC_TEST_HALF
+ * frames and is processed in two periods that start from VOL_ZC_TEST_OFFSET
+ * frames, so the second period wraps around the buffer end.
+ */
+#define VOL_ZC_TEST_HALF	10
+#define VOL_ZC_TEST_OFFSET	12
+
+static int zc_test_index(struct audio_stream *stream, int frame, int channel)
+{
+	int frames = stream->size / audio_stream_frame_bytes(stream);
+
+	return ((frame + VOL_ZC_TEST_OFFSET) % frames) * stream->channels + channel;
+}
+
+static int32_t zc_test_get(struct audio_stream *stream, int frame, int channel)
+{
+	int idx = zc_test_index(stream, frame, channel);
+
+	if (stream->frame_fmt == SOF_IPC_FRAME_S16_LE)
+		return ((int16_t *)stream->addr)[idx];
+
+	return ((int32_t *)stream->addr)[idx];
+}
+
+static void zc_test_set(struct audio_stream *stream, int frame, int channel, int32_t value)
+{
+	int idx = zc_test_index(stream, frame, channel);
+
+	if (stream->frame_fmt == SOF_IPC_FRAME_S16_LE)
+		((int16_t *)stream->addr)[idx] = value;
+	else
+		((int32_t *)stream->addr)[idx] = value;
+}
+
+static void zc_test_period(struct processing_module_test_data *vol_state, int frame,
+			   int frames, const int32_t *start_volume)
+{
+	struct vol_data *cd = module_get_private_data(vol_state->mod);
+	struct audio_stream *source = &vol_state->sources[0]->stream;
+	struct audio_stream *sink = &vol_state->sinks[0]->stream;
+	int frame_bytes = audio_stream_frame_bytes(source);
+
+	source->r_ptr = audio_stream_wrap(source, (char *)source->addr +
+					  (frame + VOL_ZC_TEST_OFFSET) * frame_bytes);
+	sink->w_ptr = audio_stream_wrap(sink, (char *)sink->addr +
+					(frame + VOL_ZC_TEST_OFFSET) * frame_bytes);
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+	cd->scale_vol_ramp(vol_state->mod, vol_state->input_buffers[0],
+			   vol_state->output_buffers[0], frames, start_volume);
+}
+
+static void test_audio_vol_ramp_zc(void **state)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct vol_data *cd = module_get_private_data(vol_state->mod);
+	struct audio_stream *source = &vol_state->sources[0]->stream;
+	struct audio_stream *sink = &vol_state->sinks[0]->stream;
+	int32_t start_volume[SOF_IPC_MAX_CHANNELS];
+	int frames = vol_state->parameters.frames;
+	int period = frames / 2;
+	int32_t amplitude;
+	int32_t x, prev_x;
+	int32_t y, prev_y;
+	int channel;
+	int i;
+
+	/* ramp processing is optional for the platform */
+	if (!cd->scale_vol_ramp)
+		skip();
+
+	switch (source->frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		amplitude = 1 << 13;
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		amplitude = 1 << 21;
+		break;
+	default:
+		amplitude = 1 << 29;
+		break;
+	}
+
+	for (i = 0; i < frames; i++)
+		for (channel = 0; channel < source->channels; channel++)
+			zc_test_set(source, i, channel,
+				    (i / VOL_ZC_TEST_HALF) & 1 ? -amplitude : amplitude);
+
+	cd->ramp_type = SOF_VOLUME_LINEAR_ZC;
+	cd->ramp_zc_state = false;
+
+	/* ramp from -12 dB to 0 dB in two periods */
+	set_volume(start_volume, VOL_ZERO_DB / 4, source->channels);
+	set_volume(cd->volume, VOL_ZERO_DB * 5 / 8, source->channels);
+	zc_test_period(vol_state, 0, period, start_volume);
+	set_volume(start_volume, VOL_ZERO_DB * 5 / 8, source->channels);
+	set_volume(cd->volume, VOL_ZERO_DB, source->channels);
+	zc_test_period(vol_state, period, frames - period, start_volume);
+
+	/* the gain may change only in a zero crossing, also in the period
+	 * boundary, and it must have ramped up in the crossings
+	 */
+	for (channel = 0; channel < source->channels; channel++) {
+		prev_x = zc_test_get(source, 0, channel);
+		prev_y = zc_test_get(sink, 0, channel);
+		for (i = 1; i < frames; i++) {
+			x = zc_test_get(source, i, channel);
+			y = zc_test_get(sink, i, channel);
+			if (x == prev_x)
+				assert_int_equal(y, prev_y);
+
+			prev_x = x;
+			prev_y = y;
+		}
+
+		assert_true(ABS(zc_test_get(sink, frames - 1, channel)) >
+			    ABS(zc_test_get(sink, 0, channel)));
+
+		/* the end gain is held until the next zero crossing */
+		assert_true(cd->ramp_zc_state);
+		assert_true(cd->ramp_zc_vol[channel] < cd->volume[channel]);
+	}
+}
+
 static struct processing_module_test_parameters test_parameters[] = {
 #if CONFIG_FORMAT_S16LE
 	{ 2, 48, 1, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE,   verify_s16_to_s16 },
@@ -318,7 +480,7 @@ int main(void)
 		}
 	}
 
-	struct CMUnitTest tests[num_tests];
+	struct CMUnitTest tests[num_tests * 3];
 
 	for (i = 0; i < num_tests; i++) {
 		tests[i].name = "test_audio_vol";
@@ -326,6 +488,16 @@ int main(void)
 		tests[i].setup_func = setup;
 		tests[i].teardown_func = teardown;
 		tests[i].initial_state = &parameters[i];
+		tests[num_tests + i].name = "test_audio_vol_ramp";
+		tests[num_tests + i].test_func = test_audio_vol_ramp;
+		tests[num_tests + i].setup_func = setup;
+		tests[num_tests + i].teardown_func = teardown;
+		tests[num_tests + i].initial_state = &parameters[i];
+		tests[2 * num_tests + i].name = "test_audio_vol_ramp_zc";
+		tests[2 * num_tests + i].test_func = test_audio_vol_ramp_zc;
+		tests[2 * num_tests + i].setup_func = setup;
+		tests[2 * num_tests + i].teardown_func = teardown;
+		tests[2 * num_tests + i].initial_state = &parameters[i];
 	}
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
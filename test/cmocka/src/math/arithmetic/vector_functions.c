@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/decibels.h>
+#include <sof/math/log.h>
+
+/* not a multiple of the block sizes to test the partial blocks */
+#define VEC_TEST_SIZE		4099
+#define VEC_TEST_ROUNDS		50
+
+static void test_vec_exp_fixed(void **state)
+{
+	int32_t *x = test_malloc(VEC_TEST_SIZE * sizeof(*x));
+	int32_t *y = test_malloc(VEC_TEST_SIZE * sizeof(*y));
+	int i;
+
+	(void)state;
+
+	/* sweep over -16.0 .. +16.0 that includes the out of range values */
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		x[i] = (int32_t)(INT32_MIN + (int64_t)(UINT32_MAX / (VEC_TEST_SIZE - 1)) * i);
+
+	x[0] = INT32_MIN;
+	x[VEC_TEST_SIZE - 1] = INT32_MAX;
+	exp_fixed_vec(x, y, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(y[i], exp_fixed(x[i]));
+
+	test_free(x);
+	test_free(y);
+}
+
+static void test_vec_db2lin_fixed(void **state)
+{
+	int32_t *x = test_malloc(VEC_TEST_SIZE * sizeof(*x));
+	int32_t *y = test_malloc(VEC_TEST_SIZE * sizeof(*y));
+	int i;
+
+	(void)state;
+
+	/* -128 .. +128 dB */
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		x[i] = (int32_t)(INT32_MIN + (int64_t)(UINT32_MAX / (VEC_TEST_SIZE - 1)) * i);
+
+	db2lin_fixed_vec(x, y, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(y[i], db2lin_fixed(x[i]));
+
+	test_free(x);
+	test_free(y);
+}
+
+static void test_vec_logarithms(void **state)
+{
+	uint32_t *u = test_malloc(VEC_TEST_SIZE * sizeof(*u));
+	int32_t *y = test_malloc(VEC_TEST_SIZE * sizeof(*y));
+	uint32_t *z = test_malloc(VEC_TEST_SIZE * sizeof(*z));
+	int i;
+
+	(void)state;
+
+	/* every bit position and random values in between */
+	srand(1);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		u[i] = i < 32 ? 1U << i : ((uint32_t)rand() << 16 ^ rand()) >> (i % 32);
+
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		if (!u[i])
+			u[i] = UINT32_MAX;
+
+	base2_logarithm_vec(u, y, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(y[i], base2_logarithm(u[i]));
+
+	ln_int32_vec(u, z, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(z[i], ln_int32(u[i]));
+
+	log10_int32_vec(u, z, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(z[i], log10_int32(u[i]));
+
+	test_free(u);
+	test_free(y);
+	test_free(z);
+}
+
+/* informative only, the speed of the host is not checked */
+static void test_vec_throughput(void **state)
+{
+	int32_t *x = test_malloc(VEC_TEST_SIZE * sizeof(*x));
+	int32_t *y = test_malloc(VEC_TEST_SIZE * sizeof(*y));
+	clock_t scalar = 0;
+	clock_t vec = 0;
+	clock_t t;
+	int64_t step = ((int64_t)18 << 27) / VEC_TEST_SIZE;
+	int i, r;
+
+	(void)state;
+
+	/* -11.0 .. +7.0 in Q5.27, without zero that base2_logarithm() can't take */
+	for (i = 0; i < VEC_TEST_SIZE; i++) {
+		x[i] = (int32_t)(((int64_t)-11 << 27) + i * step);
+		if (!x[i])
+			x[i] = 1;
+	}
+
+	for (r = 0; r < VEC_TEST_ROUNDS; r++) {
+		t = clock();
+		for (i = 0; i < VEC_TEST_SIZE; i++)
+			y[i] = exp_fixed(x[i]);
+		scalar += clock() - t;
+
+		t = clock();
+		exp_fixed_vec(x, y, VEC_TEST_SIZE);
+		vec += clock() - t;
+	}
+
+	print_message("exp_fixed: scalar %ld, vector %ld clocks\n", (long)scalar, (long)vec);
+
+	scalar = 0;
+	vec = 0;
+	for (r = 0; r < VEC_TEST_ROUNDS; r++) {
+		t = clock();
+		for (i = 0; i < VEC_TEST_SIZE; i++)
+			y[i] = base2_logarithm((uint32_t)x[i]);
+		scalar += clock() - t;
+
+		t = clock();
+		base2_logarithm_vec((uint32_t *)x, y, VEC_TEST_SIZE);
+		vec += clock() - t;
+	}
+
+	print_message("base2_logarithm: scalar %ld, vector %ld clocks\n", (long)scalar, (long)vec);
+
+	test_free(x);
+	test_free(y);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_vec_exp_fixed),
+		cmocka_unit_test(test_vec_db2lin_fixed),
+		cmocka_unit_test(test_vec_logarithms),
+		cmocka_unit_test(test_vec_throughput),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -153,7 +153,7 @@ static void filterbank_32_test(const int32_t *fft_real, const int32_t *fft_imag,
 	float sum_squares = 0;
 	float error_rms;
 	float delta_max = 0;
-	int32_t *power_spectra;
+	int64_t *power_spectra;
 	int16_t *mel_log;
 	int i;
 	const int half_fft = num_fft_bins / 2 + 1;
@@ -203,7 +203,7 @@ static void filterbank_32_test(const int32_t *fft_real, const int32_t *fft_imag,
 	}
 
 	/* Run filterbank */
-	power_spectra = (int32_t *)&fft_buf[0];
+	power_spectra = (int64_t *)&fft_buf[0];
 	psy_apply_mel_filterbank_32(&fb, fft_out, power_spectra, mel_log, shift);
 
 	/* Check */
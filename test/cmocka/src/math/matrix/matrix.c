@@ -19,9 +19,13 @@
 #include "ref_matrix_mult_16_test2.h"
 #include "ref_matrix_mult_16_test3.h"
 #include "ref_matrix_mult_16_test4.h"
+#include "ref_matrix_mult_16x16_32_test1.h"
+#include "ref_matrix_mult_32x16_32_test1.h"
 
 #define MATRIX_MULT_16_MAX_ERROR_ABS  1.5
 #define MATRIX_MULT_16_MAX_ERROR_RMS  0.5
+#define MATRIX_MULT_32_MAX_ERROR_ABS  1.5
+#define MATRIX_MULT_32_MAX_ERROR_RMS  0.5
 
 static void matrix_mult_16_test(const int16_t *a_ref, const int16_t *b_ref, const int16_t *c_ref,
 				int elementwise, int a_rows, int a_columns,
@@ -85,6 +89,145 @@ static void matrix_mult_16_test(const int16_t *a_ref, const int16_t *b_ref, cons
 	assert_true(delta_max < MATRIX_MULT_16_MAX_ERROR_ABS);
 }
 
+static void matrix_mult_16_transposed_test(const int16_t *a_ref, const int16_t *b_ref,
+					   const int16_t *c_ref, int a_rows, int a_columns,
+					   int b_rows, int b_columns, int c_rows, int c_columns,
+					   int a_frac, int b_frac, int c_frac)
+{
+	struct mat_matrix_16b *a_matrix;
+	struct mat_matrix_16b *b_matrix;
+	struct mat_matrix_16b *bt_matrix;
+	struct mat_matrix_16b *c_matrix;
+	float delta;
+	float sum_squares = 0;
+	float error_rms;
+	float delta_max = 0;
+	int16_t x;
+	int ret;
+	int i, j, k;
+
+	a_matrix = mat_matrix_alloc_16b(a_rows, a_columns, a_frac);
+	b_matrix = mat_matrix_alloc_16b(b_rows, b_columns, b_frac);
+	bt_matrix = mat_matrix_alloc_16b(b_columns, b_rows, 0);
+	c_matrix = mat_matrix_alloc_16b(c_rows, c_columns, c_frac);
+	if (!a_matrix || !b_matrix || !bt_matrix || !c_matrix) {
+		free(a_matrix);
+		free(b_matrix);
+		free(bt_matrix);
+		free(c_matrix);
+		exit(EXIT_FAILURE);
+	}
+
+	/* Initialize matrices a and b from test vectors, transpose b, and multiply */
+	mat_copy_from_linear_16b(a_matrix, a_ref);
+	mat_copy_from_linear_16b(b_matrix, b_ref);
+	ret = mat_transpose_16b(b_matrix, bt_matrix);
+	assert_int_equal(ret, 0);
+	assert_int_equal(bt_matrix->fractions, b_frac);
+	ret = mat_multiply_transposed(a_matrix, bt_matrix, c_matrix);
+	assert_int_equal(ret, 0);
+
+	/* Check */
+	k = 0;
+	for (i = 0; i < c_matrix->rows; i++) {
+		for (j = 0; j < c_matrix->columns; j++) {
+			x = mat_get_scalar_16b(c_matrix, i, j);
+			delta = (float)x - (float)c_ref[k++];
+			sum_squares += delta * delta;
+			if (delta > delta_max)
+				delta_max = delta;
+			else if (-delta > delta_max)
+				delta_max = -delta;
+		}
+	}
+
+	error_rms = sqrt(sum_squares / (float)(c_matrix->rows * c_matrix->columns));
+	printf("Max absolute error = %5.2f (max %5.2f), error RMS = %5.2f (max %5.2f)\n",
+	       delta_max, MATRIX_MULT_16_MAX_ERROR_ABS, error_rms, MATRIX_MULT_16_MAX_ERROR_RMS);
+
+	assert_true(error_rms < MATRIX_MULT_16_MAX_ERROR_RMS);
+	assert_true(delta_max < MATRIX_MULT_16_MAX_ERROR_ABS);
+
+	free(a_matrix);
+	free(b_matrix);
+	free(bt_matrix);
+	free(c_matrix);
+}
+
+/* Matrix multiply with 32 bit result. The a matrix is 16 bit if a16_ref is set,
+ * otherwise 32 bit from a32_ref.
+ */
+static void matrix_mult_32_test(const int16_t *a16_ref, const int32_t *a32_ref,
+				const int16_t *b_ref, const int32_t *c_ref,
+				int a_rows, int a_columns, int b_rows, int b_columns,
+				int c_rows, int c_columns, int a_frac, int b_frac, int c_frac)
+{
+	struct mat_matrix_16b *a16_matrix = NULL;
+	struct mat_matrix_32b *a32_matrix = NULL;
+	struct mat_matrix_16b *b_matrix;
+	struct mat_matrix_32b *c_matrix;
+	double delta;
+	double sum_squares = 0;
+	double error_rms;
+	double delta_max = 0;
+	int32_t x;
+	int ret;
+	int i, j, k;
+
+	if (a16_ref)
+		a16_matrix = mat_matrix_alloc_16b(a_rows, a_columns, a_frac);
+	else
+		a32_matrix = mat_matrix_alloc_32b(a_rows, a_columns, a_frac);
+
+	b_matrix = mat_matrix_alloc_16b(b_rows, b_columns, b_frac);
+	c_matrix = mat_matrix_alloc_32b(c_rows, c_columns, c_frac);
+	if ((!a16_matrix && !a32_matrix) || !b_matrix || !c_matrix) {
+		free(a16_matrix);
+		free(a32_matrix);
+		free(b_matrix);
+		free(c_matrix);
+		exit(EXIT_FAILURE);
+	}
+
+	/* Initialize matrices a and b from test vectors and do matrix multiply */
+	mat_copy_from_linear_16b(b_matrix, b_ref);
+	if (a16_ref) {
+		mat_copy_from_linear_16b(a16_matrix, a16_ref);
+		ret = mat_multiply_16b_32b(a16_matrix, b_matrix, c_matrix);
+	} else {
+		mat_copy_from_linear_32b(a32_matrix, a32_ref);
+		ret = mat_multiply_32b_16b(a32_matrix, b_matrix, c_matrix);
+	}
+
+	assert_int_equal(ret, 0);
+
+	/* Check */
+	k = 0;
+	for (i = 0; i < c_matrix->rows; i++) {
+		for (j = 0; j < c_matrix->columns; j++) {
+			x = mat_get_scalar_32b(c_matrix, i, j);
+			delta = (double)x - (double)c_ref[k++];
+			sum_squares += delta * delta;
+			if (delta > delta_max)
+				delta_max = delta;
+			else if (-delta > delta_max)
+				delta_max = -delta;
+		}
+	}
+
+	error_rms = sqrt(sum_squares / (double)(c_matrix->rows * c_matrix->columns));
+	printf("Max absolute error = %5.2f (max %5.2f), error RMS = %5.2f (max %5.2f)\n",
+	       delta_max, MATRIX_MULT_32_MAX_ERROR_ABS, error_rms, MATRIX_MULT_32_MAX_ERROR_RMS);
+
+	assert_true(error_rms < MATRIX_MULT_32_MAX_ERROR_RMS);
+	assert_true(delta_max < MATRIX_MULT_32_MAX_ERROR_ABS);
+
+	free(a16_matrix);
+	free(a32_matrix);
+	free(b_matrix);
+	free(c_matrix);
+}
+
 static void test_matrix_mult_16_test1(void **state)
 {
 	(void)state;
@@ -161,6 +304,98 @@ static void test_matrix_mult_16_test4(void **state)
 			    MATRIX_MULT_16_TEST4_C_QXY_Y);
 }
 
+static void test_matrix_mult_16_transposed_test1(void **state)
+{
+	(void)state;
+
+	matrix_mult_16_transposed_test(matrix_mult_16_test1_a,
+				       matrix_mult_16_test1_b,
+				       matrix_mult_16_test1_c,
+				       MATRIX_MULT_16_TEST1_A_ROWS,
+				       MATRIX_MULT_16_TEST1_A_COLUMNS,
+				       MATRIX_MULT_16_TEST1_B_ROWS,
+				       MATRIX_MULT_16_TEST1_B_COLUMNS,
+				       MATRIX_MULT_16_TEST1_C_ROWS,
+				       MATRIX_MULT_16_TEST1_C_COLUMNS,
+				       MATRIX_MULT_16_TEST1_A_QXY_Y,
+				       MATRIX_MULT_16_TEST1_B_QXY_Y,
+				       MATRIX_MULT_16_TEST1_C_QXY_Y);
+}
+
+static void test_matrix_mult_16_transposed_test2(void **state)
+{
+	(void)state;
+
+	matrix_mult_16_transposed_test(matrix_mult_16_test2_a,
+				       matrix_mult_16_test2_b,
+				       matrix_mult_16_test2_c,
+				       MATRIX_MULT_16_TEST2_A_ROWS,
+				       MATRIX_MULT_16_TEST2_A_COLUMNS,
+				       MATRIX_MULT_16_TEST2_B_ROWS,
+				       MATRIX_MULT_16_TEST2_B_COLUMNS,
+				       MATRIX_MULT_16_TEST2_C_ROWS,
+				       MATRIX_MULT_16_TEST2_C_COLUMNS,
+				       MATRIX_MULT_16_TEST2_A_QXY_Y,
+				       MATRIX_MULT_16_TEST2_B_QXY_Y,
+				       MATRIX_MULT_16_TEST2_C_QXY_Y);
+}
+
+static void test_matrix_mult_16_transposed_test4(void **state)
+{
+	(void)state;
+
+	matrix_mult_16_transposed_test(matrix_mult_16_test4_a,
+				       matrix_mult_16_test4_b,
+				       matrix_mult_16_test4_c,
+				       MATRIX_MULT_16_TEST4_A_ROWS,
+				       MATRIX_MULT_16_TEST4_A_COLUMNS,
+				       MATRIX_MULT_16_TEST4_B_ROWS,
+				       MATRIX_MULT_16_TEST4_B_COLUMNS,
+				       MATRIX_MULT_16_TEST4_C_ROWS,
+				       MATRIX_MULT_16_TEST4_C_COLUMNS,
+				       MATRIX_MULT_16_TEST4_A_QXY_Y,
+				       MATRIX_MULT_16_TEST4_B_QXY_Y,
+				       MATRIX_MULT_16_TEST4_C_QXY_Y);
+}
+
+static void test_matrix_mult_16x16_32_test1(void **state)
+{
+	(void)state;
+
+	matrix_mult_32_test(matrix_mult_16x16_32_test1_a,
+			    NULL,
+			    matrix_mult_16x16_32_test1_b,
+			    matrix_mult_16x16_32_test1_c,
+			    MATRIX_MULT_16X16_32_TEST1_A_ROWS,
+			    MATRIX_MULT_16X16_32_TEST1_A_COLUMNS,
+			    MATRIX_MULT_16X16_32_TEST1_B_ROWS,
+			    MATRIX_MULT_16X16_32_TEST1_B_COLUMNS,
+			    MATRIX_MULT_16X16_32_TEST1_C_ROWS,
+			    MATRIX_MULT_16X16_32_TEST1_C_COLUMNS,
+			    MATRIX_MULT_16X16_32_TEST1_A_QXY_Y,
+			    MATRIX_MULT_16X16_32_TEST1_B_QXY_Y,
+			    MATRIX_MULT_16X16_32_TEST1_C_QXY_Y);
+}
+
+static void test_matrix_mult_32x16_32_test1(void **state)
+{
+	(void)state;
+
+	matrix_mult_32_test(NULL,
+			    matrix_mult_32x16_32_test1_a,
+			    matrix_mult_32x16_32_test1_b,
+			    matrix_mult_32x16_32_test1_c,
+			    MATRIX_MULT_32X16_32_TEST1_A_ROWS,
+			    MATRIX_MULT_32X16_32_TEST1_A_COLUMNS,
+			    MATRIX_MULT_32X16_32_TEST1_B_ROWS,
+			    MATRIX_MULT_32X16_32_TEST1_B_COLUMNS,
+			    MATRIX_MULT_32X16_32_TEST1_C_ROWS,
+			    MATRIX_MULT_32X16_32_TEST1_C_COLUMNS,
+			    MATRIX_MULT_32X16_32_TEST1_A_QXY_Y,
+			    MATRIX_MULT_32X16_32_TEST1_B_QXY_Y,
+			    MATRIX_MULT_32X16_32_TEST1_C_QXY_Y);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -168,6 +403,11 @@ int main(void)
 		cmocka_unit_test(test_matrix_mult_16_test2),
 		cmocka_unit_test(test_matrix_mult_16_test3),
 		cmocka_unit_test(test_matrix_mult_16_test4),
+		cmocka_unit_test(test_matrix_mult_16_transposed_test1),
+		cmocka_unit_test(test_matrix_mult_16_transposed_test2),
+		cmocka_unit_test(test_matrix_mult_16_transposed_test4),
+		cmocka_unit_test(test_matrix_mult_16x16_32_test1),
+		cmocka_unit_test(test_matrix_mult_32x16_32_test1),
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
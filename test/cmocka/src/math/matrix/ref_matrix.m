@@ -64,13 +64,52 @@ function ref_matrix()
 	opt.c_qxy_y = 15;
 	opt.elementwise = 0;
 	get_ref_mult(opt);
+
+	% 16 bit a and b with 32 bit result
+	opt.test_n = 1;
+	opt.input = 'random';
+	opt.a_rows = 4;
+	opt.a_columns = 9;
+	opt.b_rows = 9;
+	opt.b_columns = 11;
+	opt.a_qxy_x = 1;
+	opt.a_qxy_y = 15;
+	opt.b_qxy_x = 1;
+	opt.b_qxy_y = 15;
+	opt.c_qxy_x = 5;
+	opt.c_qxy_y = 27;
+	opt.elementwise = 0;
+	get_ref_mult(opt);
+
+	% 32 bit a and 16 bit b with 32 bit result
+	opt.test_n = 1;
+	opt.input = 'random';
+	opt.a_rows = 5;
+	opt.a_columns = 10;
+	opt.b_rows = 10;
+	opt.b_columns = 17;
+	opt.a_qxy_x = 1;
+	opt.a_qxy_y = 31;
+	opt.b_qxy_x = 1;
+	opt.b_qxy_y = 15;
+	opt.c_qxy_x = 5;
+	opt.c_qxy_y = 27;
+	opt.elementwise = 0;
+	get_ref_mult(opt);
 end
 
 function get_ref_mult(opt)
 	[a_bits, a_scale] = get_qxy_scale(opt.a_qxy_x, opt.a_qxy_y);
 	[b_bits, b_scale] = get_qxy_scale(opt.b_qxy_x, opt.b_qxy_y);
 	[c_bits, c_scale] = get_qxy_scale(opt.c_qxy_x, opt.c_qxy_y);
-	bits = max([a_bits b_bits c_bits]);
+	a_word = 16 * ceil(a_bits / 16);
+	b_word = 16 * ceil(b_bits / 16);
+	c_word = 16 * ceil(c_bits / 16);
+	if a_word == b_word && b_word == c_word
+		bits_str = sprintf('%d', a_word);
+	else
+		bits_str = sprintf('%dx%d_%d', a_word, b_word, c_word);
+	end
 
 	% Data to process
 	switch lower(opt.input)
@@ -84,19 +123,19 @@ function get_ref_mult(opt)
 			error('Illegal input');
 	end
 
-	[iqa, fqa] = quant_qxy(a, bits, opt.a_qxy_y, true);
-	[iqb, fqb] = quant_qxy(b, bits, opt.b_qxy_y, true);
+	[iqa, fqa] = quant_qxy(a, a_word, opt.a_qxy_y, true);
+	[iqb, fqb] = quant_qxy(b, b_word, opt.b_qxy_y, true);
 	if opt.elementwise
 		c = fqa .* fqb;
 	else
 		c = fqa * fqb;
 	end
 
-	iqc = quant_qxy(c, bits, opt.c_qxy_y, false);
+	iqc = quant_qxy(c, c_word, opt.c_qxy_y, false);
 	c_size = size(c);
 
-	header_fn = sprintf('ref_matrix_mult_%d_test%d.h', bits, opt.test_n);
-	define_prefix = sprintf('MATRIX_MULT_%d_TEST%d_', bits, opt.test_n);
+	header_fn = sprintf('ref_matrix_mult_%s_test%d.h', bits_str, opt.test_n);
+	define_prefix = upper(sprintf('MATRIX_MULT_%s_TEST%d_', bits_str, opt.test_n));
 
 	fh = export_headerfile_open(header_fn);
 	comment = sprintf('Created %s with script ref_matrix.m %s', ...
@@ -113,12 +152,12 @@ function get_ref_mult(opt)
 	export_ndefine(fh, [define_prefix 'B_QXY_Y'], opt.b_qxy_y);
 	export_ndefine(fh, [define_prefix 'C_QXY_Y'], opt.c_qxy_y);
 
-	vector_name_a = sprintf('matrix_mult_%d_test%d_a', bits, opt.test_n);
-	vector_name_b = sprintf('matrix_mult_%d_test%d_b', bits, opt.test_n);
-	vector_name_c = sprintf('matrix_mult_%d_test%d_c', bits, opt.test_n);
-	export_vector(fh, bits, vector_name_a, mat_to_vec(iqa), size(iqa));
-	export_vector(fh, bits, vector_name_b, mat_to_vec(iqb), size(iqb));
-	export_vector(fh, bits, vector_name_c, mat_to_vec(iqc), size(iqc));
+	vector_name_a = sprintf('matrix_mult_%s_test%d_a', bits_str, opt.test_n);
+	vector_name_b = sprintf('matrix_mult_%s_test%d_b', bits_str, opt.test_n);
+	vector_name_c = sprintf('matrix_mult_%s_test%d_c', bits_str, opt.test_n);
+	export_vector(fh, a_word, vector_name_a, mat_to_vec(iqa), size(iqa));
+	export_vector(fh, b_word, vector_name_b, mat_to_vec(iqb), size(iqb));
+	export_vector(fh, c_word, vector_name_c, mat_to_vec(iqc), size(iqc));
   fclose(fh);
 	fprintf(1, 'Exported file %s\n', header_fn);
 end
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation. All rights reserved.
+ */
+
+/* Created 18-Oct-2026 10:00:00 with script ref_matrix.m 93b713a-dirty */
+
+#define MATRIX_MULT_16X16_32_TEST1_ELEMENTWISE  0
+#define MATRIX_MULT_16X16_32_TEST1_A_ROWS  4
+#define MATRIX_MULT_16X16_32_TEST1_A_COLUMNS  9
+#define MATRIX_MULT_16X16_32_TEST1_B_ROWS  9
+#define MATRIX_MULT_16X16_32_TEST1_B_COLUMNS  11
+#define MATRIX_MULT_16X16_32_TEST1_C_ROWS  4
+#define MATRIX_MULT_16X16_32_TEST1_C_COLUMNS  11
+#define MATRIX_MULT_16X16_32_TEST1_A_QXY_Y  15
+#define MATRIX_MULT_16X16_32_TEST1_B_QXY_Y  15
+#define MATRIX_MULT_16X16_32_TEST1_C_QXY_Y  27
+
+static const int16_t matrix_mult_16x16_32_test1_a[36] = {
+	-29223,  15591, -23799,  -7154,  -9355,   -969,  16401,  22211,  13854,
+	 -7197,  18841,  10175, -20570, -32371, -22117, -20374,  30145, -28194,
+	 18936,  25669, -18501,   6660,  -1897,  24217,   4758, -20041,  -2383,
+	-30110,   9526, -20030,  -9553,  14651,  11612,  19084,  -8808, -21556,
+};
+
+static const int16_t matrix_mult_16x16_32_test1_b[99] = {
+	 22712,    -31,  15752, -18170, -17724, -22180,   8537,  31489, -31124,  32445,
+	  9402,   7352,   7014,  19717, -18657,  19415,  28582, -20371, -31105,  -6280,
+	 13915,  23038, -29950,   3595, -30471,   5494, -11296,  -7000,  -1436, -16328,
+	-29129,  -7559,  -5840, -30235,  10434, -28194,  14955, -27433,  13750, -30500,
+	-32566, -22840, -24667,  19645, -14036,  -5810, -28697,  -1872, -32513,  -9958,
+	-27355, -21412,  31983,   -937,   5912,  17958,  -3177, -12777,  20458, -16261,
+	 13079,  22858,  10531,   2788,  -5253, -10186,  18396, -24213, -11500,  17073,
+	  5224,   7808, -19241,  21002,  13170,   4213,  -6794,  24985,  21328,  27368,
+	   787, -12156,   7316,  32544,  -2590,  15086,  17776,  30306,  17239, -18462,
+	 -4767, -13425,  31722, -11886,  32729,   4579, -14155,  -8764,  24360,
+};
+
+static const int32_t matrix_mult_16x16_32_test1_c[44] = {
+	  198672839,   -21460468,   176003092,    13944248,   232601428,   171047898,
+	   97467336,   -30390546,   215166752,    -2308453,   117077716,    30221512,
+	  233679087,   366659833,  -101244720,   123449256,    96717139,   124721851,
+	  -60473415,   -29043345,   162847440,    37746126,   122346399,   -47765763,
+	   41693219,   -28572804,     6223834,    98654024,   -94265087,    39950746,
+	  -70357901,    63297042,     6581566,     4649331,   -59739970,   -41671166,
+	  116859043,     8092250,   161966254,  -203209221,   -59099807,   325438239,
+	  -52411649,  -135960868,
+};
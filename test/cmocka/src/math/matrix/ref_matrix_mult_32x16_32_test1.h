@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation. All rights reserved.
+ */
+
+/* Created 18-Oct-2026 10:00:00 with script ref_matrix.m 93b713a-dirty */
+
+#define MATRIX_MULT_32X16_32_TEST1_ELEMENTWISE  0
+#define MATRIX_MULT_32X16_32_TEST1_A_ROWS  5
+#define MATRIX_MULT_32X16_32_TEST1_A_COLUMNS  10
+#define MATRIX_MULT_32X16_32_TEST1_B_ROWS  10
+#define MATRIX_MULT_32X16_32_TEST1_B_COLUMNS  17
+#define MATRIX_MULT_32X16_32_TEST1_C_ROWS  5
+#define MATRIX_MULT_32X16_32_TEST1_C_COLUMNS  17
+#define MATRIX_MULT_32X16_32_TEST1_A_QXY_Y  31
+#define MATRIX_MULT_32X16_32_TEST1_B_QXY_Y  15
+#define MATRIX_MULT_32X16_32_TEST1_C_QXY_Y  27
+
+static const int32_t matrix_mult_32x16_32_test1_a[50] = {
+	  996280297,  1511577364, -2041829848,   156395905, -1753891290,  -502458892,
+	-1935602627,  -440095131,  -608818920,   572423145,  1346339641,  2136903904,
+	  -43879388,   969201395,  1515183192,  1287337984, -1253330580,   716123249,
+	 2139936613,   956623462,  1721533077,  -188105992, -1419565369,  1014778147,
+	-1983989516,  -117089646, -1648142446, -2092236932,  -865339021,  -540161835,
+	  880253015,  -565053995, -1858999899,  -720628147,  -878965935, -1441519705,
+	-1233423480,   850229353,  -441666617,   185102679, -1797775439,  1329922173,
+	  249820425,   283090167,  1842045238,  -294862176, -1698472092,   129965147,
+	 1621182544,  -135529383,
+};
+
+static const int16_t matrix_mult_32x16_32_test1_b[170] = {
+	-29911,  -8088,  15268, -10834, -31153,  -7392,  -8366,   7815,  10920,  -4598,
+	 18300,  23829,  -1209,  15209,  13431,  -8983, -11500,   1460, -21688,  28512,
+	-26409, -24416,  21983,   -584,   4227,  16156,  -8827, -10569, -19357,  22413,
+	 -4663,  27477, -24930,   6662, -18042, -29260, -11400,  12947,  11464,  28272,
+	 -6454,   7002, -22503, -10227, -31687,  20590,   8366,  27594,   3830,  17802,
+	  3475,  10087,  18387,  14781, -18874, -27804,  10195,  29374, -20522, -13746,
+	-30370,  -1540,  31973,  25132,  23239,  24721,  -2295,  -9076,   2003, -26841,
+	-21800,   5581,  24947,  -3020,  22863,  23450,   7309, -14357,  30803, -10581,
+	-22245, -16683,   6271, -20522, -11342, -13001,  23596, -26044,  10325, -26713,
+	-20925,  -8624,   6078,  -9332, -27202, -30441,  21604,  -8622, -10882,  30364,
+	 17797,  31603,  16672,  21374,   9896,  17016,  13907, -17519,   2157,  28487,
+	 -1687, -29309,  -2276,  26823, -19188, -30867,  19191, -23629,   3888, -27061,
+	 32341, -29667, -24684, -29801,  26335,  18807,   5065,  29300, -25008, -15013,
+	-26412,  29981, -18838,   -121, -14573, -21270,  12259,     32,  -2190,  32185,
+	    54,  24708,  22922,   4819, -25261,  -7337,  10418,  16946, -15241,  28365,
+	  9301, -16010, -16265,  19328,  28259,   7541, -28168, -13475,  28885,  28825,
+	-27412,  13043,   6902,  10099,  16126, -17393, -27182,  27523, -27411, -18749,
+};
+
+static const int32_t matrix_mult_32x16_32_test1_c[85] = {
+	   -5565305,    33475304,   257053860,  -291573426,  -281489053,    17842693,
+	  -70798729,  -235571924,   160567708,   215933246,    73310326,  -145413007,
+	  164297658,    48317152,    -4377991,   -19232437,    -9313960,   -68351146,
+	  -47587586,    -2612814,  -124374999,  -323683662,   258392891,   242560796,
+	  -10060202,    33318979,  -192801493,    63879907,    60538706,    41424887,
+	  100003310,   326678830,  -224800078,  -113571097,   -19606475,   -33081147,
+	  270817054,  -100198179,  -177825347,  -193435420,  -186885651,  -214106766,
+	  -44557546,   214313428,    76397672,   103036062,    83836040,   240837200,
+	  -62343453,   187589838,    87555411,   -55906138,    80506391,    56281415,
+	 -164555919,   -82646665,   -14460480,   -29233192,  -116621302,   190379753,
+	  215673999,   164440049,  -212261768,    71065875,   -32758279,  -192083542,
+	  -26942777,  -130769215,    89658716,  -207300953,   -87560005,    25498694,
+	   89221642,   233460338,   186269756,   -13891354,   -52433948,     1238812,
+	   53109143,  -198272852,    32209908,    99284344,     3217782,   -76787887,
+	  -67850799,
+};
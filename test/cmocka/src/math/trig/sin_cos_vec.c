@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/trig.h>
+
+/* not a multiple of CORDIC_VEC_BLOCK to test the partial block */
+#define VEC_TEST_SIZE		4099
+#define VEC_TEST_ROUNDS		50
+
+/* angles over the whole input range [-2*pi, 2*pi) in Q4.28 */
+static void sin_cos_vec_angles(int32_t *th)
+{
+	int i;
+
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		th[i] = -PI_MUL2_Q4_28 + (int32_t)(((int64_t)2 * PI_MUL2_Q4_28 * i) /
+						   VEC_TEST_SIZE);
+}
+
+static void test_sin_cos_32b_vec(void **state)
+{
+	int32_t *th = test_malloc(VEC_TEST_SIZE * sizeof(*th));
+	int32_t *s = test_malloc(VEC_TEST_SIZE * sizeof(*s));
+	int32_t *c = test_malloc(VEC_TEST_SIZE * sizeof(*c));
+	int i;
+
+	(void)state;
+
+	sin_cos_vec_angles(th);
+	sin_cos_fixed_32b_vec(th, s, c, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++) {
+		assert_int_equal(s[i], sin_fixed_32b(th[i]));
+		assert_int_equal(c[i], cos_fixed_32b(th[i]));
+	}
+
+	/* one output only */
+	sin_cos_fixed_32b_vec(th, NULL, s, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++)
+		assert_int_equal(s[i], c[i]);
+
+	test_free(th);
+	test_free(s);
+	test_free(c);
+}
+
+static void test_sin_cos_16b_vec(void **state)
+{
+	int32_t *th = test_malloc(VEC_TEST_SIZE * sizeof(*th));
+	int16_t *s = test_malloc(VEC_TEST_SIZE * sizeof(*s));
+	int16_t *c = test_malloc(VEC_TEST_SIZE * sizeof(*c));
+	int i;
+
+	(void)state;
+
+	sin_cos_vec_angles(th);
+	sin_cos_fixed_16b_vec(th, s, c, VEC_TEST_SIZE);
+	for (i = 0; i < VEC_TEST_SIZE; i++) {
+		assert_int_equal(s[i], sin_fixed_16b(th[i]));
+		assert_int_equal(c[i], cos_fixed_16b(th[i]));
+	}
+
+	test_free(th);
+	test_free(s);
+	test_free(c);
+}
+
+/* informative only, the speed of the host is not checked */
+static void test_sin_cos_vec_throughput(void **state)
+{
+	int32_t *th = test_malloc(VEC_TEST_SIZE * sizeof(*th));
+	int32_t *s = test_malloc(VEC_TEST_SIZE * sizeof(*s));
+	int32_t *c = test_malloc(VEC_TEST_SIZE * sizeof(*c));
+	clock_t scalar = 0;
+	clock_t vec = 0;
+	clock_t t;
+	int i, r;
+
+	(void)state;
+
+	sin_cos_vec_angles(th);
+	for (r = 0; r < VEC_TEST_ROUNDS; r++) {
+		t = clock();
+		for (i = 0; i < VEC_TEST_SIZE; i++) {
+			s[i] = sin_fixed_32b(th[i]);
+			c[i] = cos_fixed_32b(th[i]);
+		}
+		scalar += clock() - t;
+
+		t = clock();
+		sin_cos_fixed_32b_vec(th, s, c, VEC_TEST_SIZE);
+		vec += clock() - t;
+	}
+
+	print_message("sin and cos: scalar %ld, vector %ld clocks\n", (long)scalar, (long)vec);
+
+	test_free(th);
+	test_free(s);
+	test_free(c);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_sin_cos_32b_vec),
+		cmocka_unit_test(test_sin_cos_16b_vec),
+		cmocka_unit_test(test_sin_cos_vec_throughput),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
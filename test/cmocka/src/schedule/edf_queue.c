@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include <sof/schedule/edf_queue.h>
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/task.h>
+#include <sof/list.h>
+
+#define EDF_TEST_MAX_TASKS	512
+#define EDF_TEST_SELECTIONS	2000
+
+struct edf_test_data {
+	struct task tasks[EDF_TEST_MAX_TASKS];
+	struct edf_task_pdata pdata[EDF_TEST_MAX_TASKS];
+	struct task *storage[EDF_TEST_MAX_TASKS];
+	struct edf_queue queue;
+	uint64_t deadline[EDF_TEST_MAX_TASKS];
+	bool queued[EDF_TEST_MAX_TASKS];
+	struct list_item list;	/* queued tasks in queueing order */
+};
+
+static uint64_t test_deadline(void *data)
+{
+	return *(uint64_t *)data;
+}
+
+static int setup(void **state)
+{
+	struct edf_test_data *td = test_calloc(1, sizeof(*td));
+	int i;
+
+	list_init(&td->list);
+
+	for (i = 0; i < EDF_TEST_MAX_TASKS; i++) {
+		td->tasks[i].data = &td->deadline[i];
+		td->tasks[i].ops.get_deadline = test_deadline;
+		td->pdata[i].queue_index = -1;
+		edf_sch_set_pdata((&td->tasks[i]), &td->pdata[i]);
+	}
+
+	edf_queue_set_storage(&td->queue, td->storage, EDF_TEST_MAX_TASKS);
+	*state = td;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	test_free(*state);
+
+	return 0;
+}
+
+static void queue_task(struct edf_test_data *td, int i, uint64_t deadline)
+{
+	assert_int_equal(edf_queue_push(&td->queue, &td->tasks[i], deadline), 0);
+	list_item_append(&td->tasks[i].list, &td->list);
+	td->tasks[i].state = SOF_TASK_STATE_QUEUED;
+	td->deadline[i] = deadline;
+	td->queued[i] = true;
+}
+
+static void remove_task(struct edf_test_data *td, int i)
+{
+	edf_queue_remove(&td->queue, &td->tasks[i]);
+	if (td->queued[i])
+		list_item_del(&td->tasks[i].list);
+	td->tasks[i].state = SOF_TASK_STATE_CANCEL;
+	td->queued[i] = false;
+}
+
+/* reference selection, the former walk of the task list */
+static struct task *scan_next(struct edf_test_data *td)
+{
+	uint64_t deadline_next = SOF_TASK_DEADLINE_IDLE;
+	struct task *task_next = NULL;
+	struct list_item *tlist;
+	struct task *task;
+	uint64_t deadline;
+
+	list_for_item(tlist, &td->list) {
+		task = container_of(tlist, struct task, list);
+
+		if (task->state != SOF_TASK_STATE_QUEUED &&
+		    task->state != SOF_TASK_STATE_RUNNING)
+			continue;
+
+		deadline = task_get_deadline(task);
+
+		if (deadline == SOF_TASK_DEADLINE_NOW)
+			return task;
+
+		if (deadline <= deadline_next) {
+			deadline_next = deadline;
+			task_next = task;
+		}
+	}
+
+	return task_next;
+}
+
+static uint64_t random_deadline(void)
+{
+	switch (rand() % 8) {
+	case 0:
+		return SOF_TASK_DEADLINE_NOW;
+	case 1:
+		return SOF_TASK_DEADLINE_ALMOST_IDLE;
+	case 2:
+		return SOF_TASK_DEADLINE_IDLE;
+	default:
+		/* few distinct values to get equal deadlines */
+		return 1000 + rand() % 16;
+	}
+}
+
+static void test_edf_queue_empty(void **state)
+{
+	struct edf_test_data *td = *state;
+
+	assert_null(edf_queue_peek(&td->queue));
+
+	queue_task(td, 0, 100);
+	assert_true(edf_queue_contains(&td->tasks[0]));
+	assert_ptr_equal(edf_queue_peek(&td->queue), &td->tasks[0]);
+
+	remove_task(td, 0);
+	assert_false(edf_queue_contains(&td->tasks[0]));
+	assert_null(edf_queue_peek(&td->queue));
+
+	/* removing a task not queued is harmless */
+	remove_task(td, 0);
+	assert_int_equal(td->queue.count, 0);
+}
+
+static void test_edf_queue_full(void **state)
+{
+	struct edf_test_data *td = *state;
+	struct task *storage[2];
+
+	edf_queue_set_storage(&td->queue, storage, 2);
+
+	queue_task(td, 0, 100);
+	queue_task(td, 1, 50);
+	assert_int_equal(edf_queue_push(&td->queue, &td->tasks[2], 10), -ENOSPC);
+	assert_ptr_equal(edf_queue_peek(&td->queue), &td->tasks[1]);
+
+	/* a larger storage keeps the queued tasks */
+	edf_queue_set_storage(&td->queue, td->storage, EDF_TEST_MAX_TASKS);
+	queue_task(td, 2, 10);
+	assert_ptr_equal(edf_queue_peek(&td->queue), &td->tasks[2]);
+	assert_int_equal(td->queue.count, 3);
+}
+
+static void test_edf_queue_equal_deadlines(void **state)
+{
+	struct edf_test_data *td = *state;
+
+	/* tasks to run now keep the queueing order */
+	queue_task(td, 0, SOF_TASK_DEADLINE_NOW);
+	queue_task(td, 1, SOF_TASK_DEADLINE_NOW);
+	assert_ptr_equal(edf_queue_peek(&td->queue), &td->tasks[0]);
+
+	/* other equal deadlines run the latest queued task first */
+	queue_task(td, 2, 500);
+	queue_task(td, 3, 500);
+	remove_task(td, 0);
+	remove_task(td, 1);
+	assert_ptr_equal(edf_queue_peek(&td->queue), &td->tasks[3]);
+}
+
+static void test_edf_queue_random(void **state)
+{
+	struct edf_test_data *td = *state;
+	int num_tasks = 64;
+	int i, k;
+
+	srand(1);
+
+	for (k = 0; k < 20000; k++) {
+		i = rand() % num_tasks;
+
+		if (td->queued[i])
+			remove_task(td, i);
+		else
+			queue_task(td, i, random_deadline());
+
+		assert_ptr_equal(edf_queue_peek(&td->queue), scan_next(td));
+	}
+}
+
+/*
+ * Selection latency against the number of queued tasks. The scan is the
+ * former walk of the task list, the queue selects the next task and then
+ * queues it back with a new deadline like a periodic task does.
+ */
+static void test_edf_queue_benchmark(void **state)
+{
+	struct edf_test_data *td = *state;
+	struct task *task;
+	clock_t t0, t_scan, t_queue;
+	uintptr_t selected = 0;
+	int num_tasks;
+	int i, k;
+
+	srand(1);
+
+	for (num_tasks = 4; num_tasks <= EDF_TEST_MAX_TASKS; num_tasks *= 4) {
+		for (i = 0; i < num_tasks; i++) {
+			remove_task(td, i);
+			queue_task(td, i, 1000 + rand() % 100000);
+		}
+
+		t0 = clock();
+		for (k = 0; k < EDF_TEST_SELECTIONS; k++)
+			selected += (uintptr_t)scan_next(td);
+		t_scan = clock() - t0;
+
+		t0 = clock();
+		for (k = 0; k < EDF_TEST_SELECTIONS; k++) {
+			task = edf_queue_peek(&td->queue);
+			i = task - td->tasks;
+			remove_task(td, i);
+			queue_task(td, i, td->deadline[i] + 1000 + rand() % 100000);
+		}
+		t_queue = clock() - t0;
+
+		assert_int_equal(td->queue.count, num_tasks);
+		print_message("edf_queue: %3d tasks, scan %8.1f ns, select and requeue %6.1f ns\n",
+			      num_tasks,
+			      1e9 * t_scan / CLOCKS_PER_SEC / EDF_TEST_SELECTIONS,
+			      1e9 * t_queue / CLOCKS_PER_SEC / EDF_TEST_SELECTIONS);
+	}
+
+	/* keep the scan from being optimized out */
+	assert_true(selected);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_edf_queue_empty, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_edf_queue_full, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_edf_queue_equal_deadlines, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_edf_queue_random, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_edf_queue_benchmark, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
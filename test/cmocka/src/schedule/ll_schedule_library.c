@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <cmocka.h>
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/topology.h>
+#include <sof/schedule/ll_schedule.h>
+#include <sof/schedule/ll_schedule_domain.h>
+#include <sof/schedule/schedule.h>
+
+/* Test of the work stealing of the host library LL scheduler */
+
+#define TEST_TASKS		4
+#define TEST_THREADS		CONFIG_CORE_COUNT
+#define TEST_TASK_RUN_US	200
+#define TEST_RUNS		100
+#define TEST_TIMEOUT_MS		10000
+
+struct test_task {
+	struct task task;
+	struct pipeline pipeline;
+	struct ipc_comp_dev icd;
+	pthread_t threads[TEST_THREADS];
+	int thread_count;
+	int running;
+	int runs;
+	int overlaps;
+};
+
+static struct test_task test_tasks[TEST_TASKS];
+static struct ipc test_ipc;
+
+static void spin_us(int us)
+{
+	struct timespec t0, t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+	} while ((t1.tv_sec - t0.tv_sec) * 1000000 +
+		 (t1.tv_nsec - t0.tv_nsec) / 1000 < us);
+}
+
+static enum task_state test_task_run(void *data)
+{
+	struct test_task *tt = data;
+	pthread_t self = pthread_self();
+	int i;
+
+	if (__sync_fetch_and_add(&tt->running, 1))
+		tt->overlaps++;
+
+	spin_us(TEST_TASK_RUN_US);
+
+	/* remember the vcore threads the task has run on */
+	for (i = 0; i < tt->thread_count; i++)
+		if (pthread_equal(tt->threads[i], self))
+			break;
+	if (i == tt->thread_count && i < TEST_THREADS)
+		tt->threads[tt->thread_count++] = self;
+
+	__atomic_add_fetch(&tt->runs, 1, __ATOMIC_RELEASE);
+	__sync_fetch_and_sub(&tt->running, 1);
+
+	return SOF_TASK_STATE_RESCHEDULE;
+}
+
+/* pipeline tasks all owned by core 0 */
+static void tasks_init(void)
+{
+	struct test_task *tt;
+	int i;
+
+	list_init(&test_ipc.comp_list);
+
+	for (i = 0; i < TEST_TASKS; i++) {
+		tt = test_tasks + i;
+		memset(tt, 0, sizeof(*tt));
+		schedule_task_init_ll(&tt->task, NULL, SOF_SCHEDULE_LL_TIMER, 0,
+				      test_task_run, tt, 0, 0);
+		tt->pipeline.pipe_task = &tt->task;
+		tt->icd.type = COMP_TYPE_PIPELINE;
+		tt->icd.pipeline = &tt->pipeline;
+		list_item_append(&tt->icd.list, &test_ipc.comp_list);
+	}
+}
+
+static void tasks_run(void)
+{
+	struct timespec ts = { .tv_sec = 0, .tv_nsec = 1000000 };
+	int done, ms, i;
+
+	for (i = 0; i < TEST_TASKS; i++)
+		assert_int_equal(schedule_task(&test_tasks[i].task, 0, 1000), 0);
+
+	for (ms = 0; ms < TEST_TIMEOUT_MS; ms++) {
+		for (done = 0, i = 0; i < TEST_TASKS; i++)
+			done += __atomic_load_n(&test_tasks[i].runs, __ATOMIC_ACQUIRE) >=
+				TEST_RUNS;
+		if (done == TEST_TASKS)
+			break;
+		nanosleep(&ts, NULL);
+	}
+
+	for (i = 0; i < TEST_TASKS; i++) {
+		assert_int_equal(schedule_task_free(&test_tasks[i].task), 0);
+		assert_true(test_tasks[i].runs >= TEST_RUNS);
+		assert_int_equal(test_tasks[i].overlaps, 0);
+	}
+}
+
+static void test_ll_schedule_steal(void **state)
+{
+	pthread_t threads[TEST_THREADS];
+	int thread_count = 0;
+	int i, j, k;
+
+	(void)state;
+
+	tasks_init();
+	tasks_run();
+
+	/* the idle vcores have run the tasks of core 0 */
+	for (i = 0; i < TEST_TASKS; i++) {
+		for (j = 0; j < test_tasks[i].thread_count; j++) {
+			for (k = 0; k < thread_count; k++)
+				if (pthread_equal(threads[k], test_tasks[i].threads[j]))
+					break;
+			if (k == thread_count)
+				threads[thread_count++] = test_tasks[i].threads[j];
+		}
+	}
+
+	assert_true(thread_count > 1);
+}
+
+static void test_ll_schedule_steal_connected(void **state)
+{
+	struct comp_buffer buffer;
+	struct comp_dev source, sink;
+	struct ipc_comp_dev icd;
+	int i;
+
+	(void)state;
+
+	tasks_init();
+
+	/* a buffer between the pipelines of tasks 0 and 1 */
+	memset(&buffer, 0, sizeof(buffer));
+	memset(&source, 0, sizeof(source));
+	memset(&sink, 0, sizeof(sink));
+	memset(&icd, 0, sizeof(icd));
+	source.pipeline = &test_tasks[0].pipeline;
+	sink.pipeline = &test_tasks[1].pipeline;
+	buffer.source = &source;
+	buffer.sink = &sink;
+	icd.type = COMP_TYPE_BUFFER;
+	icd.cb = &buffer;
+	list_item_append(&icd.list, &test_ipc.comp_list);
+
+	tasks_run();
+
+	/* the connected pipelines stay on the vcore of their core */
+	for (i = 0; i < 2; i++)
+		assert_int_equal(test_tasks[i].thread_count, 1);
+	assert_true(pthread_equal(test_tasks[0].threads[0], test_tasks[1].threads[0]));
+
+	list_item_del(&icd.list);
+}
+
+static void test_ll_schedule_invalid_core(void **state)
+{
+	struct task task;
+
+	(void)state;
+
+	schedule_task_init_ll(&task, NULL, SOF_SCHEDULE_LL_TIMER, 0,
+			      test_task_run, NULL, CONFIG_CORE_COUNT, 0);
+
+	assert_int_equal(schedule_task(&task, 0, 1000), -EINVAL);
+	assert_int_equal(schedule_task_cancel(&task), -EINVAL);
+	assert_int_equal(schedule_task_free(&task), -EINVAL);
+}
+
+static int setup_group(void **state)
+{
+	struct ll_schedule_domain domain;
+
+	(void)state;
+
+	/* batch mode, the vcore threads run back to back ticks */
+	memset(&domain, 0, sizeof(domain));
+	setenv("SOF_HOST_WORK_STEALING", "1", 1);
+	sof_get()->ipc = &test_ipc;
+	list_init(&test_ipc.comp_list);
+
+	return scheduler_init_ll(&domain);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_ll_schedule_steal),
+		cmocka_unit_test(test_ll_schedule_steal_connected),
+		cmocka_unit_test(test_ll_schedule_invalid_core),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup_group, NULL);
+}
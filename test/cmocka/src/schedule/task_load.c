@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <sof/common.h>
+#include <sof/schedule/task_load.h>
+#include <sof/schedule/task.h>
+
+#define TASK_LOAD_TEST_RUNS	10000
+
+static struct task test_task;
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static void test_task_load_empty(void **state)
+{
+	struct task_load load;
+
+	(void)state;
+
+	task_load_init(&load, &test_task);
+
+	assert_int_equal(load.runs, 0);
+	assert_int_equal(task_load_percentile(&load, 500), 0);
+	assert_int_equal(task_load_percentile(&load, 999), 0);
+}
+
+static void test_task_load_small(void **state)
+{
+	struct task_load load;
+	uint32_t i;
+
+	(void)state;
+
+	task_load_init(&load, &test_task);
+
+	/* run times below the sub bucket count are exact */
+	for (i = 0; i < TASK_LOAD_SUB_BUCKETS; i++)
+		task_load_add(&load, i);
+
+	assert_int_equal(load.runs, TASK_LOAD_SUB_BUCKETS);
+	assert_int_equal(task_load_percentile(&load, 250), 0);
+	assert_int_equal(task_load_percentile(&load, 500), 1);
+	assert_int_equal(task_load_percentile(&load, 1000), TASK_LOAD_SUB_BUCKETS - 1);
+}
+
+/* the percentiles are upper bounds within a sub bucket of the exact ones */
+static void test_task_load_percentiles(void **state)
+{
+	static const uint32_t permille[] = {0, 10, 500, 900, 990, 999, 1000};
+	uint32_t *times = test_malloc(TASK_LOAD_TEST_RUNS * sizeof(*times));
+	struct task_load load;
+	uint32_t exact;
+	uint32_t value;
+	uint32_t n;
+	unsigned int i;
+
+	(void)state;
+
+	srand(1);
+	task_load_init(&load, &test_task);
+
+	/* mostly short runs with a long tail, over several decades */
+	for (i = 0; i < TASK_LOAD_TEST_RUNS; i++) {
+		times[i] = (uint32_t)rand() % 1000 + 10000;
+		if (!(i % 50))
+			times[i] <<= rand() % 16;
+		task_load_add(&load, times[i]);
+	}
+
+	qsort(times, TASK_LOAD_TEST_RUNS, sizeof(*times), cmp_u32);
+
+	assert_int_equal(load.runs, TASK_LOAD_TEST_RUNS);
+	assert_int_equal(load.max, times[TASK_LOAD_TEST_RUNS - 1]);
+
+	for (i = 0; i < ARRAY_SIZE(permille); i++) {
+		n = ((uint64_t)TASK_LOAD_TEST_RUNS * permille[i] + 999) / 1000;
+		exact = times[n ? n - 1 : 0];
+		value = task_load_percentile(&load, permille[i]);
+
+		assert_true(value >= exact);
+		assert_true(value - exact <= exact / TASK_LOAD_SUB_BUCKETS);
+	}
+
+	test_free(times);
+}
+
+static void test_task_load_overruns(void **state)
+{
+	struct task_load load;
+
+	(void)state;
+
+	task_load_init(&load, &test_task);
+
+	/* no budget, no overruns */
+	task_load_add(&load, 1000);
+	assert_int_equal(load.overruns, 0);
+
+	load.budget = 100;
+	task_load_add(&load, 50);
+	task_load_add(&load, 100);
+	task_load_add(&load, 101);
+	task_load_add(&load, UINT32_MAX);
+
+	assert_int_equal(load.overruns, 2);
+	assert_int_equal(load.max, UINT32_MAX);
+	assert_int_equal(task_load_percentile(&load, 1000), UINT32_MAX);
+}
+
+/* a full histogram is halved instead of wrapping */
+static void test_task_load_saturate(void **state)
+{
+	struct task_load load;
+	uint32_t p50;
+	int i;
+
+	(void)state;
+
+	task_load_init(&load, &test_task);
+	task_load_add(&load, 1000);
+	task_load_add(&load, 100000);
+	p50 = task_load_percentile(&load, 500);
+
+	load.runs = UINT32_MAX;
+	for (i = 0; i < TASK_LOAD_BUCKETS; i++)
+		if (load.hist[i])
+			load.hist[i] = UINT32_MAX / 2;
+
+	task_load_add(&load, 1000);
+
+	assert_int_equal(load.runs, 2 * (UINT32_MAX / 4) + 1);
+	assert_int_equal(task_load_percentile(&load, 500), p50);
+	assert_int_equal(task_load_percentile(&load, 1000), 100000);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_task_load_empty),
+		cmocka_unit_test(test_task_load_small),
+		cmocka_unit_test(test_task_load_percentiles),
+		cmocka_unit_test(test_task_load_overruns),
+		cmocka_unit_test(test_task_load_saturate),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -110,6 +110,62 @@ static void ipc_dump_err(struct ipc_msg *msg)
 		msg->header, msg->msg_size, msg->reply_size);
 }
 
+/*
+ * Read the topology file into memory. It is parsed from there in place, the
+ * same way as a topology passed in memory by a fuzzing engine would be.
+ */
+static int fuzzer_read_topology(const char *file, void **data, size_t *size)
+{
+	FILE *fp;
+	long len;
+	int ret = 0;
+
+	*data = NULL;
+	*size = 0;
+
+	if (!file) {
+		fprintf(stderr, "error: no topology file specified\n");
+		return -EINVAL;
+	}
+
+	fp = fopen(file, "rb");
+	if (!fp) {
+		fprintf(stderr, "error: opening file %s\n", file);
+		return -errno;
+	}
+
+	len = fseek(fp, 0, SEEK_END) < 0 ? -1 : ftell(fp);
+	if (len < 0 || fseek(fp, 0, SEEK_SET) < 0) {
+		fprintf(stderr, "error: can't get size of file %s\n", file);
+		ret = -EIO;
+		goto out;
+	}
+
+	/* an empty topology has no objects */
+	if (!len)
+		goto out;
+
+	*data = malloc(len);
+	if (!*data) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (fread(*data, 1, len, fp) != (size_t)len) {
+		fprintf(stderr, "error: reading file %s\n", file);
+		free(*data);
+		*data = NULL;
+		ret = -EIO;
+		goto out;
+	}
+
+	*size = len;
+
+out:
+	fclose(fp);
+	return ret;
+}
+
 void *fuzzer_create_io_region(struct fuzz *fuzzer, int id, int idx)
 {
 	struct fuzz_platform *plat = fuzzer->platform;
@@ -289,6 +345,8 @@ int main(int argc, char *argv[])
 	char *platform_name = NULL;
 	int i;
 	struct tplg_context ctx;
+	void *tplg_data;
+	size_t tplg_size;
 
 	/* parse arguments */
 	while ((opt = getopt(argc, argv, "ht:p:")) != -1) {
@@ -344,11 +402,18 @@ int main(int argc, char *argv[])
 	/* allocate max ipc size bytes for the msg and reply */
 	fuzzer.msg.msg_data = malloc(SOF_IPC_MSG_MAX_SIZE);
 	fuzzer.msg.reply_data = malloc(SOF_IPC_MSG_MAX_SIZE);
+	memset(&ctx, 0, sizeof(ctx));
 	ctx.fuzzer = &fuzzer;
 	ctx.tplg_file = topology_file;
 
 	/* load topology */
+	ret = fuzzer_read_topology(topology_file, &tplg_data, &tplg_size);
+	if (ret < 0)
+		exit(EXIT_FAILURE);
+
+	tplg_set_data(&ctx, tplg_data, tplg_size);
 	ret = fuzzer_parse_topology(&ctx);
+	free(tplg_data);
 	if (ret < 0)
 		exit(EXIT_FAILURE);
 
@@ -107,8 +107,9 @@ static int fuzzer_complete_pipeline(struct fuzz *fuzzer, uint32_t comp_id)
 }
 
 /* load pipeline graph DAPM widget*/
-static int fuzzer_load_graph(void *dev, struct comp_info *temp_comp_list,
-		      int count, int num_comps, int pipeline_id)
+static int fuzzer_load_graph(void *dev, struct tplg_context *ctx,
+			     struct comp_info *temp_comp_list,
+			     int count, int num_comps, int pipeline_id)
 {
 	struct sof_ipc_pipe_comp_connect connection;
 	struct fuzz *fuzzer = (struct fuzz *)dev;
@@ -120,7 +121,7 @@ static int fuzzer_load_graph(void *dev, struct comp_info *temp_comp_list,
 	for (i = 0; i < count; i++) {
 		ret = tplg_create_graph(num_comps, pipeline_id, temp_comp_list,
 				      pipeline_string, &connection,
-				      fuzzer->tplg_file, i, count);
+				      ctx, i, count);
 		if (ret < 0)
 			return ret;
 
@@ -376,20 +377,11 @@ static int fuzzer_load_widget(struct tplg_context *ctx)
 		return -EINVAL;
 	}
 
-	/* allocate memory for widget */
+	/* get widget data */
 	ctx->widget_size = sizeof(struct snd_soc_tplg_dapm_widget);
-	ctx->widget = malloc(ctx->widget_size);
-	if (!ctx->widget) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
-	/* read widget data */
-	ret = fread(ctx->widget, ctx->widget_size, 1, ctx->file);
-	if (ret != 1) {
-		ret = -EINVAL;
-		goto exit;
-	}
+	ctx->widget = tplg_get(ctx, ctx->widget_size);
+	if (!ctx->widget)
+		return -EINVAL;
 
 	/*
 	 * create a list with all widget info
@@ -491,14 +483,14 @@ static int fuzzer_load_widget(struct tplg_context *ctx)
 		break;
 	/* unsupported widgets */
 	default:
-		if (fseek(ctx->file, ctx->widget->priv.size, SEEK_CUR)) {
-			fprintf(stderr, "error: fseek unsupported widget\n");
-			ret = -errno;
+		if (tplg_skip(ctx, ctx->widget->priv.size)) {
+			fprintf(stderr, "error: skip unsupported widget\n");
+			ret = -EINVAL;
 			goto exit;
 		}
 
 		printf("info: Widget type not supported %d\n", ctx->widget->id);
-		ret = tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, NULL, 0);
+		ret = tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0);
 		if (ret < 0) {
 			fprintf(stderr, "error: loading controls\n");
 			goto exit;
@@ -510,8 +502,6 @@ static int fuzzer_load_widget(struct tplg_context *ctx)
 	ret = 1;
 
 exit:
-	/* free allocated widget data */
-	free(ctx->widget);
 	return ret;
 }
 
@@ -524,44 +514,21 @@ int fuzzer_parse_topology(struct tplg_context *ctx)
 	char message[DEBUG_MSG_LEN];
 	int num_comps = 0;
 	int i, ret = 0;
-	size_t file_size, size;
-
-	/* open topology file */
-	ctx->file = fopen(ctx->tplg_file, "rb");
-	if (!ctx->file) {
-		fprintf(stderr, "error: opening file %s\n", ctx->tplg_file);
-		return -errno;
-	}
-	fuzzer->tplg_file = ctx->file;
+	size_t size;
 
-	/* file size */
-	if (fseek(ctx->file, 0, SEEK_END)) {
-		fprintf(stderr, "error: seek to end of topology\n");
-		fclose(ctx->file);
-		return -errno;
-	}
-	file_size = ftell(ctx->file);
-	if (fseek(ctx->file, 0, SEEK_SET)) {
-		fprintf(stderr, "error: seek to beginning of topology\n");
-		fclose(ctx->file);
-		return -errno;
-	}
-
-	/* allocate memory */
-	size = sizeof(struct snd_soc_tplg_hdr);
-	hdr = (struct snd_soc_tplg_hdr *)malloc(size);
-	if (!hdr) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -EINVAL;
+	/* map topology file, unless the topology is already in memory */
+	if (!ctx->tplg_data) {
+		ret = tplg_open_file(ctx);
+		if (ret < 0)
+			return ret;
 	}
 
 	fprintf(stdout, "debug: %s", "topology parsing start\n");
 
 	while (1) {
-		/* read topology header */
-		ret = fread(hdr, sizeof(struct snd_soc_tplg_hdr), 1,
-			    fuzzer->tplg_file);
-		if (ret != 1)
+		/* get topology header */
+		hdr = tplg_get(ctx, sizeof(*hdr));
+		if (!hdr)
 			return -EINVAL;
 
 		sprintf(message, "type: %x, size: 0x%x count: %d index: %d\n",
@@ -604,17 +571,18 @@ int fuzzer_parse_topology(struct tplg_context *ctx)
 
 		/* set up component connections from pipeline graph */
 		case SND_SOC_TPLG_TYPE_DAPM_GRAPH:
-			if (fuzzer_load_graph(fuzzer, comp_list_realloc, hdr->count,
-				       num_comps, hdr->index) < 0) {
+			if (fuzzer_load_graph(fuzzer, ctx, comp_list_realloc, hdr->count,
+					      num_comps, hdr->index) < 0) {
 				fprintf(stderr, "error: pipeline graph\n");
 				return -EINVAL;
 			}
-			if (ftell(fuzzer->tplg_file) == file_size)
+			if (tplg_is_end(ctx))
 				goto finish;
 			break;
 		default:
-			fseek(fuzzer->tplg_file, hdr->payload_size, SEEK_CUR);
-			if (ftell(fuzzer->tplg_file) == file_size)
+			if (tplg_skip(ctx, hdr->payload_size))
+				return -EINVAL;
+			if (tplg_is_end(ctx))
 				goto finish;
 			break;
 		}
@@ -628,12 +596,10 @@ finish:
 	fprintf(stdout, "debug: %s", "topology parsing end\n");
 
 	/* free all data */
-	free(hdr);
-
 	for (i = 0; i < num_comps; i++)
 		free(comp_list_realloc[i].name);
 
 	free(comp_list_realloc);
-	fclose(fuzzer->tplg_file);
+	tplg_close_file(ctx);
 	return 0;
 }
@@ -57,7 +57,6 @@ struct testbench_prm {
 	int tick_period_us;
 	int pipeline_duration_ms;
 	int real_time;
-	FILE *file;
 	char *pipeline_string;
 	int output_file_index;
 	int input_file_index;
@@ -9,12 +9,15 @@
 #include <sof/ipc/driver.h>
 #include <sof/ipc/topology.h>
 #include <sof/list.h>
+#include <sof/schedule/ll_schedule.h>
+#include <sof/schedule/task_load.h>
 #include <getopt.h>
 #include <dlfcn.h>
 #include "testbench/common_test.h"
 #include <tplg_parser/topology.h>
 #include "testbench/trace.h"
 #include "testbench/file.h"
+#include <inttypes.h>
 #include <limits.h>
 #include <stdlib.h>
 
@@ -258,6 +261,7 @@ static void print_usage(char *executable)
 	printf("  -R <output rate>\n\n");
 	printf("Environment variables\n");
 	printf("  SOF_HOST_CORE0=<i> - Map DSP core 0..N to host i..i+N\n");
+	printf("  SOF_HOST_WORK_STEALING=1 - Let idle cores run independent pipelines\n");
 	printf("Help:\n");
 	printf("  -h\n\n");
 	printf("Example Usage:\n");
@@ -394,6 +398,21 @@ static void test_pipeline_get_file_stats(int pipeline_id)
 	}
 }
 
+static void test_pipeline_get_task_load(struct pipeline *p)
+{
+	struct task_load *load = schedule_ll_task_load(p->pipe_task);
+
+	if (!load || !load->runs)
+		return;
+
+	printf("pipeline %d: task runs %u p50 %u ns p99 %u ns p999 %u ns max %u ns\n",
+	       p->pipeline_id, load->runs, task_load_percentile(load, 500),
+	       task_load_percentile(load, 990), task_load_percentile(load, 999),
+	       load->max);
+	printf("pipeline %d: task budget %u ns overruns %u\n",
+	       p->pipeline_id, load->budget, load->overruns);
+}
+
 static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 {
 	int option = 0;
@@ -643,13 +662,14 @@ static bool test_pipeline_check_state(struct pipeline_thread_data *ptdata, int s
 static int test_pipeline_load(struct pipeline_thread_data *ptdata, struct tplg_context *ctx)
 {
 	struct testbench_prm *tp = ptdata->tp;
+	struct timespec td0, td1;
+	uint64_t delta;
 	int ret;
 
 	/* setup the thread virtual core config */
 	memset(ctx, 0, sizeof(*ctx));
 	ctx->comp_id = 1000 * ptdata->core_id;
 	ctx->core_id = ptdata->core_id;
-	ctx->file = tp->file;
 	ctx->sof = sof_get();
 	ctx->tp = tp;
 	ctx->tplg_file = tp->tplg_file;
@@ -660,9 +680,17 @@ static int test_pipeline_load(struct pipeline_thread_data *ptdata, struct tplg_c
 	ctx->frame_fmt = tp->cmd_frame_fmt;
 
 	/* parse topology file and create pipeline */
+	clock_gettime(CLOCK_MONOTONIC, &td0);
 	ret = parse_topology(ctx);
-	if (ret < 0)
+	clock_gettime(CLOCK_MONOTONIC, &td1);
+	if (ret < 0) {
 		fprintf(stderr, "error: parsing topology\n");
+		return ret;
+	}
+
+	delta = (td1.tv_sec - td0.tv_sec) * 1000000;
+	delta += (td1.tv_nsec - td0.tv_nsec) / 1000;
+	printf("Topology parse time: %" PRIu64 " us\n", delta);
 
 	return ret;
 }
@@ -721,6 +749,7 @@ static void test_pipeline_stats(struct pipeline_thread_data *ptdata,
 	printf("Test Pipeline:\n");
 	printf("%s\n", tp->pipeline_string);
 	test_pipeline_get_file_stats(ctx->pipeline_id);
+	test_pipeline_get_task_load(p);
 
 	printf("Input bit format: %s\n", tp->bits_in);
 	printf("Input sample rate: %d\n", ctx->fs_in);
@@ -149,7 +149,7 @@ int tplg_register_buffer(struct tplg_context *ctx)
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, NULL, 0) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -165,7 +165,7 @@ int tplg_register_buffer(struct tplg_context *ctx)
 
 /* load pipeline graph DAPM widget*/
 int tplg_register_graph(void *dev, struct comp_info *temp_comp_list,
-			char *pipeline_string, FILE *file,
+			char *pipeline_string, struct tplg_context *ctx,
 			int count, int num_comps, int pipeline_id)
 {
 	struct sof_ipc_pipe_comp_connect connection;
@@ -175,7 +175,7 @@ int tplg_register_graph(void *dev, struct comp_info *temp_comp_list,
 
 	for (i = 0; i < count; i++) {
 		ret = tplg_create_graph(num_comps, pipeline_id, temp_comp_list,
-				      pipeline_string, &connection, file, i,
+				      pipeline_string, &connection, ctx, i,
 				      count);
 		if (ret < 0)
 			return ret;
@@ -257,14 +257,13 @@ int tplg_register_pipeline(struct tplg_context *ctx)
 {
 	struct sof *sof = ctx->sof;
 	struct sof_ipc_pipe_new pipeline = {0};
-	FILE *file = ctx->file;
 	int ret;
 
 	ret = tplg_create_pipeline(ctx, &pipeline);
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, file, NULL, 0) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -310,7 +309,7 @@ int load_process(struct tplg_context *ctx)
 
 	/* Get control into ctl and priv_data */
 	for (i = 0; i < widget->num_kcontrols; i++) {
-		ret = tplg_create_single_control(&ctl, &priv_data, ctx->file);
+		ret = tplg_create_single_control(&ctl, &priv_data, ctx);
 
 		if (ret < 0) {
 			fprintf(stderr, "error: failed control load\n");
@@ -321,8 +320,6 @@ int load_process(struct tplg_context *ctx)
 		if (priv_data)
 			ret = tplg_process_append_data(&process_ipc, process, ctl, priv_data);
 
-		free(ctl);
-		free(priv_data);
 		if (ret) {
 			fprintf(stderr, "error: private data append failed\n");
 			free(process_ipc);
@@ -404,20 +401,11 @@ int load_widget(struct tplg_context *ctx)
 		return -EINVAL;
 	}
 
-	/* allocate memory for widget */
+	/* get widget data */
 	ctx->widget_size = sizeof(struct snd_soc_tplg_dapm_widget);
-	ctx->widget = malloc(ctx->widget_size);
-	if (!ctx->widget) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
-	/* read widget data */
-	ret = fread(ctx->widget, ctx->widget_size, 1, ctx->file);
-	if (ret != 1) {
-		ret = -EINVAL;
-		goto exit;
-	}
+	ctx->widget = tplg_get(ctx, ctx->widget_size);
+	if (!ctx->widget)
+		return -EINVAL;
 
 	/*
 	 * create a list with all widget info
@@ -521,14 +509,14 @@ int load_widget(struct tplg_context *ctx)
 		break;
 	/* unsupported widgets */
 	default:
-		if (fseek(ctx->file, ctx->widget->priv.size, SEEK_CUR)) {
-			fprintf(stderr, "error: fseek unsupported widget\n");
-			ret = -errno;
+		if (tplg_skip(ctx, ctx->widget->priv.size)) {
+			fprintf(stderr, "error: skip unsupported widget\n");
+			ret = -EINVAL;
 			goto exit;
 		}
 
 		printf("info: Widget type not supported %d\n", ctx->widget->id);
-		ret = tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, NULL, 0);
+		ret = tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0);
 		if (ret < 0) {
 			fprintf(stderr, "error: loading controls\n");
 			goto exit;
@@ -540,8 +528,6 @@ int load_widget(struct tplg_context *ctx)
 	ret = 1;
 
 exit:
-	/* free allocated widget data */
-	free(ctx->widget);
 	return ret;
 }
 
@@ -551,38 +537,30 @@ static int tplg_load_fileread(struct tplg_context *ctx,
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
 	size_t total_array_size = 0;
-	size_t read_size;
-	FILE *file = ctx->file;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	int ret;
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array) {
 			fprintf(stderr,
-				"error: fread failed during load_fileread\n");
-			free(array);
+				"error: read failed during load_fileread\n");
 			return -EINVAL;
 		}
 
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: filewrite array size mismatch for widget size %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
-		tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
+		if (ret) {
+			fprintf(stderr, "error: read array fail\n");
+			return ret;
+		}
 
 		/* parse comp tokens */
 		ret = sof_parse_tokens(&fileread->config, comp_tokens,
@@ -591,15 +569,12 @@ static int tplg_load_fileread(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse comp tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
 		total_array_size += array->size;
 	}
 
-	free(array);
-
 	/* configure fileread */
 	fileread->mode = FILE_READ;
 	fileread->comp.id = comp_id;
@@ -618,36 +593,27 @@ static int tplg_load_filewrite(struct tplg_context *ctx,
 			       struct sof_ipc_comp_file *filewrite)
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
-	size_t read_size;
 	size_t total_array_size = 0;
-	FILE *file = ctx->file;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	int ret;
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(array);
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: filewrite array size mismatch\n");
-			free(array);
 			return -EINVAL;
 		}
 
-		tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
+		if (ret) {
+			fprintf(stderr, "error: read array fail\n");
+			return ret;
+		}
 
 		ret = sof_parse_tokens(&filewrite->config, comp_tokens,
 				       ARRAY_SIZE(comp_tokens), array,
@@ -655,14 +621,11 @@ static int tplg_load_filewrite(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse filewrite tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 		total_array_size += array->size;
 	}
 
-	free(array);
-
 	/* configure filewrite */
 	filewrite->comp.core = ctx->core_id;
 	filewrite->comp.id = comp_id;
@@ -679,7 +642,6 @@ static int load_fileread(struct tplg_context *ctx, int dir)
 {
 	struct sof *sof = ctx->sof;
 	struct testbench_prm *tp = ctx->tp;
-	FILE *file = ctx->file;
 	struct sof_ipc_comp_file fileread = {0};
 	int ret;
 
@@ -689,7 +651,7 @@ static int load_fileread(struct tplg_context *ctx, int dir)
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, file, NULL, 0) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -729,7 +691,6 @@ static int load_filewrite(struct tplg_context *ctx, int dir)
 {
 	struct sof *sof = ctx->sof;
 	struct testbench_prm *tp = ctx->tp;
-	FILE *file = ctx->file;
 	struct sof_ipc_comp_file filewrite = {0};
 	int ret;
 
@@ -737,7 +698,7 @@ static int load_filewrite(struct tplg_context *ctx, int dir)
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, file, NULL, 0) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, NULL, 0) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -790,14 +751,14 @@ int load_dai_in_out(struct tplg_context *ctx, int dir)
 		return load_fileread(ctx, dir);
 }
 
-static int get_next_hdr(struct tplg_context *ctx, struct snd_soc_tplg_hdr *hdr, size_t file_size)
+static int get_next_hdr(struct tplg_context *ctx, struct snd_soc_tplg_hdr *hdr)
 {
-	if (fseek(ctx->file, hdr->payload_size, SEEK_CUR)) {
-		fprintf(stderr, "error: fseek payload size\n");
-		return -errno;
+	if (tplg_skip(ctx, hdr->payload_size)) {
+		fprintf(stderr, "error: skip payload size\n");
+		return -EINVAL;
 	}
 
-	if (ftell(ctx->file) == file_size)
+	if (tplg_is_end(ctx))
 		return 0;
 
 	return 1;
@@ -813,50 +774,29 @@ int parse_topology(struct tplg_context *ctx)
 	int i;
 	int next;
 	int ret = 0;
-	size_t file_size;
 	size_t size;
 	bool pipeline_match;
 
 	/* initialize output file index */
 	tp->output_file_index = 0;
 
-	/* open topology file */
-	ctx->file = fopen(ctx->tplg_file, "rb");
-	if (!ctx->file) {
-		fprintf(stderr, "error: opening file %s\n", ctx->tplg_file);
-		fprintf(stderr, "error: %s\n", strerror(errno));
-		return -errno;
-	}
-	tp->file = ctx->file; /* duplicated until we can merge tp with ctx */
-
-	/* file size */
-	if (fseek(ctx->file, 0, SEEK_END)) {
-		fprintf(stderr, "error: seek to end of topology\n");
-		fclose(ctx->file);
-		return -errno;
-	}
-	file_size = ftell(ctx->file);
-	if (fseek(ctx->file, 0, SEEK_SET)) {
-		fprintf(stderr, "error: seek to beginning of topology\n");
-		fclose(ctx->file);
-		return -errno;
-	}
-
-	/* allocate memory */
-	size = sizeof(struct snd_soc_tplg_hdr);
-	hdr = (struct snd_soc_tplg_hdr *)malloc(size);
-	if (!hdr) {
-		fprintf(stderr, "error: mem alloc\n");
-		fclose(ctx->file);
-		return -errno;
+	/* map topology file, unless the topology is already in memory */
+	if (!ctx->tplg_data) {
+		ret = tplg_open_file(ctx);
+		if (ret < 0) {
+			fprintf(stderr, "error: %s\n", strerror(-ret));
+			return ret;
+		}
 	}
 
 	debug_print("topology parsing start\n");
 	while (1) {
-		/* read topology header */
-		ret = fread(hdr, sizeof(struct snd_soc_tplg_hdr), 1, ctx->file);
-		if (ret != 1)
+		/* get topology header */
+		hdr = tplg_get(ctx, sizeof(*hdr));
+		if (!hdr) {
+			ret = 0;
 			goto out;
+		}
 
 		sprintf(message, "type: %x, size: 0x%x count: %d index: %d\n",
 			hdr->type, hdr->payload_size, hdr->count, hdr->index);
@@ -876,7 +816,7 @@ int parse_topology(struct tplg_context *ctx)
 		if (!pipeline_match) {
 			sprintf(message, "skipped pipeline %d\n", hdr->index);
 			debug_print(message);
-			next = get_next_hdr(ctx, hdr, file_size);
+			next = get_next_hdr(ctx, hdr);
 			if (next < 0)
 				goto out;
 			else if (next > 0)
@@ -932,19 +872,19 @@ int parse_topology(struct tplg_context *ctx)
 		case SND_SOC_TPLG_TYPE_DAPM_GRAPH:
 			if (tplg_register_graph(ctx->sof, ctx->info,
 						tp->pipeline_string,
-						tp->file, hdr->count,
+						ctx, hdr->count,
 						ctx->comp_id,
 						hdr->index) < 0) {
 				fprintf(stderr, "error: pipeline graph\n");
 				ret = -EINVAL;
 				goto out;
 			}
-			if (ftell(ctx->file) == file_size)
+			if (tplg_is_end(ctx))
 				goto finish;
 			break;
 
 		default:
-			next = get_next_hdr(ctx, hdr, file_size);
+			next = get_next_hdr(ctx, hdr);
 			if (next < 0)
 				goto out;
 			else if (next == 0)
@@ -957,12 +897,10 @@ finish:
 
 out:
 	/* free all data */
-	free(hdr);
-
 	for (i = 0; i < ctx->info_elems; i++)
 		free(ctx->info[i].name);
 
 	free(ctx->info);
-	fclose(ctx->file);
+	tplg_close_file(ctx);
 	return ret;
 }
@@ -42,42 +42,29 @@ int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc,
 		     size_t max_comp_size)
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
-	size_t total_array_size = 0, read_size;
-	FILE *file = ctx->file;
+	size_t total_array_size = 0;
 	int ret, comp_id = ctx->comp_id;
 	int size = ctx->widget_size;
 	char uuid[UUID_SIZE];
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc for asrc vendor array\n");
-		return -errno;
-	}
-
 	if (max_comp_size < sizeof(struct sof_ipc_comp_asrc) + UUID_SIZE)
 		return -EINVAL;
 
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: load asrc array size mismatch\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return ret;
 		}
 
@@ -88,7 +75,6 @@ int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse asrc comp_tokens %d\n",
 				size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -98,7 +84,6 @@ int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc,
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse asrc tokens %d\n", size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -108,19 +93,12 @@ int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc,
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse asrc uuid token %d\n", size);
-			free(array);
 			return -EINVAL;
 		}
 
 		total_array_size += array->size;
-
-		/* read next array */
-		array = MOVE_POINTER_BY_BYTES(array, array->size);
 	}
 
-	/* point to the start of array so it gets freed properly */
-	array = MOVE_POINTER_BY_BYTES(array, -total_array_size);
-
 	/* configure asrc */
 	asrc->comp.hdr.cmd = SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_NEW;
 	asrc->comp.id = comp_id;
@@ -131,7 +109,6 @@ int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc,
 	asrc->config.hdr.size = sizeof(struct sof_ipc_comp_config);
 	memcpy(asrc + 1, &uuid, UUID_SIZE);
 
-	free(array);
 	return 0;
 }
 
@@ -146,7 +123,7 @@ int tplg_new_asrc(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t co
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, rctl, max_ctl_size) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, rctl, max_ctl_size) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -40,9 +40,7 @@ int tplg_create_buffer(struct tplg_context *ctx,
 		     struct sof_ipc_buffer *buffer)
 {
 	struct snd_soc_tplg_vendor_array *array;
-	size_t read_size;
 	size_t parsed_size = 0;
-	FILE *file = ctx->file;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	int ret;
@@ -55,35 +53,24 @@ int tplg_create_buffer(struct tplg_context *ctx,
 	buffer->comp.type = SOF_COMP_BUFFER;
 	buffer->comp.hdr.size = sizeof(struct sof_ipc_buffer);
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: malloc fail during load_buffer\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (parsed_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array) {
 			fprintf(stderr,
-				"error: fread fail during load_buffer\n");
-			free(array);
+				"error: read fail during load_buffer\n");
 			return -EINVAL;
 		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(parsed_size, size, array)) {
 			fprintf(stderr, "error: load buffer array size mismatch\n");
-			free(array);
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(array);
 			return ret;
 		}
 
@@ -94,7 +81,6 @@ int tplg_create_buffer(struct tplg_context *ctx,
 		if (ret) {
 			fprintf(stderr, "error: parse buffer comp tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
@@ -105,14 +91,12 @@ int tplg_create_buffer(struct tplg_context *ctx,
 		if (ret) {
 			fprintf(stderr, "error: parse buffer tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
 		parsed_size += array->size;
 	}
 
-	free(array);
 	return 0;
 }
 
@@ -126,7 +110,7 @@ int tplg_new_buffer(struct tplg_context *ctx, struct sof_ipc_buffer *buffer,
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, rctl, 0) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, rctl, 0) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
@@ -35,8 +35,7 @@ static const struct sof_topology_token dai_tokens[] = {
 int tplg_create_dai(struct tplg_context *ctx, struct sof_ipc_comp_dai *comp_dai)
 {
 	struct snd_soc_tplg_vendor_array *array;
-	size_t total_array_size = 0, read_size;
-	FILE *file = ctx->file;
+	size_t total_array_size = 0;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	int ret;
@@ -49,33 +48,21 @@ int tplg_create_dai(struct tplg_context *ctx, struct sof_ipc_comp_dai *comp_dai)
 	comp_dai->comp.pipeline_id = ctx->pipeline_id;
 	comp_dai->config.hdr.size = sizeof(comp_dai->config);
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(array);
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: load dai array size mismatch\n");
-			free(array);
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(array);
 			return ret;
 		}
 
@@ -85,7 +72,6 @@ int tplg_create_dai(struct tplg_context *ctx, struct sof_ipc_comp_dai *comp_dai)
 		if (ret != 0) {
 			fprintf(stderr, "error: parse dai tokens failed %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
@@ -96,13 +82,11 @@ int tplg_create_dai(struct tplg_context *ctx, struct sof_ipc_comp_dai *comp_dai)
 		if (ret != 0) {
 			fprintf(stderr, "error: parse filewrite tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 		total_array_size += array->size;
 	}
 
-	free(array);
 	return 0;
 }
 
@@ -77,8 +77,13 @@ struct tplg_context {
 	uint32_t channels_out;
 	enum sof_ipc_frame frame_fmt;
 
+	/* topology data parsed in place and the parse position in it */
+	const void *tplg_data;
+	size_t tplg_size;
+	size_t tplg_offset;
+	bool tplg_mapped;
+
 	/* global data */
-	FILE *file;
 	struct testbench_prm *tp;
 	struct sof *sof;
 	const char *tplg_file;
@@ -98,6 +103,20 @@ enum sof_ipc_process_type {
 	SOF_PROCESS_DCBLOCK,
 };
 
+/*
+ * The topology is parsed in place from a read only view of its data, a
+ * mapped topology file or a blob in memory. The objects got from the view
+ * are not copied and stay valid until tplg_close_file().
+ */
+int tplg_open_file(struct tplg_context *ctx);
+void tplg_close_file(struct tplg_context *ctx);
+void tplg_set_data(struct tplg_context *ctx, const void *data, size_t size);
+
+/* object at the parse position, which is moved past it */
+void *tplg_get(struct tplg_context *ctx, size_t size);
+int tplg_skip(struct tplg_context *ctx, size_t size);
+bool tplg_is_end(struct tplg_context *ctx);
+
 enum sof_ipc_frame find_format(const char *name);
 
 int get_token_uint32_t(void *elem, void *object, uint32_t offset,
@@ -154,7 +173,7 @@ int tplg_process_append_data(struct sof_ipc_comp_process **process_ipc,
 int tplg_process_init_data(struct sof_ipc_comp_process **process_ipc,
 			     struct sof_ipc_comp_process *process);
 
-int tplg_read_array(struct snd_soc_tplg_vendor_array *array, FILE *file);
+int tplg_read_array(struct snd_soc_tplg_vendor_array *array, struct tplg_context *ctx);
 int tplg_create_buffer(struct tplg_context *ctx,
 		     struct sof_ipc_buffer *buffer);
 int tplg_new_buffer(struct tplg_context *ctx, struct sof_ipc_buffer *buffer,
@@ -171,9 +190,9 @@ int tplg_new_pipeline(struct tplg_context *ctx, struct sof_ipc_pipe_new *pipelin
 		struct snd_soc_tplg_ctl_hdr *rctl);
 
 int tplg_create_single_control(struct snd_soc_tplg_ctl_hdr **ctl, char **priv,
-			  FILE *file);
-int tplg_create_controls(int num_kcontrols, FILE *file, struct snd_soc_tplg_ctl_hdr *rctl,
-		size_t max_ctl_size);
+			  struct tplg_context *ctx);
+int tplg_create_controls(int num_kcontrols, struct tplg_context *ctx,
+			 struct snd_soc_tplg_ctl_hdr *rctl, size_t max_ctl_size);
 
 int tplg_create_src(struct tplg_context *ctx,
 		  struct sof_ipc_comp_src *src, size_t max_comp_size);
@@ -195,8 +214,8 @@ int tplg_new_process(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t
 
 int tplg_create_graph(int num_comps, int pipeline_id,
 		    struct comp_info *temp_comp_list, char *pipeline_string,
-		    struct sof_ipc_pipe_comp_connect *connection, FILE *file,
-		    int route_num, int count);
+		    struct sof_ipc_pipe_comp_connect *connection,
+		    struct tplg_context *ctx, int route_num, int count);
 
 int tplg_new_pga(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t comp_size,
 		struct snd_soc_tplg_ctl_hdr *rctl, size_t ctl_size);
@@ -216,7 +235,7 @@ int tplg_new_mixer(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t c
 		struct snd_soc_tplg_ctl_hdr *rctl, size_t max_ctl_size);
 
 int tplg_register_graph(void *dev, struct comp_info *temp_comp_list,
-			char *pipeline_string, FILE *file,
+			char *pipeline_string, struct tplg_context *ctx,
 			int count, int num_comps, int pipeline_id);
 int load_process(struct tplg_context *ctx);
 int load_widget(struct tplg_context *ctx);
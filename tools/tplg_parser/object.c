@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/* Topology parser */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tplg_parser/topology.h>
+
+/* map the topology file read only, it is parsed in place */
+int tplg_open_file(struct tplg_context *ctx)
+{
+	struct stat st;
+	void *data;
+	int ret;
+	int fd;
+
+	fd = open(ctx->tplg_file, O_RDONLY);
+	if (fd < 0) {
+		ret = -errno;
+		fprintf(stderr, "error: opening file %s\n", ctx->tplg_file);
+		return ret;
+	}
+
+	if (fstat(fd, &st) < 0) {
+		ret = -errno;
+		fprintf(stderr, "error: can't get size of file %s\n", ctx->tplg_file);
+		close(fd);
+		return ret;
+	}
+
+	/* nothing to map, an empty topology has no objects */
+	if (!st.st_size) {
+		close(fd);
+		tplg_set_data(ctx, NULL, 0);
+		return 0;
+	}
+
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	ret = -errno;
+	close(fd);
+	if (data == MAP_FAILED) {
+		fprintf(stderr, "error: mapping file %s\n", ctx->tplg_file);
+		return ret;
+	}
+
+	tplg_set_data(ctx, data, st.st_size);
+	ctx->tplg_mapped = true;
+
+	return 0;
+}
+
+void tplg_close_file(struct tplg_context *ctx)
+{
+	if (ctx->tplg_mapped)
+		munmap((void *)ctx->tplg_data, ctx->tplg_size);
+
+	tplg_set_data(ctx, NULL, 0);
+}
+
+/* parse a topology already in memory, e.g. embedded in the caller */
+void tplg_set_data(struct tplg_context *ctx, const void *data, size_t size)
+{
+	ctx->tplg_data = data;
+	ctx->tplg_size = size;
+	ctx->tplg_offset = 0;
+	ctx->tplg_mapped = false;
+}
+
+void *tplg_get(struct tplg_context *ctx, size_t size)
+{
+	void *obj;
+
+	if (size > ctx->tplg_size - ctx->tplg_offset)
+		return NULL;
+
+	obj = (void *)((const uint8_t *)ctx->tplg_data + ctx->tplg_offset);
+	ctx->tplg_offset += size;
+
+	return obj;
+}
+
+int tplg_skip(struct tplg_context *ctx, size_t size)
+{
+	return tplg_get(ctx, size) ? 0 : -EINVAL;
+}
+
+bool tplg_is_end(struct tplg_context *ctx)
+{
+	return ctx->tplg_offset == ctx->tplg_size;
+}
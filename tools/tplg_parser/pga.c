@@ -34,8 +34,7 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 		    size_t max_comp_size)
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
-	size_t total_array_size = 0, read_size;
-	FILE *file = ctx->file;
+	size_t total_array_size = 0;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	char uuid[UUID_SIZE];
@@ -44,33 +43,21 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 	if (max_comp_size < sizeof(struct sof_ipc_comp_volume) + UUID_SIZE)
 		return -EINVAL;
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(array);
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: pga array size mismatch\n");
-			free(array);
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(array);
 			return ret;
 		}
 
@@ -81,7 +68,6 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 		if (ret != 0) {
 			fprintf(stderr, "error: parse pga comp tokens %d\n",
 				size);
-			free(array);
 			return -EINVAL;
 		}
 
@@ -91,7 +77,6 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse src tokens %d\n", size);
-			free(array);
 			return -EINVAL;
 		}
 
@@ -101,7 +86,6 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse pga uuid token %d\n", size);
-			free(array);
 			return -EINVAL;
 		}
 
@@ -118,7 +102,6 @@ int tplg_create_pga(struct tplg_context *ctx, struct sof_ipc_comp_volume *volume
 	volume->config.hdr.size = sizeof(struct sof_ipc_comp_config);
 	memcpy(volume + 1, &uuid, UUID_SIZE);
 
-	free(array);
 	return 0;
 }
 
@@ -151,7 +134,7 @@ int tplg_new_pga(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t com
 
 	/* Get control into ctl and priv_data */
 	if (ctx->widget->num_kcontrols) {
-		ret = tplg_create_single_control(&ctl, &priv_data, ctx->file);
+		ret = tplg_create_single_control(&ctl, &priv_data, ctx);
 		if (ret < 0) {
 			fprintf(stderr, "error: failed control load\n");
 			goto err;
@@ -168,7 +151,7 @@ int tplg_new_pga(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t com
 		if (max_ctl_size && ctl->size > max_ctl_size) {
 			fprintf(stderr, "error: failed pga control copy\n");
 			ret = -EINVAL;
-			goto out;
+			goto err;
 		} else if (rctl)
 			memcpy(rctl, ctl, ctl->size);
 	}
@@ -179,10 +162,6 @@ int tplg_new_pga(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t com
 	volume->max_value = round(pow(10, vol_max_db / 20.0) * 65536);
 	volume->channels = channels;
 
-out:
-	free(ctl);
-	free(priv_data);
-
 err:
 	return ret;
 }
@@ -32,39 +32,25 @@ int tplg_create_process(struct tplg_context *ctx,
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
 	size_t total_array_size = 0;
-	size_t read_size;
-	FILE *file = ctx->file;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	int ret;
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc for asrc vendor array\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: load process array size mismatch\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return ret;
 		}
 
@@ -75,7 +61,6 @@ int tplg_create_process(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse process comp_tokens %d\n",
 				size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -86,7 +71,6 @@ int tplg_create_process(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse process tokens %d\n",
 				size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -98,19 +82,12 @@ int tplg_create_process(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse comp extended tokens %d\n",
 				size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
 		total_array_size += array->size;
-
-		/* read next array */
-		array = MOVE_POINTER_BY_BYTES(array, array->size);
 	}
 
-	/* point to the start of array so it gets freed properly */
-	array = MOVE_POINTER_BY_BYTES(array, -total_array_size);
-
 	/* configure asrc */
 	process->comp.hdr.cmd = SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_NEW;
 	process->comp.id = comp_id;
@@ -121,7 +98,6 @@ int tplg_create_process(struct tplg_context *ctx,
 	process->comp.ext_data_length = UUID_SIZE;
 	memcpy(process + 1, comp_ext, UUID_SIZE);
 
-	free(array);
 	return 0;
 }
 
@@ -196,7 +172,7 @@ int tplg_new_process(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t
 
 	/* Get control into ctl and priv_data */
 	for (i = 0; i < widget->num_kcontrols; i++) {
-		ret = tplg_create_single_control(&ctl, &priv_data, ctx->file);
+		ret = tplg_create_single_control(&ctl, &priv_data, ctx);
 
 		if (ret < 0) {
 			fprintf(stderr, "error: failed control load\n");
@@ -207,8 +183,6 @@ int tplg_new_process(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t
 		if (priv_data)
 			ret = tplg_process_append_data(&process_ipc, process, ctl, priv_data);
 
-		free(ctl);
-		free(priv_data);
 		if (ret) {
 			fprintf(stderr, "error: private data append failed\n");
 			free(process_ipc);
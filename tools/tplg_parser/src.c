@@ -33,8 +33,7 @@ int tplg_create_src(struct tplg_context *ctx,
 		  struct sof_ipc_comp_src *src, size_t max_comp_size)
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
-	size_t total_array_size = 0, read_size;
-	FILE *file = ctx->file;
+	size_t total_array_size = 0;
 	int size = ctx->widget->priv.size;
 	int comp_id = ctx->comp_id;
 	unsigned char uuid[UUID_SIZE];
@@ -43,33 +42,21 @@ int tplg_create_src(struct tplg_context *ctx,
 	if (max_comp_size < sizeof(struct sof_ipc_comp_src) + UUID_SIZE)
 		return -EINVAL;
 
-	/* allocate memory for vendor tuple array */
-	array = (struct snd_soc_tplg_vendor_array *)malloc(size);
-	if (!array) {
-		fprintf(stderr, "error: mem alloc for src vendor array\n");
-		return -errno;
-	}
-
 	/* read vendor tokens */
 	while (total_array_size < size) {
-		read_size = sizeof(struct snd_soc_tplg_vendor_array);
-		ret = fread(array, read_size, 1, file);
-		if (ret != 1) {
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
+		array = tplg_get(ctx, sizeof(*array));
+		if (!array)
 			return -EINVAL;
-		}
 
 		/* check for array size mismatch */
 		if (!is_valid_priv_size(total_array_size, size, array)) {
 			fprintf(stderr, "error: load src array size mismatch\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
-		ret = tplg_read_array(array, file);
+		ret = tplg_read_array(array, ctx);
 		if (ret) {
 			fprintf(stderr, "error: read array fail\n");
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return ret;
 		}
 
@@ -80,7 +67,6 @@ int tplg_create_src(struct tplg_context *ctx,
 		if (ret != 0) {
 			fprintf(stderr, "error: parse src comp_tokens %d\n",
 				size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -90,7 +76,6 @@ int tplg_create_src(struct tplg_context *ctx,
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse src tokens %d\n", size);
-			free(MOVE_POINTER_BY_BYTES(array, -total_array_size));
 			return -EINVAL;
 		}
 
@@ -100,19 +85,12 @@ int tplg_create_src(struct tplg_context *ctx,
 				       array->size);
 		if (ret != 0) {
 			fprintf(stderr, "error: parse src uuid token %d\n", size);
-			free(array);
 			return -EINVAL;
 		}
 
 		total_array_size += array->size;
-
-		/* read next array */
-		array = MOVE_POINTER_BY_BYTES(array, array->size);
 	}
 
-	/* point to the start of array so it gets freed properly */
-	array = MOVE_POINTER_BY_BYTES(array, -total_array_size);
-
 	/* configure src */
 	src->comp.hdr.cmd = SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_NEW;
 	src->comp.id = comp_id;
@@ -123,7 +101,6 @@ int tplg_create_src(struct tplg_context *ctx,
 	src->config.hdr.size = sizeof(struct sof_ipc_comp_config);
 	memcpy(src + 1, &uuid, UUID_SIZE);
 
-	free(array);
 	return 0;
 }
 
@@ -138,7 +115,7 @@ int tplg_new_src(struct tplg_context *ctx, struct sof_ipc_comp *comp, size_t com
 	if (ret < 0)
 		return ret;
 
-	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx->file, rctl, max_ctl_size) < 0) {
+	if (tplg_create_controls(ctx->widget->num_kcontrols, ctx, rctl, max_ctl_size) < 0) {
 		fprintf(stderr, "error: loading controls\n");
 		return -EINVAL;
 	}
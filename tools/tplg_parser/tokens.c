@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <errno.h>
 #include <string.h>
+#include <pthread.h>
 #include <ipc/topology.h>
 #include <sof/lib/uuid.h>
 #include <sof/ipc/topology.h>
@@ -95,6 +96,134 @@ int get_token_process_type(void *elem, void *object, uint32_t offset,
 	return 0;
 }
 
+/*
+ * The vendor tuples are looked up in an index of the token table sorted by
+ * tuple type and token id. The index of a table is built on its first use
+ * and kept while the parser is loaded, as the token tables are static. The
+ * indexes are only added to the hash, so it is read without the lock.
+ */
+#define TOKEN_INDEX_HASH_SIZE	64
+#define TOKEN_INDEX_SCAN_SIZE	8
+
+#define TOKEN_KEY(type, token)	((uint64_t)(type) << 32 | (token))
+
+struct token_index_entry {
+	uint64_t key;
+	const struct sof_topology_token *token;
+};
+
+struct token_index {
+	const struct sof_topology_token *tokens;
+	int count;
+	struct token_index *next;
+	struct token_index_entry entry[];
+};
+
+static struct token_index *token_index_hash[TOKEN_INDEX_HASH_SIZE];
+static pthread_mutex_t token_index_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* entries with the same key keep their table order, they are all loaded */
+static int token_index_cmp(const void *a, const void *b)
+{
+	const struct token_index_entry *ea = a;
+	const struct token_index_entry *eb = b;
+
+	if (ea->key != eb->key)
+		return ea->key < eb->key ? -1 : 1;
+
+	return ea->token < eb->token ? -1 : ea->token > eb->token;
+}
+
+static struct token_index *token_index_find(struct token_index *index,
+					    const struct sof_topology_token *tokens, int count)
+{
+	for (; index; index = index->next)
+		if (index->tokens == tokens && index->count == count)
+			return index;
+
+	return NULL;
+}
+
+static struct token_index *token_index_get(const struct sof_topology_token *tokens, int count)
+{
+	struct token_index **head;
+	struct token_index *index;
+	int i;
+
+	head = &token_index_hash[((uintptr_t)tokens >> 4) % TOKEN_INDEX_HASH_SIZE];
+
+	index = token_index_find(__atomic_load_n(head, __ATOMIC_ACQUIRE), tokens, count);
+	if (index)
+		return index;
+
+	pthread_mutex_lock(&token_index_lock);
+
+	/* another thread may have built it meanwhile */
+	index = token_index_find(*head, tokens, count);
+	if (index)
+		goto out;
+
+	index = malloc(sizeof(*index) + count * sizeof(index->entry[0]));
+	if (!index) {
+		fprintf(stderr, "error: mem alloc\n");
+		goto out;
+	}
+
+	index->tokens = tokens;
+	index->count = count;
+	for (i = 0; i < count; i++) {
+		index->entry[i].key = TOKEN_KEY(tokens[i].type, tokens[i].token);
+		index->entry[i].token = &tokens[i];
+	}
+
+	qsort(index->entry, count, sizeof(index->entry[0]), token_index_cmp);
+
+	index->next = *head;
+	__atomic_store_n(head, index, __ATOMIC_RELEASE);
+
+out:
+	pthread_mutex_unlock(&token_index_lock);
+	return index;
+}
+
+/* load the tuple into object with all table entries matching it */
+static void token_index_load(const struct token_index *index, uint32_t type,
+			     uint32_t token, void *elem, void *object)
+{
+	const struct sof_topology_token *t;
+	uint64_t key = TOKEN_KEY(type, token);
+	int low = 0;
+	int high = index->count;
+	int mid;
+
+	/* short indexes are faster to scan */
+	if (high <= TOKEN_INDEX_SCAN_SIZE) {
+		for (; low < high && index->entry[low].key <= key; low++) {
+			if (index->entry[low].key != key)
+				continue;
+
+			t = index->entry[low].token;
+			t->get_token(elem, object, t->offset, t->size);
+		}
+
+		return;
+	}
+
+	/* first entry not below the tuple */
+	while (low < high) {
+		mid = (low + high) / 2;
+		if (index->entry[mid].key < key)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	for (; low < index->count && index->entry[low].key == key; low++) {
+		t = index->entry[low].token;
+		t->get_token(elem, object, t->offset, t->size);
+	}
+}
+
 /* parse vendor tokens in topology */
 int sof_parse_tokens(void *object, const struct sof_topology_token *tokens,
 		     int count, struct snd_soc_tplg_vendor_array *array,
@@ -141,6 +270,9 @@ int sof_parse_tokens(void *object, const struct sof_topology_token *tokens,
 				array->type);
 			return -EINVAL;
 		}
+
+		/* next array */
+		array = MOVE_POINTER_BY_BYTES(array, asize);
 	}
 	return ret;
 }
@@ -152,7 +284,8 @@ int sof_parse_word_tokens(void *object,
 			  struct snd_soc_tplg_vendor_array *array)
 {
 	struct snd_soc_tplg_vendor_value_elem *elem;
-	int i, j;
+	struct token_index *index;
+	int i;
 
 	if (sizeof(struct snd_soc_tplg_vendor_value_elem) * array->num_elems +
 		sizeof(struct snd_soc_tplg_vendor_array) > array->size) {
@@ -161,24 +294,18 @@ int sof_parse_word_tokens(void *object,
 		return -EINVAL;
 	}
 
+	if (!count)
+		return 0;
+
+	index = token_index_get(tokens, count);
+	if (!index)
+		return -ENOMEM;
+
 	/* parse element by element */
 	for (i = 0; i < array->num_elems; i++) {
 		elem = &array->value[i];
-
-		/* search for token */
-		for (j = 0; j < count; j++) {
-			/* match token type */
-			if (tokens[j].type != SND_SOC_TPLG_TUPLE_TYPE_WORD)
-				continue;
-
-			/* match token id */
-			if (tokens[j].token != elem->token)
-				continue;
-
-			/* matched - now load token */
-			tokens[j].get_token(elem, object, tokens[j].offset,
-					    tokens[j].size);
-		}
+		token_index_load(index, SND_SOC_TPLG_TUPLE_TYPE_WORD, elem->token,
+				 elem, object);
 	}
 
 	return 0;
@@ -191,7 +318,8 @@ int sof_parse_uuid_tokens(void *object,
 			  struct snd_soc_tplg_vendor_array *array)
 {
 	struct snd_soc_tplg_vendor_uuid_elem *elem;
-	int i, j;
+	struct token_index *index;
+	int i;
 
 	if (sizeof(struct snd_soc_tplg_vendor_uuid_elem) * array->num_elems +
 		sizeof(struct snd_soc_tplg_vendor_array) > array->size) {
@@ -200,24 +328,18 @@ int sof_parse_uuid_tokens(void *object,
 		return -EINVAL;
 	}
 
+	if (!count)
+		return 0;
+
+	index = token_index_get(tokens, count);
+	if (!index)
+		return -ENOMEM;
+
 	/* parse element by element */
 	for (i = 0; i < array->num_elems; i++) {
 		elem = &array->uuid[i];
-
-		/* search for token */
-		for (j = 0; j < count; j++) {
-			/* match token type */
-			if (tokens[j].type != SND_SOC_TPLG_TUPLE_TYPE_UUID)
-				continue;
-
-			/* match token id */
-			if (tokens[j].token != elem->token)
-				continue;
-
-			/* matched - now load token */
-			tokens[j].get_token(elem, object, tokens[j].offset,
-					    tokens[j].size);
-		}
+		token_index_load(index, SND_SOC_TPLG_TUPLE_TYPE_UUID, elem->token,
+				 elem, object);
 	}
 
 	return 0;
@@ -230,7 +352,8 @@ int sof_parse_string_tokens(void *object,
 			    struct snd_soc_tplg_vendor_array *array)
 {
 	struct snd_soc_tplg_vendor_string_elem *elem;
-	int i, j;
+	struct token_index *index;
+	int i;
 
 	if (sizeof(struct snd_soc_tplg_vendor_string_elem) * array->num_elems +
 		sizeof(struct snd_soc_tplg_vendor_array) > array->size) {
@@ -239,24 +362,18 @@ int sof_parse_string_tokens(void *object,
 		return -EINVAL;
 	}
 
+	if (!count)
+		return 0;
+
+	index = token_index_get(tokens, count);
+	if (!index)
+		return -ENOMEM;
+
 	/* parse element by element */
 	for (i = 0; i < array->num_elems; i++) {
 		elem = &array->string[i];
-
-		/* search for token */
-		for (j = 0; j < count; j++) {
-			/* match token type */
-			if (tokens[j].type != SND_SOC_TPLG_TUPLE_TYPE_STRING)
-				continue;
-
-			/* match token id */
-			if (tokens[j].token != elem->token)
-				continue;
-
-			/* matched - now load token */
-			tokens[j].get_token(elem, object, tokens[j].offset,
-					    tokens[j].size);
-		}
+		token_index_load(index, SND_SOC_TPLG_TUPLE_TYPE_STRING, elem->token,
+				 elem, object);
 	}
 
 	return 0;
@@ -338,53 +455,31 @@ bool is_valid_priv_size(size_t size_read, size_t priv_size,
 }
 
 /* read vendor tuples array from topology */
-int tplg_read_array(struct snd_soc_tplg_vendor_array *array, FILE *file)
+int tplg_read_array(struct snd_soc_tplg_vendor_array *array, struct tplg_context *ctx)
 {
-	struct snd_soc_tplg_vendor_uuid_elem uuid;
-	struct snd_soc_tplg_vendor_string_elem string;
-	struct snd_soc_tplg_vendor_value_elem value;
-	int j, ret = 0;
 	size_t size;
 
 	switch (array->type) {
 	case SND_SOC_TPLG_TUPLE_TYPE_UUID:
-
-		/* copy uuid elems into array */
-		for (j = 0; j < array->num_elems; j++) {
-			size = sizeof(struct snd_soc_tplg_vendor_uuid_elem);
-			ret = fread(&uuid, size, 1, file);
-			if (ret != 1)
-				return -EINVAL;
-			memcpy(&array->uuid[j], &uuid, size);
-		}
+		size = sizeof(struct snd_soc_tplg_vendor_uuid_elem);
 		break;
 	case SND_SOC_TPLG_TUPLE_TYPE_STRING:
-
-		/* copy string elems into array */
-		for (j = 0; j < array->num_elems; j++) {
-			size = sizeof(struct snd_soc_tplg_vendor_string_elem);
-			ret = fread(&string, size, 1, file);
-			if (ret != 1)
-				return -EINVAL;
-			memcpy(&array->string[j], &string, size);
-		}
+		size = sizeof(struct snd_soc_tplg_vendor_string_elem);
 		break;
 	case SND_SOC_TPLG_TUPLE_TYPE_BOOL:
 	case SND_SOC_TPLG_TUPLE_TYPE_BYTE:
 	case SND_SOC_TPLG_TUPLE_TYPE_WORD:
 	case SND_SOC_TPLG_TUPLE_TYPE_SHORT:
-		/* copy value elems into array */
-		for (j = 0; j < array->num_elems; j++) {
-			size = sizeof(struct snd_soc_tplg_vendor_value_elem);
-			ret = fread(&value, size, 1, file);
-			if (ret != 1)
-				return -EINVAL;
-			memcpy(&array->value[j], &value, size);
-		}
+		size = sizeof(struct snd_soc_tplg_vendor_value_elem);
 		break;
 	default:
 		fprintf(stderr, "error: unknown token type %d\n", array->type);
 		return -EINVAL;
 	}
+
+	/* the elems follow the array header in the topology data */
+	if (!tplg_get(ctx, size * array->num_elems))
+		return -EINVAL;
+
 	return 0;
 }